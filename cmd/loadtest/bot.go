@@ -0,0 +1,218 @@
+package main
+
+import (
+	"bufio"
+	"errors"
+	"fmt"
+	"math/rand"
+	"net"
+	"regexp"
+	"strings"
+	"time"
+)
+
+const (
+	telnetIAC  byte = 255
+	telnetSB   byte = 250
+	telnetSE   byte = 240
+	telnetWILL byte = 251
+	telnetWONT byte = 252
+	telnetDO   byte = 253
+	telnetDONT byte = 254
+)
+
+// promptMarker ends every prompt the server sends after a command.
+const promptMarker = "] > "
+
+var ansiPattern = regexp.MustCompile(`\x1b\[[0-9;]*m`)
+
+// errTimeout reports that the server did not answer within the read timeout.
+var errTimeout = errors.New("timed out waiting for the server")
+
+// bot is one scripted client connected over telnet.
+type bot struct {
+	name     string
+	password string
+	conn     net.Conn
+	reader   *bufio.Reader
+	timeout  time.Duration
+	rng      *rand.Rand
+
+	exits []string
+	npcs  []string
+}
+
+func dialBot(addr, name string, timeout time.Duration, seed int64) (*bot, error) {
+	conn, err := net.DialTimeout("tcp", addr, timeout)
+	if err != nil {
+		return nil, err
+	}
+	return &bot{
+		name:     name,
+		password: "loadtest-" + name,
+		conn:     conn,
+		reader:   bufio.NewReader(conn),
+		timeout:  timeout,
+		rng:      rand.New(rand.NewSource(seed)),
+	}, nil
+}
+
+func (b *bot) close() {
+	_ = b.conn.Close()
+}
+
+func (b *bot) send(line string) error {
+	_ = b.conn.SetWriteDeadline(time.Now().Add(b.timeout))
+	_, err := b.conn.Write([]byte(line + "\r\n"))
+	return err
+}
+
+// readUntil collects server text, with telnet commands removed, until it
+// contains one of markers. It returns the text and the marker found.
+func (b *bot) readUntil(markers ...string) (string, string, error) {
+	_ = b.conn.SetReadDeadline(time.Now().Add(b.timeout))
+	var text strings.Builder
+	for {
+		c, err := b.reader.ReadByte()
+		if err != nil {
+			var ne net.Error
+			if errors.As(err, &ne) && ne.Timeout() {
+				err = errTimeout
+			}
+			return text.String(), "", err
+		}
+		if c == telnetIAC {
+			if err := b.skipCommand(); err != nil {
+				return text.String(), "", err
+			}
+			continue
+		}
+		text.WriteByte(c)
+		if c != ' ' {
+			continue
+		}
+		// Every marker ends in a space, so only check after one.
+		seen := text.String()
+		for _, marker := range markers {
+			if strings.HasSuffix(seen, marker) {
+				return seen, marker, nil
+			}
+		}
+	}
+}
+
+// skipCommand discards the rest of a telnet command. The bot refuses every
+// option by simply not answering, which the server tolerates.
+func (b *bot) skipCommand() error {
+	cmd, err := b.reader.ReadByte()
+	if err != nil {
+		return err
+	}
+	switch cmd {
+	case telnetWILL, telnetWONT, telnetDO, telnetDONT:
+		_, err = b.reader.ReadByte()
+		return err
+	case telnetSB:
+		for {
+			c, err := b.reader.ReadByte()
+			if err != nil {
+				return err
+			}
+			if c != telnetIAC {
+				continue
+			}
+			if c, err = b.reader.ReadByte(); err != nil || c == telnetSE {
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+// login registers the bot's account on first use and logs in, taking over
+// any session left behind by an earlier run.
+func (b *bot) login() error {
+	if _, _, err := b.readUntil("Username: "); err != nil {
+		return fmt.Errorf("waiting for username prompt: %w", err)
+	}
+	if err := b.send(b.name); err != nil {
+		return err
+	}
+	if _, _, err := b.readUntil("Password: ", "Set a password: "); err != nil {
+		return fmt.Errorf("waiting for password prompt: %w", err)
+	}
+	if err := b.send(b.password); err != nil {
+		return err
+	}
+	text, marker, err := b.readUntil(promptMarker, "(yes/no): ", "Password: ")
+	if err != nil {
+		return fmt.Errorf("waiting for first prompt: %w", err)
+	}
+	switch marker {
+	case "Password: ":
+		return fmt.Errorf("account %s exists with another password", b.name)
+	case "(yes/no): ":
+		if err := b.send("yes"); err != nil {
+			return err
+		}
+		if text, _, err = b.readUntil(promptMarker); err != nil {
+			return fmt.Errorf("waiting for first prompt: %w", err)
+		}
+	}
+	b.observe(text)
+	return nil
+}
+
+// observe remembers the exits and NPCs mentioned in server output.
+func (b *bot) observe(text string) {
+	for _, line := range strings.Split(ansiPattern.ReplaceAllString(text, ""), "\n") {
+		line = strings.TrimSpace(line)
+		if rest, ok := strings.CutPrefix(line, "Exits: "); ok {
+			b.exits = b.exits[:0]
+			if rest != "none" {
+				b.exits = append(b.exits, strings.Fields(rest)...)
+			}
+			b.npcs = b.npcs[:0]
+		}
+		if rest, ok := strings.CutPrefix(line, "You notice: "); ok {
+			b.npcs = strings.Split(rest, ", ")
+		}
+	}
+}
+
+// nextCommand picks the bot's next action: mostly walking and chatting,
+// with some fighting and use of the mail boards.
+func (b *bot) nextCommand() string {
+	roll := b.rng.Intn(100)
+	switch {
+	case roll < 35 && len(b.exits) > 0:
+		return b.exits[b.rng.Intn(len(b.exits))]
+	case roll < 50:
+		return "look"
+	case roll < 65:
+		return fmt.Sprintf("say Hello from %s", b.name)
+	case roll < 75:
+		return fmt.Sprintf("ooc %s checking in", b.name)
+	case roll < 85 && len(b.npcs) > 0:
+		return "attack " + b.npcs[b.rng.Intn(len(b.npcs))]
+	case roll < 93:
+		return "mail board loadtest"
+	default:
+		return fmt.Sprintf("mail write loadtest = Field report from %s", b.name)
+	}
+}
+
+// command sends line and waits for the prompt that follows it, returning
+// how long that took.
+func (b *bot) command(line string) (time.Duration, error) {
+	start := time.Now()
+	if err := b.send(line); err != nil {
+		return 0, err
+	}
+	text, _, err := b.readUntil(promptMarker)
+	if err != nil {
+		return 0, err
+	}
+	b.observe(text)
+	return time.Since(start), nil
+}
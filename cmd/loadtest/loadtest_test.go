@@ -0,0 +1,73 @@
+package main
+
+import (
+	"bytes"
+	"context"
+	"strings"
+	"testing"
+	"time"
+
+	"LumenClay/internal/game"
+)
+
+func TestParseStages(t *testing.T) {
+	stages, err := parseStages("10, 100,1000")
+	if err != nil || len(stages) != 3 || stages[2] != 1000 {
+		t.Fatalf("parseStages = %v, %v", stages, err)
+	}
+	for _, bad := range []string{"", "ten", "100,10", "0"} {
+		if _, err := parseStages(bad); err == nil {
+			t.Fatalf("expected %q to be rejected", bad)
+		}
+	}
+}
+
+func TestPercentile(t *testing.T) {
+	var latencies []time.Duration
+	for i := 1; i <= 100; i++ {
+		latencies = append(latencies, time.Duration(i)*time.Millisecond)
+	}
+	if got := percentile(latencies, 0.50); got != 50*time.Millisecond {
+		t.Fatalf("p50 = %s", got)
+	}
+	if got := percentile(latencies, 0.99); got != 99*time.Millisecond {
+		t.Fatalf("p99 = %s", got)
+	}
+}
+
+func TestRunDrivesInProcessServer(t *testing.T) {
+	for _, mode := range []game.ConnMode{game.ConnModeGoroutine, game.ConnModePoll} {
+		t.Run(string(mode), func(t *testing.T) { testRun(t, mode) })
+	}
+}
+
+func testRun(t *testing.T, mode game.ConnMode) {
+	if testing.Short() {
+		t.Skip("starts a server and several bots")
+	}
+	var out bytes.Buffer
+	cfg := config{
+		connMode: mode,
+		areas:    "../../data/areas",
+		stages:   []int{2, 4},
+		duration: 500 * time.Millisecond,
+		think:    20 * time.Millisecond,
+		timeout:  5 * time.Second,
+		logins:   4,
+		prefix:   "bot",
+	}
+	results, err := run(context.Background(), cfg, &out)
+	if err != nil {
+		t.Fatalf("run: %v\n%s", err, out.String())
+	}
+	if len(results) != 2 {
+		t.Fatalf("expected two stages, got %d\n%s", len(results), out.String())
+	}
+	last := results[1]
+	if last.Online != 4 || last.Commands == 0 || last.Failures != 0 || !last.ServerStats {
+		t.Fatalf("unexpected final stage %+v\n%s", last, out.String())
+	}
+	if !strings.Contains(out.String(), "mem/session") {
+		t.Fatalf("report missing header:\n%s", out.String())
+	}
+}
@@ -0,0 +1,344 @@
+// Command loadtest connects scripted telnet bots to a LumenClay server and
+// reports command-to-prompt latency, throughput, shed output and memory per
+// session at each connection level.
+//
+// By default it starts a server in-process on a loopback port, with a copy
+// of the areas and a throwaway account database, so that the server's own
+// statistics are available. Pass -addr to drive a server that is already
+// running instead.
+package main
+
+import (
+	"context"
+	"flag"
+	"fmt"
+	"io"
+	"log"
+	"net"
+	"os"
+	"os/signal"
+	"path/filepath"
+	"runtime"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"LumenClay/commands"
+	"LumenClay/internal/game"
+)
+
+type config struct {
+	// addr is an external server to connect to; empty starts one.
+	addr     string
+	areas    string
+	stages   []int
+	duration time.Duration
+	think    time.Duration
+	timeout  time.Duration
+	logins   int
+	prefix   string
+	connMode game.ConnMode
+}
+
+func main() {
+	addr := flag.String("addr", "", "Address of a running server to load (empty starts one in-process)")
+	areas := flag.String("areas", game.DefaultAreasPath, "Areas directory for the in-process server")
+	bots := flag.String("bots", "10,100,1000", "Comma-separated connection counts to step through")
+	duration := flag.Duration("duration", 30*time.Second, "How long to measure at each connection count")
+	think := flag.Duration("think", time.Second, "Mean pause between a bot's commands")
+	timeout := flag.Duration("timeout", 10*time.Second, "How long a bot waits for the server before counting a timeout")
+	logins := flag.Int("logins", 50, "Bots allowed to log in at the same time while ramping up")
+	prefix := flag.String("prefix", "bot", "Account name prefix for the bots")
+	connMode := flag.String("conn-mode", "goroutine", "Connection mode for the in-process server: goroutine or poll")
+	flag.Parse()
+
+	stages, err := parseStages(*bots)
+	if err != nil {
+		log.Fatal(err)
+	}
+	mode, err := game.ParseConnMode(*connMode)
+	if err != nil {
+		log.Fatal(err)
+	}
+	cfg := config{
+		addr:     *addr,
+		areas:    *areas,
+		stages:   stages,
+		duration: *duration,
+		think:    *think,
+		timeout:  *timeout,
+		logins:   *logins,
+		prefix:   *prefix,
+		connMode: mode,
+	}
+	ctx, stop := signal.NotifyContext(context.Background(), os.Interrupt)
+	defer stop()
+	if _, err := run(ctx, cfg, os.Stdout); err != nil {
+		log.Fatal(err)
+	}
+}
+
+func parseStages(value string) ([]int, error) {
+	var stages []int
+	last := 0
+	for _, field := range strings.Split(value, ",") {
+		n, err := strconv.Atoi(strings.TrimSpace(field))
+		if err != nil || n <= 0 {
+			return nil, fmt.Errorf("invalid bot count %q", field)
+		}
+		if n < last {
+			return nil, fmt.Errorf("bot counts must not decrease: %d after %d", n, last)
+		}
+		stages = append(stages, n)
+		last = n
+	}
+	return stages, nil
+}
+
+// run steps through cfg.stages, adding bots until each count is connected
+// and then measuring for cfg.duration. Bots stay connected between stages.
+func run(ctx context.Context, cfg config, out io.Writer) ([]stageResult, error) {
+	addr := cfg.addr
+	var world *game.World
+	if addr == "" {
+		server, err := startServer(cfg.areas, cfg.connMode)
+		if err != nil {
+			return nil, err
+		}
+		defer server.cleanup()
+		addr, world = server.addr, server.world
+		fmt.Fprintf(out, "started server on %s\n", addr)
+	}
+	baseline := memoryInUse()
+	baselineGoroutines := runtime.NumGoroutine()
+
+	ctx, cancel := context.WithCancel(ctx)
+	var (
+		rec     recorder
+		online  atomic.Int64
+		running sync.WaitGroup
+		results []stageResult
+	)
+	defer func() {
+		cancel()
+		running.Wait()
+	}()
+
+	writeReportHeader(out)
+	started := 0
+	for _, target := range cfg.stages {
+		var ramp sync.WaitGroup
+		logins := make(chan struct{}, max(cfg.logins, 1))
+		for ; started < target; started++ {
+			ramp.Add(1)
+			running.Add(1)
+			go func(id int) {
+				defer running.Done()
+				logins <- struct{}{}
+				b, err := connectBot(addr, fmt.Sprintf("%s%d", cfg.prefix, id), cfg.timeout, int64(id))
+				<-logins
+				ramp.Done()
+				if err != nil {
+					rec.fail(err)
+					return
+				}
+				b.run(ctx, cfg.think, &rec, &online)
+			}(started)
+		}
+		ramp.Wait()
+
+		droppedBefore := droppedOutput(world)
+		rec.reset()
+		start := time.Now()
+		select {
+		case <-time.After(cfg.duration):
+		case <-ctx.Done():
+			return results, ctx.Err()
+		}
+		latencies, timeouts, failures := rec.reset()
+		result := summarise(target, time.Since(start), latencies)
+		result.Timeouts, result.Failures = timeouts, failures
+		result.Online = int(online.Load())
+		if world != nil {
+			result.ServerStats = true
+			result.Online = len(world.PlayerSnapshots())
+			result.Dropped = droppedOutput(world) - droppedBefore
+			if memory := memoryInUse(); result.Online > 0 && memory > baseline {
+				result.MemoryPerSession = (memory - baseline) / uint64(result.Online)
+			}
+			// Every connected bot runs one goroutine of its own.
+			if server := runtime.NumGoroutine() - baselineGoroutines - int(online.Load()); result.Online > 0 && server > 0 {
+				result.GoroutinesPerSession = float64(server) / float64(result.Online)
+			}
+		}
+		writeReportRow(out, result)
+		results = append(results, result)
+	}
+	return results, nil
+}
+
+func connectBot(addr, name string, timeout time.Duration, seed int64) (*bot, error) {
+	b, err := dialBot(addr, name, timeout, seed)
+	if err != nil {
+		return nil, err
+	}
+	if err := b.login(); err != nil {
+		b.close()
+		return nil, fmt.Errorf("%s: %w", name, err)
+	}
+	return b, nil
+}
+
+// run issues commands with a randomised pause until ctx is cancelled or the
+// connection fails.
+func (b *bot) run(ctx context.Context, think time.Duration, rec *recorder, online *atomic.Int64) {
+	online.Add(1)
+	defer online.Add(-1)
+	stop := context.AfterFunc(ctx, b.close)
+	defer stop()
+	defer b.close()
+
+	timer := time.NewTimer(0)
+	defer timer.Stop()
+	<-timer.C
+	for {
+		pause := think/2 + time.Duration(b.rng.Int63n(int64(think)+1))
+		timer.Reset(pause)
+		select {
+		case <-ctx.Done():
+			return
+		case <-timer.C:
+		}
+		latency, err := b.command(b.nextCommand())
+		if ctx.Err() != nil {
+			return
+		}
+		if err != nil {
+			rec.fail(err)
+			if err == errTimeout {
+				continue
+			}
+			return
+		}
+		rec.observe(latency)
+	}
+}
+
+// droppedOutput totals the output messages the server has shed.
+func droppedOutput(world *game.World) uint64 {
+	if world == nil {
+		return 0
+	}
+	var dropped uint64
+	for _, snap := range world.PlayerSnapshots() {
+		dropped += snap.Output.Dropped
+	}
+	return dropped
+}
+
+// memoryInUse reports the heap and goroutine stacks in use after a
+// collection. With an in-process server it includes the bots, which each
+// hold one goroutine and a small read buffer.
+func memoryInUse() uint64 {
+	runtime.GC()
+	var stats runtime.MemStats
+	runtime.ReadMemStats(&stats)
+	return stats.HeapInuse + stats.StackInuse
+}
+
+type localServer struct {
+	addr    string
+	world   *game.World
+	cleanup func()
+}
+
+// startServer runs a server on a loopback port with a copy of the areas in
+// areasPath and a temporary account database.
+func startServer(areasPath string, mode game.ConnMode) (*localServer, error) {
+	dir, err := os.MkdirTemp("", "lumenclay-loadtest-")
+	if err != nil {
+		return nil, err
+	}
+	cleanup := func() { _ = os.RemoveAll(dir) }
+	areasCopy := filepath.Join(dir, "areas")
+	if err := copyAreas(areasPath, areasCopy); err != nil {
+		cleanup()
+		return nil, err
+	}
+
+	type listening struct {
+		addr  net.Addr
+		world *game.World
+	}
+	// Every bot connects from loopback and the point is to find the
+	// server's limits, so admission control only keeps its login timeout
+	// and command rate.
+	admission := game.DefaultAdmissionConfig()
+	admission.MaxConnections = 0
+	admission.MaxPerIP = 0
+	admission.ShedLockWait = 0
+	admission.ShedOutputBytes = 0
+	ready := make(chan listening, 1)
+	failed := make(chan error, 1)
+	go func() {
+		failed <- game.ListenAndServe(
+			"127.0.0.1:0",
+			filepath.Join(dir, "accounts.json"),
+			areasCopy,
+			"loadtest-admin",
+			commands.Dispatch,
+			false,
+			game.WithOutputConfig(game.DefaultOutputConfig()),
+			game.WithConnMode(mode),
+			game.WithAdmissionConfig(admission),
+			game.WithListenHook(func(addr net.Addr, world *game.World) {
+				ready <- listening{addr: addr, world: world}
+			}),
+		)
+	}()
+	select {
+	case l := <-ready:
+		return &localServer{addr: l.addr.String(), world: l.world, cleanup: cleanup}, nil
+	case err := <-failed:
+		cleanup()
+		if err == nil {
+			err = fmt.Errorf("server stopped before listening")
+		}
+		return nil, fmt.Errorf("start server: %w", err)
+	}
+}
+
+// copyAreas copies the area files, and the quests file beside them, so the
+// run cannot touch the real world data.
+func copyAreas(from, to string) error {
+	if err := os.MkdirAll(to, 0o755); err != nil {
+		return err
+	}
+	files, err := filepath.Glob(filepath.Join(from, "*.json"))
+	if err != nil {
+		return err
+	}
+	if len(files) == 0 {
+		return fmt.Errorf("no area files in %s", from)
+	}
+	quests := filepath.Join(filepath.Dir(from), "quests.json")
+	if _, err := os.Stat(quests); err == nil {
+		files = append(files, quests)
+	}
+	for _, src := range files {
+		data, err := os.ReadFile(src)
+		if err != nil {
+			return err
+		}
+		dst := filepath.Join(to, filepath.Base(src))
+		if filepath.Base(src) == "quests.json" {
+			dst = filepath.Join(filepath.Dir(to), "quests.json")
+		}
+		if err := os.WriteFile(dst, data, 0o644); err != nil {
+			return err
+		}
+	}
+	return nil
+}
@@ -0,0 +1,122 @@
+package main
+
+import (
+	"fmt"
+	"io"
+	"sort"
+	"sync"
+	"time"
+)
+
+// recorder collects command latencies and failures for the current stage.
+type recorder struct {
+	mu        sync.Mutex
+	latencies []time.Duration
+	timeouts  int
+	failures  int
+}
+
+func (r *recorder) observe(latency time.Duration) {
+	r.mu.Lock()
+	r.latencies = append(r.latencies, latency)
+	r.mu.Unlock()
+}
+
+func (r *recorder) fail(err error) {
+	r.mu.Lock()
+	if err == errTimeout {
+		r.timeouts++
+	} else {
+		r.failures++
+	}
+	r.mu.Unlock()
+}
+
+// reset returns what was recorded since the last reset and starts afresh.
+func (r *recorder) reset() (latencies []time.Duration, timeouts, failures int) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	latencies, timeouts, failures = r.latencies, r.timeouts, r.failures
+	r.latencies, r.timeouts, r.failures = nil, 0, 0
+	return latencies, timeouts, failures
+}
+
+// stageResult summarises one connection level of a run.
+type stageResult struct {
+	Bots       int
+	Online     int
+	Commands   int
+	Throughput float64
+	P50        time.Duration
+	P99        time.Duration
+	Max        time.Duration
+	Timeouts   int
+	Failures   int
+	// Dropped is the number of output messages the server shed during
+	// the stage, MemoryPerSession its heap and stacks divided by the connected
+	// sessions, and GoroutinesPerSession the server goroutines each
+	// session costs. They are only known for an in-process server.
+	Dropped              uint64
+	MemoryPerSession     uint64
+	GoroutinesPerSession float64
+	ServerStats          bool
+}
+
+func summarise(bots int, elapsed time.Duration, latencies []time.Duration) stageResult {
+	result := stageResult{Bots: bots, Commands: len(latencies)}
+	if elapsed > 0 {
+		result.Throughput = float64(len(latencies)) / elapsed.Seconds()
+	}
+	if len(latencies) == 0 {
+		return result
+	}
+	sort.Slice(latencies, func(i, j int) bool { return latencies[i] < latencies[j] })
+	result.P50 = percentile(latencies, 0.50)
+	result.P99 = percentile(latencies, 0.99)
+	result.Max = latencies[len(latencies)-1]
+	return result
+}
+
+// percentile returns the q quantile of sorted latencies.
+func percentile(sorted []time.Duration, q float64) time.Duration {
+	if len(sorted) == 0 {
+		return 0
+	}
+	index := int(q*float64(len(sorted))+0.5) - 1
+	if index < 0 {
+		index = 0
+	}
+	if index >= len(sorted) {
+		index = len(sorted) - 1
+	}
+	return sorted[index]
+}
+
+func writeReportHeader(w io.Writer) {
+	fmt.Fprintf(w, "%6s %6s %9s %10s %10s %10s %8s %8s %9s %12s %11s\n",
+		"bots", "online", "cmd/s", "p50", "p99", "max", "timeout", "failed", "dropped", "mem/session", "gor/session")
+}
+
+func writeReportRow(w io.Writer, r stageResult) {
+	dropped, memory, goroutines := "-", "-", "-"
+	if r.ServerStats {
+		dropped = fmt.Sprint(r.Dropped)
+		memory = formatBytes(r.MemoryPerSession)
+		goroutines = fmt.Sprintf("%.2f", r.GoroutinesPerSession)
+	}
+	fmt.Fprintf(w, "%6d %6d %9.1f %10s %10s %10s %8d %8d %9s %12s %11s\n",
+		r.Bots, r.Online, r.Throughput,
+		r.P50.Round(time.Microsecond), r.P99.Round(time.Microsecond), r.Max.Round(time.Microsecond),
+		r.Timeouts, r.Failures, dropped, memory, goroutines)
+}
+
+func formatBytes(n uint64) string {
+	switch {
+	case n >= 1<<20:
+		return fmt.Sprintf("%.1f MiB", float64(n)/(1<<20))
+	case n >= 1<<10:
+		return fmt.Sprintf("%.1f KiB", float64(n)/(1<<10))
+	default:
+		return fmt.Sprintf("%d B", n)
+	}
+}
@@ -29,11 +29,11 @@ func TestBuilderCommandTogglesFlag(t *testing.T) {
 		t.Fatalf("target should be builder after command")
 	}
 
-	adminMsgs := drainOutput(admin.Output)
+	adminMsgs := drainOutput(admin)
 	if len(adminMsgs) == 0 || !strings.Contains(adminMsgs[len(adminMsgs)-1], "Target is now a builder") {
 		t.Fatalf("unexpected admin output: %v", adminMsgs)
 	}
-	targetMsgs := drainOutput(target.Output)
+	targetMsgs := drainOutput(target)
 	sawNotice := false
 	for _, msg := range targetMsgs {
 		if strings.Contains(msg, "You are now a builder") {
@@ -74,11 +74,11 @@ func TestModeratorCommandTogglesFlag(t *testing.T) {
 		t.Fatalf("target should be moderator after enable")
 	}
 
-	adminMsgs := drainOutput(admin.Output)
+	adminMsgs := drainOutput(admin)
 	if len(adminMsgs) == 0 || !strings.Contains(adminMsgs[len(adminMsgs)-1], "Target is now a moderator") {
 		t.Fatalf("unexpected admin output: %v", adminMsgs)
 	}
-	targetMsgs := drainOutput(target.Output)
+	targetMsgs := drainOutput(target)
 	sawNotice := false
 	for _, msg := range targetMsgs {
 		if strings.Contains(msg, "You are now a moderator") {
@@ -121,7 +121,7 @@ func TestGotoRequiresBuilder(t *testing.T) {
 	if player.Room != "start" {
 		t.Fatalf("player should not have moved, room = %s", player.Room)
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawWarning := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Only builders or admins may use goto") {
@@ -161,7 +161,7 @@ func TestGotoMovesBuilder(t *testing.T) {
 		t.Fatalf("builder.Room = %s, want second", builder.Room)
 	}
 
-	builderMsgs := drainOutput(builder.Output)
+	builderMsgs := drainOutput(builder)
 	sawRoom := false
 	for _, msg := range builderMsgs {
 		if strings.Contains(msg, "Second room.") {
@@ -172,7 +172,7 @@ func TestGotoMovesBuilder(t *testing.T) {
 		t.Fatalf("builder did not see destination room: %v", builderMsgs)
 	}
 
-	observerMsgs := drainOutput(observer.Output)
+	observerMsgs := drainOutput(observer)
 	sawArrival := false
 	for _, msg := range observerMsgs {
 		if strings.Contains(msg, "appears in a shimmer of light") {
@@ -208,7 +208,7 @@ func TestTeleportRequiresBuilder(t *testing.T) {
 	if player.Room != "start" {
 		t.Fatalf("player should not have moved, room = %s", player.Room)
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawWarning := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Only builders or admins may use teleport") {
@@ -250,7 +250,7 @@ func TestTeleportMovesBuilderToRoom(t *testing.T) {
 		t.Fatalf("builder.Room = %s, want second", builder.Room)
 	}
 
-	builderMsgs := drainOutput(builder.Output)
+	builderMsgs := drainOutput(builder)
 	sawRoom := false
 	for _, msg := range builderMsgs {
 		if strings.Contains(msg, "Second room.") {
@@ -261,7 +261,7 @@ func TestTeleportMovesBuilderToRoom(t *testing.T) {
 		t.Fatalf("builder did not see destination room: %v", builderMsgs)
 	}
 
-	startMsgs := drainOutput(witnessStart.Output)
+	startMsgs := drainOutput(witnessStart)
 	sawVanish := false
 	for _, msg := range startMsgs {
 		if strings.Contains(msg, "vanishes in a shimmer of light") {
@@ -272,7 +272,7 @@ func TestTeleportMovesBuilderToRoom(t *testing.T) {
 		t.Fatalf("start witness did not see departure: %v", startMsgs)
 	}
 
-	endMsgs := drainOutput(witnessEnd.Output)
+	endMsgs := drainOutput(witnessEnd)
 	sawArrival := false
 	for _, msg := range endMsgs {
 		if strings.Contains(msg, "appears in a shimmer of light") {
@@ -314,7 +314,7 @@ func TestTeleportMovesBuilderToPlayer(t *testing.T) {
 		t.Fatalf("builder.Room = %s, want second", builder.Room)
 	}
 
-	targetMsgs := drainOutput(target.Output)
+	targetMsgs := drainOutput(target)
 	sawArrival := false
 	for _, msg := range targetMsgs {
 		if strings.Contains(msg, "appears in a shimmer of light next to Target") {
@@ -325,7 +325,7 @@ func TestTeleportMovesBuilderToPlayer(t *testing.T) {
 		t.Fatalf("target did not see arrival message: %v", targetMsgs)
 	}
 
-	observerMsgs := drainOutput(observer.Output)
+	observerMsgs := drainOutput(observer)
 	sawArrival = false
 	for _, msg := range observerMsgs {
 		if strings.Contains(msg, "appears in a shimmer of light next to Target") {
@@ -365,7 +365,7 @@ func TestSummonMovesTarget(t *testing.T) {
 		t.Fatalf("target.Room = %s, want start", target.Room)
 	}
 
-	adminMsgs := drainOutput(admin.Output)
+	adminMsgs := drainOutput(admin)
 	sawSummon := false
 	for _, msg := range adminMsgs {
 		if strings.Contains(msg, "You summon Target to your side") {
@@ -376,7 +376,7 @@ func TestSummonMovesTarget(t *testing.T) {
 		t.Fatalf("admin did not receive confirmation: %v", adminMsgs)
 	}
 
-	targetMsgs := drainOutput(target.Output)
+	targetMsgs := drainOutput(target)
 	sawNotice := false
 	for _, msg := range targetMsgs {
 		if strings.Contains(msg, "You are summoned by Admin") {
@@ -412,7 +412,7 @@ func TestWhereListsLocations(t *testing.T) {
 	if quit := Dispatch(world, builder, "where"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := drainOutput(builder.Output)
+	msgs := drainOutput(builder)
 	sawHeader := false
 	sawOther := false
 	for _, msg := range msgs {
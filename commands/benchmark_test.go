@@ -0,0 +1,37 @@
+package commands
+
+import (
+	"testing"
+
+	"LumenClay/internal/game"
+)
+
+func BenchmarkDispatch(b *testing.B) {
+	world := game.NewWorldWithRooms(map[game.RoomID]*game.Room{
+		"start": {
+			ID:          "start",
+			Title:       "Starting Room",
+			Description: "A quiet foyer lit by a single lantern.",
+			Exits:       map[string]game.RoomID{"north": "hall"},
+			NPCs:        []game.NPC{{Name: "Guide"}},
+			Items:       []game.Item{{Name: "Lantern"}},
+		},
+		"hall": {ID: "hall", Title: "Hallway", Exits: map[string]game.RoomID{"south": "start"}},
+	})
+	player := newTestPlayer("Hero", "start")
+	world.AddPlayerForTest(player)
+	for _, bench := range []struct{ name, line string }{
+		{"look", "look"},
+		{"abbreviation", "l"},
+		{"typo", "lokk"},
+		{"unknown", "xyzzy"},
+	} {
+		b.Run(bench.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				Dispatch(world, player, bench.line)
+				player.TakeOutputForTest()
+			}
+		})
+	}
+}
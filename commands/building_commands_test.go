@@ -22,7 +22,7 @@ func TestDigRequiresBuilder(t *testing.T) {
 	if quit := Dispatch(world, player, "dig cavern Cavern of Echoes"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawWarning := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Only builders or admins may use dig") {
@@ -57,7 +57,7 @@ func TestDigCreatesRoom(t *testing.T) {
 	if room.Title != "Cavern of Echoes" {
 		t.Fatalf("room title = %q, want Cavern of Echoes", room.Title)
 	}
-	msgs := drainOutput(builder.Output)
+	msgs := drainOutput(builder)
 	sawConfirmation := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Created room cavern") {
@@ -176,7 +176,7 @@ func TestResetRequiresBuilder(t *testing.T) {
 	if quit := Dispatch(world, player, "reset add npc Stone Guide"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawWarning := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Only builders or admins may manage resets") {
@@ -218,7 +218,7 @@ func TestResetAddNPCAndList(t *testing.T) {
 	if quit := Dispatch(world, builder, "reset list"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := drainOutput(builder.Output)
+	msgs := drainOutput(builder)
 	listed := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Stone Guide") {
@@ -331,7 +331,7 @@ func TestNameRoomUpdatesTitle(t *testing.T) {
 	if room.Title != "Gathering Hall" {
 		t.Fatalf("room title = %q, want Gathering Hall", room.Title)
 	}
-	output := strings.Join(drainOutput(builder.Output), "")
+	output := strings.Join(drainOutput(builder), "")
 	if !strings.Contains(output, "Room name updated") {
 		t.Fatalf("expected confirmation, got %q", output)
 	}
@@ -353,12 +353,12 @@ func TestListShowsRoomRevisions(t *testing.T) {
 	if quit := Dispatch(world, builder, "describe A quiet alcove"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	drainOutput(builder.Output)
+	drainOutput(builder)
 
 	if quit := Dispatch(world, builder, "list"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := strings.Join(drainOutput(builder.Output), "")
+	output := strings.Join(drainOutput(builder), "")
 	if !strings.Contains(output, "#1") || !strings.Contains(output, "#2") {
 		t.Fatalf("expected revision numbers, got %q", output)
 	}
@@ -386,12 +386,12 @@ func TestRevnumRevertsRoom(t *testing.T) {
 	if quit := Dispatch(world, builder, "describe Second draft"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	drainOutput(builder.Output)
+	drainOutput(builder)
 
 	if quit := Dispatch(world, builder, "revnum 2"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := strings.Join(drainOutput(builder.Output), "")
+	msgs := strings.Join(drainOutput(builder), "")
 	if !strings.Contains(msgs, "Room reverted to revision #2") {
 		t.Fatalf("expected revert confirmation, got %q", msgs)
 	}
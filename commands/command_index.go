@@ -0,0 +1,193 @@
+package commands
+
+import (
+	"strings"
+	"sync/atomic"
+	"unicode"
+	"unicode/utf8"
+)
+
+// commandIndex is an immutable prefix trie over every registered name,
+// shortcut and alias. Abbreviations are resolved when the index is built, so
+// lookups walk the input once without locking or allocating.
+type commandIndex struct {
+	root       *commandNode
+	candidates []fuzzyCandidate
+}
+
+type commandNode struct {
+	labels   []byte
+	children []*commandNode
+	// exact is the command registered under the key ending at this node.
+	exact *Command
+	// match is the only command with a key under this prefix, or nil when
+	// several commands share it.
+	match     *Command
+	ambiguous bool
+}
+
+// fuzzyCandidate is a primary command name prepared for typo matching.
+type fuzzyCandidate struct {
+	name      string
+	threshold int
+	cmd       *Command
+}
+
+// index caches the trie built from the registry. Define clears it; the next
+// lookup rebuilds it.
+var index atomic.Pointer[commandIndex]
+
+func currentIndex() *commandIndex {
+	if idx := index.Load(); idx != nil {
+		return idx
+	}
+	registryMu.RLock()
+	defer registryMu.RUnlock()
+	if idx := index.Load(); idx != nil {
+		return idx
+	}
+	idx := buildCommandIndexLocked()
+	index.Store(idx)
+	return idx
+}
+
+func buildCommandIndexLocked() *commandIndex {
+	root := &commandNode{}
+	for key, cmd := range registry {
+		node := root
+		for i := 0; i < len(key); i++ {
+			next := node.child(key[i])
+			if next == nil {
+				next = &commandNode{}
+				node.labels = append(node.labels, key[i])
+				node.children = append(node.children, next)
+			}
+			node = next
+		}
+		node.exact = cmd
+	}
+	root.resolve()
+
+	candidates := make([]fuzzyCandidate, 0, len(ordered))
+	for _, cmd := range ordered {
+		name := strings.ToLower(cmd.Name)
+		threshold := len(name) / 2
+		if threshold < 2 {
+			threshold = 2
+		}
+		candidates = append(candidates, fuzzyCandidate{name: name, threshold: threshold, cmd: cmd})
+	}
+	return &commandIndex{root: root, candidates: candidates}
+}
+
+// resolve records which command each prefix abbreviates.
+func (n *commandNode) resolve() (*Command, bool) {
+	match := n.exact
+	ambiguous := false
+	for _, child := range n.children {
+		cmd, childAmbiguous := child.resolve()
+		switch {
+		case childAmbiguous:
+			ambiguous = true
+		case cmd == nil:
+		case match == nil:
+			match = cmd
+		case match != cmd:
+			ambiguous = true
+		}
+	}
+	if ambiguous {
+		match = nil
+	}
+	n.match, n.ambiguous = match, ambiguous
+	return match, ambiguous
+}
+
+func (n *commandNode) child(label byte) *commandNode {
+	for i, l := range n.labels {
+		if l == label {
+			return n.children[i]
+		}
+	}
+	return nil
+}
+
+// find returns the command registered under name, ignoring case.
+func (idx *commandIndex) find(name string) (*Command, bool) {
+	node := idx.walk(name)
+	if node == nil || node.exact == nil {
+		return nil, false
+	}
+	return node.exact, true
+}
+
+// resolve returns the command name refers to: an exact key, else the single
+// command it abbreviates, else the closest primary name by edit distance.
+// Prefixes shared by several commands resolve to nothing.
+func (idx *commandIndex) resolve(name string) *Command {
+	if node := idx.walk(name); node != nil {
+		if node.exact != nil {
+			return node.exact
+		}
+		return node.match
+	}
+	return idx.nearest(name)
+}
+
+func (idx *commandIndex) walk(name string) *commandNode {
+	if name == "" {
+		return nil
+	}
+	node := idx.root
+	for i := 0; i < len(name) && node != nil; i++ {
+		b := name[i]
+		if 'A' <= b && b <= 'Z' {
+			b += 'a' - 'A'
+		}
+		node = node.child(b)
+	}
+	return node
+}
+
+func (idx *commandIndex) nearest(name string) *Command {
+	var (
+		bestCmd      *Command
+		bestDistance int
+		bestName     string
+	)
+	for _, candidate := range idx.candidates {
+		dist := levenshtein(name, candidate.name)
+		if dist > candidate.threshold {
+			continue
+		}
+		if bestCmd == nil || dist < bestDistance || (dist == bestDistance && candidate.name < bestName) {
+			bestCmd = candidate.cmd
+			bestDistance = dist
+			bestName = candidate.name
+		}
+	}
+	return bestCmd
+}
+
+// splitCommand returns the first whitespace-separated word of line and the
+// trimmed remainder, matching strings.Fields without allocating.
+func splitCommand(line string) (word, rest string) {
+	start := -1
+	for i := 0; i < len(line); {
+		r, size := rune(line[i]), 1
+		if r >= utf8.RuneSelf {
+			r, size = utf8.DecodeRuneInString(line[i:])
+		}
+		space := unicode.IsSpace(r)
+		if start < 0 && !space {
+			start = i
+		} else if start >= 0 && space {
+			return line[start:i], strings.TrimSpace(line[i:])
+		}
+		i += size
+	}
+	if start < 0 {
+		return "", ""
+	}
+	return line[start:], ""
+}
@@ -0,0 +1,102 @@
+package commands
+
+import (
+	"strings"
+	"testing"
+)
+
+// linearResolve is the registry scan the prefix trie replaced.
+func linearResolve(name string) *Command {
+	lower := strings.ToLower(name)
+	registryMu.RLock()
+	defer registryMu.RUnlock()
+	if cmd, ok := registry[lower]; ok {
+		return cmd
+	}
+	matches := make(map[*Command]bool)
+	for key, cmd := range registry {
+		if strings.HasPrefix(key, lower) {
+			matches[cmd] = true
+		}
+	}
+	if len(matches) == 1 {
+		for cmd := range matches {
+			return cmd
+		}
+	}
+	if len(matches) > 1 {
+		return nil
+	}
+	return currentIndex().nearest(lower)
+}
+
+func TestCommandIndexMatchesRegistryScan(t *testing.T) {
+	registryMu.RLock()
+	inputs := []string{"sya", "lokk", "tel", "xyzzy", "HeL", "SAY"}
+	for key := range registry {
+		for i := 1; i <= len(key); i++ {
+			inputs = append(inputs, key[:i])
+		}
+	}
+	registryMu.RUnlock()
+
+	idx := currentIndex()
+	for _, input := range inputs {
+		if got, want := idx.resolve(input), linearResolve(input); got != want {
+			t.Fatalf("resolve(%q) = %v, want %v", input, commandName(got), commandName(want))
+		}
+	}
+}
+
+func commandName(cmd *Command) string {
+	if cmd == nil {
+		return "<nil>"
+	}
+	return cmd.Name
+}
+
+func TestSplitCommandMatchesFields(t *testing.T) {
+	for _, line := range []string{"", "   ", "look", "  say  hello there ", "go\teast", "tell Bob hi"} {
+		word, rest := splitCommand(line)
+		fields := strings.Fields(line)
+		if len(fields) == 0 {
+			if word != "" || rest != "" {
+				t.Fatalf("splitCommand(%q) = %q, %q; want empty", line, word, rest)
+			}
+			continue
+		}
+		if word != fields[0] {
+			t.Fatalf("splitCommand(%q) word = %q, want %q", line, word, fields[0])
+		}
+		if strings.Join(strings.Fields(rest), " ") != strings.Join(fields[1:], " ") {
+			t.Fatalf("splitCommand(%q) rest = %q, want %q", line, rest, fields[1:])
+		}
+	}
+}
+
+func TestCommandLookupDoesNotAllocate(t *testing.T) {
+	idx := currentIndex()
+	allocs := testing.AllocsPerRun(100, func() {
+		word, _ := splitCommand("  Sya hello there")
+		idx.resolve(word)
+		idx.resolve("hel")
+		Find("look")
+	})
+	if allocs != 0 {
+		t.Fatalf("command lookup allocated %.0f times", allocs)
+	}
+}
+
+func BenchmarkCommandLookup(b *testing.B) {
+	idx := currentIndex()
+	for _, input := range []string{"look", "l", "inv", "sya", "xyzzy"} {
+		line := input + " the lantern"
+		b.Run(input, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				word, _ := splitCommand(line)
+				idx.resolve(word)
+			}
+		})
+	}
+}
@@ -22,7 +22,7 @@ func TestCommandToggleRequiresAdmin(t *testing.T) {
 	if quit := Dispatch(world, player, "command say off"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := strings.Join(drainOutput(player.Output), "\n")
+	output := strings.Join(drainOutput(player), "\n")
 	if !strings.Contains(output, "Only admins may manage commands") {
 		t.Fatalf("expected admin warning, got %q", output)
 	}
@@ -51,7 +51,7 @@ func TestCommandToggleDisablesAndEnables(t *testing.T) {
 	if !world.CommandDisabled("say") {
 		t.Fatalf("say command should be disabled")
 	}
-	adminOutput := strings.Join(drainOutput(admin.Output), "\n")
+	adminOutput := strings.Join(drainOutput(admin), "\n")
 	if !strings.Contains(adminOutput, "Command say is now disabled.") {
 		t.Fatalf("unexpected admin output: %q", adminOutput)
 	}
@@ -59,11 +59,11 @@ func TestCommandToggleDisablesAndEnables(t *testing.T) {
 	if quit := Dispatch(world, speaker, "say hello"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	speakerOutput := strings.Join(drainOutput(speaker.Output), "\n")
+	speakerOutput := strings.Join(drainOutput(speaker), "\n")
 	if !strings.Contains(speakerOutput, "command is temporarily disabled") {
 		t.Fatalf("expected disabled notice, got %q", speakerOutput)
 	}
-	if msgs := drainOutput(listener.Output); len(msgs) != 0 {
+	if msgs := drainOutput(listener); len(msgs) != 0 {
 		t.Fatalf("listener should not receive broadcast, got %v", msgs)
 	}
 
@@ -73,7 +73,7 @@ func TestCommandToggleDisablesAndEnables(t *testing.T) {
 	if world.CommandDisabled("say") {
 		t.Fatalf("say command should be enabled")
 	}
-	adminOutput = strings.Join(drainOutput(admin.Output), "\n")
+	adminOutput = strings.Join(drainOutput(admin), "\n")
 	if !strings.Contains(adminOutput, "Command say is now enabled.") {
 		t.Fatalf("unexpected admin output after enable: %q", adminOutput)
 	}
@@ -81,7 +81,7 @@ func TestCommandToggleDisablesAndEnables(t *testing.T) {
 	if quit := Dispatch(world, speaker, "say hello again"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || !strings.Contains(speakerMsgs[len(speakerMsgs)-1], "You say: hello again") {
 		t.Fatalf("expected say output, got %v", speakerMsgs)
 	}
@@ -103,7 +103,7 @@ func TestCommandToggleCannotDisableItself(t *testing.T) {
 	if quit := Dispatch(world, admin, "command command off"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := strings.Join(drainOutput(admin.Output), "\n")
+	output := strings.Join(drainOutput(admin), "\n")
 	if !strings.Contains(output, "cannot disable itself") {
 		t.Fatalf("expected self-disable warning, got %q", output)
 	}
@@ -41,17 +41,17 @@ func TestDispatchGoMovesPlayerAndNotifiesRooms(t *testing.T) {
 		t.Fatalf("hero.Room = %q, want %q", hero.Room, "second")
 	}
 
-	watcherMsgs := drainOutput(watcher.Output)
+	watcherMsgs := drainOutput(watcher)
 	if len(watcherMsgs) == 0 || !strings.Contains(watcherMsgs[len(watcherMsgs)-1], "Hero leaves east.") {
 		t.Fatalf("watcher did not receive leave message: %v", watcherMsgs)
 	}
 
-	greeterMsgs := drainOutput(greeter.Output)
+	greeterMsgs := drainOutput(greeter)
 	if len(greeterMsgs) == 0 || !strings.Contains(greeterMsgs[len(greeterMsgs)-1], "Hero arrives from east.") {
 		t.Fatalf("greeter did not receive arrival message: %v", greeterMsgs)
 	}
 
-	heroMsgs := drainOutput(hero.Output)
+	heroMsgs := drainOutput(hero)
 	if len(heroMsgs) == 0 {
 		t.Fatalf("hero received no output")
 	}
@@ -91,12 +91,12 @@ func TestDispatchSayBroadcastsToRoomChannel(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || !strings.Contains(speakerMsgs[len(speakerMsgs)-1], "You say: hello there") {
 		t.Fatalf("speaker output unexpected: %v", speakerMsgs)
 	}
 
-	listenerMsgs := drainOutput(listener.Output)
+	listenerMsgs := drainOutput(listener)
 	if len(listenerMsgs) == 0 || !strings.Contains(listenerMsgs[len(listenerMsgs)-1], "Speaker says: hello there") {
 		t.Fatalf("listener output unexpected: %v", listenerMsgs)
 	}
@@ -120,7 +120,7 @@ func TestDispatchRespectsDisabledCommands(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	msgs := drainOutput(speaker.Output)
+	msgs := drainOutput(speaker)
 	if len(msgs) == 0 {
 		t.Fatalf("expected output, got none")
 	}
@@ -139,7 +139,7 @@ func TestDispatchRespectsDisabledCommands(t *testing.T) {
 	if quit := Dispatch(world, speaker, "say hello again"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs = drainOutput(speaker.Output)
+	msgs = drainOutput(speaker)
 	sawEcho := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "You say: hello again") {
@@ -171,12 +171,12 @@ func TestDispatchSayStripsUnsafeCharacters(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || speakerMsgs[len(speakerMsgs)-1] != "You say: hello world" {
 		t.Fatalf("speaker output unexpected: %v", speakerMsgs)
 	}
 
-	listenerMsgs := drainOutput(listener.Output)
+	listenerMsgs := drainOutput(listener)
 	if len(listenerMsgs) == 0 || listenerMsgs[len(listenerMsgs)-1] != "Speaker says: hello world" {
 		t.Fatalf("listener output unexpected: %v", listenerMsgs)
 	}
@@ -198,7 +198,7 @@ func TestDispatchAutocompletePrefix(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawHelp := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Unknown command") {
@@ -229,7 +229,7 @@ func TestDispatchAmbiguousPrefixDoesNotFallback(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawUnknown := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Unknown command") {
@@ -260,12 +260,12 @@ func TestDispatchAutocompleteSimilarity(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || !strings.Contains(speakerMsgs[len(speakerMsgs)-1], "You say: hello there") {
 		t.Fatalf("speaker output unexpected: %v", speakerMsgs)
 	}
 
-	listenerMsgs := drainOutput(listener.Output)
+	listenerMsgs := drainOutput(listener)
 	if len(listenerMsgs) == 0 || !strings.Contains(listenerMsgs[len(listenerMsgs)-1], "Speaker says: hello there") {
 		t.Fatalf("listener output unexpected: %v", listenerMsgs)
 	}
@@ -299,18 +299,18 @@ func TestDispatchChannelToggleDisablesSay(t *testing.T) {
 	if target.Channels[game.ChannelSay] {
 		t.Fatalf("channel was not disabled: %+v", target.Channels)
 	}
-	drainOutput(target.Output)
+	drainOutput(target)
 
 	if done := Dispatch(world, talker, "say testing"); done {
 		t.Fatalf("dispatch returned true during say command")
 	}
 
-	talkerMsgs := drainOutput(talker.Output)
+	talkerMsgs := drainOutput(talker)
 	if len(talkerMsgs) == 0 || !strings.Contains(talkerMsgs[len(talkerMsgs)-1], "You say: testing") {
 		t.Fatalf("talker output unexpected: %v", talkerMsgs)
 	}
 
-	if msgs := drainOutput(target.Output); len(msgs) != 0 {
+	if msgs := drainOutput(target); len(msgs) != 0 {
 		t.Fatalf("target received unexpected messages: %v", msgs)
 	}
 }
@@ -325,7 +325,7 @@ func TestChannelAliasCommand(t *testing.T) {
 	if done := Dispatch(world, player, "channel alias say local"); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	drainOutput(player.Output)
+	drainOutput(player)
 	if alias := world.ChannelAlias(player, game.ChannelSay); alias != "local" {
 		t.Fatalf("alias = %q, want local", alias)
 	}
@@ -340,12 +340,12 @@ func TestHistoryCommandDisplaysMessages(t *testing.T) {
 
 	message := game.Ansi("hello")
 	world.RecordPlayerChannelMessage(player, game.ChannelOOC, message)
-	drainOutput(player.Output)
+	drainOutput(player)
 
 	if done := Dispatch(world, player, "history ooc"); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := strings.Join(drainOutput(player.Output), "\n")
+	output := strings.Join(drainOutput(player), "\n")
 	if !strings.Contains(output, "Recent OOC messages") {
 		t.Fatalf("expected history header, got %q", output)
 	}
@@ -367,8 +367,8 @@ func TestMuteCommandsToggleChannelAccess(t *testing.T) {
 	if done := Dispatch(world, admin, "mute Target say"); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	drainOutput(admin.Output)
-	if len(drainOutput(target.Output)) == 0 {
+	drainOutput(admin)
+	if len(drainOutput(target)) == 0 {
 		t.Fatalf("expected target to receive mute notification")
 	}
 	if !world.ChannelMuted(target, game.ChannelSay) {
@@ -378,8 +378,8 @@ func TestMuteCommandsToggleChannelAccess(t *testing.T) {
 	if done := Dispatch(world, admin, "unmute Target say"); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	drainOutput(admin.Output)
-	drainOutput(target.Output)
+	drainOutput(admin)
+	drainOutput(target)
 	if world.ChannelMuted(target, game.ChannelSay) {
 		t.Fatalf("target should be unmuted on say")
 	}
@@ -411,7 +411,7 @@ func TestSetHomeUpdatesRecallPoint(t *testing.T) {
 		t.Fatalf("expected home to be 'hall', got %q", traveler.Home)
 	}
 
-	msgs := drainOutput(traveler.Output)
+	msgs := drainOutput(traveler)
 	sawAttune := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "attune yourself") {
@@ -454,7 +454,7 @@ func TestRecallReturnsPlayerHome(t *testing.T) {
 		t.Fatalf("expected traveler to be in start, got %q", traveler.Room)
 	}
 
-	travelerMsgs := drainOutput(traveler.Output)
+	travelerMsgs := drainOutput(traveler)
 	sawCall := false
 	sawPrompt := false
 	for _, msg := range travelerMsgs {
@@ -472,7 +472,7 @@ func TestRecallReturnsPlayerHome(t *testing.T) {
 		t.Fatalf("expected prompt after recall, got %v", travelerMsgs)
 	}
 
-	companionMsgs := drainOutput(companion.Output)
+	companionMsgs := drainOutput(companion)
 	sawDeparture := false
 	for _, msg := range companionMsgs {
 		if strings.Contains(msg, "flash of light and vanishes") {
@@ -484,7 +484,7 @@ func TestRecallReturnsPlayerHome(t *testing.T) {
 		t.Fatalf("companion did not see departure: %v", companionMsgs)
 	}
 
-	watcherMsgs := drainOutput(watcher.Output)
+	watcherMsgs := drainOutput(watcher)
 	sawArrival := false
 	for _, msg := range watcherMsgs {
 		if strings.Contains(msg, "arrives in a flash of light") {
@@ -503,7 +503,6 @@ func newTestPlayer(name string, room game.RoomID) *game.Player {
 		Account:  name,
 		Room:     room,
 		Home:     room,
-		Output:   make(chan string, 32),
 		Alive:    true,
 		Channels: game.DefaultChannelSettings(),
 	}
@@ -511,19 +510,15 @@ func newTestPlayer(name string, room game.RoomID) *game.Player {
 
 var ansiPattern = regexp.MustCompile(`\x1b\[[0-9;]*m`)
 
-func drainOutput(ch chan string) []string {
+func drainOutput(p *game.Player) []string {
 	t := make([]string, 0)
-	for {
-		select {
-		case msg := <-ch:
-			cleaned := game.Trim(ansiPattern.ReplaceAllString(msg, ""))
-			if cleaned != "" {
-				t = append(t, cleaned)
-			}
-		default:
-			return t
+	for _, msg := range p.TakeOutputForTest() {
+		cleaned := game.Trim(ansiPattern.ReplaceAllString(msg, ""))
+		if cleaned != "" {
+			t = append(t, cleaned)
 		}
 	}
+	return t
 }
 
 func isPrompt(msg string) bool {
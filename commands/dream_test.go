@@ -22,7 +22,7 @@ func TestDreamCommandPersonalisedAndDeterministic(t *testing.T) {
 	if quit := Dispatch(world, dreamer, "dream"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	first := strings.Join(drainOutput(dreamer.Output), "\n")
+	first := strings.Join(drainOutput(dreamer), "\n")
 	if !strings.Contains(first, "Lyra") {
 		t.Fatalf("expected player's name in dream, got %q", first)
 	}
@@ -33,7 +33,7 @@ func TestDreamCommandPersonalisedAndDeterministic(t *testing.T) {
 	if quit := Dispatch(world, dreamer, "dream"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	second := strings.Join(drainOutput(dreamer.Output), "\n")
+	second := strings.Join(drainOutput(dreamer), "\n")
 	if first != second {
 		t.Fatalf("dream output should be deterministic, first %q second %q", first, second)
 	}
@@ -16,18 +16,18 @@ var Get = Define(Definition{
 }, func(ctx *Context) bool {
 	target := strings.TrimSpace(ctx.Arg)
 	if target == "" {
-		ctx.Player.Output <- game.Ansi("\r\nGet what?")
+		ctx.Player.Send(game.Ansi("\r\nGet what?"))
 		return false
 	}
 	item, err := ctx.World.TakeItem(ctx.Player, target)
 	switch {
 	case err == nil:
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou pick up %s.", game.HighlightItemName(item.Name)))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou pick up %s.", game.HighlightItemName(item.Name))))
 		ctx.World.BroadcastToRoom(ctx.Player.Room, game.Ansi(fmt.Sprintf("\r\n%s picks up %s.", game.HighlightName(ctx.Player.Name), game.HighlightItemName(item.Name))), ctx.Player)
 	case errors.Is(err, game.ErrItemNotFound):
-		ctx.Player.Output <- game.Ansi("\r\nYou don't see that here.")
+		ctx.Player.Send(game.Ansi("\r\nYou don't see that here."))
 	default:
-		ctx.Player.Output <- game.Ansi("\r\n" + err.Error())
+		ctx.Player.Send(game.Ansi("\r\n" + err.Error()))
 	}
 	return false
 })
@@ -24,7 +24,7 @@ var Help = Define(Definition{
 	if ctx.Player.IsModerator {
 		message += "\r\nModerators may type 'portal' to request a moderation portal link."
 	}
-	ctx.Player.Output <- game.Ansi(message)
+	ctx.Player.Send(game.Ansi(message))
 	return false
 })
 
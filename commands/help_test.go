@@ -24,7 +24,7 @@ func TestHelpMentionsPortalForModerators(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	msgs := drainOutput(moderator.Output)
+	msgs := drainOutput(moderator)
 	text := strings.Join(msgs, "\n")
 	if !strings.Contains(text, "Moderators may type 'portal' to request a moderation portal link.") {
 		t.Fatalf("help output missing moderator portal note: %v", msgs)
@@ -47,7 +47,7 @@ func TestHelpOmitsPortalNoteForAdventurers(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	text := strings.Join(msgs, "\n")
 	if strings.Contains(text, "Moderators may type 'portal' to request a moderation portal link.") {
 		t.Fatalf("unexpected moderator portal note for regular player: %v", msgs)
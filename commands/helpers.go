@@ -22,13 +22,13 @@ func sendChannelStatus(world *game.World, player *game.Player) {
 		}
 		builder.WriteString(fmt.Sprintf("  %-18s %s\r\n", label, state))
 	}
-	player.Output <- game.Ansi(builder.String())
+	player.Send(game.Ansi(builder.String()))
 }
 
 func move(world *game.World, player *game.Player, dir string) bool {
 	prev := player.Room
 	if _, err := world.Move(player, dir); err != nil {
-		player.Output <- game.Ansi("\r\n" + err.Error())
+		player.Send(game.Ansi("\r\n" + err.Error()))
 		return false
 	}
 	world.BroadcastToRoom(prev, game.Ansi(fmt.Sprintf("\r\n%s leaves %s.", game.HighlightName(player.Name), dir)), player)
@@ -13,14 +13,13 @@ var Look = Define(Definition{
 	Usage:       "look [target]",
 	Description: "describe your surroundings or inspect a target",
 }, func(ctx *Context) bool {
-	room, ok := ctx.World.GetRoom(ctx.Player.Room)
+	width, _ := ctx.Player.WindowSize()
+	view, ok := ctx.World.RoomView(ctx.Player.Room, width)
 	if !ok {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nYou see only void.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nYou see only void.", game.AnsiYellow)))
 		return false
 	}
 
-	width, _ := ctx.Player.WindowSize()
-
 	target := strings.TrimSpace(ctx.Arg)
 	if target != "" {
 		if npc, found := ctx.World.FindRoomNPC(ctx.Player.Room, target); found {
@@ -28,7 +27,7 @@ var Look = Define(Definition{
 			if greet := strings.TrimSpace(npc.AutoGreet); greet != "" {
 				line = fmt.Sprintf("%s They say, \"%s\"", line, greet)
 			}
-			ctx.Player.Output <- game.Ansi(line)
+			ctx.Player.Send(game.Ansi(line))
 			if offered := ctx.World.QuestsByNPC(npc.Name); len(offered) > 0 {
 				if available := ctx.World.AvailableQuests(ctx.Player); len(available) > 0 {
 					eligible := make(map[string]struct{}, len(available))
@@ -43,8 +42,8 @@ var Look = Define(Definition{
 						names = append(names, game.HighlightQuestName(quest.Name))
 					}
 					if len(names) > 0 {
-						ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nThey seem ready to offer: %s", strings.Join(names, ", ")))
-						ctx.Player.Output <- game.Ansi("\r\nUse 'quests accept <id>' to begin.")
+						ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nThey seem ready to offer: %s", strings.Join(names, ", "))))
+						ctx.Player.Send(game.Ansi("\r\nUse 'quests accept <id>' to begin."))
 					}
 				}
 			}
@@ -55,11 +54,11 @@ var Look = Define(Definition{
 			if desc == "" {
 				desc = "You see nothing special."
 			}
-			ctx.Player.Output <- game.Ansi(fmt.Sprintf(
+			ctx.Player.Send(game.Ansi(fmt.Sprintf(
 				"\r\nYou study %s. %s",
 				game.HighlightItemName(item.Name),
 				game.WrapText(desc, width),
-			))
+			)))
 			ctx.World.TriggerItemInspect(ctx.Player, ctx.Player.Room, item, "room")
 			return false
 		}
@@ -79,23 +78,20 @@ var Look = Define(Definition{
 					message = fmt.Sprintf("\r\nLooking %s you glimpse %s.", dir, title)
 				}
 			}
-			ctx.Player.Output <- game.Ansi(message)
+			ctx.Player.Send(game.Ansi(message))
 			return false
 		}
-		ctx.Player.Output <- game.Ansi("\r\nYou don't see that here.")
+		ctx.Player.Send(game.Ansi("\r\nYou don't see that here."))
 		return false
 	}
 
-	title := game.Style(room.Title, game.AnsiBold, game.AnsiCyan)
-	desc := game.Style(game.WrapText(room.Description, width), game.AnsiItalic, game.AnsiDim)
-	exits := game.Style(game.ExitList(room), game.AnsiGreen)
-	ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\n%s\r\n%s\r\nExits: %s", title, desc, exits))
+	ctx.Player.Send(view.Look)
 
 	others := ctx.World.ListPlayers(true, ctx.Player.Room)
 	if len(others) > 1 {
 		seen := game.FilterOut(others, ctx.Player.Name)
 		colored := game.HighlightNames(seen)
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou see: %s", strings.Join(colored, ", ")))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou see: %s", strings.Join(colored, ", "))))
 	}
 
 	if npcs := ctx.World.RoomNPCs(ctx.Player.Room); len(npcs) > 0 {
@@ -103,7 +99,7 @@ var Look = Define(Definition{
 		for i, npc := range npcs {
 			names[i] = game.HighlightNPCName(npc.Name)
 		}
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou notice: %s", strings.Join(names, ", ")))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou notice: %s", strings.Join(names, ", "))))
 	}
 
 	if items := ctx.World.RoomItems(ctx.Player.Room); len(items) > 0 {
@@ -111,7 +107,7 @@ var Look = Define(Definition{
 		for i, item := range items {
 			names[i] = game.HighlightItemName(item.Name)
 		}
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nOn the ground: %s", strings.Join(names, ", ")))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nOn the ground: %s", strings.Join(names, ", "))))
 	}
 	ctx.World.TriggerRoomLook(ctx.Player)
 	return false
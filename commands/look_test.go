@@ -29,7 +29,7 @@ func TestLookListsNPCs(t *testing.T) {
 	if done := Dispatch(world, player, "look"); done {
 		t.Fatalf("look returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	sawNPCs := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "You notice: Guide") {
@@ -58,7 +58,7 @@ func TestLookAtNPC(t *testing.T) {
 	if done := Dispatch(world, player, "look guide"); done {
 		t.Fatalf("look returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	if len(msgs) == 0 || !strings.Contains(msgs[len(msgs)-1], "Guide stands here.") {
 		t.Fatalf("expected NPC description, got %v", msgs)
 	}
@@ -80,7 +80,7 @@ func TestLookAtItem(t *testing.T) {
 	if done := Dispatch(world, player, "look key"); done {
 		t.Fatalf("look returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	matched := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "You study Golden Key. It's engraved with runes.") {
@@ -114,7 +114,7 @@ func TestLookAtExit(t *testing.T) {
 	if done := Dispatch(world, player, "look north"); done {
 		t.Fatalf("look returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	matched := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "Looking north you glimpse Verdant Garden. A lush garden bathed in sunlight.") {
@@ -142,7 +142,7 @@ func TestLookUnknownTarget(t *testing.T) {
 	if done := Dispatch(world, player, "look dragon"); done {
 		t.Fatalf("look returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	if len(msgs) == 0 || msgs[len(msgs)-1] != "You don't see that here." {
 		t.Fatalf("expected not found message, got %v", msgs)
 	}
@@ -164,7 +164,7 @@ func TestExamineInventoryItem(t *testing.T) {
 	if done := Dispatch(world, player, "examine lantern"); done {
 		t.Fatalf("examine returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	if len(msgs) == 0 || msgs[len(msgs)-1] != "You examine Lantern. It glows softly." {
 		t.Fatalf("expected inventory description, got %v", msgs)
 	}
@@ -186,7 +186,7 @@ func TestExamineUnknownInventoryItem(t *testing.T) {
 	if done := Dispatch(world, player, "examine coin"); done {
 		t.Fatalf("examine returned true, want false")
 	}
-	msgs := drainOutput(player.Output)
+	msgs := drainOutput(player)
 	if len(msgs) == 0 || msgs[len(msgs)-1] != "You aren't carrying that." {
 		t.Fatalf("expected missing item message, got %v", msgs)
 	}
@@ -16,7 +16,7 @@ var Mail = Define(Definition{
 }, func(ctx *Context) bool {
 	mail := ctx.World.MailSystem()
 	if mail == nil {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nThe public boards are currently unavailable.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nThe public boards are currently unavailable.", game.AnsiYellow)))
 		return false
 	}
 	arg := strings.TrimSpace(ctx.Arg)
@@ -49,13 +49,13 @@ func sendMailHelp(player *game.Player) {
 	builder.WriteString("  mail boards - List boards and personal posts.\r\n")
 	builder.WriteString("  mail board <name> - Show posts on a board.\r\n")
 	builder.WriteString("  mail write <board> [recipients] = <message> - Post to a board; recipients are comma-separated player names.\r\n")
-	player.Output <- game.Ansi(builder.String())
+	player.Send(game.Ansi(builder.String()))
 }
 
 func sendMailBoards(player *game.Player, mail *game.MailSystem, self string) {
 	boards := mail.Boards()
 	if len(boards) == 0 {
-		player.Output <- game.Ansi("\r\nNo boards have any posts yet.")
+		player.Send(game.Ansi("\r\nNo boards have any posts yet."))
 		return
 	}
 	var builder strings.Builder
@@ -74,18 +74,18 @@ func sendMailBoards(player *game.Player, mail *game.MailSystem, self string) {
 		}
 		builder.WriteString(line + "\r\n")
 	}
-	player.Output <- game.Ansi(builder.String())
+	player.Send(game.Ansi(builder.String()))
 }
 
 func handleMailBoard(ctx *Context, mail *game.MailSystem, fields []string) {
 	if len(fields) < 2 {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nWhich board?", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nWhich board?", game.AnsiYellow)))
 		return
 	}
 	board := fields[1]
 	messages := mail.Messages(board)
 	if len(messages) == 0 {
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nThere are no posts on %s yet.", board))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nThere are no posts on %s yet.", board)))
 		return
 	}
 	var builder strings.Builder
@@ -93,7 +93,7 @@ func handleMailBoard(ctx *Context, mail *game.MailSystem, fields []string) {
 	for _, msg := range messages {
 		builder.WriteString(formatMailMessage(msg, ctx.Player.Name))
 	}
-	ctx.Player.Output <- game.Ansi(builder.String())
+	ctx.Player.Send(game.Ansi(builder.String()))
 }
 
 func formatMailMessage(msg game.MailMessage, viewer string) string {
@@ -112,34 +112,35 @@ func formatMailMessage(msg game.MailMessage, viewer string) string {
 
 func handleMailWrite(ctx *Context, mail *game.MailSystem, arg string, fields []string) {
 	if len(fields) < 2 {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nWhich board should receive the post?", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nWhich board should receive the post?", game.AnsiYellow)))
 		return
 	}
 	board := fields[1]
 	rest := strings.TrimSpace(arg[len(fields[0]):])
 	rest = strings.TrimSpace(rest[len(board):])
 	if rest == "" {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nProvide recipients (optional) and a message separated by '='.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nProvide recipients (optional) and a message separated by '='.", game.AnsiYellow)))
 		return
 	}
 	parts := strings.SplitN(rest, "=", 2)
 	if len(parts) != 2 {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nUse '=' to separate recipients from the message body.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nUse '=' to separate recipients from the message body.", game.AnsiYellow)))
 		return
 	}
 	recipients := parseRecipients(parts[0])
 	body := strings.TrimSpace(parts[1])
 	if body == "" {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nYour message is empty.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nYour message is empty.", game.AnsiYellow)))
 		return
 	}
 	msg, err := mail.Write(board, ctx.Player.Name, recipients, body)
 	if err != nil {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\n"+err.Error(), game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\n"+err.Error(), game.AnsiYellow)))
 		return
 	}
+	ctx.World.RelayMail(msg)
 	summary := msg.RecipientSummary()
-	ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou post to %s for %s.\r\n", game.Style(strings.ToUpper(board), game.AnsiCyan, game.AnsiBold), summary))
+	ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou post to %s for %s.\r\n", game.Style(strings.ToUpper(board), game.AnsiCyan, game.AnsiBold), summary)))
 }
 
 func parseRecipients(raw string) []string {
@@ -30,7 +30,7 @@ func TestMailBoardsListsBoards(t *testing.T) {
 	if done := Dispatch(world, player, "mail boards"); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := drainOutput(player.Output)
+	output := drainOutput(player)
 	if len(output) == 0 {
 		t.Fatalf("no output captured")
 	}
@@ -66,7 +66,7 @@ func TestMailWriteCommandStoresPost(t *testing.T) {
 	if done := Dispatch(world, poster, "mail write general Hero = Meet me by the fountain."); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := drainOutput(poster.Output)
+	output := drainOutput(poster)
 	sawConfirmation := false
 	for _, line := range output {
 		if strings.Contains(line, "You post to") && strings.Contains(line, "Hero") {
@@ -114,7 +114,7 @@ func TestMailBoardShowsForYouMarker(t *testing.T) {
 	if done := Dispatch(world, hero, "mail board general"); done {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := drainOutput(hero.Output)
+	output := drainOutput(hero)
 	seenMarker := false
 	for _, line := range output {
 		if strings.Contains(line, "(for you)") {
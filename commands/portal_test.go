@@ -34,7 +34,7 @@ func TestPortalCommandRequiresPortal(t *testing.T) {
 	if quit := Dispatch(world, builder, "portal"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	output := strings.Join(drainOutput(builder.Output), "\n")
+	output := strings.Join(drainOutput(builder), "\n")
 	if !strings.Contains(output, "web portal is not configured") {
 		t.Fatalf("expected configuration warning, got %q", output)
 	}
@@ -54,7 +54,7 @@ func TestPortalCommandGeneratesLink(t *testing.T) {
 	if quit := Dispatch(world, admin, "portal moderator"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := strings.Join(drainOutput(admin.Output), "\n")
+	msgs := strings.Join(drainOutput(admin), "\n")
 	if !strings.Contains(msgs, "Open portal") || !strings.Contains(msgs, fake.url) {
 		t.Fatalf("expected portal link in output, got %q", msgs)
 	}
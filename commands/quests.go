@@ -27,39 +27,39 @@ var Quests = Define(Definition{
 		return showAvailableQuests(ctx, width)
 	case "accept":
 		if len(parts) < 2 {
-			ctx.Player.Output <- game.Ansi(game.Style("\r\nUsage: quests accept <id>", game.AnsiYellow))
+			ctx.Player.Send(game.Ansi(game.Style("\r\nUsage: quests accept <id>", game.AnsiYellow)))
 			return false
 		}
 		questID := strings.ToLower(parts[1])
 		quest, err := ctx.World.AcceptQuest(ctx.Player, questID)
 		if err != nil {
-			ctx.Player.Output <- game.Ansi(game.Style("\r\n"+err.Error(), game.AnsiYellow))
+			ctx.Player.Send(game.Ansi(game.Style("\r\n"+err.Error(), game.AnsiYellow)))
 			return false
 		}
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou accept %s.", game.HighlightQuestName(quest.Name)))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou accept %s.", game.HighlightQuestName(quest.Name))))
 		if desc := strings.TrimSpace(quest.Description); desc != "" {
-			ctx.Player.Output <- game.Ansi("\r\n" + game.WrapText(desc, width))
+			ctx.Player.Send(game.Ansi("\r\n" + game.WrapText(desc, width)))
 		}
 		return false
 	case "turnin", "complete":
 		if len(parts) < 2 {
-			ctx.Player.Output <- game.Ansi(game.Style("\r\nUsage: quests turnin <id>", game.AnsiYellow))
+			ctx.Player.Send(game.Ansi(game.Style("\r\nUsage: quests turnin <id>", game.AnsiYellow)))
 			return false
 		}
 		questID := strings.ToLower(parts[1])
 		result, err := ctx.World.CompleteQuest(ctx.Player, questID)
 		if err != nil {
-			ctx.Player.Output <- game.Ansi(game.Style("\r\n"+err.Error(), game.AnsiYellow))
+			ctx.Player.Send(game.Ansi(game.Style("\r\n"+err.Error(), game.AnsiYellow)))
 			return false
 		}
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou complete %s!", game.HighlightQuestName(result.Quest.Name)))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou complete %s!", game.HighlightQuestName(result.Quest.Name))))
 		if strings.TrimSpace(result.CompletionMsg) != "" {
-			ctx.Player.Output <- game.Ansi("\r\n" + game.WrapText(result.CompletionMsg, width))
+			ctx.Player.Send(game.Ansi("\r\n" + game.WrapText(result.CompletionMsg, width)))
 		}
 		if result.RewardXP > 0 {
-			ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou gain %d experience.", result.RewardXP))
+			ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou gain %d experience.", result.RewardXP)))
 			if result.LevelsGained > 0 {
-				ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nYou advance to level %d!", ctx.Player.Level))
+				ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nYou advance to level %d!", ctx.Player.Level)))
 			}
 		}
 		if len(result.RewardItems) > 0 {
@@ -67,11 +67,11 @@ var Quests = Define(Definition{
 			for i, item := range result.RewardItems {
 				names[i] = game.HighlightItemName(item.Name)
 			}
-			ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\nRewards: %s", strings.Join(names, ", ")))
+			ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nRewards: %s", strings.Join(names, ", "))))
 		}
 		return false
 	default:
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nUnrecognised quests subcommand.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nUnrecognised quests subcommand.", game.AnsiYellow)))
 		return false
 	}
 })
@@ -79,7 +79,7 @@ var Quests = Define(Definition{
 func showActiveQuests(ctx *Context, width int) bool {
 	snapshots := ctx.World.SnapshotQuestLog(ctx.Player)
 	if len(snapshots) == 0 {
-		ctx.Player.Output <- game.Ansi("\r\nYou have no active quests.")
+		ctx.Player.Send(game.Ansi("\r\nYou have no active quests."))
 		return false
 	}
 	inventory := ctx.World.PlayerInventory(ctx.Player)
@@ -93,24 +93,24 @@ func showActiveQuests(ctx *Context, width int) bool {
 			status = "completed"
 		}
 		header := fmt.Sprintf("\r\n%s (%s)", game.HighlightQuestName(snap.Quest.Name), status)
-		ctx.Player.Output <- game.Ansi(header)
+		ctx.Player.Send(game.Ansi(header))
 		if desc := strings.TrimSpace(snap.Quest.Description); desc != "" {
-			ctx.Player.Output <- game.Ansi("\r\n  " + game.WrapText(desc, width))
+			ctx.Player.Send(game.Ansi("\r\n  " + game.WrapText(desc, width)))
 		}
 		for _, prog := range snap.KillProgress {
-			ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\n  - Defeat %s (%d/%d)",
+			ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\n  - Defeat %s (%d/%d)",
 				game.HighlightNPCName(prog.NPC),
 				prog.Current,
 				prog.Required,
-			))
+			)))
 		}
 		for _, req := range snap.Quest.RequiredItems {
 			have := itemCounts[strings.ToLower(req.Item)]
-			ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\n  - Deliver %s (%d/%d)",
+			ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\n  - Deliver %s (%d/%d)",
 				game.HighlightItemName(req.Item),
 				have,
 				req.Count,
-			))
+			)))
 		}
 	}
 	return false
@@ -119,31 +119,31 @@ func showActiveQuests(ctx *Context, width int) bool {
 func showAvailableQuests(ctx *Context, width int) bool {
 	quests := ctx.World.AvailableQuests(ctx.Player)
 	if len(quests) == 0 {
-		ctx.Player.Output <- game.Ansi("\r\nNo quests are available here.")
+		ctx.Player.Send(game.Ansi("\r\nNo quests are available here."))
 		return false
 	}
 	for _, quest := range quests {
-		ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\n[%s] %s", strings.ToLower(quest.ID), game.HighlightQuestName(quest.Name)))
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\n[%s] %s", strings.ToLower(quest.ID), game.HighlightQuestName(quest.Name))))
 		if desc := strings.TrimSpace(quest.Description); desc != "" {
-			ctx.Player.Output <- game.Ansi("\r\n  " + game.WrapText(desc, width))
+			ctx.Player.Send(game.Ansi("\r\n  " + game.WrapText(desc, width)))
 		}
 		if len(quest.RequiredKills) > 0 {
 			for _, req := range quest.RequiredKills {
-				ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\n  - Defeat %s (%d)",
+				ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\n  - Defeat %s (%d)",
 					game.HighlightNPCName(req.NPC),
 					req.Count,
-				))
+				)))
 			}
 		}
 		if len(quest.RequiredItems) > 0 {
 			for _, req := range quest.RequiredItems {
-				ctx.Player.Output <- game.Ansi(fmt.Sprintf("\r\n  - Deliver %s (%d)",
+				ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\n  - Deliver %s (%d)",
 					game.HighlightItemName(req.Item),
 					req.Count,
-				))
+				)))
 			}
 		}
-		ctx.Player.Output <- game.Ansi("\r\n")
+		ctx.Player.Send(game.Ansi("\r\n"))
 	}
 	return false
 }
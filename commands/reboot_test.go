@@ -24,7 +24,7 @@ func TestRebootDisabledWhenCriticalOperationsLocked(t *testing.T) {
 	if quit := Dispatch(world, admin, "reboot"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	msgs := drainOutput(admin.Output)
+	msgs := drainOutput(admin)
 	sawDisabled := false
 	for _, msg := range msgs {
 		if strings.Contains(msg, "World reboot is temporarily disabled.") {
@@ -5,6 +5,8 @@ import (
 	"sort"
 	"strings"
 	"sync"
+	"time"
+	"unicode"
 
 	"LumenClay/internal/game"
 )
@@ -92,6 +94,7 @@ func Define(def Definition, handler Handler) *Command {
 	sort.SliceStable(ordered, func(i, j int) bool {
 		return ordered[i].Name < ordered[j].Name
 	})
+	index.Store(nil)
 
 	return cmd
 }
@@ -108,99 +111,51 @@ func All() []*Command {
 
 // Find looks up a command by name or alias.
 func Find(name string) (*Command, bool) {
-	normalized := strings.ToLower(strings.TrimSpace(name))
-	if normalized == "" {
-		return nil, false
-	}
-	registryMu.RLock()
-	cmd, ok := registry[normalized]
-	registryMu.RUnlock()
-	return cmd, ok
+	return currentIndex().find(strings.TrimSpace(name))
 }
 
 // Dispatch parses the input line, looks up the command, and executes it.
 func Dispatch(world *game.World, player *game.Player, line string) bool {
-	parts := strings.Fields(line)
-	if len(parts) == 0 {
+	input, arg := splitCommand(line)
+	if input == "" {
 		return false
 	}
-	name := strings.ToLower(parts[0])
 
-	registryMu.RLock()
-	cmd, ok := registry[name]
-	if !ok {
-		cmd = nearestCommandLocked(name)
-	}
-	registryMu.RUnlock()
+	cmd := currentIndex().resolve(input)
 	if cmd == nil {
-		player.Output <- game.Ansi("\r\nUnknown command. Type 'help'.")
+		player.Send(game.Ansi("\r\nUnknown command. Type 'help'."))
 		return false
 	}
 
 	if world.CommandDisabled(cmd.Name) {
-		player.Output <- game.Ansi(game.Style("\r\nThat command is temporarily disabled.", game.AnsiYellow))
+		player.Send(game.Ansi(game.Style("\r\nThat command is temporarily disabled.", game.AnsiYellow)))
 		return false
 	}
 
-	arg := strings.TrimSpace(strings.TrimPrefix(line, parts[0]))
 	ctx := &Context{
 		World:   world,
 		Player:  player,
 		Raw:     line,
 		Arg:     arg,
-		Input:   parts[0],
+		Input:   input,
 		Command: cmd,
 	}
-	return cmd.Handler(ctx)
-}
-
-func nearestCommandLocked(name string) *Command {
-	lower := strings.ToLower(name)
-
-	prefixMatches := make(map[*Command]string)
-	for key, cmd := range registry {
-		if strings.HasPrefix(key, lower) {
-			if best, exists := prefixMatches[cmd]; !exists || len(key) < len(best) || (len(key) == len(best) && key < best) {
-				prefixMatches[cmd] = key
-			}
-		}
-	}
-	if len(prefixMatches) == 1 {
-		for cmd := range prefixMatches {
-			return cmd
-		}
-	}
-	if len(prefixMatches) > 1 {
-		return nil
-	}
-
-	var bestCmd *Command
-	bestDistance := 0
-	bestName := ""
-	for _, cmd := range ordered {
-		candidate := strings.ToLower(cmd.Name)
-		dist := levenshtein(lower, candidate)
-		threshold := len(candidate) / 2
-		if threshold < 2 {
-			threshold = 2
-		}
-		if dist > threshold {
-			continue
-		}
-		if bestCmd == nil || dist < bestDistance || (dist == bestDistance && candidate < bestName) {
-			bestCmd = cmd
-			bestDistance = dist
-			bestName = candidate
-		}
-	}
-	return bestCmd
+	start := time.Now()
+	quit := cmd.Handler(ctx)
+	game.ObserveCommand(cmd.Name, time.Since(start))
+	return quit
 }
 
+// levenshtein returns the edit distance between a, compared case-insensitively,
+// and the lowercase b.
 func levenshtein(a, b string) int {
 	if a == b {
 		return 0
 	}
 	ar := []rune(a)
+	for i, r := range ar {
+		ar[i] = unicode.ToLower(r)
+	}
 	br := []rune(b)
 	if len(ar) == 0 {
 		return len(br)
@@ -209,8 +164,13 @@ func levenshtein(a, b string) int {
 		return len(ar)
 	}
 
-	prev := make([]int, len(br)+1)
-	curr := make([]int, len(br)+1)
+	// Command names are short, so the rows normally fit on the stack.
+	var prevBuf, currBuf [32]int
+	prev, curr := prevBuf[:0], currBuf[:0]
+	if len(br)+1 > len(prevBuf) {
+		prev, curr = make([]int, 0, len(br)+1), make([]int, 0, len(br)+1)
+	}
+	prev, curr = prev[:len(br)+1], curr[:len(br)+1]
 	for j := range prev {
 		prev[j] = j
 	}
@@ -0,0 +1,30 @@
+package commands
+
+import (
+	"fmt"
+	"strings"
+
+	"LumenClay/internal/game"
+)
+
+var ReleaseScripts = Define(Definition{
+	Name:        "releasescripts",
+	Usage:       "releasescripts [room]",
+	Description: "run the script hooks stuck behind a runaway hook (admin only)",
+	Group:       GroupAdmin,
+}, func(ctx *Context) bool {
+	if !ctx.Player.IsAdmin {
+		ctx.Player.Send(game.Ansi(game.Style("\r\nOnly admins may release scripts.", game.AnsiYellow)))
+		return false
+	}
+	room := ctx.Player.Room
+	if arg := strings.TrimSpace(ctx.Arg); arg != "" {
+		room = game.RoomID(arg)
+	}
+	if !ctx.World.ReleaseScriptRoom(room) {
+		ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nNo runaway script is holding up %s.", room)))
+		return false
+	}
+	ctx.Player.Send(game.Ansi(fmt.Sprintf("\r\nReleased the scripts waiting in %s.", room)))
+	return false
+})
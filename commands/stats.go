@@ -15,7 +15,7 @@ var Stats = Define(Definition{
 }, func(ctx *Context) bool {
 	stats, ok := ctx.World.AccountStats(ctx.Player.Account)
 	if !ok {
-		ctx.Player.Output <- game.Ansi(game.Style("\r\nAccount details are unavailable.", game.AnsiYellow))
+		ctx.Player.Send(game.Ansi(game.Style("\r\nAccount details are unavailable.", game.AnsiYellow)))
 		return false
 	}
 
@@ -38,7 +38,7 @@ var Stats = Define(Definition{
 	builder.WriteString(fmt.Sprintf("  Total logins: %s\r\n", game.Style(fmt.Sprintf("%d", stats.TotalLogins), game.AnsiGreen, game.AnsiBold)))
 	builder.WriteString(fmt.Sprintf("  Channels: %s\r\n", formatChannelStatuses(ctx.World, ctx.Player)))
 
-	ctx.Player.Output <- game.Ansi(builder.String())
+	ctx.Player.Send(game.Ansi(builder.String()))
 	return false
 })
 
@@ -45,7 +45,7 @@ func TestStatsCommandDisplaysAccountInformation(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	output := strings.Join(drainOutput(player.Output), "\n")
+	output := strings.Join(drainOutput(player), "\n")
 	if !strings.Contains(output, "Account overview") {
 		t.Fatalf("expected account overview in output: %q", output)
 	}
@@ -27,11 +27,11 @@ func TestTellCommandSendsToOnlinePlayer(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || speakerMsgs[len(speakerMsgs)-1] != "You tell Listener: Hello there" {
 		t.Fatalf("unexpected speaker output: %v", speakerMsgs)
 	}
-	listenerMsgs := drainOutput(listener.Output)
+	listenerMsgs := drainOutput(listener)
 	if len(listenerMsgs) == 0 || listenerMsgs[len(listenerMsgs)-1] != "Speaker tells you: Hello there" {
 		t.Fatalf("unexpected listener output: %v", listenerMsgs)
 	}
@@ -67,7 +67,7 @@ func TestTellCommandQueuesOfflineMessage(t *testing.T) {
 	if quit := Dispatch(world, speaker, "tell listener Catch you later"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || speakerMsgs[len(speakerMsgs)-1] != "You queue an offline tell for Listener: Catch you later" {
 		t.Fatalf("unexpected speaker output: %v", speakerMsgs)
 	}
@@ -112,7 +112,7 @@ func TestTellCommandRespectsSenderLimit(t *testing.T) {
 	if quit := Dispatch(world, speaker, "tell listener Another"); quit {
 		t.Fatalf("dispatch returned true, want false")
 	}
-	speakerMsgs := drainOutput(speaker.Output)
+	speakerMsgs := drainOutput(speaker)
 	if len(speakerMsgs) == 0 || speakerMsgs[len(speakerMsgs)-1] != fmt.Sprintf("You already have %d offline tells queued for Listener.", game.OfflineTellLimitPerSender) {
 		t.Fatalf("unexpected speaker output: %v", speakerMsgs)
 	}
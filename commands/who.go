@@ -12,11 +12,11 @@ var Who = Define(Definition{
 	Description: "list connected players",
 }, func(ctx *Context) bool {
 	names := ctx.World.ListPlayers(false, "")
-	others := game.FilterOut(names, ctx.Player.Name)
+	others := game.FilterOut(append(names, ctx.World.RemotePlayers()...), ctx.Player.Name)
 	if len(others) == 0 {
-		ctx.Player.Output <- game.Ansi("\r\nYou are the only adventurer online.")
+		ctx.Player.Send(game.Ansi("\r\nYou are the only adventurer online."))
 		return false
 	}
-	ctx.Player.Output <- game.Ansi("\r\nOther adventurers online: " + strings.Join(game.HighlightNames(others), ", "))
+	ctx.Player.Send(game.Ansi("\r\nOther adventurers online: " + strings.Join(game.HighlightNames(others), ", ")))
 	return false
 })
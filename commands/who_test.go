@@ -29,7 +29,7 @@ func TestWhoCommandListsOthersInLoginOrder(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	output := strings.Join(drainOutput(hero.Output), "\n")
+	output := strings.Join(drainOutput(hero), "\n")
 	want := "Other adventurers online: Watcher, Scout"
 	if !strings.Contains(output, want) {
 		t.Fatalf("who output = %q, want substring %q", output, want)
@@ -53,7 +53,7 @@ func TestWhoCommandHandlesNoOtherPlayers(t *testing.T) {
 		t.Fatalf("dispatch returned true, want false")
 	}
 
-	output := strings.Join(drainOutput(hero.Output), "\n")
+	output := strings.Join(drainOutput(hero), "\n")
 	want := "You are the only adventurer online."
 	if !strings.Contains(output, want) {
 		t.Fatalf("who output = %q, want substring %q", output, want)
@@ -1,6 +1,7 @@
 package game
 
 import (
+	"bytes"
 	"crypto/sha256"
 	"encoding/hex"
 	"encoding/json"
@@ -31,12 +32,53 @@ type AccountStats struct {
 	TotalLogins int
 }
 
+const (
+	// accountFlushInterval is how often pending account and profile changes
+	// are written to disk.
+	accountFlushInterval = 5 * time.Second
+	// accountFlushThreshold triggers an early flush once this many changes
+	// are pending.
+	accountFlushThreshold = 64
+)
+
+// AccountManager keeps the account database in memory and writes changes
+// behind: logins and profile saves only mark state dirty, and a background
+// flusher persists it on an interval, after accountFlushThreshold changes, or
+// when Flush or Close is called. Registrations are still written immediately.
+// Recently used profiles stay decoded in memory, so logging out and back in
+// touches the disk only when the flusher writes a changed profile.
 type AccountManager struct {
 	mu           sync.RWMutex
 	accounts     map[string]accountRecord
 	path         string
 	playersPath  string
 	adminAccount string
+	// logins bounds how many passwords are hashed at once.
+	logins *loginQueue
+
+	// Write-behind state, guarded by mu. The sequence numbers let a flush
+	// tell whether something changed again while it was writing.
+	accountsSeq     uint64
+	accountsFlushed uint64
+	profiles        map[string]pendingProfile
+	// cache holds decoded profiles as they are on disk.
+	cache          *profileCache
+	changeSeq      uint64
+	pendingChanges int
+
+	// flushMu serialises writers so snapshots reach disk in the order they
+	// were taken.
+	flushMu   sync.Mutex
+	flushKick chan struct{}
+	stop      chan struct{}
+	stopped   chan struct{}
+	closeOnce sync.Once
+	closeErr  error
+}
+
+type pendingProfile struct {
+	profile PlayerProfile
+	seq     uint64
 }
 
 func NewAccountManager(path string) (*AccountManager, error) {
@@ -45,13 +87,117 @@ func NewAccountManager(path string) (*AccountManager, error) {
 		path:         path,
 		playersPath:  filepath.Join(filepath.Dir(path), "players"),
 		adminAccount: defaultAdminAccount,
+		logins:       newLoginQueue(DefaultLoginConfig()),
+		cache:        newProfileCache(profileCacheSize),
+		flushKick:    make(chan struct{}, 1),
+		stop:         make(chan struct{}),
+		stopped:      make(chan struct{}),
 	}
 	if err := manager.load(); err != nil {
 		return nil, err
 	}
+	go manager.flushLoop(accountFlushInterval)
 	return manager, nil
 }
 
+func (a *AccountManager) flushLoop(interval time.Duration) {
+	defer close(a.stopped)
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-ticker.C:
+		case <-a.flushKick:
+		case <-a.stop:
+			return
+		}
+		if err := a.Flush(); err != nil {
+			fmt.Printf("failed to flush account data: %v\n", err)
+		}
+	}
+}
+
+// markChangedLocked records a pending change and wakes the flusher early once
+// enough have accumulated. Callers must hold a.mu.
+func (a *AccountManager) markChangedLocked() uint64 {
+	a.changeSeq++
+	a.pendingChanges++
+	if a.pendingChanges >= accountFlushThreshold {
+		select {
+		case a.flushKick <- struct{}{}:
+		default:
+		}
+	}
+	return a.changeSeq
+}
+
+// Flush writes every pending account and profile change to disk using the
+// same temp file and rename as a direct save. Changes made while the flush is
+// writing stay pending for the next one.
+func (a *AccountManager) Flush() error {
+	a.flushMu.Lock()
+	defer a.flushMu.Unlock()
+	defer observeFlush("accounts", time.Now())
+
+	a.mu.Lock()
+	var accountsData []byte
+	accountsSeq := a.accountsSeq
+	if accountsSeq != a.accountsFlushed {
+		data, err := encodeAccounts(a.accounts)
+		if err != nil {
+			a.mu.Unlock()
+			return err
+		}
+		accountsData = data
+	}
+	profiles := make(map[string]pendingProfile, len(a.profiles))
+	for name, pending := range a.profiles {
+		profiles[name] = pending
+	}
+	a.pendingChanges = 0
+	a.mu.Unlock()
+
+	var firstErr error
+	if accountsData != nil {
+		if err := a.writeAccountsFile(accountsData); err != nil {
+			firstErr = err
+		} else {
+			a.mu.Lock()
+			if accountsSeq > a.accountsFlushed {
+				a.accountsFlushed = accountsSeq
+			}
+			a.mu.Unlock()
+		}
+	}
+	for name, pending := range profiles {
+		if err := a.savePlayerProfile(name, pending.profile); err != nil {
+			if firstErr == nil {
+				firstErr = err
+			}
+			continue
+		}
+		a.mu.Lock()
+		a.cache.put(name, pending.profile, true)
+		if current, ok := a.profiles[name]; ok && current.seq == pending.seq {
+			delete(a.profiles, name)
+		}
+		a.mu.Unlock()
+	}
+	return firstErr
+}
+
+// Close stops the background flusher and writes any pending changes.
+func (a *AccountManager) Close() error {
+	a.closeOnce.Do(func() {
+		if a.stop != nil {
+			close(a.stop)
+			<-a.stopped
+		}
+		a.closeErr = a.Flush()
+	})
+	return a.closeErr
+}
+
 func (a *AccountManager) playerFilePath(name string) string {
 	sum := sha256.Sum256([]byte(strings.ToLower(name)))
 	filename := hex.EncodeToString(sum[:]) + ".json"
@@ -174,7 +320,17 @@ func (a *AccountManager) load() error {
 	return nil
 }
 
-func (a *AccountManager) saveLocked() error {
+func encodeAccounts(accounts map[string]accountRecord) ([]byte, error) {
+	var buf bytes.Buffer
+	enc := json.NewEncoder(&buf)
+	enc.SetIndent("", "  ")
+	if err := enc.Encode(accounts); err != nil {
+		return nil, fmt.Errorf("write accounts file: %w", err)
+	}
+	return buf.Bytes(), nil
+}
+
+func (a *AccountManager) writeAccountsFile(data []byte) error {
 	dir := filepath.Dir(a.path)
 	if err := os.MkdirAll(dir, 0o755); err != nil {
 		return fmt.Errorf("create accounts directory: %w", err)
@@ -183,9 +339,7 @@ func (a *AccountManager) saveLocked() error {
 	if err != nil {
 		return fmt.Errorf("create temp accounts file: %w", err)
 	}
-	enc := json.NewEncoder(tmp)
-	enc.SetIndent("", "  ")
-	if err := enc.Encode(a.accounts); err != nil {
+	if _, err := tmp.Write(data); err != nil {
 		tmp.Close()
 		os.Remove(tmp.Name())
 		return fmt.Errorf("write accounts file: %w", err)
@@ -208,14 +362,38 @@ func (a *AccountManager) Exists(name string) bool {
 	return ok
 }
 
+// ConfigureLogins sets how many passwords may be hashed at once and the
+// bcrypt cost of new hashes.
+func (a *AccountManager) ConfigureLogins(cfg LoginConfig) {
+	a.logins.configure(cfg)
+}
+
+// LoginsQueued reports how many logins are waiting to have their password
+// hashed.
+func (a *AccountManager) LoginsQueued() int {
+	return a.logins.queued()
+}
+
 func (a *AccountManager) Register(name, pass string) error {
-	hashed, err := bcrypt.GenerateFromPassword([]byte(pass), bcrypt.DefaultCost)
+	return a.register(name, pass, nil)
+}
+
+// register creates an account once a hashing slot is free, telling wait the
+// caller's place in the queue meanwhile.
+func (a *AccountManager) register(name, pass string, wait func(int) bool) error {
+	var hashed []byte
+	var err error
+	if qerr := a.logins.hashing(wait, func() {
+		hashed, err = bcrypt.GenerateFromPassword([]byte(pass), a.logins.cost())
+	}); qerr != nil {
+		return qerr
+	}
 	if err != nil {
 		return fmt.Errorf("hash password: %w", err)
 	}
 	a.mu.Lock()
-	defer a.mu.Unlock()
 	if _, ok := a.accounts[name]; ok {
+		a.mu.Unlock()
 		return fmt.Errorf("account already exists")
 	}
 	now := time.Now().UTC()
@@ -225,21 +403,50 @@ func (a *AccountManager) Register(name, pass string) error {
 		LastLogin:   time.Time{},
 		TotalLogins: 0,
 	}
-	if err := a.saveLocked(); err != nil {
-		delete(a.accounts, name)
-		return err
+	seq := a.markChangedLocked()
+	a.accountsSeq = seq
+	a.mu.Unlock()
+
+	// New accounts are written through so a crash cannot lose a password. A
+	// failed profile write in the same flush is retried later and does not
+	// undo an account that already reached accounts.json.
+	if err := a.Flush(); err != nil {
+		a.mu.Lock()
+		written := a.accountsFlushed >= seq
+		if !written {
+			delete(a.accounts, name)
+			a.accountsSeq = a.markChangedLocked()
+		}
+		a.mu.Unlock()
+		if !written {
+			return err
+		}
+		fmt.Printf("failed to flush account data: %v\n", err)
 	}
 	return nil
 }
 
 func (a *AccountManager) Authenticate(name, pass string) bool {
+	ok, _ := a.authenticate(name, pass, nil)
+	return ok
+}
+
+// authenticate checks pass once a hashing slot is free, telling wait the
+// caller's place in the queue meanwhile.
+func (a *AccountManager) authenticate(name, pass string, wait func(int) bool) (bool, error) {
 	a.mu.RLock()
 	record, ok := a.accounts[name]
 	a.mu.RUnlock()
 	if !ok {
-		return false
+		return false, nil
 	}
-	return bcrypt.CompareHashAndPassword([]byte(record.Password), []byte(pass)) == nil
+	var err error
+	if qerr := a.logins.hashing(wait, func() {
+		err = bcrypt.CompareHashAndPassword([]byte(record.Password), []byte(pass))
+	}); qerr != nil {
+		return false, qerr
+	}
+	return err == nil, nil
 }
 
 // Profile retrieves the persisted state for a player. Defaults are returned for
@@ -250,7 +457,22 @@ func (a *AccountManager) Profile(name string) PlayerProfile {
 		Home:     StartRoom,
 		Channels: defaultChannelSettings(),
 	}
-	if disk, found := a.loadPlayerProfile(name); found {
+	a.mu.Lock()
+	pending, queued := a.profiles[name]
+	disk, found := pending.profile, queued
+	cached := queued
+	if !queued {
+		disk, found, cached = a.cache.get(name)
+	}
+	disk = cloneProfile(disk)
+	a.mu.Unlock()
+	if !cached {
+		disk, found = a.loadPlayerProfile(name)
+		a.mu.Lock()
+		a.cache.add(name, cloneProfile(disk), found)
+		a.mu.Unlock()
+	}
+	if found {
 		if disk.Room != "" {
 			profile.Room = disk.Room
 		}
@@ -267,20 +489,32 @@ func (a *AccountManager) Profile(name string) PlayerProfile {
 	return profile
 }
 
-// SaveProfile persists the provided state for the named account.
+// SaveProfile queues the provided state for the named account. It is written
+// to disk by the next flush unless it matches what is already there.
 func (a *AccountManager) SaveProfile(name string, profile PlayerProfile) error {
-	a.mu.RLock()
-	_, ok := a.accounts[name]
-	a.mu.RUnlock()
-	if !ok {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+	if _, ok := a.accounts[name]; !ok {
 		return fmt.Errorf("account not found")
 	}
-	if err := a.savePlayerProfile(name, profile); err != nil {
-		return err
+	if _, queued := a.profiles[name]; !queued {
+		if onDisk, found, ok := a.cache.get(name); ok && found && profilesEqual(onDisk, profile) {
+			return nil
+		}
+	}
+	if a.profiles == nil {
+		a.profiles = make(map[string]pendingProfile)
 	}
+	a.profiles[name] = pendingProfile{profile: cloneProfile(profile), seq: a.markChangedLocked()}
 	return nil
 }
 
+func cloneProfile(profile PlayerProfile) PlayerProfile {
+	profile.Channels = cloneChannelSettings(profile.Channels)
+	profile.Aliases = cloneChannelAliases(profile.Aliases)
+	return profile
+}
+
 // RecordLogin updates bookkeeping for a successful login.
 func (a *AccountManager) RecordLogin(name string, when time.Time) error {
 	a.mu.Lock()
@@ -295,7 +529,8 @@ func (a *AccountManager) RecordLogin(name string, when time.Time) error {
 	record.LastLogin = when.UTC()
 	record.TotalLogins++
 	a.accounts[name] = record
-	return a.saveLocked()
+	a.accountsSeq = a.markChangedLocked()
+	return nil
 }
 
 // Stats returns account metadata for display purposes.
@@ -0,0 +1,260 @@
+package game
+
+import (
+	"fmt"
+	"net"
+	"sync"
+	"sync/atomic"
+	"syscall"
+	"time"
+)
+
+const (
+	// overloadSample is how often the overload monitor looks at lock waits
+	// and output backlog.
+	overloadSample = time.Second
+	// overloadMinSamples is the fewest world lock acquisitions in a sample
+	// for their wait times to count; a quiet server is never overloaded.
+	overloadMinSamples = 20
+	// rejectWriteTimeout bounds the notice written to a refused connection.
+	rejectWriteTimeout = time.Second
+)
+
+// AdmissionConfig limits who may connect and how quickly players may send
+// commands, and sets the load at which the server stops accepting new
+// connections. Zero limits and thresholds are disabled.
+type AdmissionConfig struct {
+	// MaxConnections caps the open connections, logged in or not.
+	MaxConnections int
+	// MaxPerIP caps the open connections from one remote address.
+	MaxPerIP int
+	// LoginTimeout is how long a connection may take to log in.
+	LoginTimeout time.Duration
+	// CommandRate is how many commands per second a player may send once
+	// their burst is spent. Zero uses the built-in rate.
+	CommandRate float64
+	// CommandBurst is how many commands a player may send back to back.
+	// Zero uses the built-in burst.
+	CommandBurst int
+	// ShedLockWait sheds load once the 99th percentile world lock wait over
+	// a second exceeds it.
+	ShedLockWait time.Duration
+	// ShedOutputBytes sheds load once this many bytes are waiting in
+	// output queues across all sessions.
+	ShedOutputBytes int
+}
+
+// DefaultAdmissionConfig returns the limits used when none are supplied.
+func DefaultAdmissionConfig() AdmissionConfig {
+	return AdmissionConfig{
+		MaxConnections:  4096,
+		MaxPerIP:        16,
+		LoginTimeout:    2 * time.Minute,
+		CommandRate:     float64(commandLimit) / commandWindow.Seconds(),
+		CommandBurst:    commandLimit,
+		ShedLockWait:    25 * time.Millisecond,
+		ShedOutputBytes: 32 << 20,
+	}
+}
+
+// rejection counts connections refused for one reason.
+type rejection struct {
+	reason string
+	notice string
+	count  atomic.Uint64
+}
+
+var (
+	rejectedFull = &rejection{
+		reason: "max_connections",
+		notice: "The server is full. Please try again later.",
+	}
+	rejectedPerIP = &rejection{
+		reason: "max_per_ip",
+		notice: "Too many connections from your address.",
+	}
+	rejectedOverload = &rejection{
+		reason: "overload",
+		notice: "The server is overloaded. Please try again in a minute.",
+	}
+	rejections = []*rejection{rejectedFull, rejectedPerIP, rejectedOverload}
+)
+
+// admission tracks open connections and whether the server is shedding
+// load.
+type admission struct {
+	cfg AdmissionConfig
+
+	mu    sync.Mutex
+	open  int
+	perIP map[string]int
+
+	overloaded atomic.Bool
+}
+
+func newAdmission(cfg AdmissionConfig) *admission {
+	return &admission{cfg: cfg, perIP: make(map[string]int)}
+}
+
+// admit decides whether conn may proceed. Admitted connections are wrapped
+// so that closing them frees their place; refused ones are sent a notice
+// and closed in the background.
+func (a *admission) admit(conn net.Conn) (net.Conn, bool) {
+	if a.overloaded.Load() {
+		a.reject(conn, rejectedOverload)
+		return nil, false
+	}
+	host := remoteHost(conn.RemoteAddr())
+	a.mu.Lock()
+	if a.cfg.MaxConnections > 0 && a.open >= a.cfg.MaxConnections {
+		a.mu.Unlock()
+		a.reject(conn, rejectedFull)
+		return nil, false
+	}
+	if a.cfg.MaxPerIP > 0 && a.perIP[host] >= a.cfg.MaxPerIP {
+		a.mu.Unlock()
+		a.reject(conn, rejectedPerIP)
+		return nil, false
+	}
+	a.open++
+	a.perIP[host]++
+	a.mu.Unlock()
+	return &admittedConn{Conn: conn, release: func() { a.release(host) }}, true
+}
+
+func (a *admission) release(host string) {
+	a.mu.Lock()
+	a.open--
+	if a.perIP[host]--; a.perIP[host] <= 0 {
+		delete(a.perIP, host)
+	}
+	a.mu.Unlock()
+}
+
+func (a *admission) reject(conn net.Conn, r *rejection) {
+	r.count.Add(1)
+	go func() {
+		_ = conn.SetWriteDeadline(time.Now().Add(rejectWriteTimeout))
+		_, _ = conn.Write([]byte("\r\n" + r.notice + "\r\n"))
+		_ = conn.Close()
+	}()
+}
+
+func remoteHost(addr net.Addr) string {
+	if addr == nil {
+		return ""
+	}
+	if host, _, err := net.SplitHostPort(addr.String()); err == nil {
+		return host
+	}
+	return addr.String()
+}
+
+// admittedConn frees its admission place the first time it is closed.
+type admittedConn struct {
+	net.Conn
+	once    sync.Once
+	release func()
+}
+
+func (c *admittedConn) Close() error {
+	err := c.Conn.Close()
+	c.once.Do(c.release)
+	return err
+}
+
+// SyscallConn exposes the underlying descriptor so the poll connection mode
+// still works behind admission control.
+func (c *admittedConn) SyscallConn() (syscall.RawConn, error) {
+	conn, ok := c.Conn.(syscall.Conn)
+	if !ok {
+		return nil, fmt.Errorf("connection has no file descriptor")
+	}
+	return conn.SyscallConn()
+}
+
+// watch samples world lock waits and output backlog until done is closed,
+// refusing new connections while either is over its threshold. Shedding
+// stops once both have fallen below half their thresholds.
+func (a *admission) watch(world *World, done <-chan struct{}) {
+	if a.cfg.ShedLockWait <= 0 && a.cfg.ShedOutputBytes <= 0 {
+		return
+	}
+	ticker := time.NewTicker(overloadSample)
+	defer ticker.Stop()
+	prev := worldLockWaits()
+	for {
+		select {
+		case <-done:
+			return
+		case <-ticker.C:
+		}
+		waits := worldLockWaits()
+		lockWait := waits.since(prev).quantile(0.99, overloadMinSamples)
+		prev = waits
+		queued := 0
+		if a.cfg.ShedOutputBytes > 0 {
+			queued = world.outputQueued()
+		}
+		a.update(lockWait, queued)
+	}
+}
+
+// update moves the server into or out of shedding given one sample.
+func (a *admission) update(lockWait time.Duration, queued int) {
+	lockOver := a.cfg.ShedLockWait > 0 && lockWait > a.cfg.ShedLockWait
+	queueOver := a.cfg.ShedOutputBytes > 0 && queued > a.cfg.ShedOutputBytes
+	if !a.overloaded.Load() {
+		if lockOver || queueOver {
+			a.overloaded.Store(true)
+			fmt.Printf("Server overloaded (world lock p99 wait %s, %d bytes of output queued); refusing new connections\n", lockWait, queued)
+		}
+		return
+	}
+	lockCalm := a.cfg.ShedLockWait <= 0 || lockWait <= a.cfg.ShedLockWait/2
+	queueCalm := a.cfg.ShedOutputBytes <= 0 || queued <= a.cfg.ShedOutputBytes/2
+	if lockCalm && queueCalm {
+		a.overloaded.Store(false)
+		fmt.Println("Server load back to normal; accepting connections")
+	}
+}
+
+// outputQueued reports the bytes waiting in every session's output queue.
+func (w *World) outputQueued() int {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	queued := 0
+	for _, p := range w.players {
+		if p.Alive && p.Session != nil {
+			queued += p.Session.output.stats().Queued
+		}
+	}
+	return queued
+}
+
+func (w *World) useAdmission(a *admission) {
+	w.mu.Lock()
+	w.admission = a
+	w.mu.Unlock()
+}
+
+// loginTimeout is how long a new connection may take to log in, or zero for
+// no limit.
+func (w *World) loginTimeout() time.Duration {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	if w.admission == nil {
+		return 0
+	}
+	return w.admission.cfg.LoginTimeout
+}
+
+// limitCommandsLocked applies the configured command rate to p and gives
+// p a full burst. Callers must hold w.mu.
+func (w *World) limitCommandsLocked(p *Player) {
+	p.commands = tokenBucket{}
+	if w.admission != nil {
+		p.commands.rate = w.admission.cfg.CommandRate
+		p.commands.burst = float64(w.admission.cfg.CommandBurst)
+	}
+}
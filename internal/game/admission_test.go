@@ -0,0 +1,141 @@
+package game
+
+import (
+	"net"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+)
+
+// remoteConn is a connection from a chosen address that records what was
+// written to it and whether it was closed.
+type remoteConn struct {
+	nopConn
+	addr    string
+	mu      sync.Mutex
+	written strings.Builder
+	once    sync.Once
+	closed  chan struct{}
+}
+
+func newRemoteConn(addr string) *remoteConn {
+	return &remoteConn{addr: addr, closed: make(chan struct{})}
+}
+
+func (c *remoteConn) RemoteAddr() net.Addr { return fakeAddr(c.addr) }
+
+func (c *remoteConn) Write(b []byte) (int, error) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.written.Write(b)
+}
+
+func (c *remoteConn) Close() error {
+	c.once.Do(func() { close(c.closed) })
+	return nil
+}
+
+func (c *remoteConn) waitClosed(t *testing.T) string {
+	t.Helper()
+	select {
+	case <-c.closed:
+	case <-time.After(5 * time.Second):
+		t.Fatalf("connection from %s was not closed", c.addr)
+	}
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.written.String()
+}
+
+func TestAdmissionLimitsConnections(t *testing.T) {
+	a := newAdmission(AdmissionConfig{MaxConnections: 3, MaxPerIP: 2})
+	first, ok := a.admit(newRemoteConn("10.0.0.1:1000"))
+	if !ok {
+		t.Fatalf("first connection refused")
+	}
+	if _, ok := a.admit(newRemoteConn("10.0.0.1:1001")); !ok {
+		t.Fatalf("second connection from one address refused")
+	}
+	refused := newRemoteConn("10.0.0.1:1002")
+	if _, ok := a.admit(refused); ok {
+		t.Fatalf("expected a third connection from one address to be refused")
+	}
+	if got := refused.waitClosed(t); !strings.Contains(got, rejectedPerIP.notice) {
+		t.Fatalf("refused connection was told %q", got)
+	}
+
+	if _, ok := a.admit(newRemoteConn("10.0.0.2:1000")); !ok {
+		t.Fatalf("connection from another address refused")
+	}
+	full := newRemoteConn("10.0.0.3:1000")
+	if _, ok := a.admit(full); ok {
+		t.Fatalf("expected the connection limit to apply")
+	}
+	if got := full.waitClosed(t); !strings.Contains(got, rejectedFull.notice) {
+		t.Fatalf("refused connection was told %q", got)
+	}
+
+	// Closing twice frees one place.
+	_ = first.Close()
+	_ = first.Close()
+	if a.open != 2 || a.perIP["10.0.0.1"] != 1 {
+		t.Fatalf("after close: %d open, %d from 10.0.0.1", a.open, a.perIP["10.0.0.1"])
+	}
+	if _, ok := a.admit(newRemoteConn("10.0.0.3:1000")); !ok {
+		t.Fatalf("connection refused after a place was freed")
+	}
+}
+
+func TestAdmissionShedsLoadWithHysteresis(t *testing.T) {
+	a := newAdmission(AdmissionConfig{ShedLockWait: 10 * time.Millisecond, ShedOutputBytes: 1000})
+	a.update(5*time.Millisecond, 500)
+	if a.overloaded.Load() {
+		t.Fatalf("overloaded below both thresholds")
+	}
+	a.update(25*time.Millisecond, 0)
+	if !a.overloaded.Load() {
+		t.Fatalf("expected a slow world lock to shed load")
+	}
+	conn := newRemoteConn("10.0.0.1:1000")
+	if _, ok := a.admit(conn); ok {
+		t.Fatalf("expected connections to be refused while overloaded")
+	}
+	if got := conn.waitClosed(t); !strings.Contains(got, rejectedOverload.notice) {
+		t.Fatalf("refused connection was told %q", got)
+	}
+
+	a.update(5*time.Millisecond, 800)
+	if !a.overloaded.Load() {
+		t.Fatalf("expected shedding to continue until the backlog halves")
+	}
+	a.update(5*time.Millisecond, 400)
+	if a.overloaded.Load() {
+		t.Fatalf("expected shedding to stop once load fell")
+	}
+}
+
+func TestHistogramCountsQuantile(t *testing.T) {
+	var h histogram
+	var before histogramCounts
+	h.observe(time.Second)
+	h.addCounts(&before)
+	for i := 0; i < 98; i++ {
+		h.observe(0)
+	}
+	h.observe(3 * time.Millisecond)
+	h.observe(8 * time.Millisecond)
+	var after histogramCounts
+	h.addCounts(&after)
+
+	sample := after.since(before)
+	if got := sample.quantile(0.99, 10); got != 5*time.Millisecond {
+		t.Fatalf("p99 = %s, want 5ms", got)
+	}
+	if got := sample.quantile(0.5, 10); got != 10*time.Microsecond {
+		t.Fatalf("p50 = %s, want 10µs", got)
+	}
+	if got := sample.quantile(0.99, 1000); got != 0 {
+		t.Fatalf("p99 of too few samples = %s, want 0", got)
+	}
+}
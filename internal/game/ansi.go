@@ -73,6 +73,9 @@ func Hyperlink(url, label string) string {
 
 // Trim normalises a telnet input line.
 func Trim(s string) string {
+	if plain, ok := trimPlainInput(s); ok {
+		return plain
+	}
 	cleaned := sanitizeInput(s)
 	cleaned = strings.TrimSpace(cleaned)
 	if cleaned == "" {
@@ -106,3 +109,9 @@ func Prompt(p *Player) string {
 	summary := fmt.Sprintf("\r\n[L%02d HP %d/%d MP %d/%d] > ", p.Level, p.Health, p.MaxHealth, p.Mana, p.MaxMana)
 	return Ansi(Style(summary, AnsiBold, AnsiYellow))
 }
+
+// isPrompt reports whether msg was rendered by Prompt, so output queues can
+// collapse prompts that a newer one has already superseded.
+func isPrompt(msg string) bool {
+	return strings.HasPrefix(msg, AnsiBold+AnsiYellow+"\r\n") && strings.HasSuffix(msg, "> "+AnsiReset)
+}
@@ -19,3 +19,18 @@ func TestTrimNormalisesWhitespace(t *testing.T) {
 		t.Fatalf("Trim(%q) = %q, want %q", input, got, want)
 	}
 }
+
+func TestTrimPlainInputDoesNotAllocate(t *testing.T) {
+	for _, input := range []string{"  say hello  ", "a  b", "tab\there", "café", "", "   "} {
+		plain, ok := trimPlainInput(input)
+		if want := Trim(input); ok && plain != want {
+			t.Fatalf("trimPlainInput(%q) = %q, want %q", input, plain, want)
+		}
+	}
+	allocs := testing.AllocsPerRun(100, func() {
+		Trim("  get lantern from chest ")
+	})
+	if allocs != 0 {
+		t.Fatalf("Trim allocated %.0f times for plain input", allocs)
+	}
+}
@@ -0,0 +1,382 @@
+package game
+
+import (
+	"bytes"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"hash/fnv"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"time"
+)
+
+// AreaReload summarises the changes applied by ReloadAreas.
+type AreaReload struct {
+	// Files lists the area files whose rooms were applied.
+	Files   []string
+	Added   int
+	Updated int
+	Removed int
+	// Relocated holds players who stood in a removed room and were moved to
+	// the start room.
+	Relocated []*Player
+	// Skipped describes area files that could not be applied.
+	Skipped []string
+}
+
+// Changed reports whether the reload touched any room.
+func (r AreaReload) Changed() bool {
+	return r.Added+r.Updated+r.Removed > 0
+}
+
+func (r AreaReload) String() string {
+	if len(r.Files) == 0 && len(r.Skipped) == 0 {
+		return "no area changes"
+	}
+	summary := fmt.Sprintf("%d added, %d updated, %d removed", r.Added, r.Updated, r.Removed)
+	if len(r.Files) > 0 {
+		summary += " from " + strings.Join(r.Files, ", ")
+	}
+	if len(r.Relocated) > 0 {
+		summary += fmt.Sprintf("; %d players relocated", len(r.Relocated))
+	}
+	if len(r.Skipped) > 0 {
+		summary += "; skipped " + strings.Join(r.Skipped, "; ")
+	}
+	return summary
+}
+
+type areaChange struct {
+	name    string
+	removed bool
+	meta    areaMetadata
+	rooms   []Room
+	err     error
+}
+
+// ReloadAreas re-reads the area directory and applies files that changed
+// since they were last loaded. Files are read and decoded without holding the
+// world lock; the lock is only taken to swap in rooms whose definition
+// differs from the one previously loaded. Unchanged rooms keep their live
+// items and NPCs, rooms edited in-game keep their builder version, and room
+// histories carry on. Only players standing in a room that was removed are
+// moved, to the start room.
+func (w *World) ReloadAreas() (AreaReload, error) {
+	w.mu.RLock()
+	areasPath := w.areasPath
+	known := make(map[string]uint64, len(w.areaMeta))
+	for name, meta := range w.areaMeta {
+		known[name] = meta.Digest
+	}
+	w.mu.RUnlock()
+	if areasPath == "" {
+		return AreaReload{}, fmt.Errorf("world does not have an areas path configured")
+	}
+	changes, err := scanAreaChanges(areasPath, known)
+	if err != nil {
+		return AreaReload{}, err
+	}
+
+	var result AreaReload
+	if len(changes) == 0 {
+		return result, nil
+	}
+	w.precompileAreaChanges(changes)
+	w.mu.Lock()
+	defer w.mu.Unlock()
+	for _, change := range changes {
+		if change.err != nil {
+			result.Skipped = append(result.Skipped, change.err.Error())
+			continue
+		}
+		if err := w.applyAreaChangeLocked(change, &result); err != nil {
+			result.Skipped = append(result.Skipped, err.Error())
+			continue
+		}
+		result.Files = append(result.Files, change.name)
+	}
+	return result, nil
+}
+
+// precompileAreaChanges compiles the scripts in changed areas before the
+// world lock is taken, so swapped-in rooms fire their hooks without delay.
+func (w *World) precompileAreaChanges(changes []areaChange) {
+	if w.scripts == nil {
+		return
+	}
+	var sources []string
+	for _, change := range changes {
+		sources = append(sources, change.meta.Script)
+		for i := range change.rooms {
+			sources = appendRoomScripts(sources, &change.rooms[i])
+		}
+	}
+	w.scripts.precompile(sources)
+}
+
+// scanAreaChanges returns the area files whose contents no longer match the
+// digests recorded when they were loaded. The builder area is never reloaded
+// from disk because the live world is its source of truth.
+func scanAreaChanges(areasPath string, known map[string]uint64) ([]areaChange, error) {
+	entries, err := os.ReadDir(areasPath)
+	if err != nil {
+		return nil, fmt.Errorf("read areas: %w", err)
+	}
+	present := make(map[string]bool, len(entries))
+	var changes []areaChange
+	for _, entry := range entries {
+		name := entry.Name()
+		if entry.IsDir() || filepath.Ext(name) != ".json" || name == builderAreaFile {
+			continue
+		}
+		present[name] = true
+		data, err := os.ReadFile(filepath.Join(areasPath, name))
+		if err != nil {
+			changes = append(changes, areaChange{name: name, err: fmt.Errorf("read area %s: %w", name, err)})
+			continue
+		}
+		digest := digestBytes(data)
+		if prev, ok := known[name]; ok && prev == digest {
+			continue
+		}
+		file, _, err := decodeAreaFile(name, bytes.NewReader(data))
+		if err != nil {
+			changes = append(changes, areaChange{name: name, err: err})
+			continue
+		}
+		changes = append(changes, areaChange{
+			name:  name,
+			meta:  areaMetadata{Name: file.Name, Script: strings.TrimSpace(file.Script), ResetInterval: file.resetInterval(), Digest: digest},
+			rooms: file.Rooms,
+		})
+	}
+	for name := range known {
+		if name != builderAreaFile && !present[name] {
+			changes = append(changes, areaChange{name: name, removed: true})
+		}
+	}
+	sort.Slice(changes, func(i, j int) bool { return changes[i].name < changes[j].name })
+	return changes, nil
+}
+
+func (w *World) applyAreaChangeLocked(change areaChange, result *AreaReload) error {
+	if w.rooms == nil {
+		w.rooms = make(map[RoomID]*Room)
+	}
+	if w.roomSources == nil {
+		w.roomSources = make(map[RoomID]string)
+	}
+	if w.roomDigests == nil {
+		w.roomDigests = make(map[RoomID]uint64)
+	}
+	if w.roomHistories == nil {
+		w.roomHistories = make(map[RoomID]*roomHistory)
+	}
+	defined := make(map[RoomID]bool, len(change.rooms))
+	for i := range change.rooms {
+		id := change.rooms[i].ID
+		if defined[id] {
+			return fmt.Errorf("area %s: duplicate room id %s", change.name, id)
+		}
+		defined[id] = true
+		if source, ok := w.roomSources[id]; ok && source != change.name && source != builderAreaFile {
+			return fmt.Errorf("area %s: room %s is already defined in %s", change.name, id, source)
+		}
+	}
+
+	for i := range change.rooms {
+		def := change.rooms[i]
+		if w.roomSources[def.ID] == builderAreaFile {
+			continue
+		}
+		digest := digestRoom(&def)
+		_, exists := w.rooms[def.ID]
+		if exists && w.roomDigests[def.ID] == digest {
+			continue
+		}
+		room := def
+		w.rooms[def.ID] = &room
+		w.invalidateRoomGraphLocked()
+		w.roomSources[def.ID] = change.name
+		w.roomDigests[def.ID] = digest
+		history, ok := w.roomHistories[def.ID]
+		if !ok {
+			history = &roomHistory{}
+			w.roomHistories[def.ID] = history
+		}
+		history.append(&room, "")
+		if exists {
+			result.Updated++
+		} else {
+			result.Added++
+		}
+	}
+
+	var stale []RoomID
+	for id, source := range w.roomSources {
+		if source == change.name && !defined[id] {
+			stale = append(stale, id)
+		}
+	}
+	sort.Slice(stale, func(i, j int) bool { return stale[i] < stale[j] })
+	for _, id := range stale {
+		w.removeRoomLocked(id, result)
+	}
+
+	if w.areaMeta == nil {
+		w.areaMeta = make(map[string]areaMetadata)
+	}
+	if change.removed {
+		delete(w.areaMeta, change.name)
+	} else {
+		w.areaMeta[change.name] = change.meta
+	}
+	return nil
+}
+
+// removeRoomLocked drops a room whose area no longer defines it, ending any
+// fight there and moving its occupants to the start room. The room's history
+// is kept in case the room returns.
+func (w *World) removeRoomLocked(id RoomID, result *AreaReload) {
+	delete(w.rooms, id)
+	w.invalidateRoomViewLocked(id)
+	w.invalidateRoomGraphLocked()
+	delete(w.roomSources, id)
+	delete(w.roomDigests, id)
+	if combat, ok := w.combats[id]; ok {
+		delete(w.combats, id)
+		combat.stopLoop()
+	}
+	occupants := make([]*Player, 0, len(w.occupants[id]))
+	for p := range w.occupants[id] {
+		occupants = append(occupants, p)
+	}
+	sort.Slice(occupants, func(i, j int) bool {
+		return occupants[i].loginSeq < occupants[j].loginSeq
+	})
+	for _, p := range occupants {
+		w.placePlayerLocked(p, StartRoom)
+		result.Relocated = append(result.Relocated, p)
+	}
+	result.Removed++
+}
+
+// WatchAreas polls the areas directory every interval and reloads it when a
+// file's size or modification time changes, until stop is closed. Players
+// moved out of removed rooms are shown their new surroundings.
+func (w *World) WatchAreas(interval time.Duration, stop <-chan struct{}) {
+	if interval <= 0 {
+		return
+	}
+	w.mu.RLock()
+	areasPath := w.areasPath
+	w.mu.RUnlock()
+	if areasPath == "" {
+		return
+	}
+	last, _ := statAreas(areasPath)
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-stop:
+			return
+		case <-ticker.C:
+		}
+		current, err := statAreas(areasPath)
+		if err != nil {
+			fmt.Printf("failed to scan areas: %v\n", err)
+			continue
+		}
+		if sameAreaStats(last, current) {
+			continue
+		}
+		last = current
+		result, err := w.ReloadAreas()
+		if err != nil {
+			fmt.Printf("failed to reload areas: %v\n", err)
+			continue
+		}
+		if !result.Changed() && len(result.Skipped) == 0 {
+			continue
+		}
+		fmt.Printf("Reloaded areas: %s\n", result)
+		for _, p := range result.Relocated {
+			p.Send(Ansi(Style("\r\nThe world reshapes itself around you.", AnsiMagenta)))
+			EnterRoom(w, p, "")
+		}
+	}
+}
+
+type areaStat struct {
+	size    int64
+	modTime time.Time
+}
+
+func statAreas(areasPath string) (map[string]areaStat, error) {
+	entries, err := os.ReadDir(areasPath)
+	if err != nil {
+		return nil, fmt.Errorf("read areas: %w", err)
+	}
+	stats := make(map[string]areaStat, len(entries))
+	for _, entry := range entries {
+		name := entry.Name()
+		if entry.IsDir() || filepath.Ext(name) != ".json" || name == builderAreaFile {
+			continue
+		}
+		info, err := entry.Info()
+		if errors.Is(err, os.ErrNotExist) {
+			continue
+		}
+		if err != nil {
+			return nil, fmt.Errorf("stat area %s: %w", name, err)
+		}
+		stats[name] = areaStat{size: info.Size(), modTime: info.ModTime()}
+	}
+	return stats, nil
+}
+
+func sameAreaStats(a, b map[string]areaStat) bool {
+	if len(a) != len(b) {
+		return false
+	}
+	for name, stat := range a {
+		other, ok := b[name]
+		if !ok || other.size != stat.size || !other.modTime.Equal(stat.modTime) {
+			return false
+		}
+	}
+	return true
+}
+
+func digestBytes(data []byte) uint64 {
+	h := fnv.New64a()
+	h.Write(data)
+	return h.Sum64()
+}
+
+// digestRoom hashes a room definition so a reload can tell whether an area
+// file changed that particular room.
+func digestRoom(room *Room) uint64 {
+	data, err := json.Marshal(room)
+	if err != nil {
+		return 0
+	}
+	return digestBytes(data)
+}
+
+// digestRooms records the definition digest of every room loaded from a
+// stock area file.
+func digestRooms(rooms map[RoomID]*Room, sources map[RoomID]string) map[RoomID]uint64 {
+	digests := make(map[RoomID]uint64, len(rooms))
+	for id, room := range rooms {
+		if sources[id] == builderAreaFile {
+			continue
+		}
+		digests[id] = digestRoom(room)
+	}
+	return digests
+}
@@ -0,0 +1,119 @@
+package game
+
+import (
+	"encoding/json"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+func writeAreaForTest(t *testing.T, dir, name string, file areaFile) {
+	t.Helper()
+	data, err := json.Marshal(file)
+	if err != nil {
+		t.Fatalf("Marshal %s: %v", name, err)
+	}
+	if err := os.WriteFile(filepath.Join(dir, name), data, 0o644); err != nil {
+		t.Fatalf("WriteFile %s: %v", name, err)
+	}
+}
+
+func TestReloadAreasSwapsOnlyChangedRooms(t *testing.T) {
+	dir := t.TempDir()
+	writeAreaForTest(t, dir, "a.json", areaFile{Name: "A", Rooms: []Room{
+		{ID: StartRoom, Title: "Start", Description: "Plain."},
+		{ID: "hall", Title: "Hall", Description: "Old hall."},
+		{ID: "vault", Title: "Vault", Description: "Old vault."},
+	}})
+	writeAreaForTest(t, dir, "b.json", areaFile{Name: "B", Rooms: []Room{
+		{ID: "garden", Title: "Garden", Description: "Green."},
+	}})
+	world, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld: %v", err)
+	}
+	world.builder.delay = time.Hour
+	defer world.Close()
+
+	stayer := &Player{Name: "Stayer", Room: "hall", Alive: true}
+	gardener := &Player{Name: "Gardener", Room: "garden", Alive: true}
+	world.AddPlayerForTest(stayer)
+	world.AddPlayerForTest(gardener)
+	world.rooms[StartRoom].Items = append(world.rooms[StartRoom].Items, Item{Name: "dropped coin"})
+	if _, err := world.UpdateRoomDescription("vault", "Builder vault.", "Builder"); err != nil {
+		t.Fatalf("UpdateRoomDescription: %v", err)
+	}
+
+	writeAreaForTest(t, dir, "a.json", areaFile{Name: "A", Rooms: []Room{
+		{ID: StartRoom, Title: "Start", Description: "Plain."},
+		{ID: "hall", Title: "Hall", Description: "New hall."},
+		{ID: "vault", Title: "Vault", Description: "New vault."},
+	}})
+	writeAreaForTest(t, dir, "b.json", areaFile{Name: "B", Rooms: []Room{
+		{ID: "pond", Title: "Pond", Description: "Still water."},
+	}})
+
+	result, err := world.ReloadAreas()
+	if err != nil {
+		t.Fatalf("ReloadAreas: %v", err)
+	}
+	if result.Added != 1 || result.Updated != 1 || result.Removed != 1 || len(result.Skipped) != 0 {
+		t.Fatalf("unexpected reload result: %s", result)
+	}
+	if len(result.Relocated) != 1 || result.Relocated[0] != gardener {
+		t.Fatalf("expected only the gardener to be relocated, got %v", result.Relocated)
+	}
+	if gardener.Room != StartRoom || stayer.Room != "hall" {
+		t.Fatalf("unexpected player rooms: gardener %s, stayer %s", gardener.Room, stayer.Room)
+	}
+	if items := world.RoomItems(StartRoom); len(items) != 1 {
+		t.Fatalf("expected unchanged room to keep live items, got %+v", items)
+	}
+	if hall, _ := world.GetRoom("hall"); hall.Description != "New hall." {
+		t.Fatalf("expected hall to be updated, got %q", hall.Description)
+	}
+	if vault, _ := world.GetRoom("vault"); vault.Description != "Builder vault." {
+		t.Fatalf("expected builder edit to win, got %q", vault.Description)
+	}
+	if _, ok := world.GetRoom("garden"); ok {
+		t.Fatalf("expected garden to be removed")
+	}
+	if _, ok := world.GetRoom("pond"); !ok {
+		t.Fatalf("expected pond to be added")
+	}
+	revisions, err := world.RoomRevisions("hall")
+	if err != nil || len(revisions) != 2 {
+		t.Fatalf("expected hall history to be kept and extended, got %d (%v)", len(revisions), err)
+	}
+
+	again, err := world.ReloadAreas()
+	if err != nil {
+		t.Fatalf("ReloadAreas again: %v", err)
+	}
+	if again.Changed() || len(again.Files) != 0 {
+		t.Fatalf("expected no changes on second reload, got %s", again)
+	}
+}
+
+func TestReloadAreasSkipsConflictingFile(t *testing.T) {
+	dir := t.TempDir()
+	writeAreaForTest(t, dir, "a.json", areaFile{Name: "A", Rooms: []Room{{ID: StartRoom, Title: "Start"}}})
+	world, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld: %v", err)
+	}
+	defer world.Close()
+
+	writeAreaForTest(t, dir, "b.json", areaFile{Name: "B", Rooms: []Room{{ID: StartRoom, Title: "Impostor"}}})
+	result, err := world.ReloadAreas()
+	if err != nil {
+		t.Fatalf("ReloadAreas: %v", err)
+	}
+	if len(result.Skipped) != 1 || result.Changed() {
+		t.Fatalf("expected conflicting file to be skipped, got %s", result)
+	}
+	if room, _ := world.GetRoom(StartRoom); room.Title != "Start" {
+		t.Fatalf("expected original room to survive, got %q", room.Title)
+	}
+}
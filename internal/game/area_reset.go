@@ -0,0 +1,248 @@
+package game
+
+import (
+	"strings"
+	"sync"
+	"time"
+)
+
+const (
+	// areaResetTick is how often the reset scheduler checks for due areas
+	// and repopulates a batch of rooms.
+	areaResetTick = 250 * time.Millisecond
+	// areaResetBatch is how many rooms one tick repopulates. Each room takes
+	// the world lock for reading and its own shard lock, no more.
+	areaResetBatch = 8
+)
+
+// roomItemIndex counts a room's items by folded name so resets do not scan
+// the floor. Taking, dropping and loot keep it current. It remembers which
+// Items slice it describes and is rebuilt when Items was replaced or resized
+// behind its back; builder edits, which may rewrite Items in place, drop it.
+type roomItemIndex struct {
+	base   *Item
+	length int
+	counts map[string]int
+}
+
+func (x *roomItemIndex) matches(items []Item) bool {
+	if x.counts == nil || x.length != len(items) {
+		return false
+	}
+	return len(items) == 0 || x.base == &items[0]
+}
+
+func (x *roomItemIndex) track(items []Item) {
+	x.length = len(items)
+	x.base = nil
+	if len(items) > 0 {
+		x.base = &items[0]
+	}
+}
+
+func (x *roomItemIndex) rebuild(items []Item) {
+	x.counts = make(map[string]int, len(items))
+	for i := range items {
+		x.counts[strings.ToLower(items[i].Name)]++
+	}
+	x.track(items)
+}
+
+// itemCount returns how many of the room's items are called name, ignoring
+// case.
+func (r *Room) itemCount(name string) int {
+	if !r.itemIndex.matches(r.Items) {
+		r.itemIndex.rebuild(r.Items)
+	}
+	return r.itemIndex.counts[strings.ToLower(name)]
+}
+
+// addItems puts items on the room's floor.
+func (r *Room) addItems(items ...Item) {
+	indexed := r.itemIndex.matches(r.Items)
+	r.Items = append(r.Items, items...)
+	if indexed {
+		for i := range items {
+			r.itemIndex.counts[strings.ToLower(items[i].Name)]++
+		}
+		r.itemIndex.track(r.Items)
+	}
+}
+
+// removeItemAt takes the item at index i off the room's floor.
+func (r *Room) removeItemAt(i int) Item {
+	indexed := r.itemIndex.matches(r.Items)
+	item := r.Items[i]
+	r.Items = append(r.Items[:i], r.Items[i+1:]...)
+	if indexed {
+		r.itemIndex.counts[strings.ToLower(item.Name)]--
+		r.itemIndex.track(r.Items)
+	}
+	return item
+}
+
+// repopulateRoom brings the room back up to its resets: missing NPCs are
+// spawned fresh and item counts are topped up. Unlike a builder's reset it
+// leaves NPCs and items that are still present alone. Callers must hold the
+// room's shard lock.
+func repopulateRoom(room *Room) {
+	for i := range room.Resets {
+		reset := &room.Resets[i]
+		switch reset.Kind {
+		case ResetKindNPC:
+			if findNPCIndex(room.NPCs, reset.Name) >= 0 {
+				continue
+			}
+			npc := NPC{Name: reset.Name, AutoGreet: reset.AutoGreet, Script: reset.Script}
+			normalizeNPC(&npc)
+			room.NPCs = append(room.NPCs, npc)
+		case ResetKindItem:
+			for existing := room.itemCount(reset.Name); existing < max(reset.Count, 1); existing++ {
+				room.addItems(Item{Name: reset.Name, Description: reset.Description})
+			}
+		}
+	}
+}
+
+// resetInterval returns the area's reset interval, which decodeAreaFile has
+// already validated.
+func (f *areaFile) resetInterval() time.Duration {
+	d, _ := time.ParseDuration(strings.TrimSpace(f.ResetInterval))
+	return d
+}
+
+// areaResetScheduler keeps track of when each area is next due to reset
+// and which rooms are waiting to be repopulated.
+type areaResetScheduler struct {
+	mu sync.Mutex
+	// fallback is the interval for areas that do not set their own.
+	fallback time.Duration
+	due      map[string]time.Time
+	queue    []RoomID
+	queued   map[RoomID]bool
+}
+
+// ConfigureAreaResets sets the reset interval for areas whose files do not
+// set reset_interval. Zero leaves those areas alone.
+func (w *World) ConfigureAreaResets(fallback time.Duration) {
+	s := w.areaResets()
+	s.mu.Lock()
+	s.fallback = fallback
+	s.mu.Unlock()
+}
+
+func (w *World) areaResets() *areaResetScheduler {
+	w.resetMu.Lock()
+	defer w.resetMu.Unlock()
+	if w.resets == nil {
+		w.resets = &areaResetScheduler{
+			due:    make(map[string]time.Time),
+			queued: make(map[RoomID]bool),
+		}
+	}
+	return w.resets
+}
+
+// RunAreaResets repopulates areas on their reset intervals until stop is
+// closed.
+func (w *World) RunAreaResets(stop <-chan struct{}) {
+	ticker := time.NewTicker(areaResetTick)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-stop:
+			return
+		case now := <-ticker.C:
+			w.queueDueAreaResets(now)
+			w.runAreaResetBatch(areaResetBatch)
+		}
+	}
+}
+
+// queueDueAreaResets queues the rooms of every area whose reset is due. An
+// area's first reset comes one interval after it is first seen.
+func (w *World) queueDueAreaResets(now time.Time) {
+	s := w.areaResets()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	var dueAreas map[string]bool
+	for name, meta := range w.areaMeta {
+		interval := meta.ResetInterval
+		if interval <= 0 {
+			interval = s.fallback
+		}
+		if interval <= 0 {
+			delete(s.due, name)
+			continue
+		}
+		next, ok := s.due[name]
+		if !ok || next.Sub(now) > interval {
+			s.due[name] = now.Add(interval)
+			continue
+		}
+		if now.Before(next) {
+			continue
+		}
+		s.due[name] = now.Add(interval)
+		if dueAreas == nil {
+			dueAreas = make(map[string]bool)
+		}
+		dueAreas[name] = true
+	}
+	for name := range s.due {
+		if _, ok := w.areaMeta[name]; !ok {
+			delete(s.due, name)
+		}
+	}
+	if dueAreas != nil {
+		for id, source := range w.roomSources {
+			room := w.rooms[id]
+			if !dueAreas[source] || room == nil || len(room.Resets) == 0 || s.queued[id] {
+				continue
+			}
+			s.queued[id] = true
+			s.queue = append(s.queue, id)
+		}
+	}
+}
+
+// runAreaResetBatch repopulates up to limit queued rooms and reports how
+// many it handled. Rooms with a fight in progress are skipped until the
+// area's next reset.
+func (w *World) runAreaResetBatch(limit int) int {
+	s := w.areaResets()
+	s.mu.Lock()
+	n := min(limit, len(s.queue))
+	batch := append([]RoomID(nil), s.queue[:n]...)
+	s.queue = s.queue[n:]
+	if len(s.queue) == 0 {
+		s.queue = nil
+	}
+	for _, id := range batch {
+		delete(s.queued, id)
+	}
+	s.mu.Unlock()
+
+	for _, id := range batch {
+		w.resetRoom(id)
+	}
+	return len(batch)
+}
+
+func (w *World) resetRoom(id RoomID) {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	room, ok := w.rooms[id]
+	if !ok || room == nil {
+		return
+	}
+	if _, fighting := w.combats[id]; fighting {
+		return
+	}
+	lock := w.roomLock(id)
+	lock.Lock()
+	repopulateRoom(room)
+	lock.Unlock()
+}
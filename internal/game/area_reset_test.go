@@ -0,0 +1,118 @@
+package game
+
+import (
+	"fmt"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestRoomItemIndexFollowsItemMoves(t *testing.T) {
+	room := &Room{Items: []Item{{Name: "Lantern"}, {Name: "lantern"}, {Name: "Rope"}}}
+	if got := room.itemCount("LANTERN"); got != 2 {
+		t.Fatalf("itemCount(LANTERN) = %d, want 2", got)
+	}
+	room.addItems(Item{Name: "Lantern"}, Item{Name: "Map"})
+	if taken := room.removeItemAt(2); taken.Name != "Rope" {
+		t.Fatalf("removed %q, want Rope", taken.Name)
+	}
+	if got := room.itemCount("lantern"); got != 3 {
+		t.Fatalf("itemCount after moves = %d, want 3", got)
+	}
+	if got := room.itemCount("rope"); got != 0 {
+		t.Fatalf("itemCount(rope) = %d, want 0", got)
+	}
+
+	// Code that replaces the slice outright is noticed and recounted.
+	room.Items = []Item{{Name: "Rope"}}
+	if got := room.itemCount("lantern"); got != 0 {
+		t.Fatalf("itemCount after replacement = %d, want 0", got)
+	}
+	room.Items = append(room.Items, Item{Name: "Map"})
+	if got := room.itemCount("map"); got != 1 {
+		t.Fatalf("itemCount(map) after an untracked append = %d, want 1", got)
+	}
+}
+
+func TestBuilderEditsDropRoomItemIndex(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom, Items: []Item{{Name: "Rope"}}}})
+	room := world.rooms[StartRoom]
+	if got := room.itemCount("rope"); got != 1 {
+		t.Fatalf("itemCount(rope) = %d, want 1", got)
+	}
+	// Builders may rewrite Items in place, keeping its length.
+	room.Items[0] = Item{Name: "Map"}
+	world.mu.Lock()
+	world.markRoomAsBuilderLocked(StartRoom)
+	world.mu.Unlock()
+	if got := room.itemCount("rope"); got != 0 {
+		t.Fatalf("itemCount(rope) after a builder edit = %d, want 0", got)
+	}
+}
+
+func TestAreaResetsRepopulateInBatches(t *testing.T) {
+	rooms := map[RoomID]*Room{StartRoom: {ID: StartRoom}}
+	for i := 0; i < 10; i++ {
+		id := RoomID(fmt.Sprintf("cave%d", i))
+		rooms[id] = &Room{ID: id, Resets: []RoomReset{
+			{Kind: ResetKindItem, Name: "Glowstone", Count: 2},
+			{Kind: ResetKindNPC, Name: "Bat"},
+		}}
+	}
+	world := NewWorldWithRooms(rooms)
+	world.areaMeta["caves.json"] = areaMetadata{Name: "Caves", ResetInterval: time.Minute}
+	for id := range rooms {
+		if id != StartRoom {
+			world.roomSources[id] = "caves.json"
+		}
+	}
+	// A bat already hurt by a player is left alone, and one stone is
+	// still on the floor.
+	rooms["cave0"].NPCs = []NPC{{Name: "Bat", Health: 3, MaxHealth: 10}}
+	rooms["cave0"].Items = []Item{{Name: "glowstone"}, {Name: "Pebble"}}
+
+	start := time.Now()
+	world.queueDueAreaResets(start)
+	if n := world.runAreaResetBatch(areaResetBatch); n != 0 {
+		t.Fatalf("reset %d rooms before the first interval passed", n)
+	}
+	world.queueDueAreaResets(start.Add(time.Minute))
+	world.queueDueAreaResets(start.Add(time.Minute))
+	if n := world.runAreaResetBatch(8); n != 8 {
+		t.Fatalf("first batch reset %d rooms, want 8", n)
+	}
+	if n := world.runAreaResetBatch(8); n != 2 {
+		t.Fatalf("second batch reset %d rooms, want the remaining 2", n)
+	}
+
+	for id, room := range rooms {
+		if id == StartRoom {
+			continue
+		}
+		if got := room.itemCount("glowstone"); got != 2 {
+			t.Fatalf("%s has %d glowstones, want 2", id, got)
+		}
+		if len(room.NPCs) != 1 || room.NPCs[0].Name != "Bat" {
+			t.Fatalf("%s NPCs = %+v, want one bat", id, room.NPCs)
+		}
+	}
+	if bat := rooms["cave0"].NPCs[0]; bat.Health != 3 {
+		t.Fatalf("the hurt bat was replaced (health %d)", bat.Health)
+	}
+	if len(rooms["cave0"].Items) != 3 {
+		t.Fatalf("cave0 items = %+v, want the pebble and two stones", rooms["cave0"].Items)
+	}
+}
+
+func TestDecodeAreaFileRejectsBadResetInterval(t *testing.T) {
+	if _, _, err := decodeAreaFile("bad.json", strings.NewReader(`{"name":"Bad","reset_interval":"soon","rooms":[]}`)); err == nil {
+		t.Fatalf("expected an invalid reset_interval to be rejected")
+	}
+	file, _, err := decodeAreaFile("ok.json", strings.NewReader(`{"name":"Ok","reset_interval":"90s","rooms":[]}`))
+	if err != nil {
+		t.Fatalf("decodeAreaFile: %v", err)
+	}
+	if got := file.resetInterval(); got != 90*time.Second {
+		t.Fatalf("resetInterval = %s, want 1m30s", got)
+	}
+}
@@ -61,7 +61,11 @@ func login(session *TelnetSession, accounts *AccountManager) (string, bool, erro
 					return "", false, err
 				}
 				password = Trim(password)
-				if accounts.Authenticate(username, password) {
+				ok, err := accounts.authenticate(username, password, loginQueueNotifier(session))
+				if err != nil {
+					return "", false, err
+				}
+				if ok {
 					_ = session.WriteString(Ansi(Style("\r\nWelcome back, "+username+"!", AnsiGreen)))
 					return username, accounts.IsAdmin(username), nil
 				}
@@ -82,7 +86,10 @@ func login(session *TelnetSession, accounts *AccountManager) (string, bool, erro
 				_ = session.WriteString(Ansi(Style("\r\n"+err.Error(), AnsiYellow)))
 				continue
 			}
-			if err := accounts.Register(username, password); err != nil {
+			if err := accounts.register(username, password, loginQueueNotifier(session)); err != nil {
+				if err == errLoginAbandoned {
+					return "", false, err
+				}
 				_ = session.WriteString(Ansi(Style("\r\n"+err.Error(), AnsiYellow)))
 				break
 			}
@@ -0,0 +1,192 @@
+package game
+
+import (
+	"fmt"
+	"path/filepath"
+	"strings"
+	"testing"
+	"time"
+
+	"golang.org/x/text/encoding/charmap"
+)
+
+// This file holds the benchmarks for the server's hot paths. Run them with
+// scripts/bench.sh to record results that benchstat can compare between
+// commits. Benchmarks for a single feature live next to its tests.
+
+var benchPlayerCounts = []int{10, 100, 1000}
+
+// benchWorld returns a world with n players spread over rooms of ten, each
+// with an output channel that the benchmark drains.
+func benchWorld(n int) (*World, []*Player) {
+	rooms := make(map[RoomID]*Room, n/10+1)
+	for i := 0; i <= n/10; i++ {
+		id := RoomID(fmt.Sprintf("room%d", i))
+		rooms[id] = &Room{ID: id, Title: "Bench Room", Exits: map[string]RoomID{}}
+	}
+	world := NewWorldWithRooms(rooms)
+	players := make([]*Player, n)
+	for i := range players {
+		players[i] = &Player{
+			Name:  fmt.Sprintf("Player%d", i),
+			Room:  RoomID(fmt.Sprintf("room%d", i/10)),
+			Alive: true,
+		}
+		world.AddPlayerForTest(players[i])
+	}
+	return world, players
+}
+
+func drainBenchOutput(players []*Player) {
+	for _, p := range players {
+		p.TakeOutputForTest()
+	}
+}
+
+func BenchmarkBroadcastToRoom(b *testing.B) {
+	for _, n := range benchPlayerCounts {
+		world, players := benchWorld(n)
+		room := players[0].Room
+		b.Run(fmt.Sprintf("players=%d", n), func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				world.BroadcastToRoom(room, "Player0 says, \"hello\"", players[0])
+				drainBenchOutput(players[:10])
+			}
+		})
+	}
+}
+
+func BenchmarkBroadcastToAllChannel(b *testing.B) {
+	for _, n := range benchPlayerCounts {
+		world, players := benchWorld(n)
+		b.Run(fmt.Sprintf("players=%d", n), func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				world.BroadcastToAllChannel("[OOC] Player0: hello", players[0], ChannelOOC)
+				drainBenchOutput(players)
+			}
+		})
+	}
+}
+
+var benchOutput = Ansi(Style("\r\nAtrium of Echoes\r\n", AnsiBold, AnsiCyan)) +
+	"Light pools like molten glass along the floor mosaics.\nExits: north south\n" +
+	Ansi(Style("[L01 HP 50/50 MP 0/0] > ", AnsiBold, AnsiYellow))
+
+func BenchmarkTranslateForTelnet(b *testing.B) {
+	data := []byte(benchOutput)
+	b.ReportAllocs()
+	b.SetBytes(int64(len(data)))
+	for i := 0; i < b.N; i++ {
+		translateForTelnet(data)
+	}
+}
+
+func BenchmarkEncodeWithCharmap(b *testing.B) {
+	data := []byte(benchOutput + " café")
+	b.ReportAllocs()
+	b.SetBytes(int64(len(data)))
+	for i := 0; i < b.N; i++ {
+		encodeWithCharmap(charmap.ISO8859_1, data)
+	}
+}
+
+func BenchmarkUniqueMatch(b *testing.B) {
+	names := make([]string, 50)
+	for i := range names {
+		names[i] = fmt.Sprintf("Worn Item %d", i)
+	}
+	names[25] = "Rusty Lantern"
+	for _, bench := range []struct {
+		name, target string
+		words        bool
+	}{
+		{"exact", "rusty lantern", false},
+		{"prefix", "rus", false},
+		{"word", "lant", true},
+		{"miss", "sword", true},
+	} {
+		b.Run(bench.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				uniqueMatch(bench.target, names, bench.words)
+			}
+		})
+	}
+}
+
+func BenchmarkWrapText(b *testing.B) {
+	text := strings.Repeat("Light pools like molten glass along the floor mosaics. ", 8)
+	for _, width := range []int{40, 80} {
+		b.Run(fmt.Sprintf("width=%d", width), func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				WrapText(text, width)
+			}
+		})
+	}
+}
+
+func BenchmarkPrompt(b *testing.B) {
+	p := &Player{Name: "Bench", Level: 3, Health: 40, MaxHealth: 50, Mana: 10, MaxMana: 25}
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		Prompt(p)
+	}
+}
+
+func BenchmarkPersistBuilderRooms(b *testing.B) {
+	world := NewWorldWithRooms(map[RoomID]*Room{
+		StartRoom: {ID: StartRoom, Title: "Start", Description: "A bench room.", Exits: map[string]RoomID{"north": "hall"}},
+		"hall":    {ID: "hall", Title: "Hall", Exits: map[string]RoomID{"south": StartRoom}},
+	})
+	world.builderPath = filepath.Join(b.TempDir(), builderAreaFile)
+	world.mu.Lock()
+	world.builderStoreLocked().delay = time.Hour
+	world.mu.Unlock()
+	b.Cleanup(func() { _ = world.Close() })
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		world.mu.Lock()
+		err := world.persistBuilderRoomsLocked(StartRoom, "hall")
+		world.mu.Unlock()
+		if err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkRecordLogin(b *testing.B) {
+	manager, err := NewAccountManager(filepath.Join(b.TempDir(), "accounts.json"))
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Cleanup(func() { _ = manager.Close() })
+	if err := manager.Register("bench", "secret"); err != nil {
+		b.Fatal(err)
+	}
+	now := time.Now()
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := manager.RecordLogin("bench", now); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkScriptFor(b *testing.B) {
+	const source = "package main\n\nfunc OnHear(ctx any) {}\n"
+	engine := newScriptEngine()
+	if _, err := engine.scriptFor(source); err != nil {
+		b.Skipf("script compiler unavailable: %v", err)
+	}
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := engine.scriptFor(source); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
@@ -0,0 +1,447 @@
+package game
+
+import (
+	"encoding/json"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+)
+
+// builderFlushDelay is how long the builder store waits after the first
+// unsaved edit before writing, so a burst of edits reaches the disk as one
+// flush. The window is not extended by later edits, which bounds how long a
+// change can stay unsaved while a builder keeps typing.
+const builderFlushDelay = 500 * time.Millisecond
+
+// Builder journal ops. A room record holds the full state of a room after an
+// edit, and an unlink record names exits removed from a room already in the
+// builder area.
+const (
+	builderOpRoom   = "room"
+	builderOpUnlink = "unlink"
+)
+
+// builderJournalEntry is one record in the builder journal.
+type builderJournalEntry struct {
+	Seq   uint64   `json:"seq"`
+	Op    string   `json:"op"`
+	Room  *Room    `json:"room,omitempty"`
+	ID    RoomID   `json:"id,omitempty"`
+	Exits []string `json:"exits,omitempty"`
+}
+
+// builderEdit is one queued change to a builder room. room always holds the
+// room's state after the edit, and unlinked lists the exits removed since the
+// room was last written.
+type builderEdit struct {
+	room     Room
+	unlinked []string
+}
+
+// then folds a newer edit of the same room into e. Unlinks only stay small
+// while every edit since the last write was an unlink.
+func (e builderEdit) then(next builderEdit) builderEdit {
+	switch {
+	case next.unlinked == nil:
+		return next
+	case e.unlinked == nil:
+		return builderEdit{room: next.room}
+	}
+	next.unlinked = append(append([]string(nil), e.unlinked...), next.unlinked...)
+	return next
+}
+
+// builderStore persists rooms created or modified in-game. Edits hand it a
+// copy of each touched room while the world lock is held; a debounced flush
+// later appends those edits to builder.json.journal without any world lock,
+// and the builder.json snapshot is only rewritten when the journal is due for
+// compaction.
+type builderStore struct {
+	path  string
+	delay time.Duration
+
+	mu       sync.Mutex
+	pending  map[RoomID]builderEdit
+	meta     areaMetadata
+	timer    *time.Timer
+	dirReady bool
+	closed   bool
+
+	// flushMu serialises flushes and guards journal and rooms, the last
+	// persisted copy of every builder room used to write snapshots.
+	flushMu sync.Mutex
+	journal *journal
+	rooms   map[RoomID]Room
+}
+
+func newBuilderStore(path string, meta areaMetadata) *builderStore {
+	journal := newJournal(path, DefaultJournalConfig())
+	journal.seq = meta.JournalSeq
+	return &builderStore{
+		path:    path,
+		delay:   builderFlushDelay,
+		meta:    meta,
+		journal: journal,
+		rooms:   make(map[RoomID]Room),
+	}
+}
+
+// openBuilderStore replays the builder journal over the loaded rooms, marking
+// any room it touches as a builder room, and returns a store seeded with every
+// builder room.
+func openBuilderStore(path string, meta areaMetadata, rooms map[RoomID]*Room, sources map[RoomID]string) (*builderStore, error) {
+	store := newBuilderStore(path, meta)
+	err := store.journal.replay(meta.JournalSeq, func(line []byte) error {
+		var entry builderJournalEntry
+		if err := json.Unmarshal(line, &entry); err != nil {
+			return err
+		}
+		return applyBuilderEntry(entry, rooms, sources)
+	})
+	if err != nil {
+		return nil, fmt.Errorf("replay builder journal: %w", err)
+	}
+	store.seed(rooms, sources)
+	return store, nil
+}
+
+// applyBuilderEntry replays one journal record over the loaded rooms.
+func applyBuilderEntry(entry builderJournalEntry, rooms map[RoomID]*Room, sources map[RoomID]string) error {
+	switch entry.Op {
+	case builderOpRoom:
+		if entry.Room == nil || entry.Room.ID == "" {
+			return fmt.Errorf("builder journal room without an id")
+		}
+		room := *entry.Room
+		if room.Exits == nil {
+			room.Exits = make(map[string]RoomID)
+		}
+		for i := range room.NPCs {
+			normalizeNPC(&room.NPCs[i])
+		}
+		rooms[room.ID] = &room
+		sources[room.ID] = builderAreaFile
+	case builderOpUnlink:
+		room, ok := rooms[entry.ID]
+		if !ok {
+			return fmt.Errorf("builder journal unlinks unknown room %q", entry.ID)
+		}
+		for _, dir := range entry.Exits {
+			delete(room.Exits, dir)
+		}
+		sources[entry.ID] = builderAreaFile
+	default:
+		return fmt.Errorf("unknown builder journal op %q", entry.Op)
+	}
+	return nil
+}
+
+// seed records the current state of every builder room as already persisted.
+func (s *builderStore) seed(rooms map[RoomID]*Room, sources map[RoomID]string) {
+	for id, source := range sources {
+		if source != builderAreaFile {
+			continue
+		}
+		if room, ok := rooms[id]; ok {
+			s.rooms[id] = cloneBuilderRoom(id, room)
+		}
+	}
+}
+
+func (s *builderStore) setJournalConfig(cfg JournalConfig) {
+	s.flushMu.Lock()
+	s.journal.cfg = cfg.normalized()
+	s.flushMu.Unlock()
+}
+
+// queue records edits for the next flush. Only the first call touches the
+// disk, to make sure the area directory can be created, so edits that can
+// never be saved are still rejected while they can be rolled back.
+func (s *builderStore) queue(edits []builderEdit, meta areaMetadata) error {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if s.closed {
+		return fmt.Errorf("builder area is closed")
+	}
+	if !s.dirReady {
+		if err := os.MkdirAll(filepath.Dir(s.path), 0o755); err != nil {
+			return fmt.Errorf("create builder area directory: %w", err)
+		}
+		s.dirReady = true
+	}
+	if s.pending == nil {
+		s.pending = make(map[RoomID]builderEdit)
+	}
+	for _, edit := range edits {
+		if prev, ok := s.pending[edit.room.ID]; ok {
+			edit = prev.then(edit)
+		}
+		s.pending[edit.room.ID] = edit
+	}
+	s.meta = meta
+	s.scheduleLocked()
+	return nil
+}
+
+func (s *builderStore) scheduleLocked() {
+	if s.timer != nil || s.closed {
+		return
+	}
+	s.timer = time.AfterFunc(s.delay, func() {
+		s.mu.Lock()
+		s.timer = nil
+		s.mu.Unlock()
+		if err := s.Flush(); err != nil {
+			fmt.Printf("failed to save builder rooms: %v\n", err)
+		}
+	})
+}
+
+// Flush writes every queued edit to the journal, compacting it into the
+// snapshot when it has grown past the configured threshold. Edits that could
+// not be written stay queued and are retried by the next flush.
+func (s *builderStore) Flush() error {
+	s.flushMu.Lock()
+	defer s.flushMu.Unlock()
+	s.mu.Lock()
+	pending := s.pending
+	s.pending = nil
+	meta := s.meta
+	s.mu.Unlock()
+	if len(pending) == 0 {
+		return nil
+	}
+	defer observeFlush("builder", time.Now())
+
+	ids := make([]RoomID, 0, len(pending))
+	for id := range pending {
+		ids = append(ids, id)
+	}
+	sort.Slice(ids, func(i, j int) bool { return ids[i] < ids[j] })
+	for i, id := range ids {
+		edit := pending[id]
+		if err := s.journal.append(s.entryFor(id, edit)); err != nil {
+			s.requeue(pending, ids[i:])
+			return fmt.Errorf("write builder area: %w", err)
+		}
+		s.rooms[id] = edit.room
+	}
+	if s.journal.needsCompaction() {
+		return s.saveSnapshotLocked(meta)
+	}
+	return nil
+}
+
+// entryFor builds the journal record for edit. An unlink is only written as
+// such when the room it applies to has already been persisted.
+func (s *builderStore) entryFor(id RoomID, edit builderEdit) builderJournalEntry {
+	entry := builderJournalEntry{Seq: s.journal.nextSeq()}
+	_, persisted := s.rooms[id]
+	switch {
+	case edit.unlinked != nil && persisted:
+		entry.Op, entry.ID, entry.Exits = builderOpUnlink, id, edit.unlinked
+	default:
+		room := edit.room
+		entry.Op, entry.Room = builderOpRoom, &room
+	}
+	return entry
+}
+
+// requeue puts unwritten edits back, in front of any newer edit of the same
+// room that was queued meanwhile.
+func (s *builderStore) requeue(pending map[RoomID]builderEdit, ids []RoomID) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if s.pending == nil {
+		s.pending = make(map[RoomID]builderEdit, len(ids))
+	}
+	for _, id := range ids {
+		edit := pending[id]
+		if newer, ok := s.pending[id]; ok {
+			edit = edit.then(newer)
+		}
+		s.pending[id] = edit
+	}
+	s.scheduleLocked()
+}
+
+func (s *builderStore) saveSnapshotLocked(meta areaMetadata) error {
+	rooms := make([]Room, 0, len(s.rooms))
+	for _, room := range s.rooms {
+		rooms = append(rooms, room)
+	}
+	sort.Slice(rooms, func(i, j int) bool {
+		return rooms[i].ID < rooms[j].ID
+	})
+	file := areaFile{Name: meta.Name, Script: meta.Script, Rooms: rooms, JournalSeq: s.journal.seq}
+	if meta.ResetInterval > 0 {
+		file.ResetInterval = meta.ResetInterval.String()
+	}
+	dir := filepath.Dir(s.path)
+	tmp, err := os.CreateTemp(dir, "builder-*.tmp")
+	if err != nil {
+		return fmt.Errorf("create temp builder area file: %w", err)
+	}
+	enc := json.NewEncoder(tmp)
+	enc.SetIndent("", "  ")
+	if err := enc.Encode(file); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return fmt.Errorf("write builder area: %w", err)
+	}
+	if err := syncFile(tmp); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmp.Name())
+		return fmt.Errorf("close builder area: %w", err)
+	}
+	if err := os.Rename(tmp.Name(), s.path); err != nil {
+		os.Remove(tmp.Name())
+		return fmt.Errorf("replace builder area: %w", err)
+	}
+	if err := s.journal.truncate(); err != nil {
+		fmt.Printf("failed to truncate builder journal: %v\n", err)
+	}
+	return nil
+}
+
+// Close flushes queued edits and stops accepting new ones.
+func (s *builderStore) Close() error {
+	s.mu.Lock()
+	s.closed = true
+	if s.timer != nil {
+		s.timer.Stop()
+		s.timer = nil
+	}
+	s.mu.Unlock()
+	err := s.Flush()
+	s.flushMu.Lock()
+	if closeErr := s.journal.close(); err == nil {
+		err = closeErr
+	}
+	s.flushMu.Unlock()
+	return err
+}
+
+// cloneBuilderRoom copies a room deeply enough that later edits to the live
+// room cannot change what the store writes.
+func cloneBuilderRoom(id RoomID, room *Room) Room {
+	copyRoom := *room
+	copyRoom.ID = id
+	copyRoom.itemIndex = roomItemIndex{}
+	if room.Exits == nil {
+		copyRoom.Exits = make(map[string]RoomID)
+	} else {
+		copyRoom.Exits = cloneExits(room.Exits)
+	}
+	if room.NPCs != nil {
+		copyRoom.NPCs = append([]NPC(nil), room.NPCs...)
+	}
+	if room.Items != nil {
+		copyRoom.Items = append([]Item(nil), room.Items...)
+	}
+	if room.Resets != nil {
+		copyRoom.Resets = append([]RoomReset(nil), room.Resets...)
+	}
+	return copyRoom
+}
+
+// builderAreaMetaLocked returns the builder area's name and script, filling in
+// the default name the first time the area is written.
+func (w *World) builderAreaMetaLocked() areaMetadata {
+	meta := areaMetadata{Name: "Builder Rooms"}
+	if w.areaMeta != nil {
+		if existing, ok := w.areaMeta[builderAreaFile]; ok {
+			if strings.TrimSpace(existing.Name) != "" {
+				meta.Name = existing.Name
+			}
+			meta.Script = existing.Script
+			meta.ResetInterval = existing.ResetInterval
+			meta.JournalSeq = existing.JournalSeq
+		}
+	} else {
+		w.areaMeta = make(map[string]areaMetadata)
+	}
+	w.areaMeta[builderAreaFile] = meta
+	return meta
+}
+
+// builderStoreLocked returns the world's builder store, creating one for
+// worlds that were assembled without NewWorld. Such worlds already hold their
+// rooms, so the journal is not replayed over them.
+func (w *World) builderStoreLocked() *builderStore {
+	if w.builder == nil && w.builderPath != "" {
+		store := newBuilderStore(w.builderPath, w.builderAreaMetaLocked())
+		store.seed(w.rooms, w.roomSources)
+		w.builder = store
+	}
+	return w.builder
+}
+
+// persistBuilderRoomsLocked queues the named rooms for the builder area. The
+// rooms are copied here and written later by the store's background flush.
+func (w *World) persistBuilderRoomsLocked(ids ...RoomID) error {
+	edits := make([]builderEdit, 0, len(ids))
+	for _, id := range ids {
+		room, ok := w.rooms[id]
+		if !ok {
+			continue
+		}
+		edits = append(edits, builderEdit{room: cloneBuilderRoom(id, room)})
+	}
+	return w.persistBuilderEditsLocked(edits)
+}
+
+// unlinkEditLocked describes the removal of directions from a room's exits.
+func (w *World) unlinkEditLocked(id RoomID, directions ...string) builderEdit {
+	return builderEdit{room: cloneBuilderRoom(id, w.rooms[id]), unlinked: directions}
+}
+
+func (w *World) persistBuilderEditsLocked(edits []builderEdit) error {
+	store := w.builderStoreLocked()
+	if store == nil {
+		return nil
+	}
+	return store.queue(edits, w.builderAreaMetaLocked())
+}
+
+// FlushBuilderRooms writes any builder edits still waiting for the debounce
+// window to pass.
+func (w *World) FlushBuilderRooms() error {
+	w.mu.RLock()
+	store := w.builder
+	w.mu.RUnlock()
+	if store == nil {
+		return nil
+	}
+	return store.Flush()
+}
+
+// Close flushes pending builder edits and closes the builder journal.
+func (w *World) Close() error {
+	w.mu.RLock()
+	store := w.builder
+	w.mu.RUnlock()
+	if store == nil {
+		return nil
+	}
+	return store.Close()
+}
+
+// SetJournalConfig applies the journal fsync and compaction settings to the
+// builder area.
+func (w *World) SetJournalConfig(cfg JournalConfig) {
+	w.mu.Lock()
+	store := w.builderStoreLocked()
+	w.mu.Unlock()
+	if store != nil {
+		store.setJournalConfig(cfg)
+	}
+}
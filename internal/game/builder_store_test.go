@@ -0,0 +1,175 @@
+package game
+
+import (
+	"bytes"
+	"encoding/json"
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+	"time"
+)
+
+func TestBuilderStoreDebouncesJournalsAndCompacts(t *testing.T) {
+	dir := t.TempDir()
+	stock := areaFile{Name: "Stock", Rooms: []Room{{ID: StartRoom, Title: "Start", Exits: map[string]RoomID{}}}}
+	data, err := json.Marshal(stock)
+	if err != nil {
+		t.Fatalf("Marshal: %v", err)
+	}
+	if err := os.WriteFile(filepath.Join(dir, "stock.json"), data, 0o644); err != nil {
+		t.Fatalf("WriteFile: %v", err)
+	}
+	world, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld: %v", err)
+	}
+	world.builder.delay = time.Hour
+	world.SetJournalConfig(JournalConfig{Sync: JournalSyncNever, CompactAfter: 3})
+
+	for _, desc := range []string{"one", "two", "three"} {
+		if _, err := world.UpdateRoomDescription(StartRoom, desc, "Builder"); err != nil {
+			t.Fatalf("UpdateRoomDescription: %v", err)
+		}
+	}
+	if _, err := world.CreateRoom("annex", "Annex", "Builder"); err != nil {
+		t.Fatalf("CreateRoom: %v", err)
+	}
+	snapshotPath := filepath.Join(dir, builderAreaFile)
+	journalPath := snapshotPath + ".journal"
+	if _, err := os.Stat(journalPath); !errors.Is(err, os.ErrNotExist) {
+		t.Fatalf("expected edits to wait for the debounce window, stat err %v", err)
+	}
+
+	if err := world.FlushBuilderRooms(); err != nil {
+		t.Fatalf("FlushBuilderRooms: %v", err)
+	}
+	journalData, err := os.ReadFile(journalPath)
+	if err != nil {
+		t.Fatalf("ReadFile journal: %v", err)
+	}
+	if lines := bytes.Count(journalData, []byte("\n")); lines != 2 {
+		t.Fatalf("expected one journal record per edited room, got %d", lines)
+	}
+	if _, err := os.Stat(snapshotPath); !errors.Is(err, os.ErrNotExist) {
+		t.Fatalf("expected no snapshot before compaction, stat err %v", err)
+	}
+
+	if err := world.SetExit("annex", "south", StartRoom); err != nil {
+		t.Fatalf("SetExit: %v", err)
+	}
+	if err := world.FlushBuilderRooms(); err != nil {
+		t.Fatalf("FlushBuilderRooms: %v", err)
+	}
+	if _, err := os.Stat(journalPath); !errors.Is(err, os.ErrNotExist) {
+		t.Fatalf("expected compaction to remove the journal, stat err %v", err)
+	}
+	snapshotData, err := os.ReadFile(snapshotPath)
+	if err != nil {
+		t.Fatalf("ReadFile snapshot: %v", err)
+	}
+	var snapshot areaFile
+	if err := json.Unmarshal(snapshotData, &snapshot); err != nil {
+		t.Fatalf("Unmarshal snapshot: %v", err)
+	}
+	if snapshot.JournalSeq != 3 || len(snapshot.Rooms) != 2 {
+		t.Fatalf("unexpected snapshot: seq %d, %d rooms", snapshot.JournalSeq, len(snapshot.Rooms))
+	}
+
+	if _, err := world.UpdateRoomDescription(StartRoom, "four", "Builder"); err != nil {
+		t.Fatalf("UpdateRoomDescription: %v", err)
+	}
+	if err := world.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	reloaded, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld reload: %v", err)
+	}
+	defer reloaded.Close()
+	room, ok := reloaded.GetRoom(StartRoom)
+	if !ok || room.Description != "four" {
+		t.Fatalf("expected journaled description to replay, got %+v", room)
+	}
+	annex, ok := reloaded.GetRoom("annex")
+	if !ok || annex.Exits["south"] != StartRoom {
+		t.Fatalf("expected annex from snapshot, got %+v", annex)
+	}
+	if got := reloaded.roomSources[StartRoom]; got != builderAreaFile {
+		t.Fatalf("expected replayed room to belong to the builder area, got %q", got)
+	}
+}
+
+func TestBuilderJournalReplaysUnlinks(t *testing.T) {
+	dir := t.TempDir()
+	stock := areaFile{Name: "Stock", Rooms: []Room{{ID: StartRoom, Title: "Start", Exits: map[string]RoomID{}}}}
+	data, err := json.Marshal(stock)
+	if err != nil {
+		t.Fatalf("Marshal: %v", err)
+	}
+	if err := os.WriteFile(filepath.Join(dir, "stock.json"), data, 0o644); err != nil {
+		t.Fatalf("WriteFile: %v", err)
+	}
+	world, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld: %v", err)
+	}
+	world.builder.delay = time.Hour
+	world.SetJournalConfig(JournalConfig{Sync: JournalSyncNever})
+
+	for _, id := range []RoomID{"annex", "shed"} {
+		if _, err := world.CreateRoom(id, string(id), "Builder"); err != nil {
+			t.Fatalf("CreateRoom(%s): %v", id, err)
+		}
+	}
+	if err := world.LinkRooms(StartRoom, "east", "annex", "west"); err != nil {
+		t.Fatalf("LinkRooms: %v", err)
+	}
+	if err := world.LinkRooms("annex", "north", "shed", "south"); err != nil {
+		t.Fatalf("LinkRooms: %v", err)
+	}
+	if err := world.FlushBuilderRooms(); err != nil {
+		t.Fatalf("FlushBuilderRooms: %v", err)
+	}
+
+	for _, dir := range []string{"west", "north"} {
+		if err := world.ClearExit("annex", dir); err != nil {
+			t.Fatalf("ClearExit(%s): %v", dir, err)
+		}
+	}
+	if err := world.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	journalData, err := os.ReadFile(filepath.Join(dir, builderAreaFile) + ".journal")
+	if err != nil {
+		t.Fatalf("ReadFile journal: %v", err)
+	}
+	lines := bytes.Split(bytes.TrimSpace(journalData), []byte("\n"))
+	var last builderJournalEntry
+	if err := json.Unmarshal(lines[len(lines)-1], &last); err != nil {
+		t.Fatalf("Unmarshal journal line: %v", err)
+	}
+	if last.Op != builderOpUnlink || last.ID != "annex" || last.Room != nil || !reflect.DeepEqual(last.Exits, []string{"west", "north"}) {
+		t.Fatalf("expected both exits in one unlink record, got %s", lines[len(lines)-1])
+	}
+
+	reloaded, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld reload: %v", err)
+	}
+	defer reloaded.Close()
+	if shed, ok := reloaded.GetRoom("shed"); !ok || shed.Exits["south"] != "annex" {
+		t.Fatalf("expected shed to keep its exit, got %+v", shed)
+	}
+	annex, ok := reloaded.GetRoom("annex")
+	if !ok || len(annex.Exits) != 0 {
+		t.Fatalf("expected annex without exits after replay, got %+v", annex)
+	}
+	start, ok := reloaded.GetRoom(StartRoom)
+	if !ok || start.Exits["east"] != "annex" {
+		t.Fatalf("expected the start room to keep its exit, got %+v", start)
+	}
+}
@@ -0,0 +1,375 @@
+package game
+
+import (
+	"fmt"
+	"os"
+	"slices"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+)
+
+const (
+	// busFlushInterval is the longest a message waits before its batch is
+	// published.
+	busFlushInterval = 25 * time.Millisecond
+	// busBatchSize publishes a batch early once this many messages wait.
+	busBatchSize = 128
+	// busPresenceInterval is how often a node checks whether its player
+	// list changed and announces it if so.
+	busPresenceInterval = 2 * time.Second
+	// busPresenceRefresh is the longest a node goes without announcing its
+	// players, changed or not.
+	busPresenceRefresh = 10 * time.Second
+	// busPresenceExpiry forgets a node's players when it has not been heard
+	// from for this long.
+	busPresenceExpiry = 30 * time.Second
+)
+
+// BusKind says what a bus message carries.
+type BusKind string
+
+const (
+	// BusChannel is a message on a global channel such as ooc or yell.
+	BusChannel BusKind = "channel"
+	// BusTell is a private message for a player on another node.
+	BusTell BusKind = "tell"
+	// BusPresence lists the players logged in on the sending node.
+	BusPresence BusKind = "presence"
+	// BusMail is a post that every node adds to its own mail boards.
+	BusMail BusKind = "mail"
+)
+
+// BusMessage is one message relayed between nodes.
+type BusMessage struct {
+	Kind BusKind `json:"kind"`
+	// Node names the node that sent the message.
+	Node string `json:"node"`
+	// Target names the node hosting a tell's recipient. Other nodes ignore
+	// the tell, so it is delivered or queued offline exactly once.
+	Target  string       `json:"target,omitempty"`
+	Channel Channel      `json:"channel,omitempty"`
+	From    string       `json:"from,omitempty"`
+	To      string       `json:"to,omitempty"`
+	Text    string       `json:"text,omitempty"`
+	Players []string     `json:"players,omitempty"`
+	Mail    *MailMessage `json:"mail,omitempty"`
+}
+
+// MessageBus carries batches of messages between the nodes of a cluster.
+// Publish hands a batch to every other node; Messages delivers the batches
+// other nodes publish. Implementations may drop batches for nodes they
+// cannot reach.
+type MessageBus interface {
+	Publish(batch []BusMessage) error
+	Messages() <-chan []BusMessage
+	Close() error
+}
+
+// ClusterConfig joins a server to other LumenClay nodes. Each node serves
+// its own players and world; global channels, tells, who lists and mail
+// are shared over the bus.
+type ClusterConfig struct {
+	// Node names this server to the others. It defaults to the host name.
+	Node string
+	// Listen is the address other nodes connect to.
+	Listen string
+	// Peers are the bus addresses of the other nodes.
+	Peers []string
+	// Secret must match on every node. A node that listens for peers
+	// refuses to start without one.
+	Secret string
+}
+
+// Enabled reports whether the configuration joins a cluster.
+func (c ClusterConfig) Enabled() bool {
+	return c.Listen != "" || len(c.Peers) > 0
+}
+
+func (c ClusterConfig) normalized() ClusterConfig {
+	c.Node = strings.TrimSpace(c.Node)
+	if c.Node == "" {
+		if host, err := os.Hostname(); err == nil {
+			c.Node = host
+		}
+	}
+	if c.Node == "" {
+		c.Node = "lumenclay"
+	}
+	return c
+}
+
+// busRelay batches outgoing messages and tracks the players on other
+// nodes.
+type busRelay struct {
+	node string
+	bus  MessageBus
+
+	mu      sync.Mutex
+	pending []BusMessage
+	full    chan struct{}
+
+	remoteMu sync.RWMutex
+	remote   map[string]remoteNode
+}
+
+// remoteNode is the last player list heard from another node.
+type remoteNode struct {
+	players []string
+	seen    time.Time
+}
+
+// AttachBus relays global channels, tells, who lists and mail over bus,
+// naming this node node. RunBus does the relaying.
+func (w *World) AttachBus(node string, bus MessageBus) {
+	w.mu.Lock()
+	w.bus = &busRelay{
+		node:   node,
+		bus:    bus,
+		full:   make(chan struct{}, 1),
+		remote: make(map[string]remoteNode),
+	}
+	w.mu.Unlock()
+}
+
+func (w *World) relay() *busRelay {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	return w.bus
+}
+
+// publishBus queues msg for the next batch. It does nothing without a bus.
+func (w *World) publishBus(msg BusMessage) {
+	relay := w.relay()
+	if relay == nil {
+		return
+	}
+	relay.mu.Lock()
+	msg.Node = relay.node
+	relay.pending = append(relay.pending, msg)
+	full := len(relay.pending) >= busBatchSize
+	relay.mu.Unlock()
+	if full {
+		select {
+		case relay.full <- struct{}{}:
+		default:
+		}
+	}
+}
+
+func (r *busRelay) flush() {
+	r.mu.Lock()
+	batch := r.pending
+	r.pending = nil
+	r.mu.Unlock()
+	if len(batch) == 0 {
+		return
+	}
+	if err := r.bus.Publish(batch); err != nil {
+		fmt.Printf("failed to publish %d bus messages: %v\n", len(batch), err)
+	}
+}
+
+// RunBus publishes batched messages, announces this node's players and
+// applies messages from other nodes until stop is closed.
+func (w *World) RunBus(stop <-chan struct{}) {
+	relay := w.relay()
+	if relay == nil {
+		return
+	}
+	flush := time.NewTicker(busFlushInterval)
+	defer flush.Stop()
+	presence := time.NewTicker(busPresenceInterval)
+	defer presence.Stop()
+	var announced []string
+	var announcedAt time.Time
+	announce := func(now time.Time) {
+		players := w.ListPlayers(false, "")
+		sort.Strings(players)
+		if slices.Equal(players, announced) && now.Sub(announcedAt) < busPresenceRefresh {
+			return
+		}
+		announced, announcedAt = players, now
+		w.publishBus(BusMessage{Kind: BusPresence, Players: players})
+	}
+	announce(time.Now())
+	for {
+		select {
+		case <-stop:
+			relay.flush()
+			return
+		case <-flush.C:
+			relay.flush()
+		case <-relay.full:
+			relay.flush()
+		case now := <-presence.C:
+			announce(now)
+			relay.expire(now)
+		case batch, ok := <-relay.bus.Messages():
+			if !ok {
+				return
+			}
+			for i := range batch {
+				w.applyBusMessage(relay, batch[i])
+			}
+		}
+	}
+}
+
+func (w *World) applyBusMessage(relay *busRelay, msg BusMessage) {
+	if msg.Node == relay.node {
+		return
+	}
+	// Other nodes are trusted to relay, not to draw on players' terminals.
+	from, to := relayedName(msg.From), relayedName(msg.To)
+	text := stripTerminalControls(msg.Text)
+	switch msg.Kind {
+	case BusChannel:
+		if !slices.Contains(allChannels, msg.Channel) || strings.TrimSpace(text) == "" {
+			return
+		}
+		w.broadcastToAllChannel(text, nil, msg.Channel)
+	case BusTell:
+		if msg.Target != relay.node || from == "" || to == "" || strings.TrimSpace(text) == "" {
+			return
+		}
+		w.deliverRemoteTell(from, to, text)
+	case BusPresence:
+		players := make([]string, 0, len(msg.Players))
+		for _, name := range msg.Players {
+			if name = relayedName(name); name != "" {
+				players = append(players, name)
+			}
+		}
+		relay.remoteMu.Lock()
+		relay.remote[relayedName(msg.Node)] = remoteNode{players: players, seen: time.Now()}
+		relay.remoteMu.Unlock()
+	case BusMail:
+		if msg.Mail == nil {
+			return
+		}
+		mail := w.MailSystem()
+		if mail == nil {
+			return
+		}
+		recipients := make([]string, 0, len(msg.Mail.Recipients))
+		for _, name := range msg.Mail.Recipients {
+			recipients = append(recipients, relayedName(name))
+		}
+		board, author, body := relayedName(msg.Mail.Board), relayedName(msg.Mail.Author), Trim(stripTerminalControls(msg.Mail.Body))
+		if _, err := mail.Write(board, author, recipients, body); err != nil {
+			fmt.Printf("failed to store mail relayed from %s: %v\n", relayedName(msg.Node), err)
+		}
+	}
+}
+
+// relayedName cleans a player, board or node name from another node.
+func relayedName(name string) string {
+	return Trim(stripTerminalControls(name))
+}
+
+func (r *busRelay) expire(now time.Time) {
+	r.remoteMu.Lock()
+	for node, seen := range r.remote {
+		if now.Sub(seen.seen) > busPresenceExpiry {
+			delete(r.remote, node)
+		}
+	}
+	r.remoteMu.Unlock()
+}
+
+// RemotePlayers returns the players logged in on other nodes, sorted and
+// without players also logged in here.
+func (w *World) RemotePlayers() []string {
+	relay := w.relay()
+	if relay == nil {
+		return nil
+	}
+	local := make(map[string]bool)
+	for _, name := range w.ListPlayers(false, "") {
+		local[name] = true
+	}
+	relay.remoteMu.RLock()
+	var names []string
+	for _, node := range relay.remote {
+		for _, name := range node.players {
+			if !local[name] {
+				local[name] = true
+				names = append(names, name)
+			}
+		}
+	}
+	relay.remoteMu.RUnlock()
+	sort.Strings(names)
+	return names
+}
+
+// nodeFor returns the node whose last player list includes name, or "".
+func (r *busRelay) nodeFor(name string) string {
+	r.remoteMu.RLock()
+	defer r.remoteMu.RUnlock()
+	nodes := make([]string, 0, len(r.remote))
+	for node, remote := range r.remote {
+		if slices.Contains(remote.players, name) {
+			nodes = append(nodes, node)
+		}
+	}
+	if len(nodes) == 0 {
+		return ""
+	}
+	sort.Strings(nodes)
+	return nodes[0]
+}
+
+// FindRemotePlayer matches name against the players on other nodes the way
+// FindPlayer matches local players.
+func (w *World) FindRemotePlayer(name string) (string, bool) {
+	names := w.RemotePlayers()
+	idx, ok := uniqueMatch(name, names, false)
+	if !ok {
+		return "", false
+	}
+	return names[idx], true
+}
+
+// SendRemoteTell relays a tell to the node hosting recipient. Only that node
+// shows the tell or queues it offline. It reports false when no node lists
+// the recipient any more.
+func (w *World) SendRemoteTell(sender *Player, recipient, message string) bool {
+	relay := w.relay()
+	if relay == nil {
+		return false
+	}
+	target := relay.nodeFor(recipient)
+	if target == "" {
+		return false
+	}
+	w.publishBus(BusMessage{Kind: BusTell, Target: target, From: sender.Name, To: recipient, Text: message})
+	return true
+}
+
+// deliverRemoteTell shows a tell from another node to its recipient, or
+// queues it if they have left.
+func (w *World) deliverRemoteTell(from, to, message string) {
+	w.mu.RLock()
+	target, ok := w.players[to]
+	tells := w.tells
+	w.mu.RUnlock()
+	if ok && target.Alive {
+		sendDirect(target, Ansi(fmt.Sprintf("\r\n%s tells you: %s", HighlightName(from), message)))
+		return
+	}
+	if tells == nil {
+		return
+	}
+	if _, err := tells.Queue(from, to, message, time.Now().UTC()); err != nil {
+		fmt.Printf("failed to queue tell relayed for %s: %v\n", to, err)
+	}
+}
+
+// RelayMail shares a new post with the other nodes. Each node stores it as
+// its own post with a locally assigned ID, so IDs differ between nodes.
+func (w *World) RelayMail(msg MailMessage) {
+	w.publishBus(BusMessage{Kind: BusMail, Mail: &msg})
+}
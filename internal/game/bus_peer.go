@@ -0,0 +1,291 @@
+package game
+
+import (
+	"bufio"
+	"crypto/subtle"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"net"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+const (
+	// peerQueueBatches is how many batches wait for one unreachable peer
+	// before new batches for it are dropped.
+	peerQueueBatches = 256
+	// peerWriteTimeout bounds one batch write to a peer.
+	peerWriteTimeout = 5 * time.Second
+	// peerRedialStart and peerRedialMax bound the wait between attempts to
+	// reach a peer.
+	peerRedialStart = 500 * time.Millisecond
+	peerRedialMax   = 30 * time.Second
+	// peerMaxLine is the largest batch a peer may send in one line.
+	peerMaxLine = 4 << 20
+)
+
+// peerHello is the first line on every bus connection.
+type peerHello struct {
+	Node   string `json:"node"`
+	Secret string `json:"secret,omitempty"`
+}
+
+// PeerBus is a MessageBus that connects nodes directly over TCP. Each node
+// listens for the others and dials every peer it is told about; batches are
+// written as one JSON line each.
+type PeerBus struct {
+	cfg      ClusterConfig
+	listener net.Listener
+	peers    []*busPeer
+	incoming chan []BusMessage
+	done     chan struct{}
+	closed   sync.Once
+	wg       sync.WaitGroup
+
+	connsMu sync.Mutex
+	conns   map[net.Conn]struct{}
+
+	// dropped counts batches discarded because a peer's queue was full.
+	dropped atomic.Uint64
+}
+
+type busPeer struct {
+	addr  string
+	queue chan []byte
+}
+
+// ListenPeerBus starts a bus for cfg: it listens on cfg.Listen, when set,
+// and dials each of cfg.Peers in the background.
+func ListenPeerBus(cfg ClusterConfig) (*PeerBus, error) {
+	cfg = cfg.normalized()
+	if cfg.Listen != "" && cfg.Secret == "" {
+		return nil, fmt.Errorf("a bus secret is required to listen for bus peers")
+	}
+	b := &PeerBus{
+		cfg:      cfg,
+		incoming: make(chan []BusMessage, peerQueueBatches),
+		done:     make(chan struct{}),
+		conns:    make(map[net.Conn]struct{}),
+	}
+	if cfg.Listen != "" {
+		ln, err := net.Listen("tcp", cfg.Listen)
+		if err != nil {
+			return nil, fmt.Errorf("listen for bus peers: %w", err)
+		}
+		b.listener = ln
+		b.wg.Add(1)
+		go b.accept()
+	}
+	for _, addr := range cfg.Peers {
+		peer := &busPeer{addr: addr, queue: make(chan []byte, peerQueueBatches)}
+		b.peers = append(b.peers, peer)
+		b.wg.Add(1)
+		go b.dial(peer)
+	}
+	return b, nil
+}
+
+// Addr returns the address the bus listens on, or nil if it does not.
+func (b *PeerBus) Addr() net.Addr {
+	if b.listener == nil {
+		return nil
+	}
+	return b.listener.Addr()
+}
+
+// Dropped reports how many batches were discarded for unreachable peers.
+func (b *PeerBus) Dropped() uint64 {
+	return b.dropped.Load()
+}
+
+// Publish queues batch for every peer. Peers whose queues are full miss it.
+func (b *PeerBus) Publish(batch []BusMessage) error {
+	line, err := json.Marshal(batch)
+	if err != nil {
+		return fmt.Errorf("encode bus batch: %w", err)
+	}
+	line = append(line, '\n')
+	for _, peer := range b.peers {
+		select {
+		case peer.queue <- line:
+		default:
+			b.dropped.Add(1)
+		}
+	}
+	return nil
+}
+
+// Messages delivers the batches published by other nodes.
+func (b *PeerBus) Messages() <-chan []BusMessage {
+	return b.incoming
+}
+
+// Close stops listening, hangs up on every peer and waits for the bus's
+// goroutines to finish.
+func (b *PeerBus) Close() error {
+	b.closed.Do(func() {
+		close(b.done)
+		if b.listener != nil {
+			_ = b.listener.Close()
+		}
+		b.connsMu.Lock()
+		for conn := range b.conns {
+			_ = conn.Close()
+		}
+		b.connsMu.Unlock()
+	})
+	b.wg.Wait()
+	return nil
+}
+
+// track records conn so Close can hang up on it. It reports false once the
+// bus is closing.
+func (b *PeerBus) track(conn net.Conn) bool {
+	b.connsMu.Lock()
+	defer b.connsMu.Unlock()
+	select {
+	case <-b.done:
+		return false
+	default:
+	}
+	b.conns[conn] = struct{}{}
+	return true
+}
+
+func (b *PeerBus) untrack(conn net.Conn) {
+	b.connsMu.Lock()
+	delete(b.conns, conn)
+	b.connsMu.Unlock()
+	_ = conn.Close()
+}
+
+func (b *PeerBus) accept() {
+	defer b.wg.Done()
+	for {
+		conn, err := b.listener.Accept()
+		if err != nil {
+			select {
+			case <-b.done:
+				return
+			default:
+			}
+			var netErr net.Error
+			if errors.As(err, &netErr) && netErr.Timeout() {
+				continue
+			}
+			fmt.Printf("failed to accept bus peer: %v\n", err)
+			return
+		}
+		if !b.track(conn) {
+			_ = conn.Close()
+			return
+		}
+		b.wg.Add(1)
+		go b.serve(conn)
+	}
+}
+
+// serve reads batches from a peer that dialled in.
+func (b *PeerBus) serve(conn net.Conn) {
+	defer b.wg.Done()
+	defer b.untrack(conn)
+	scanner := bufio.NewScanner(conn)
+	scanner.Buffer(make([]byte, 0, 64<<10), peerMaxLine)
+	_ = conn.SetReadDeadline(time.Now().Add(peerWriteTimeout))
+	if !scanner.Scan() {
+		return
+	}
+	var hello peerHello
+	if err := json.Unmarshal(scanner.Bytes(), &hello); err != nil || !b.secretMatches(hello.Secret) {
+		fmt.Printf("refused bus peer %s: bad handshake\n", conn.RemoteAddr())
+		return
+	}
+	_ = conn.SetReadDeadline(time.Time{})
+	hello.Node = relayedName(hello.Node)
+	for scanner.Scan() {
+		var batch []BusMessage
+		if err := json.Unmarshal(scanner.Bytes(), &batch); err != nil {
+			fmt.Printf("failed to decode bus batch from %s: %v\n", hello.Node, err)
+			return
+		}
+		select {
+		case b.incoming <- batch:
+		case <-b.done:
+			return
+		}
+	}
+}
+
+func (b *PeerBus) secretMatches(secret string) bool {
+	return b.cfg.Secret != "" && subtle.ConstantTimeCompare([]byte(secret), []byte(b.cfg.Secret)) == 1
+}
+
+// dial keeps a connection open to peer and writes its queued batches,
+// reconnecting with backoff when the peer goes away.
+func (b *PeerBus) dial(peer *busPeer) {
+	defer b.wg.Done()
+	backoff := peerRedialStart
+	var pending []byte
+	for {
+		conn, err := net.DialTimeout("tcp", peer.addr, peerWriteTimeout)
+		if err == nil && !b.track(conn) {
+			_ = conn.Close()
+			return
+		}
+		if err == nil {
+			backoff = peerRedialStart
+			pending, err = b.send(conn, peer, pending)
+			b.untrack(conn)
+		}
+		select {
+		case <-b.done:
+			return
+		default:
+		}
+		if err != nil {
+			fmt.Printf("failed to reach bus peer %s: %v\n", peer.addr, err)
+		}
+		select {
+		case <-b.done:
+			return
+		case <-time.After(backoff):
+		}
+		backoff = min(backoff*2, peerRedialMax)
+	}
+}
+
+// send writes the handshake and then batches to conn until a write fails
+// or the bus closes. It returns the batch that failed so the next
+// connection can retry it.
+func (b *PeerBus) send(conn net.Conn, peer *busPeer, pending []byte) ([]byte, error) {
+	hello, err := json.Marshal(peerHello{Node: b.cfg.Node, Secret: b.cfg.Secret})
+	if err != nil {
+		return pending, err
+	}
+	if err := writeLine(conn, append(hello, '\n')); err != nil {
+		return pending, err
+	}
+	for {
+		if pending == nil {
+			select {
+			case pending = <-peer.queue:
+			case <-b.done:
+				return nil, nil
+			}
+		}
+		if err := writeLine(conn, pending); err != nil {
+			return pending, err
+		}
+		pending = nil
+	}
+}
+
+func writeLine(conn net.Conn, line []byte) error {
+	if err := conn.SetWriteDeadline(time.Now().Add(peerWriteTimeout)); err != nil {
+		return err
+	}
+	_, err := conn.Write(line)
+	return err
+}
@@ -0,0 +1,79 @@
+package game
+
+import (
+	"bufio"
+	"net"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestPeerBusRelaysBetweenWorlds(t *testing.T) {
+	southBus, err := ListenPeerBus(ClusterConfig{Node: "south", Listen: "127.0.0.1:0", Secret: "clay"})
+	if err != nil {
+		t.Fatalf("ListenPeerBus(south): %v", err)
+	}
+	defer southBus.Close()
+	northBus, err := ListenPeerBus(ClusterConfig{Node: "north", Peers: []string{southBus.Addr().String()}, Secret: "clay"})
+	if err != nil {
+		t.Fatalf("ListenPeerBus(north): %v", err)
+	}
+	defer northBus.Close()
+
+	north, alice, _ := busTestNode(t, "north", "Alice")
+	north.AttachBus("north", northBus)
+	south, bob, _ := busTestNode(t, "south", "Bob")
+	south.AttachBus("south", southBus)
+	done := make(chan struct{})
+	defer close(done)
+	go north.RunBus(done)
+	go south.RunBus(done)
+
+	north.BroadcastToAllChannel("[OOC] Alice: across", alice, ChannelOOC)
+	if got, ok := bob.NextOutputForTest(5 * time.Second); !ok {
+		t.Fatalf("channel message never crossed the bus")
+	} else if got != "[OOC] Alice: across" {
+		t.Fatalf("Bob got %q", got)
+	}
+	deadline := time.Now().Add(5 * time.Second)
+	for strings.Join(south.RemotePlayers(), ",") != "Alice" {
+		if time.Now().After(deadline) {
+			t.Fatalf("south RemotePlayers = %v, want [Alice]", south.RemotePlayers())
+		}
+		time.Sleep(10 * time.Millisecond)
+	}
+}
+
+func TestPeerBusRefusesWrongSecret(t *testing.T) {
+	bus, err := ListenPeerBus(ClusterConfig{Node: "south", Listen: "127.0.0.1:0", Secret: "clay"})
+	if err != nil {
+		t.Fatalf("ListenPeerBus: %v", err)
+	}
+	defer bus.Close()
+	conn, err := net.Dial("tcp", bus.Addr().String())
+	if err != nil {
+		t.Fatalf("Dial: %v", err)
+	}
+	defer conn.Close()
+	if _, err := conn.Write([]byte(`{"node":"rogue","secret":"mud"}` + "\n" + `[{"kind":"channel","node":"rogue","text":"spam"}]` + "\n")); err != nil {
+		t.Fatalf("Write: %v", err)
+	}
+	_ = conn.SetReadDeadline(time.Now().Add(5 * time.Second))
+	if _, err := bufio.NewReader(conn).ReadByte(); err == nil {
+		t.Fatalf("bus kept talking to a peer with the wrong secret")
+	} else if ne, ok := err.(net.Error); ok && ne.Timeout() {
+		t.Fatalf("bus did not hang up on a peer with the wrong secret")
+	}
+	select {
+	case batch := <-bus.Messages():
+		t.Fatalf("bus delivered %v from a refused peer", batch)
+	default:
+	}
+}
+
+func TestPeerBusRequiresSecretToListen(t *testing.T) {
+	if bus, err := ListenPeerBus(ClusterConfig{Node: "south", Listen: "127.0.0.1:0"}); err == nil {
+		bus.Close()
+		t.Fatalf("ListenPeerBus listened without a secret")
+	}
+}
@@ -0,0 +1,168 @@
+package game
+
+import (
+	"path/filepath"
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+)
+
+// recordingBus keeps what a node publishes so tests can hand it to another
+// node.
+type recordingBus struct {
+	mu        sync.Mutex
+	published []BusMessage
+}
+
+func (b *recordingBus) Publish(batch []BusMessage) error {
+	b.mu.Lock()
+	b.published = append(b.published, batch...)
+	b.mu.Unlock()
+	return nil
+}
+
+func (b *recordingBus) Messages() <-chan []BusMessage { return nil }
+
+func (b *recordingBus) Close() error { return nil }
+
+// deliver flushes from's pending messages and applies them to each of to.
+func (b *recordingBus) deliver(from *World, to ...*World) {
+	from.relay().flush()
+	b.mu.Lock()
+	batch := b.published
+	b.published = nil
+	b.mu.Unlock()
+	for _, w := range to {
+		for _, msg := range batch {
+			w.applyBusMessage(w.relay(), msg)
+		}
+	}
+}
+
+func busTestNode(t *testing.T, node, player string) (*World, *Player, *recordingBus) {
+	t.Helper()
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	p := &Player{Name: player, Room: StartRoom, Alive: true, Channels: DefaultChannelSettings()}
+	world.AddPlayerForTest(p)
+	mail, err := NewMailSystem("")
+	if err != nil {
+		t.Fatalf("NewMailSystem: %v", err)
+	}
+	world.AttachMailSystem(mail)
+	bus := &recordingBus{}
+	world.AttachBus(node, bus)
+	return world, p, bus
+}
+
+func TestBusRelaysChannelsAndTells(t *testing.T) {
+	north, alice, northBus := busTestNode(t, "north", "Alice")
+	south, bob, southBus := busTestNode(t, "south", "Bob")
+	south.publishBus(BusMessage{Kind: BusPresence, Players: []string{"Bob"}})
+	southBus.deliver(south, north)
+
+	north.BroadcastToAllChannel("[OOC] Alice: hello", alice, ChannelOOC)
+	if !north.SendRemoteTell(alice, "Bob", "psst") {
+		t.Fatalf("SendRemoteTell found no node for Bob")
+	}
+	northBus.deliver(north, north, south)
+
+	if got := nextOutput(t, bob); got != "[OOC] Alice: hello" {
+		t.Fatalf("Bob got %q, want the relayed channel message", got)
+	}
+	if got := nextOutput(t, bob); !strings.Contains(got, "tells you: psst") {
+		t.Fatalf("Bob got %q, want the relayed tell", got)
+	}
+	if got := drainOutput(alice); len(got) != 0 {
+		t.Fatalf("Alice got her own relayed message back: %q", got)
+	}
+	if history := south.ChannelHistory(bob, ChannelOOC, 0); len(history) != 1 {
+		t.Fatalf("south logged %d OOC messages, want 1", len(history))
+	}
+}
+
+func TestBusQueuesRemoteTellOnlyOnTheRecipientsNode(t *testing.T) {
+	north, alice, northBus := busTestNode(t, "north", "Alice")
+	south, _, southBus := busTestNode(t, "south", "Bob")
+	west, _, _ := busTestNode(t, "west", "Carol")
+	for _, w := range []*World{south, west} {
+		tells, err := NewTellSystem(filepath.Join(t.TempDir(), "tells.json"))
+		if err != nil {
+			t.Fatalf("NewTellSystem: %v", err)
+		}
+		w.AttachTellSystem(tells)
+	}
+	south.publishBus(BusMessage{Kind: BusPresence, Players: []string{"Dave"}})
+	southBus.deliver(south, north)
+
+	if north.SendRemoteTell(alice, "Erin", "hello?") {
+		t.Fatalf("SendRemoteTell relayed a tell for a player no node lists")
+	}
+	if !north.SendRemoteTell(alice, "Dave", "later") {
+		t.Fatalf("SendRemoteTell found no node for Dave")
+	}
+	northBus.deliver(north, south, west)
+
+	if got := south.tells.PendingFor("Dave"); len(got) != 1 {
+		t.Fatalf("south queued %d tells for Dave, want 1", len(got))
+	}
+	if got := west.tells.PendingFor("Dave"); len(got) != 0 {
+		t.Fatalf("west queued %d tells for a player it does not host", len(got))
+	}
+}
+
+func TestBusTracksRemotePlayers(t *testing.T) {
+	north, _, _ := busTestNode(t, "north", "Alice")
+	south, _, southBus := busTestNode(t, "south", "Bob")
+
+	south.publishBus(BusMessage{Kind: BusPresence, Players: []string{"Alice", "Bob", "Carol"}})
+	southBus.deliver(south, north)
+
+	if got, want := north.RemotePlayers(), []string{"Bob", "Carol"}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("RemotePlayers = %v, want %v", got, want)
+	}
+	if name, ok := north.FindRemotePlayer("car"); !ok || name != "Carol" {
+		t.Fatalf("FindRemotePlayer(car) = %q, %v", name, ok)
+	}
+	if _, ok := north.FindRemotePlayer("alice"); ok {
+		t.Fatalf("FindRemotePlayer matched a player logged in locally")
+	}
+}
+
+func TestBusReplicatesMail(t *testing.T) {
+	north, _, northBus := busTestNode(t, "north", "Alice")
+	south, _, _ := busTestNode(t, "south", "Bob")
+
+	msg, err := north.MailSystem().Write("general", "Alice", []string{"Bob"}, "Meet at the fountain")
+	if err != nil {
+		t.Fatalf("Write: %v", err)
+	}
+	north.RelayMail(msg)
+	northBus.deliver(north, north, south)
+
+	if got := north.MailSystem().Messages("general"); len(got) != 1 {
+		t.Fatalf("north has %d posts, want 1", len(got))
+	}
+	got := south.MailSystem().Messages("general")
+	if len(got) != 1 || got[0].Author != "Alice" || got[0].Body != "Meet at the fountain" {
+		t.Fatalf("south posts = %+v", got)
+	}
+}
+
+func TestBusStripsTerminalControls(t *testing.T) {
+	south, bob, _ := busTestNode(t, "south", "Bob")
+	relay := south.relay()
+	south.applyBusMessage(relay, BusMessage{Kind: BusChannel, Node: "rogue", Channel: ChannelOOC, Text: "\r\n\x1b]8;;http://evil\x1b\\hi\x1b]8;;\x1b\\ there\x1b[2J\x07"})
+	if got := nextOutput(t, bob); got != "\r\nhi there" {
+		t.Fatalf("Bob got %q, want the text without escapes", got)
+	}
+	south.applyBusMessage(relay, BusMessage{Kind: BusChannel, Node: "rogue", Channel: "system", Text: "spoof"})
+	south.applyBusMessage(relay, BusMessage{Kind: BusMail, Node: "rogue", Mail: &MailMessage{Board: "general", Author: "\x1b[31mMallory", Body: "read \x1b[5mthis"}})
+	if got := drainOutput(bob); len(got) != 0 {
+		t.Fatalf("Bob got %q from an unknown channel", got)
+	}
+	posts := south.MailSystem().Messages("general")
+	if len(posts) != 1 || posts[0].Author != "Mallory" || posts[0].Body != "read this" {
+		t.Fatalf("relayed posts = %+v", posts)
+	}
+}
@@ -0,0 +1,110 @@
+package game
+
+import (
+	"slices"
+	"sync"
+	"time"
+)
+
+// channelLogCapacity is the number of messages kept per channel for every
+// player together. Each player's history is the subset of these they
+// received, capped at ChannelHistoryLimit. Because the ring is shared, a
+// player's older messages are evicted by everyone else's traffic on the
+// channel: a busy room's say chatter can push a quiet room's say history
+// out once the channel has carried this many messages since.
+const channelLogCapacity = 1024
+
+// channelLogRecord is one message in a channel log together with who
+// received it. Players are recorded by name so the log holds no references
+// to players who have logged out.
+type channelLogRecord struct {
+	seq   uint64
+	entry ChannelLogEntry
+	// to lists the recipients of messages that only reached some players.
+	// It is nil for broadcasts to every player.
+	to []string
+	// skip and skipped are the players a broadcast passed over.
+	skip    string
+	skipped []string
+}
+
+// receivedBy reports whether p received the message during their current
+// login.
+func (r *channelLogRecord) receivedBy(p *Player) bool {
+	if r.seq == 0 || r.seq <= p.channelHistoryFrom {
+		return false
+	}
+	if r.to != nil {
+		return slices.Contains(r.to, p.Name)
+	}
+	return r.skip != p.Name && !slices.Contains(r.skipped, p.Name)
+}
+
+// channelLog is a ring buffer holding the recent messages of one channel.
+// Messages are written once however many players receive them.
+type channelLog struct {
+	mu      sync.RWMutex
+	records []channelLogRecord
+	written uint64
+}
+
+func (l *channelLog) append(record channelLogRecord) {
+	l.mu.Lock()
+	if l.records == nil {
+		l.records = make([]channelLogRecord, channelLogCapacity)
+	}
+	l.records[l.written%channelLogCapacity] = record
+	l.written++
+	l.mu.Unlock()
+}
+
+// history returns up to limit of the most recent messages p received,
+// oldest first.
+func (l *channelLog) history(p *Player, limit int) []ChannelLogEntry {
+	l.mu.RLock()
+	defer l.mu.RUnlock()
+	var out []ChannelLogEntry
+	for i := uint64(0); i < l.written && i < channelLogCapacity && len(out) < limit; i++ {
+		record := &l.records[(l.written-1-i)%channelLogCapacity]
+		if record.receivedBy(p) {
+			out = append(out, record.entry)
+		}
+	}
+	for i, j := 0, len(out)-1; i < j; i, j = i+1, j-1 {
+		out[i], out[j] = out[j], out[i]
+	}
+	return out
+}
+
+func (w *World) channelLog(channel Channel) *channelLog {
+	w.channelLogMu.Lock()
+	defer w.channelLogMu.Unlock()
+	if w.channelLogs == nil {
+		w.channelLogs = make(map[Channel]*channelLog, len(allChannels))
+	}
+	log, ok := w.channelLogs[channel]
+	if !ok {
+		log = &channelLog{}
+		w.channelLogs[channel] = log
+	}
+	return log
+}
+
+// recordChannelMessage appends msg to the channel's log. to limits the
+// message to the named recipients; a nil to means every player except skip
+// and skipped received it.
+func (w *World) recordChannelMessage(channel Channel, msg string, to []string, skip string, skipped []string) {
+	w.channelLog(channel).append(channelLogRecord{
+		seq:     w.channelSeq.Add(1),
+		entry:   ChannelLogEntry{Timestamp: time.Now(), Message: msg, Channel: channel},
+		to:      to,
+		skip:    skip,
+		skipped: skipped,
+	})
+}
+
+// startChannelHistoryLocked hides messages sent before p joined from p's
+// channel history.
+func (w *World) startChannelHistoryLocked(p *Player) {
+	p.channelHistoryFrom = w.channelSeq.Load()
+}
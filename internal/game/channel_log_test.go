@@ -0,0 +1,85 @@
+package game
+
+import (
+	"fmt"
+	"testing"
+)
+
+func TestChannelLogFiltersRecipients(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}, "far": {ID: "far"}})
+	newPlayer := func(name string, room RoomID) *Player {
+		p := &Player{Name: name, Room: room, Alive: true, Channels: DefaultChannelSettings()}
+		world.AddPlayerForTest(p)
+		return p
+	}
+	alice := newPlayer("Alice", StartRoom)
+	bob := newPlayer("Bob", "far")
+	quiet := newPlayer("Quiet", StartRoom)
+	quiet.Channels[ChannelOOC] = false
+
+	world.BroadcastToAllChannel("global", alice, ChannelOOC)
+	world.BroadcastToRoomChannel(StartRoom, "local", nil, ChannelOOC)
+	late := newPlayer("Late", StartRoom)
+	world.BroadcastToAllChannel("later", nil, ChannelOOC)
+
+	want := map[*Player][]string{
+		alice: {"local", "later"},
+		bob:   {"global", "later"},
+		quiet: nil,
+		late:  {"later"},
+	}
+	for p, messages := range want {
+		entries := world.ChannelHistory(p, ChannelOOC, ChannelHistoryLimit)
+		if len(entries) != len(messages) {
+			t.Fatalf("%s history = %+v, want %v", p.Name, entries, messages)
+		}
+		for i, entry := range entries {
+			if entry.Message != messages[i] || entry.Channel != ChannelOOC {
+				t.Fatalf("%s history = %+v, want %v", p.Name, entries, messages)
+			}
+		}
+	}
+	if entries := world.ChannelHistory(bob, ChannelSay, ChannelHistoryLimit); len(entries) != 0 {
+		t.Fatalf("expected channels to keep separate logs, got %+v", entries)
+	}
+}
+
+func TestChannelLogKeepsMostRecentMessages(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	p := &Player{Name: "Alice", Room: StartRoom, Alive: true, Channels: DefaultChannelSettings()}
+	world.AddPlayerForTest(p)
+	for i := 0; i < channelLogCapacity+10; i++ {
+		world.RecordPlayerChannelMessage(p, ChannelYell, fmt.Sprintf("message %d", i))
+	}
+	entries := world.ChannelHistory(p, ChannelYell, 0)
+	if len(entries) != ChannelHistoryLimit {
+		t.Fatalf("expected %d entries, got %d", ChannelHistoryLimit, len(entries))
+	}
+	if first, last := entries[0].Message, entries[len(entries)-1].Message; first != fmt.Sprintf("message %d", channelLogCapacity+10-ChannelHistoryLimit) || last != fmt.Sprintf("message %d", channelLogCapacity+9) {
+		t.Fatalf("unexpected history window %q..%q", first, last)
+	}
+	if log := world.channelLog(ChannelYell); len(log.records) != channelLogCapacity {
+		t.Fatalf("expected the log to stay at %d records, got %d", channelLogCapacity, len(log.records))
+	}
+}
+
+func TestChannelLogStartsFreshForEachLogin(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	first, err := world.addPlayer("Alice", nil, false, PlayerProfile{})
+	if err != nil {
+		t.Fatalf("addPlayer: %v", err)
+	}
+	world.RecordPlayerChannelMessage(first, ChannelSay, "before")
+	world.BroadcastToRoomChannel(StartRoom, "room before", nil, ChannelSay)
+	world.removePlayer("Alice")
+
+	second, err := world.addPlayer("Alice", nil, false, PlayerProfile{})
+	if err != nil {
+		t.Fatalf("addPlayer again: %v", err)
+	}
+	world.RecordPlayerChannelMessage(second, ChannelSay, "after")
+	entries := world.ChannelHistory(second, ChannelSay, 0)
+	if len(entries) != 1 || entries[0].Message != "after" {
+		t.Fatalf("history after logging in again = %+v, want only [after]", entries)
+	}
+}
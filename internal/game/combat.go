@@ -43,49 +43,32 @@ type combatInstance struct {
 	playerTargets map[string]combatTarget
 	npcTargets    map[string]combatTarget
 
-	stop     chan struct{}
-	stopOnce sync.Once
-	loopOnce sync.Once
+	// The remaining fields belong to scheduler and are guarded by its mutex.
+	scheduler *combatScheduler
+	due       time.Time
+	heapIndex int
+	active    bool
+	stopped   bool
 }
 
-func newCombatInstance(world *World, room RoomID) *combatInstance {
+func newCombatInstance(world *World, room RoomID, scheduler *combatScheduler) *combatInstance {
 	return &combatInstance{
 		world:         world,
 		room:          room,
 		roundDuration: defaultCombatRound,
 		playerTargets: make(map[string]combatTarget),
 		npcTargets:    make(map[string]combatTarget),
-		stop:          make(chan struct{}),
+		scheduler:     scheduler,
+		heapIndex:     -1,
 	}
 }
 
 func (c *combatInstance) startLoop() {
-	c.loopOnce.Do(func() {
-		go c.loop()
-	})
+	c.scheduler.start(c)
 }
 
 func (c *combatInstance) stopLoop() {
-	c.stopOnce.Do(func() {
-		close(c.stop)
-	})
-}
-
-func (c *combatInstance) loop() {
-	ticker := time.NewTicker(c.roundDuration)
-	defer ticker.Stop()
-
-	for {
-		select {
-		case <-ticker.C:
-			if !c.executeRound() {
-				c.world.finishCombat(c.room, c)
-				return
-			}
-		case <-c.stop:
-			return
-		}
-	}
+	c.scheduler.stop(c)
 }
 
 func (c *combatInstance) addPlayer(attacker string, target combatTarget) {
@@ -144,19 +127,29 @@ func (c *combatInstance) snapshotActions() []combatAction {
 	return actions
 }
 
+// combatOutcome records one resolved attack so its messages can be sent once
+// the room's locks have been released.
+type combatOutcome struct {
+	attacker *Player
+	npcName  string
+	npcHit   *NPCDamageResult
+	hit      *PlayerDamageResult
+	err      error
+	xp       int
+	levels   int
+	quests   []QuestProgressUpdate
+}
+
 func (c *combatInstance) executeRound() bool {
 	actions := c.snapshotActions()
 	if len(actions) == 0 {
 		return false
 	}
 
-	for _, action := range actions {
-		switch action.attackerKind {
-		case combatantPlayer:
-			c.resolvePlayerAttack(action.attackerName, action.target)
-		case combatantNPC:
-			c.resolveNPCAttack(action.attackerName, action.target)
-		}
+	outcomes := c.resolveRound(actions)
+	c.respawnFallen(outcomes)
+	for i := range outcomes {
+		c.report(&outcomes[i])
 	}
 
 	c.mu.Lock()
@@ -176,170 +169,238 @@ func (c *combatInstance) executeRound() bool {
 	return true
 }
 
-func (c *combatInstance) resolvePlayerAttack(name string, target combatTarget) {
-	attacker, ok := c.world.ActivePlayer(name)
-	if !ok || attacker.Room != c.room {
-		c.clearPlayer(name)
-		return
+// resolveRound applies every attack in the round while holding the world lock
+// for reading and the room's shard lock once. Players defeated earlier in the
+// round can neither attack nor be attacked again until they have respawned.
+func (c *combatInstance) resolveRound(actions []combatAction) []combatOutcome {
+	w := c.world
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	lock := w.roomLock(c.room)
+	lock.Lock()
+	defer lock.Unlock()
+
+	outcomes := make([]combatOutcome, 0, len(actions))
+	var fallen []*Player
+	for _, action := range actions {
+		var (
+			outcome combatOutcome
+			ok      bool
+		)
+		switch action.attackerKind {
+		case combatantPlayer:
+			outcome, ok = c.resolvePlayerAttackLocked(action.attackerName, action.target, fallen)
+		case combatantNPC:
+			outcome, ok = c.resolveNPCAttackLocked(action.attackerName, action.target, fallen)
+		}
+		if !ok {
+			continue
+		}
+		if outcome.hit != nil && outcome.hit.Defeated {
+			fallen = append(fallen, outcome.hit.Target)
+		}
+		outcomes = append(outcomes, outcome)
 	}
-	if !attacker.Alive {
+	return outcomes
+}
+
+func (c *combatInstance) resolvePlayerAttackLocked(name string, target combatTarget, fallen []*Player) (combatOutcome, bool) {
+	w := c.world
+	attacker, ok := w.players[name]
+	if !ok || attacker == nil || !attacker.Alive || attacker.defeated || attacker.Room != c.room || containsPlayer(fallen, attacker) {
 		c.clearPlayer(name)
-		return
+		return combatOutcome{}, false
 	}
 	attacker.EnsureStats()
 	damage := attacker.AttackDamage()
+	outcome := combatOutcome{attacker: attacker}
 
 	switch target.kind {
 	case combatTargetNPC:
-		c.attackNPC(attacker, target.name, damage)
+		result, err := w.damageNPCLocked(c.room, target.name, damage)
+		if err != nil {
+			outcome.err = err
+			c.clearPlayer(attacker.Name)
+			return outcome, true
+		}
+		outcome.npcHit = result
+		if result.Defeated {
+			xp := result.NPC.Experience
+			if xp < 1 {
+				xp = result.NPC.Level * 25
+			}
+			outcome.xp = xp
+			outcome.levels = attacker.GainExperience(xp)
+			outcome.quests = w.recordNPCKillLocked(attacker, result.NPC)
+			c.clearNPC(result.NPC.Name)
+			c.clearPlayer(attacker.Name)
+		}
 	case combatTargetPlayer:
-		c.attackPlayer(attacker, target.name, damage)
+		result, err := w.damageRoomPlayerLocked(attacker, target.name, damage, fallen)
+		if err != nil {
+			outcome.err = err
+			c.clearPlayer(attacker.Name)
+			return outcome, true
+		}
+		outcome.hit = result
+		if result.Defeated {
+			c.clearPlayer(result.Target.Name)
+			c.clearPlayer(attacker.Name)
+		}
+	default:
+		return combatOutcome{}, false
 	}
+	return outcome, true
 }
 
-func (c *combatInstance) attackNPC(attacker *Player, name string, damage int) {
-	result, err := c.world.ApplyDamageToNPC(c.room, name, damage)
-	if err != nil {
-		if attacker.Output != nil {
-			attacker.Output <- Ansi(Style(fmt.Sprintf("\r\n%s", err.Error()), AnsiYellow))
-		}
-		c.clearPlayer(attacker.Name)
-		return
+func (c *combatInstance) resolveNPCAttackLocked(name string, target combatTarget, fallen []*Player) (combatOutcome, bool) {
+	if target.kind != combatTargetPlayer {
+		return combatOutcome{}, false
 	}
-
-	npcName := HighlightNPCName(result.NPC.Name)
-	if attacker.Output != nil {
-		attacker.Output <- Ansi(fmt.Sprintf("\r\nYou strike %s for %d damage. (%d/%d HP)", npcName, result.Damage, result.NPC.Health, result.NPC.MaxHealth))
+	w := c.world
+	r, ok := w.rooms[c.room]
+	idx := -1
+	if ok && r != nil {
+		idx = findNPCIndex(r.NPCs, name)
 	}
-	broadcast := fmt.Sprintf("\r\n%s strikes %s for %d damage.", HighlightName(attacker.Name), npcName, result.Damage)
-	c.world.BroadcastToRoom(c.room, Ansi(broadcast), attacker)
+	if idx < 0 {
+		c.clearNPC(name)
+		return combatOutcome{}, false
+	}
+	npc := r.NPCs[idx]
+	normalizeNPC(&npc)
+	npc.EnsureStats()
+	damage := npc.AttackDamage()
 
-	if result.Defeated {
-		if attacker.Output != nil {
-			attacker.Output <- Ansi(fmt.Sprintf("\r\nYou defeat %s!", npcName))
+	player, ok := w.players[target.name]
+	if !ok || player == nil || !player.Alive || player.defeated || player.Room != c.room || containsPlayer(fallen, player) {
+		if !c.retargetNPC(name) {
+			c.clearNPC(name)
 		}
-		c.world.BroadcastToRoom(c.room, Ansi(fmt.Sprintf("\r\n%s defeats %s!", HighlightName(attacker.Name), npcName)), attacker)
+		return combatOutcome{}, false
+	}
 
-		xp := result.NPC.Experience
-		if xp < 1 {
-			xp = result.NPC.Level * 25
-		}
-		levels := c.world.AwardExperience(attacker, xp)
-		if attacker.Output != nil {
-			attacker.Output <- Ansi(fmt.Sprintf("\r\nYou gain %d experience.", xp))
+	result, err := w.damagePlayerFromNPCLocked(c.room, player, damage)
+	if err != nil {
+		if !c.retargetNPC(name) {
+			c.clearNPC(name)
 		}
-		if levels > 0 && attacker.Output != nil {
-			attacker.Output <- Ansi(fmt.Sprintf("\r\nYou advance to level %d!", attacker.Level))
+		return combatOutcome{}, false
+	}
+	if result.Defeated {
+		c.clearPlayer(player.Name)
+		if !c.retargetNPC(name) {
+			c.clearNPC(name)
 		}
+	}
+	return combatOutcome{npcName: npc.Name, hit: result}, true
+}
 
-		if len(result.Loot) > 0 {
-			names := make([]string, len(result.Loot))
-			for i, item := range result.Loot {
-				names[i] = HighlightItemName(item.Name)
-			}
-			lootLine := fmt.Sprintf("\r\n%s drops %s.", npcName, strings.Join(names, ", "))
-			if attacker.Output != nil {
-				attacker.Output <- Ansi(lootLine)
-			}
-			dropLine := fmt.Sprintf("\r\n%s leaves behind %s.", npcName, strings.Join(names, ", "))
-			c.world.BroadcastToRoom(c.room, Ansi(dropLine), attacker)
+// respawnFallen sends every player defeated this round home under a single
+// acquisition of the world lock.
+func (c *combatInstance) respawnFallen(outcomes []combatOutcome) {
+	w := c.world
+	locked := false
+	for _, outcome := range outcomes {
+		if outcome.hit == nil || !outcome.hit.Defeated {
+			continue
 		}
-
-		if updates := c.world.RecordNPCKill(attacker, result.NPC); len(updates) > 0 {
-			messages := FormatQuestKillUpdates(updates)
-			for _, msg := range messages {
-				if attacker.Output != nil {
-					attacker.Output <- Ansi("\r\n" + msg)
-				}
-			}
+		if !locked {
+			w.mu.Lock()
+			locked = true
 		}
-
-		c.clearNPC(result.NPC.Name)
-		c.clearPlayer(attacker.Name)
+		w.respawnPlayerLocked(outcome.hit.Target, outcome.hit.PreviousRoom)
+	}
+	if locked {
+		w.mu.Unlock()
 	}
 }
 
-func (c *combatInstance) attackPlayer(attacker *Player, name string, damage int) {
-	result, err := c.world.ApplyDamageToPlayer(attacker, name, damage)
-	if err != nil {
-		if attacker.Output != nil {
-			attacker.Output <- Ansi(Style(fmt.Sprintf("\r\n%s", err.Error()), AnsiYellow))
-		}
-		c.clearPlayer(attacker.Name)
-		return
+func (c *combatInstance) report(outcome *combatOutcome) {
+	switch {
+	case outcome.attacker == nil:
+		c.reportNPCAttack(outcome)
+	case outcome.err != nil:
+		sendDirect(outcome.attacker, Ansi(Style(fmt.Sprintf("\r\n%s", outcome.err.Error()), AnsiYellow)))
+	case outcome.npcHit != nil:
+		c.reportNPCHit(outcome)
+	case outcome.hit != nil:
+		c.reportPlayerHit(outcome)
 	}
+}
 
-	targetName := HighlightName(result.Target.Name)
-	broadcast := fmt.Sprintf("\r\n%s strikes %s for %d damage.", HighlightName(attacker.Name), targetName, result.Damage)
-	c.world.BroadcastToRoom(result.PreviousRoom, Ansi(broadcast), attacker)
+func (c *combatInstance) reportNPCHit(outcome *combatOutcome) {
+	attacker := outcome.attacker
+	result := outcome.npcHit
+	npcName := HighlightNPCName(result.NPC.Name)
+	sendDirect(attacker, Ansi(fmt.Sprintf("\r\nYou strike %s for %d damage. (%d/%d HP)", npcName, result.Damage, result.NPC.Health, result.NPC.MaxHealth)))
+	broadcast := fmt.Sprintf("\r\n%s strikes %s for %d damage.", HighlightName(attacker.Name), npcName, result.Damage)
+	c.world.BroadcastToRoom(c.room, Ansi(broadcast), attacker)
 
-	if result.Defeated {
-		if attacker.Output != nil {
-			attacker.Output <- Ansi(fmt.Sprintf("\r\nYou defeat %s!", targetName))
-		}
-		c.world.BroadcastToRoom(result.PreviousRoom, Ansi(fmt.Sprintf("\r\n%s collapses in defeat!", targetName)), attacker)
-		if result.Target.Output != nil {
-			result.Target.Output <- Ansi(fmt.Sprintf("\r\nYou have been defeated by %s!", HighlightName(attacker.Name)))
-			EnterRoom(c.world, result.Target, "defeat")
-		}
-		c.clearPlayer(result.Target.Name)
-		c.clearPlayer(attacker.Name)
+	if !result.Defeated {
 		return
 	}
+	sendDirect(attacker, Ansi(fmt.Sprintf("\r\nYou defeat %s!", npcName)))
+	c.world.BroadcastToRoom(c.room, Ansi(fmt.Sprintf("\r\n%s defeats %s!", HighlightName(attacker.Name), npcName)), attacker)
 
-	if attacker.Output != nil {
-		attacker.Output <- Ansi(fmt.Sprintf("\r\nYou strike %s for %d damage. (%d/%d HP)", targetName, result.Damage, result.Remaining, result.Target.MaxHealth))
+	sendDirect(attacker, Ansi(fmt.Sprintf("\r\nYou gain %d experience.", outcome.xp)))
+	if outcome.levels > 0 {
+		sendDirect(attacker, Ansi(fmt.Sprintf("\r\nYou advance to level %d!", attacker.Level)))
 	}
-	if result.Target.Output != nil {
-		result.Target.Output <- Ansi(fmt.Sprintf("\r\n%s strikes you for %d damage. (%d/%d HP)", HighlightName(attacker.Name), result.Damage, result.Remaining, result.Target.MaxHealth))
-	}
-}
 
-func (c *combatInstance) resolveNPCAttack(name string, target combatTarget) {
-	if target.kind != combatTargetPlayer {
-		return
-	}
-	npc, ok := c.world.FindRoomNPC(c.room, name)
-	if !ok {
-		c.clearNPC(name)
-		return
+	if len(result.Loot) > 0 {
+		names := make([]string, len(result.Loot))
+		for i, item := range result.Loot {
+			names[i] = HighlightItemName(item.Name)
+		}
+		lootLine := fmt.Sprintf("\r\n%s drops %s.", npcName, strings.Join(names, ", "))
+		sendDirect(attacker, Ansi(lootLine))
+		dropLine := fmt.Sprintf("\r\n%s leaves behind %s.", npcName, strings.Join(names, ", "))
+		c.world.BroadcastToRoom(c.room, Ansi(dropLine), attacker)
 	}
-	npc.EnsureStats()
-	damage := npc.AttackDamage()
 
-	player, ok := c.world.ActivePlayer(target.name)
-	if !ok || player.Room != c.room {
-		if !c.retargetNPC(name) {
-			c.clearNPC(name)
+	if len(outcome.quests) > 0 {
+		for _, msg := range FormatQuestKillUpdates(outcome.quests) {
+			sendDirect(attacker, Ansi("\r\n"+msg))
 		}
-		return
 	}
+}
 
-	result, err := c.world.ApplyDamageFromNPC(c.room, npc.Name, player, damage)
-	if err != nil {
-		if !c.retargetNPC(name) {
-			c.clearNPC(name)
+func (c *combatInstance) reportPlayerHit(outcome *combatOutcome) {
+	attacker := outcome.attacker
+	result := outcome.hit
+	targetName := HighlightName(result.Target.Name)
+	broadcast := fmt.Sprintf("\r\n%s strikes %s for %d damage.", HighlightName(attacker.Name), targetName, result.Damage)
+	c.world.BroadcastToRoom(result.PreviousRoom, Ansi(broadcast), attacker)
+
+	if result.Defeated {
+		sendDirect(attacker, Ansi(fmt.Sprintf("\r\nYou defeat %s!", targetName)))
+		c.world.BroadcastToRoom(result.PreviousRoom, Ansi(fmt.Sprintf("\r\n%s collapses in defeat!", targetName)), attacker)
+		if result.Target.Connected() {
+			sendDirect(result.Target, Ansi(fmt.Sprintf("\r\nYou have been defeated by %s!", HighlightName(attacker.Name))))
+			EnterRoom(c.world, result.Target, "defeat")
 		}
 		return
 	}
 
-	npcName := HighlightNPCName(npc.Name)
+	sendDirect(attacker, Ansi(fmt.Sprintf("\r\nYou strike %s for %d damage. (%d/%d HP)", targetName, result.Damage, result.Remaining, result.Target.MaxHealth)))
+	sendDirect(result.Target, Ansi(fmt.Sprintf("\r\n%s strikes you for %d damage. (%d/%d HP)", HighlightName(attacker.Name), result.Damage, result.Remaining, result.Target.MaxHealth)))
+}
+
+func (c *combatInstance) reportNPCAttack(outcome *combatOutcome) {
+	result := outcome.hit
+	player := result.Target
+	npcName := HighlightNPCName(outcome.npcName)
 	broadcast := fmt.Sprintf("\r\n%s strikes %s for %d damage.", npcName, HighlightName(player.Name), result.Damage)
 	c.world.BroadcastToRoom(c.room, Ansi(broadcast), player)
 
-	if result.Target.Output != nil {
-		result.Target.Output <- Ansi(fmt.Sprintf("\r\n%s strikes you for %d damage. (%d/%d HP)", npcName, result.Damage, result.Remaining, result.Target.MaxHealth))
-	}
+	sendDirect(player, Ansi(fmt.Sprintf("\r\n%s strikes you for %d damage. (%d/%d HP)", npcName, result.Damage, result.Remaining, player.MaxHealth)))
 
 	if result.Defeated {
-		if result.Target.Output != nil {
-			result.Target.Output <- Ansi(fmt.Sprintf("\r\nYou have been defeated by %s!", npcName))
-			EnterRoom(c.world, result.Target, "defeat")
-		}
-		c.world.BroadcastToRoom(c.room, Ansi(fmt.Sprintf("\r\n%s collapses in defeat!", HighlightName(player.Name))), result.Target)
-		c.clearPlayer(player.Name)
-		if !c.retargetNPC(name) {
-			c.clearNPC(name)
+		if player.Connected() {
+			sendDirect(player, Ansi(fmt.Sprintf("\r\nYou have been defeated by %s!", npcName)))
+			EnterRoom(c.world, player, "defeat")
 		}
+		c.world.BroadcastToRoom(c.room, Ansi(fmt.Sprintf("\r\n%s collapses in defeat!", HighlightName(player.Name))), player)
 	}
 }
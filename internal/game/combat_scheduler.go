@@ -0,0 +1,188 @@
+package game
+
+import (
+	"container/heap"
+	"sync"
+	"time"
+)
+
+// combatScheduler runs every active combat's rounds from a single goroutine.
+// Combats wait in a heap ordered by their next due time; each wakeup runs all
+// rounds that have come due in one pass. The goroutine exits once no combats
+// remain and is restarted by the next schedule call.
+type combatScheduler struct {
+	mu      sync.Mutex
+	queue   combatQueue
+	wake    chan struct{}
+	running bool
+	now     func() time.Time
+
+	rounds      uint64
+	jitterTotal time.Duration
+	jitterLast  time.Duration
+	jitterMax   time.Duration
+}
+
+// CombatStats summarises the combat scheduler for monitoring. Jitter is how
+// late a round started relative to when it was due.
+type CombatStats struct {
+	Active     int
+	Rounds     uint64
+	LastJitter time.Duration
+	MeanJitter time.Duration
+	MaxJitter  time.Duration
+}
+
+func newCombatScheduler() *combatScheduler {
+	return &combatScheduler{
+		wake: make(chan struct{}, 1),
+		now:  time.Now,
+	}
+}
+
+// start queues the first automatic round for c one round from now. It is a
+// no-op for combats that are already scheduled or have been stopped.
+func (s *combatScheduler) start(c *combatInstance) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if c.stopped || c.active {
+		return
+	}
+	c.active = true
+	c.due = s.now().Add(c.roundDuration)
+	s.pushLocked(c)
+}
+
+// stop removes c from the schedule. A round that is already running finishes,
+// but c is not queued again afterwards.
+func (s *combatScheduler) stop(c *combatInstance) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	c.stopped = true
+	c.active = false
+	if c.heapIndex >= 0 {
+		heap.Remove(&s.queue, c.heapIndex)
+	}
+}
+
+func (s *combatScheduler) pushLocked(c *combatInstance) {
+	heap.Push(&s.queue, c)
+	if !s.running {
+		s.running = true
+		go s.run()
+		return
+	}
+	if c.heapIndex == 0 {
+		select {
+		case s.wake <- struct{}{}:
+		default:
+		}
+	}
+}
+
+func (s *combatScheduler) run() {
+	var batch []*combatInstance
+	for {
+		s.mu.Lock()
+		if len(s.queue) == 0 {
+			s.running = false
+			s.mu.Unlock()
+			return
+		}
+		now := s.now()
+		if wait := s.queue[0].due.Sub(now); wait > 0 {
+			s.mu.Unlock()
+			timer := time.NewTimer(wait)
+			select {
+			case <-timer.C:
+			case <-s.wake:
+			}
+			timer.Stop()
+			continue
+		}
+		for len(s.queue) > 0 && !s.queue[0].due.After(now) {
+			c := heap.Pop(&s.queue).(*combatInstance)
+			s.recordJitterLocked(now.Sub(c.due))
+			batch = append(batch, c)
+		}
+		s.mu.Unlock()
+
+		for _, c := range batch {
+			if c.executeRound() {
+				s.reschedule(c, now)
+			} else {
+				c.world.finishCombat(c.room, c)
+			}
+		}
+		clear(batch)
+		batch = batch[:0]
+	}
+}
+
+// reschedule queues c's next round a full round after the one that just ran,
+// skipping ahead rather than bunching rounds if the scheduler fell behind.
+func (s *combatScheduler) reschedule(c *combatInstance, now time.Time) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if c.stopped {
+		return
+	}
+	c.due = c.due.Add(c.roundDuration)
+	if !c.due.After(now) {
+		c.due = now.Add(c.roundDuration)
+	}
+	s.pushLocked(c)
+}
+
+func (s *combatScheduler) recordJitterLocked(jitter time.Duration) {
+	s.rounds++
+	s.jitterTotal += jitter
+	s.jitterLast = jitter
+	serverMetrics.combatRoundLag.observe(jitter)
+	if jitter > s.jitterMax {
+		s.jitterMax = jitter
+	}
+}
+
+func (s *combatScheduler) stats() CombatStats {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	stats := CombatStats{
+		Rounds:     s.rounds,
+		LastJitter: s.jitterLast,
+		MaxJitter:  s.jitterMax,
+	}
+	if s.rounds > 0 {
+		stats.MeanJitter = s.jitterTotal / time.Duration(s.rounds)
+	}
+	return stats
+}
+
+// combatQueue is a min-heap of combats ordered by due time.
+type combatQueue []*combatInstance
+
+func (q combatQueue) Len() int { return len(q) }
+
+func (q combatQueue) Less(i, j int) bool { return q[i].due.Before(q[j].due) }
+
+func (q combatQueue) Swap(i, j int) {
+	q[i], q[j] = q[j], q[i]
+	q[i].heapIndex = i
+	q[j].heapIndex = j
+}
+
+func (q *combatQueue) Push(x any) {
+	c := x.(*combatInstance)
+	c.heapIndex = len(*q)
+	*q = append(*q, c)
+}
+
+func (q *combatQueue) Pop() any {
+	old := *q
+	n := len(old)
+	c := old[n-1]
+	old[n-1] = nil
+	c.heapIndex = -1
+	*q = old[:n-1]
+	return c
+}
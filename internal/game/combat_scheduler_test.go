@@ -0,0 +1,179 @@
+package game
+
+import (
+	"testing"
+	"time"
+)
+
+func TestCombatSchedulerRunsRoomsFromOneQueue(t *testing.T) {
+	rooms := map[RoomID]*Room{
+		"arena": {ID: "arena", NPCs: []NPC{{Name: "Stone Golem", Level: 1, Health: 10000, MaxHealth: 10000}}},
+		"pit":   {ID: "pit", NPCs: []NPC{{Name: "Iron Golem", Level: 1, Health: 10000, MaxHealth: 10000}}},
+	}
+	world := NewWorldWithRooms(rooms)
+	alpha := &Player{Name: "Alpha", Room: "arena", Alive: true, Level: 1, Health: 10000, MaxHealth: 10000}
+	bravo := &Player{Name: "Bravo", Room: "pit", Alive: true, Level: 1, Health: 10000, MaxHealth: 10000}
+	world.AddPlayerForTest(alpha)
+	world.AddPlayerForTest(bravo)
+
+	start := func(player *Player, npc string) *combatInstance {
+		combat := world.ensureCombat(player.Room)
+		combat.roundDuration = 5 * time.Millisecond
+		combat.addPlayer(player.Name, combatTarget{kind: combatTargetNPC, name: npc})
+		combat.addNPC(npc, combatTarget{kind: combatTargetPlayer, name: player.Name})
+		combat.startLoop()
+		return combat
+	}
+	arena := start(alpha, "Stone Golem")
+	pit := start(bravo, "Iron Golem")
+	if arena.scheduler != pit.scheduler {
+		t.Fatalf("expected combats to share the world scheduler")
+	}
+
+	deadline := time.Now().Add(2 * time.Second)
+	for world.CombatStats().Rounds < 6 {
+		if time.Now().After(deadline) {
+			t.Fatalf("scheduler ran only %d rounds", world.CombatStats().Rounds)
+		}
+		drainOutput(alpha)
+		drainOutput(bravo)
+		time.Sleep(time.Millisecond)
+	}
+	world.finishCombat("arena", arena)
+	world.finishCombat("pit", pit)
+
+	for id, name := range map[RoomID]string{"arena": "Stone Golem", "pit": "Iron Golem"} {
+		npc, ok := world.FindRoomNPC(id, name)
+		if !ok {
+			t.Fatalf("expected %s to survive", name)
+		}
+		if npc.Health >= npc.MaxHealth {
+			t.Fatalf("expected %s to take damage from scheduled rounds", name)
+		}
+	}
+	stats := world.CombatStats()
+	if stats.Active != 0 {
+		t.Fatalf("expected no active combats, got %d", stats.Active)
+	}
+	if stats.MaxJitter < stats.MeanJitter {
+		t.Fatalf("inconsistent jitter stats: %+v", stats)
+	}
+
+	arena.scheduler.mu.Lock()
+	queued := len(arena.scheduler.queue)
+	arena.scheduler.mu.Unlock()
+	if queued != 0 {
+		t.Fatalf("stopped combats left %d entries queued", queued)
+	}
+}
+
+func TestCombatSchedulerKeepsRunningPastAFullOutput(t *testing.T) {
+	rooms := map[RoomID]*Room{
+		"arena": {ID: "arena", NPCs: []NPC{{Name: "Stone Golem", Level: 1, Health: 10000, MaxHealth: 10000}}},
+		"pit":   {ID: "pit", NPCs: []NPC{{Name: "Iron Golem", Level: 1, Health: 10000, MaxHealth: 10000}}},
+	}
+	world := NewWorldWithRooms(rooms)
+	// Alpha's client stopped reading: its last write never returned, and its
+	// small queue soon passes the hard limit.
+	alpha := &Player{Name: "Alpha", Room: "arena", Alive: true, Level: 1, Health: 10000, MaxHealth: 10000}
+	stalled := newOutputQueue(OutputConfig{QueueBytes: 256})
+	stalled.push("\r\nWelcome.", outputDirect)
+	stalled.take(nil, 1)
+	alpha.queue.Store(stalled)
+	bravo := &Player{Name: "Bravo", Room: "pit", Alive: true, Level: 1, Health: 10000, MaxHealth: 10000}
+	world.AddPlayerForTest(alpha)
+	world.AddPlayerForTest(bravo)
+
+	var combats []*combatInstance
+	for player, npc := range map[*Player]string{alpha: "Stone Golem", bravo: "Iron Golem"} {
+		combat := world.ensureCombat(player.Room)
+		combat.roundDuration = 5 * time.Millisecond
+		combat.addPlayer(player.Name, combatTarget{kind: combatTargetNPC, name: npc})
+		combat.addNPC(npc, combatTarget{kind: combatTargetPlayer, name: player.Name})
+		combat.startLoop()
+		combats = append(combats, combat)
+	}
+	defer func() {
+		for _, combat := range combats {
+			world.finishCombat(combat.room, combat)
+		}
+	}()
+
+	deadline := time.Now().Add(2 * time.Second)
+	for world.CombatStats().Rounds < 10 {
+		if time.Now().After(deadline) {
+			t.Fatalf("a full output stalled the scheduler after %d rounds", world.CombatStats().Rounds)
+		}
+		drainOutput(bravo)
+		time.Sleep(time.Millisecond)
+	}
+}
+
+func TestCombatRoundDoesNotHitFallenPlayerTwice(t *testing.T) {
+	rooms := map[RoomID]*Room{
+		StartRoom: {ID: StartRoom, NPCs: []NPC{{Name: "Wolf", Level: 1, Health: 100, MaxHealth: 100}}},
+		"home":    {ID: "home"},
+	}
+	world := NewWorldWithRooms(rooms)
+	victim := &Player{Name: "Victim", Room: StartRoom, Home: "home", Alive: true, Level: 1, Health: 1, MaxHealth: 50}
+	bully := &Player{Name: "Bully", Room: StartRoom, Alive: true, Level: 5}
+	world.AddPlayerForTest(victim)
+	world.AddPlayerForTest(bully)
+	victim.Health = 1
+
+	combat := world.ensureCombat(StartRoom)
+	combat.addPlayer(bully.Name, combatTarget{kind: combatTargetPlayer, name: victim.Name})
+	combat.addNPC("Wolf", combatTarget{kind: combatTargetPlayer, name: victim.Name})
+
+	outcomes := combat.resolveRound(combat.snapshotActions())
+	defeats := 0
+	for _, outcome := range outcomes {
+		if outcome.hit != nil && outcome.hit.Target == victim {
+			if !outcome.hit.Defeated {
+				t.Fatalf("victim was hit again after falling")
+			}
+			defeats++
+		}
+	}
+	if defeats != 1 {
+		t.Fatalf("expected exactly one defeat, got %d", defeats)
+	}
+	combat.respawnFallen(outcomes)
+	if victim.Room != "home" {
+		t.Fatalf("expected victim to respawn at home, got %s", victim.Room)
+	}
+	world.finishCombat(StartRoom, combat)
+}
+
+func TestDefeatedPlayerCannotBeHitBeforeRespawn(t *testing.T) {
+	rooms := map[RoomID]*Room{
+		StartRoom: {ID: StartRoom, NPCs: []NPC{{Name: "Wolf", Level: 1, Health: 100, MaxHealth: 100}}},
+		"home":    {ID: "home"},
+	}
+	world := NewWorldWithRooms(rooms)
+	victim := &Player{Name: "Victim", Room: StartRoom, Home: "home", Alive: true, Level: 1, Health: 1, MaxHealth: 50}
+	bully := &Player{Name: "Bully", Room: StartRoom, Alive: true, Level: 5}
+	world.AddPlayerForTest(victim)
+	world.AddPlayerForTest(bully)
+	victim.Health = 1
+
+	// The killing blow without the respawn that normally follows it.
+	result, err := world.damageRoomPlayer(bully, "Victim", 10)
+	if err != nil || !result.Defeated {
+		t.Fatalf("damageRoomPlayer = %+v, %v; want a defeat", result, err)
+	}
+	if _, err := world.damageRoomPlayer(bully, "Victim", 10); err == nil {
+		t.Fatalf("hit a player who had fallen but not yet respawned")
+	}
+	if _, err := world.damagePlayerFromNPC(StartRoom, victim, 10); err == nil {
+		t.Fatalf("an NPC hit a player who had fallen but not yet respawned")
+	}
+	if _, err := world.damageRoomPlayer(victim, "Bully", 10); err == nil {
+		t.Fatalf("a fallen player attacked before respawning")
+	}
+
+	world.respawnPlayer(victim, result.PreviousRoom)
+	if victim.Room != "home" || victim.defeated {
+		t.Fatalf("after respawn victim is in %q, defeated = %v", victim.Room, victim.defeated)
+	}
+}
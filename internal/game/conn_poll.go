@@ -0,0 +1,469 @@
+package game
+
+import (
+	"bufio"
+	"errors"
+	"fmt"
+	"runtime"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"syscall"
+)
+
+// ConnMode selects how sessions are served once a player has logged in.
+type ConnMode string
+
+const (
+	// ConnModeGoroutine gives every session a goroutine blocked reading
+	// input plus one writing its output.
+	ConnModeGoroutine ConnMode = "goroutine"
+	// ConnModePoll parks idle sessions in an epoll set. A small pool of loop
+	// goroutines reads, dispatches and flushes sessions only while they
+	// have work, so an idle session holds no goroutine stacks.
+	ConnModePoll ConnMode = "poll"
+)
+
+// ParseConnMode converts a flag value into a ConnMode.
+func ParseConnMode(value string) (ConnMode, error) {
+	switch mode := ConnMode(strings.ToLower(strings.TrimSpace(value))); mode {
+	case ConnModeGoroutine, ConnModePoll:
+		return mode, nil
+	case "":
+		return ConnModeGoroutine, nil
+	default:
+		return "", fmt.Errorf("unknown connection mode %q", value)
+	}
+}
+
+const (
+	// pollLinesPerTurn caps the lines one session runs before its loop
+	// goroutine moves on to other sessions.
+	pollLinesPerTurn = 16
+	// pollReadBuffer sizes the pooled input buffers. It must hold the
+	// longest subnegotiation ReadLine accepts.
+	pollReadBuffer = 2048
+)
+
+// errWouldBlock is returned by a poll session's reads and writes when the
+// socket has no more input, or no room for more output, for now.
+var errWouldBlock = errors.New("connection not ready")
+
+// pollReaders holds input buffers between bursts, so idle sessions keep none.
+var pollReaders = sync.Pool{New: func() any { return bufio.NewReaderSize(nil, pollReadBuffer) }}
+
+// connPoller serves logged-in sessions from an epoll set and a fixed pool of
+// loop goroutines instead of goroutines of their own.
+type connPoller struct {
+	ep *epoller
+
+	mu       sync.Mutex
+	sessions map[int]*pollSession
+	tasks    []func()
+	head     int
+	ready    *sync.Cond
+	closed   bool
+}
+
+func newConnPoller(workers int) (*connPoller, error) {
+	ep, err := newEpoller()
+	if err != nil {
+		return nil, err
+	}
+	if workers <= 0 {
+		workers = max(4, 2*runtime.GOMAXPROCS(0))
+	}
+	p := &connPoller{ep: ep, sessions: make(map[int]*pollSession)}
+	p.ready = sync.NewCond(&p.mu)
+	for i := 0; i < workers; i++ {
+		go p.work()
+	}
+	go func() {
+		if err := ep.wait(p.event); err != nil {
+			fmt.Printf("failed to wait for connection events: %v\n", err)
+		}
+	}()
+	return p, nil
+}
+
+func (p *connPoller) close() {
+	p.mu.Lock()
+	if p.closed {
+		p.mu.Unlock()
+		return
+	}
+	p.closed = true
+	p.ready.Broadcast()
+	p.mu.Unlock()
+	p.ep.close()
+}
+
+// schedule queues task for the next free loop goroutine. It never blocks.
+func (p *connPoller) schedule(task func()) {
+	p.mu.Lock()
+	if !p.closed {
+		p.tasks = append(p.tasks, task)
+		p.ready.Signal()
+	}
+	p.mu.Unlock()
+}
+
+func (p *connPoller) work() {
+	for {
+		p.mu.Lock()
+		for p.head == len(p.tasks) && !p.closed {
+			p.ready.Wait()
+		}
+		if p.closed {
+			p.mu.Unlock()
+			return
+		}
+		task := p.tasks[p.head]
+		p.tasks[p.head] = nil
+		p.head++
+		if p.head == len(p.tasks) {
+			p.tasks, p.head = p.tasks[:0], 0
+		}
+		p.mu.Unlock()
+		task()
+	}
+}
+
+func (p *connPoller) event(fd int, readable, writable bool) {
+	p.mu.Lock()
+	ps := p.sessions[fd]
+	p.mu.Unlock()
+	if ps == nil {
+		return
+	}
+	input, output := ps.fired(readable, writable)
+	if input {
+		p.schedule(ps.inputTask)
+	}
+	if output {
+		p.schedule(ps.flushTask)
+	}
+}
+
+// attach hands session's output to the poller. It returns nil, leaving the
+// session to the goroutine model, for connections without a pollable file
+// descriptor such as TLS.
+func (p *connPoller) attach(world *World, player *Player, session *TelnetSession, dispatcher Dispatcher) *pollSession {
+	conn, ok := session.conn.(syscall.Conn)
+	if !ok {
+		return nil
+	}
+	raw, err := conn.SyscallConn()
+	if err != nil {
+		return nil
+	}
+	fd := -1
+	if err := raw.Control(func(sysfd uintptr) { fd = int(sysfd) }); err != nil || fd < 0 {
+		return nil
+	}
+	ps := &pollSession{
+		poller:     p,
+		world:      world,
+		player:     player,
+		session:    session,
+		dispatcher: dispatcher,
+		raw:        raw,
+		fd:         fd,
+	}
+	ps.inputTask, ps.flushTask = ps.serveInput, ps.flush
+
+	p.mu.Lock()
+	if p.closed {
+		p.mu.Unlock()
+		return nil
+	}
+	p.sessions[fd] = ps
+	p.mu.Unlock()
+	session.poll.Store(ps)
+	session.output.setOnPush(ps.scheduleFlush)
+	ps.scheduleFlush()
+	return ps
+}
+
+func (p *connPoller) forget(ps *pollSession) {
+	p.mu.Lock()
+	if p.sessions[ps.fd] == ps {
+		delete(p.sessions, ps.fd)
+	}
+	p.mu.Unlock()
+}
+
+// pollSession is one logged-in session served by a connPoller.
+type pollSession struct {
+	poller     *connPoller
+	world      *World
+	player     *Player
+	session    *TelnetSession
+	dispatcher Dispatcher
+	raw        syscall.RawConn
+	fd         int
+	// pending holds input the login reader had buffered at hand-over.
+	pending []byte
+
+	inputTask func()
+	flushTask func()
+	// reading and flushing ensure only one loop goroutine handles the
+	// session's input, and one its output, at a time.
+	reading  atomic.Bool
+	flushing atomic.Bool
+
+	// mu guards the epoll registration so a descriptor is never re-armed
+	// after it has been closed and possibly reused. wantRead and wantWrite
+	// record what the registration is armed for.
+	mu         sync.Mutex
+	registered bool
+	closed     bool
+	wantRead   bool
+	wantWrite  bool
+
+	// unsentMu guards unsent, the encoded output the socket has not yet
+	// accepted. The flush task writes it without blocking and, when the
+	// socket is full, waits for it to become writable.
+	unsentMu sync.Mutex
+	unsent   []byte
+}
+
+// start takes over reading from the goroutine that logged the player in.
+func (ps *pollSession) start() {
+	s := ps.session
+	if s.reader != nil && s.reader.Buffered() > 0 {
+		buffered, _ := s.reader.Peek(s.reader.Buffered())
+		ps.pending = append([]byte(nil), buffered...)
+	}
+	s.reader = nil
+	ps.poller.schedule(ps.inputTask)
+}
+
+// Read reads what the socket has without blocking, returning errWouldBlock
+// when it has nothing.
+func (ps *pollSession) Read(b []byte) (int, error) {
+	if len(ps.pending) > 0 {
+		n := copy(b, ps.pending)
+		ps.pending = ps.pending[n:]
+		if len(ps.pending) == 0 {
+			ps.pending = nil
+		}
+		return n, nil
+	}
+	return readNonblocking(ps.raw, b)
+}
+
+// serveInput runs the lines the client has sent, then waits for more.
+func (ps *pollSession) serveInput() {
+	if !ps.reading.CompareAndSwap(false, true) {
+		return
+	}
+	s := ps.session
+	if s.reader == nil {
+		reader := pollReaders.Get().(*bufio.Reader)
+		reader.Reset(ps)
+		s.reader = reader
+	}
+	for i := 0; i < pollLinesPerTurn; i++ {
+		line, err := s.ReadLine()
+		if err == errWouldBlock {
+			if s.reader.Buffered() == 0 {
+				reader := s.reader
+				s.reader = nil
+				reader.Reset(nil)
+				pollReaders.Put(reader)
+			}
+			ps.reading.Store(false)
+			if err := ps.arm(); err != nil {
+				fmt.Printf("failed to watch connection: %v\n", err)
+				ps.finish()
+			}
+			return
+		}
+		if err != nil || !serveLine(ps.world, ps.player, ps.dispatcher, line) {
+			ps.finish()
+			return
+		}
+	}
+	ps.reading.Store(false)
+	ps.poller.schedule(ps.inputTask)
+}
+
+// arm waits for the session's next input.
+func (ps *pollSession) arm() error {
+	ps.mu.Lock()
+	defer ps.mu.Unlock()
+	ps.wantRead = true
+	return ps.registerLocked()
+}
+
+// armWrite waits for the socket to accept more output.
+func (ps *pollSession) armWrite() error {
+	ps.mu.Lock()
+	defer ps.mu.Unlock()
+	ps.wantWrite = true
+	return ps.registerLocked()
+}
+
+func (ps *pollSession) registerLocked() error {
+	if ps.closed {
+		return nil
+	}
+	if ps.registered {
+		return ps.poller.ep.rearm(ps.fd, ps.wantRead, ps.wantWrite)
+	}
+	if err := ps.poller.ep.add(ps.fd, ps.wantRead, ps.wantWrite); err != nil {
+		return err
+	}
+	ps.registered = true
+	return nil
+}
+
+// fired records an epoll event, which disarms the one-shot registration,
+// and reports which tasks it wakes. Interest the event did not satisfy is
+// armed again.
+func (ps *pollSession) fired(readable, writable bool) (input, output bool) {
+	ps.mu.Lock()
+	defer ps.mu.Unlock()
+	if ps.closed {
+		return false, false
+	}
+	input = readable && ps.wantRead
+	output = writable && ps.wantWrite
+	ps.wantRead = ps.wantRead && !input
+	ps.wantWrite = ps.wantWrite && !output
+	if ps.wantRead || ps.wantWrite {
+		if err := ps.poller.ep.rearm(ps.fd, ps.wantRead, ps.wantWrite); err != nil {
+			fmt.Printf("failed to watch connection: %v\n", err)
+		}
+	}
+	return input, output
+}
+
+// detach removes the session from the poller before its connection closes.
+func (ps *pollSession) detach() {
+	ps.mu.Lock()
+	if ps.closed {
+		ps.mu.Unlock()
+		return
+	}
+	ps.closed = true
+	if ps.registered {
+		_ = ps.poller.ep.remove(ps.fd)
+	}
+	ps.mu.Unlock()
+	ps.poller.forget(ps)
+}
+
+// finish logs the player out after the input ends or the player quits. The
+// connection closes once the farewell has been flushed.
+func (ps *pollSession) finish() {
+	if ps.player.Session == ps.session {
+		logout(ps.world, ps.player)
+	}
+	ps.session.output.close(false)
+}
+
+func (ps *pollSession) scheduleFlush() {
+	if ps.flushing.CompareAndSwap(false, true) {
+		ps.poller.schedule(ps.flushTask)
+	}
+}
+
+// queueWire appends encoded output for the flush task to write. In poll
+// mode every write to the connection goes through it, so nothing a loop
+// goroutine does waits for the client.
+func (ps *pollSession) queueWire(data []byte) {
+	ps.unsentMu.Lock()
+	ps.unsent = append(ps.unsent, data...)
+	ps.unsentMu.Unlock()
+	ps.scheduleFlush()
+}
+
+// writeUnsent writes as much of the unsent output as the socket accepts. It
+// reports false, with no error, when some is left for the socket to drain.
+func (ps *pollSession) writeUnsent() (bool, error) {
+	ps.unsentMu.Lock()
+	defer ps.unsentMu.Unlock()
+	for len(ps.unsent) > 0 {
+		n, err := writeNonblocking(ps.raw, ps.unsent)
+		if err == errWouldBlock {
+			return false, nil
+		}
+		if err != nil {
+			return false, err
+		}
+		ps.unsent = ps.unsent[:copy(ps.unsent, ps.unsent[n:])]
+	}
+	if cap(ps.unsent) > outputBufferRetain {
+		ps.unsent = nil
+	}
+	return true, nil
+}
+
+func (ps *pollSession) hasUnsent() bool {
+	ps.unsentMu.Lock()
+	defer ps.unsentMu.Unlock()
+	return len(ps.unsent) > 0
+}
+
+// flush writes the queued output and closes the connection once the queue
+// has been closed and emptied. It never blocks: when the socket is full the
+// rest stays in unsent and the flush resumes once the socket is writable. A
+// client that stays full for the output stall timeout is disconnected by its
+// output queue.
+func (ps *pollSession) flush() {
+	s := ps.session
+	batch := make([]string, 0, 16)
+	for {
+		sent, err := ps.writeUnsent()
+		if err != nil {
+			s.output.close(true)
+			ps.closeFlushed()
+			return
+		}
+		if !sent {
+			if err := ps.armWrite(); err != nil {
+				fmt.Printf("failed to watch connection: %v\n", err)
+				s.output.close(true)
+				ps.closeFlushed()
+			}
+			return
+		}
+		var open bool
+		batch, open = s.output.take(batch[:0], outputBatchLimit)
+		if len(batch) == 0 {
+			s.output.written()
+			if !open {
+				ps.closeFlushed()
+				return
+			}
+			ps.flushing.Store(false)
+			if (!s.output.pending() && !ps.hasUnsent()) || !ps.flushing.CompareAndSwap(false, true) {
+				return
+			}
+			continue
+		}
+		// The batch is only encoded here; writeUnsent sends it.
+		_ = s.WriteBatch(batch)
+		clear(batch)
+	}
+}
+
+func (ps *pollSession) closeFlushed() {
+	_ = ps.session.Close()
+	ps.session.markFlushed()
+}
+
+// connPoller returns the poller serving logged-in sessions, or nil when each
+// session has its own goroutines.
+func (w *World) connPoller() *connPoller {
+	if w == nil {
+		return nil
+	}
+	return w.poller
+}
+
+func (w *World) useConnPoller(p *connPoller) {
+	w.poller = p
+}
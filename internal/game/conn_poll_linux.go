@@ -0,0 +1,136 @@
+//go:build linux
+
+package game
+
+import (
+	"io"
+	"sync/atomic"
+	"syscall"
+)
+
+// epoller is a level-triggered, one-shot epoll set: a descriptor reports
+// readiness once and is then silent until re-armed. Each arming says whether
+// the caller waits to read, to write, or both.
+type epoller struct {
+	fd     int
+	closed atomic.Bool
+}
+
+const (
+	epollReadable = syscall.EPOLLIN | syscall.EPOLLRDHUP | syscall.EPOLLERR | syscall.EPOLLHUP
+	epollWritable = syscall.EPOLLOUT | syscall.EPOLLERR | syscall.EPOLLHUP
+	// epollWaitMillis bounds each wait so a closed poller is noticed.
+	epollWaitMillis = 1000
+)
+
+func newEpoller() (*epoller, error) {
+	fd, err := syscall.EpollCreate1(syscall.EPOLL_CLOEXEC)
+	if err != nil {
+		return nil, err
+	}
+	return &epoller{fd: fd}, nil
+}
+
+func epollInterest(fd int, read, write bool) *syscall.EpollEvent {
+	events := uint32(syscall.EPOLLONESHOT)
+	if read {
+		events |= syscall.EPOLLIN | syscall.EPOLLRDHUP
+	}
+	if write {
+		events |= syscall.EPOLLOUT
+	}
+	return &syscall.EpollEvent{Events: events, Fd: int32(fd)}
+}
+
+func (e *epoller) add(fd int, read, write bool) error {
+	return syscall.EpollCtl(e.fd, syscall.EPOLL_CTL_ADD, fd, epollInterest(fd, read, write))
+}
+
+func (e *epoller) rearm(fd int, read, write bool) error {
+	return syscall.EpollCtl(e.fd, syscall.EPOLL_CTL_MOD, fd, epollInterest(fd, read, write))
+}
+
+func (e *epoller) remove(fd int) error {
+	var event syscall.EpollEvent
+	return syscall.EpollCtl(e.fd, syscall.EPOLL_CTL_DEL, fd, &event)
+}
+
+// wait calls ready for each descriptor that becomes readable or writable
+// until the epoller is closed. Errors and hang-ups count as both.
+func (e *epoller) wait(ready func(fd int, readable, writable bool)) error {
+	var events [128]syscall.EpollEvent
+	for !e.closed.Load() {
+		n, err := syscall.EpollWait(e.fd, events[:], epollWaitMillis)
+		if err == syscall.EINTR {
+			continue
+		}
+		if err != nil {
+			if e.closed.Load() {
+				return nil
+			}
+			return err
+		}
+		for i := 0; i < n; i++ {
+			ev := events[i].Events
+			ready(int(events[i].Fd), ev&epollReadable != 0, ev&epollWritable != 0)
+		}
+	}
+	return nil
+}
+
+func (e *epoller) close() {
+	if e.closed.CompareAndSwap(false, true) {
+		_ = syscall.Close(e.fd)
+	}
+}
+
+// readNonblocking makes one read attempt on the connection's descriptor,
+// returning errWouldBlock instead of parking when nothing is waiting.
+func readNonblocking(raw syscall.RawConn, b []byte) (int, error) {
+	var n int
+	var err error
+	if cerr := raw.Read(func(fd uintptr) bool {
+		for {
+			n, err = syscall.Read(int(fd), b)
+			if err != syscall.EINTR {
+				return true
+			}
+		}
+	}); cerr != nil {
+		return 0, cerr
+	}
+	switch {
+	case err == syscall.EAGAIN:
+		return 0, errWouldBlock
+	case err != nil:
+		return 0, err
+	case n <= 0:
+		return 0, io.EOF
+	}
+	return n, nil
+}
+
+// writeNonblocking makes one write attempt on the connection's descriptor,
+// returning how much was written, or errWouldBlock when the socket's send
+// buffer is full, instead of parking.
+func writeNonblocking(raw syscall.RawConn, b []byte) (int, error) {
+	var n int
+	var err error
+	if cerr := raw.Write(func(fd uintptr) bool {
+		for {
+			n, err = syscall.Write(int(fd), b)
+			if err != syscall.EINTR {
+				return true
+			}
+		}
+	}); cerr != nil {
+		return 0, cerr
+	}
+	switch {
+	case err == syscall.EAGAIN:
+		return 0, errWouldBlock
+	case err != nil:
+		return 0, err
+	}
+	return n, nil
+}
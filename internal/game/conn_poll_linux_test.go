@@ -0,0 +1,191 @@
+//go:build linux
+
+package game
+
+import (
+	"bufio"
+	"net"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestConnPollerServesSession(t *testing.T) {
+	listener, err := net.Listen("tcp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatalf("listen: %v", err)
+	}
+	defer listener.Close()
+	client, err := net.Dial("tcp", listener.Addr().String())
+	if err != nil {
+		t.Fatalf("dial: %v", err)
+	}
+	defer client.Close()
+	server, err := listener.Accept()
+	if err != nil {
+		t.Fatalf("accept: %v", err)
+	}
+
+	poller, err := newConnPoller(2)
+	if err != nil {
+		t.Fatalf("newConnPoller: %v", err)
+	}
+	defer poller.close()
+
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	world.useConnPoller(poller)
+	session := NewTelnetSession(server)
+	player, err := world.addPlayer("Alice", session, false, PlayerProfile{})
+	if err != nil {
+		t.Fatalf("addPlayer: %v", err)
+	}
+	lines := make(chan string, 4)
+	dispatcher := func(w *World, p *Player, line string) bool {
+		lines <- line
+		p.Send("echo " + line + "\r\n")
+		return line == "quit"
+	}
+	ps := poller.attach(world, player, session, dispatcher)
+	if ps == nil {
+		t.Fatalf("expected a TCP session to be attached")
+	}
+	ps.start()
+
+	reader := bufio.NewReader(client)
+	_ = client.SetReadDeadline(time.Now().Add(5 * time.Second))
+	if _, err := client.Write([]byte("look\r\n")); err != nil {
+		t.Fatalf("write: %v", err)
+	}
+	if got := <-lines; got != "look" {
+		t.Fatalf("dispatched %q, want look", got)
+	}
+	if !readUntil(t, reader, "echo look") {
+		t.Fatalf("expected the command's output")
+	}
+
+	// Output sent from outside the session's own commands reaches it too.
+	player.Send("a shout\r\n")
+	if !readUntil(t, reader, "a shout") {
+		t.Fatalf("expected output sent by another goroutine")
+	}
+
+	if _, err := client.Write([]byte("quit\r\n")); err != nil {
+		t.Fatalf("write: %v", err)
+	}
+	if !readUntil(t, reader, "Until next time") {
+		t.Fatalf("expected the farewell before the connection closed")
+	}
+	deadline := time.Now().Add(5 * time.Second)
+	for {
+		poller.mu.Lock()
+		remaining := len(poller.sessions)
+		poller.mu.Unlock()
+		if remaining == 0 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("session still attached after quitting")
+		}
+		time.Sleep(time.Millisecond)
+	}
+	if _, ok := world.FindPlayer("Alice"); ok {
+		t.Fatalf("expected the player to be logged out")
+	}
+}
+
+// readUntil reads from r until a line containing want arrives, reporting
+// false if the connection ends first.
+func readUntil(t *testing.T, r *bufio.Reader, want string) bool {
+	t.Helper()
+	for {
+		line, err := r.ReadString('\n')
+		if strings.Contains(line, want) {
+			return true
+		}
+		if err != nil {
+			return false
+		}
+	}
+}
+
+func TestConnPollerKeepsServingWhileClientIsFull(t *testing.T) {
+	listener, err := net.Listen("tcp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatalf("listen: %v", err)
+	}
+	defer listener.Close()
+	client, err := net.Dial("tcp", listener.Addr().String())
+	if err != nil {
+		t.Fatalf("dial: %v", err)
+	}
+	defer client.Close()
+	_ = client.(*net.TCPConn).SetReadBuffer(16384)
+	server, err := listener.Accept()
+	if err != nil {
+		t.Fatalf("accept: %v", err)
+	}
+	_ = server.(*net.TCPConn).SetWriteBuffer(16384)
+
+	// A single loop goroutine: a flush that blocked on the full client
+	// would keep it from running the next command.
+	poller, err := newConnPoller(1)
+	if err != nil {
+		t.Fatalf("newConnPoller: %v", err)
+	}
+	defer poller.close()
+
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	world.useConnPoller(poller)
+	session := NewTelnetSession(server)
+	session.ConfigureOutput(OutputConfig{QueueBytes: 1 << 20})
+	player, err := world.addPlayer("Alice", session, false, PlayerProfile{})
+	if err != nil {
+		t.Fatalf("addPlayer: %v", err)
+	}
+	lines := make(chan string, 4)
+	dispatcher := func(w *World, p *Player, line string) bool {
+		lines <- line
+		p.Send("done " + line + "\r\n")
+		return false
+	}
+	ps := poller.attach(world, player, session, dispatcher)
+	if ps == nil {
+		t.Fatalf("expected a TCP session to be attached")
+	}
+	ps.start()
+
+	chunk := strings.Repeat("x", 1000) + "\r\n"
+	for i := 0; i < 512; i++ {
+		player.Send(chunk)
+	}
+	if _, err := client.Write([]byte("look\r\n")); err != nil {
+		t.Fatalf("write: %v", err)
+	}
+	select {
+	case got := <-lines:
+		if got != "look" {
+			t.Fatalf("dispatched %q, want look", got)
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatalf("a client that reads nothing held up the loop goroutine")
+	}
+
+	reader := bufio.NewReader(client)
+	_ = client.SetReadDeadline(time.Now().Add(5 * time.Second))
+	got := 0
+	for {
+		line, err := reader.ReadString('\n')
+		if err != nil {
+			t.Fatalf("read after %d chunks: %v", got, err)
+		}
+		if strings.Contains(line, "done look") {
+			break
+		}
+		if strings.Contains(line, chunk[:1000]) {
+			got++
+		}
+	}
+	if got != 512 {
+		t.Fatalf("read %d chunks before the command's reply, want 512", got)
+	}
+}
@@ -0,0 +1,23 @@
+//go:build !linux
+
+package game
+
+import (
+	"errors"
+	"syscall"
+)
+
+var errPollUnsupported = errors.New("poll connection mode requires Linux")
+
+type epoller struct{}
+
+func newEpoller() (*epoller, error) { return nil, errPollUnsupported }
+
+func (e *epoller) add(int, bool, bool) error                        { return errPollUnsupported }
+func (e *epoller) rearm(int, bool, bool) error                      { return errPollUnsupported }
+func (e *epoller) remove(int) error                                 { return errPollUnsupported }
+func (e *epoller) wait(func(fd int, readable, writable bool)) error { return errPollUnsupported }
+func (e *epoller) close()                                           {}
+
+func readNonblocking(syscall.RawConn, []byte) (int, error)  { return 0, errPollUnsupported }
+func writeNonblocking(syscall.RawConn, []byte) (int, error) { return 0, errPollUnsupported }
@@ -0,0 +1,92 @@
+package game
+
+import (
+	"bufio"
+	"io"
+	"strings"
+	"testing"
+)
+
+func TestParseConnMode(t *testing.T) {
+	cases := map[string]ConnMode{
+		"":          ConnModeGoroutine,
+		"goroutine": ConnModeGoroutine,
+		" Poll ":    ConnModePoll,
+	}
+	for value, want := range cases {
+		got, err := ParseConnMode(value)
+		if err != nil || got != want {
+			t.Fatalf("ParseConnMode(%q) = %q, %v; want %q", value, got, err, want)
+		}
+	}
+	if _, err := ParseConnMode("threads"); err == nil {
+		t.Fatalf("expected an unknown mode to be rejected")
+	}
+}
+
+func TestTelnetCommandLength(t *testing.T) {
+	cases := []struct {
+		data []byte
+		want int
+	}{
+		{[]byte{telnetIAC}, -1},
+		{[]byte{telnetIAC, telnetIAC}, 2},
+		{[]byte{telnetIAC, telnetWILL}, -1},
+		{[]byte{telnetIAC, telnetWILL, telnetOptTerminalType, 'x'}, 3},
+		{[]byte{telnetIAC, telnetSB, telnetOptWindowSize, 0, 80}, -1},
+		{[]byte{telnetIAC, telnetSB, telnetOptWindowSize, telnetIAC, telnetIAC, 0, telnetIAC, telnetSE, 'x'}, 8},
+	}
+	for _, tc := range cases {
+		if got := telnetCommandLength(tc.data); got != tc.want {
+			t.Fatalf("telnetCommandLength(%v) = %d, want %d", tc.data, got, tc.want)
+		}
+	}
+}
+
+// stutterReader serves its input a byte at a time, reporting errWouldBlock
+// before every byte the way a drained non-blocking socket does.
+type stutterReader struct {
+	data    string
+	blocked bool
+}
+
+func (r *stutterReader) Read(b []byte) (int, error) {
+	if len(r.data) == 0 {
+		return 0, io.EOF
+	}
+	if r.blocked = !r.blocked; r.blocked {
+		return 0, errWouldBlock
+	}
+	b[0] = r.data[0]
+	r.data = r.data[1:]
+	return 1, nil
+}
+
+func TestReadLineResumesAfterWouldBlock(t *testing.T) {
+	naws := string([]byte{telnetIAC, telnetSB, telnetOptWindowSize, 0, 120, 0, 40, telnetIAC, telnetSE})
+	will := string([]byte{telnetIAC, telnetWILL, telnetOptTerminalType})
+	input := "look\r\nsay hi" + will + " there\r\nx" + string([]byte{telnetIAC, telnetIAC}) + "y" + naws + "z\r\n"
+	session := &TelnetSession{conn: &chunkedConn{}, reader: bufio.NewReader(&stutterReader{data: input}), charset: "UTF-8"}
+
+	var got []string
+	for {
+		line, err := session.ReadLine()
+		if err == errWouldBlock {
+			continue
+		}
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			t.Fatalf("ReadLine: %v", err)
+		}
+		got = append(got, line)
+	}
+	want := []string{"look", "say hi there", "x\xffyz"}
+	if strings.Join(got, "|") != strings.Join(want, "|") {
+		t.Fatalf("lines = %q, want %q", got, want)
+	}
+	if session.width != 120 || session.height != 40 {
+		t.Fatalf("window size = %dx%d, want 120x40", session.width, session.height)
+	}
+}
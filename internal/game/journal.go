@@ -0,0 +1,309 @@
+package game
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"strings"
+	"sync"
+	"time"
+)
+
+// JournalSync selects when journal appends are flushed to stable storage.
+type JournalSync string
+
+const (
+	// JournalSyncAlways fsyncs after every append.
+	JournalSyncAlways JournalSync = "always"
+	// JournalSyncInterval fsyncs an append only when the previous fsync is
+	// older than the configured interval, and once more when appends stop for
+	// an interval. Compaction and Close always sync.
+	JournalSyncInterval JournalSync = "interval"
+	// JournalSyncNever leaves flushing to the operating system.
+	JournalSyncNever JournalSync = "never"
+)
+
+const (
+	defaultJournalSyncInterval = time.Second
+	defaultJournalCompactAfter = 256
+)
+
+// JournalConfig tunes the append-only journals kept beside the mail, offline
+// tell and builder area snapshots.
+type JournalConfig struct {
+	Sync         JournalSync
+	SyncInterval time.Duration
+	// CompactAfter is the number of journal records after which the store is
+	// rewritten as a JSON snapshot and the journal is truncated.
+	CompactAfter int
+}
+
+// DefaultJournalConfig returns the journal settings used when none are supplied.
+func DefaultJournalConfig() JournalConfig {
+	return JournalConfig{
+		Sync:         JournalSyncInterval,
+		SyncInterval: defaultJournalSyncInterval,
+		CompactAfter: defaultJournalCompactAfter,
+	}
+}
+
+// ParseJournalSync validates a journal sync policy supplied on the command line.
+func ParseJournalSync(value string) (JournalSync, error) {
+	switch JournalSync(strings.ToLower(strings.TrimSpace(value))) {
+	case "", JournalSyncInterval:
+		return JournalSyncInterval, nil
+	case JournalSyncAlways:
+		return JournalSyncAlways, nil
+	case JournalSyncNever:
+		return JournalSyncNever, nil
+	default:
+		return "", fmt.Errorf("unknown journal sync policy %q (want always, interval or never)", value)
+	}
+}
+
+func (c JournalConfig) normalized() JournalConfig {
+	defaults := DefaultJournalConfig()
+	if c.Sync == "" {
+		c.Sync = defaults.Sync
+	}
+	if c.SyncInterval <= 0 {
+		c.SyncInterval = defaults.SyncInterval
+	}
+	if c.CompactAfter <= 0 {
+		c.CompactAfter = defaults.CompactAfter
+	}
+	return c
+}
+
+// journal is an append-only file of JSON records, one per line, that sits
+// beside a store's JSON snapshot. Every record carries a sequence number and
+// the snapshot remembers the last one it includes, so replaying a journal
+// that survived a crash during compaction never applies a record twice.
+//
+// The owning store serialises every call; mu only guards the file against
+// the idle sync timer.
+type journal struct {
+	path    string
+	cfg     JournalConfig
+	seq     uint64
+	records int
+
+	mu sync.Mutex
+	// size is the length of the file up to its last complete record.
+	size int64
+	// torn is set when a failed append could not be cut back to size.
+	torn      bool
+	file      *os.File
+	dirty     bool
+	lastSync  time.Time
+	idleTimer *time.Timer
+}
+
+type journalRecord struct {
+	Seq uint64 `json:"seq"`
+}
+
+func newJournal(snapshotPath string, cfg JournalConfig) *journal {
+	return &journal{path: snapshotPath + ".journal", cfg: cfg.normalized()}
+}
+
+// replay calls apply for every record newer than snapshotSeq. A torn final
+// line left by a crash mid-append is discarded and trimmed from the file.
+func (j *journal) replay(snapshotSeq uint64, apply func(line []byte) error) error {
+	j.seq = snapshotSeq
+	file, err := os.Open(j.path)
+	if errors.Is(err, os.ErrNotExist) {
+		return nil
+	}
+	if err != nil {
+		return fmt.Errorf("open journal: %w", err)
+	}
+	defer file.Close()
+
+	reader := bufio.NewReader(file)
+	var valid int64
+	for lineNo := 1; ; lineNo++ {
+		line, err := reader.ReadBytes('\n')
+		if errors.Is(err, io.EOF) {
+			if len(bytes.TrimSpace(line)) > 0 {
+				if truncErr := os.Truncate(j.path, valid); truncErr != nil {
+					return fmt.Errorf("trim torn journal record: %w", truncErr)
+				}
+			}
+			return nil
+		}
+		if err != nil {
+			return fmt.Errorf("read journal: %w", err)
+		}
+		valid += int64(len(line))
+		trimmed := bytes.TrimSpace(line)
+		if len(trimmed) == 0 {
+			continue
+		}
+		var header journalRecord
+		if err := json.Unmarshal(trimmed, &header); err != nil {
+			return fmt.Errorf("decode journal line %d: %w", lineNo, err)
+		}
+		if header.Seq <= snapshotSeq {
+			continue
+		}
+		if err := apply(trimmed); err != nil {
+			return fmt.Errorf("apply journal line %d: %w", lineNo, err)
+		}
+		j.seq = header.Seq
+		j.records++
+	}
+}
+
+// nextSeq returns the sequence number for the next record.
+func (j *journal) nextSeq() uint64 {
+	return j.seq + 1
+}
+
+// append writes one record, which must embed the sequence from nextSeq. A
+// write that fails part way is cut back off the file, so the next record
+// never lands after half a line.
+func (j *journal) append(record any) error {
+	data, err := json.Marshal(record)
+	if err != nil {
+		return fmt.Errorf("encode journal record: %w", err)
+	}
+	data = append(data, '\n')
+	j.mu.Lock()
+	defer j.mu.Unlock()
+	if err := j.openLocked(); err != nil {
+		return err
+	}
+	if j.torn {
+		if err := j.file.Truncate(j.size); err != nil {
+			return fmt.Errorf("trim failed journal append: %w", err)
+		}
+		j.torn = false
+	}
+	if _, err := j.file.Write(data); err != nil {
+		if truncErr := j.file.Truncate(j.size); truncErr != nil {
+			j.torn = true
+		}
+		return fmt.Errorf("append journal record: %w", err)
+	}
+	j.size += int64(len(data))
+	j.dirty = true
+	j.seq++
+	j.records++
+	switch j.cfg.Sync {
+	case JournalSyncAlways:
+		return j.syncLocked()
+	case JournalSyncInterval:
+		if time.Since(j.lastSync) >= j.cfg.SyncInterval {
+			return j.syncLocked()
+		}
+		if j.idleTimer == nil {
+			j.idleTimer = time.AfterFunc(j.cfg.SyncInterval, j.idleSync)
+		}
+	}
+	return nil
+}
+
+func (j *journal) openLocked() error {
+	if j.file != nil {
+		return nil
+	}
+	file, err := os.OpenFile(j.path, os.O_WRONLY|os.O_CREATE|os.O_APPEND, 0o644)
+	if err != nil {
+		return fmt.Errorf("open journal: %w", err)
+	}
+	info, err := file.Stat()
+	if err != nil {
+		_ = file.Close()
+		return fmt.Errorf("stat journal: %w", err)
+	}
+	j.file = file
+	if !j.torn {
+		j.size = info.Size()
+	}
+	return nil
+}
+
+// idleSync flushes the records appended since the last fsync once appends
+// have been quiet for a sync interval.
+func (j *journal) idleSync() {
+	j.mu.Lock()
+	defer j.mu.Unlock()
+	j.idleTimer = nil
+	if err := j.syncLocked(); err != nil {
+		fmt.Printf("failed to sync journal %s: %v\n", j.path, err)
+	}
+}
+
+func (j *journal) stopIdleSyncLocked() {
+	if j.idleTimer != nil {
+		j.idleTimer.Stop()
+		j.idleTimer = nil
+	}
+}
+
+func (j *journal) syncLocked() error {
+	if j.file == nil || !j.dirty {
+		return nil
+	}
+	defer observeFlush("journal_fsync", time.Now())
+	if err := j.file.Sync(); err != nil {
+		return fmt.Errorf("sync journal: %w", err)
+	}
+	j.dirty = false
+	j.lastSync = time.Now()
+	return nil
+}
+
+func (j *journal) needsCompaction() bool {
+	return j.records >= j.cfg.CompactAfter
+}
+
+// truncate discards the journal after its records have been folded into a
+// snapshot that was written with the current sequence number.
+func (j *journal) truncate() error {
+	j.mu.Lock()
+	defer j.mu.Unlock()
+	j.stopIdleSyncLocked()
+	if j.file != nil {
+		_ = j.file.Close()
+		j.file = nil
+	}
+	if err := os.Remove(j.path); err != nil && !errors.Is(err, os.ErrNotExist) {
+		return fmt.Errorf("remove journal: %w", err)
+	}
+	j.records = 0
+	j.size = 0
+	j.torn = false
+	j.dirty = false
+	return nil
+}
+
+// close syncs whatever is still unflushed and closes the file.
+func (j *journal) close() error {
+	j.mu.Lock()
+	defer j.mu.Unlock()
+	j.stopIdleSyncLocked()
+	if j.file == nil {
+		return nil
+	}
+	err := j.syncLocked()
+	if closeErr := j.file.Close(); err == nil && closeErr != nil {
+		err = fmt.Errorf("close journal: %w", closeErr)
+	}
+	j.file = nil
+	return err
+}
+
+// syncFile flushes a freshly written snapshot before it replaces the old one,
+// so a truncated journal is never the only copy of its records.
+func syncFile(file *os.File) error {
+	if err := file.Sync(); err != nil {
+		return fmt.Errorf("sync %s: %w", file.Name(), err)
+	}
+	return nil
+}
@@ -0,0 +1,83 @@
+package game
+
+import (
+	"encoding/json"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+	"time"
+)
+
+func TestJournalCutsBackAFailedAppend(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "store.json")
+	j := newJournal(path, JournalConfig{Sync: JournalSyncNever})
+	if err := j.append(journalRecord{Seq: j.nextSeq()}); err != nil {
+		t.Fatalf("append: %v", err)
+	}
+
+	// A read-only handle makes the next write fail and its cleanup fail too,
+	// and the half line it might have left is written by hand.
+	writable := j.file
+	readOnly, err := os.Open(j.path)
+	if err != nil {
+		t.Fatalf("open journal: %v", err)
+	}
+	j.file = readOnly
+	if err := j.append(journalRecord{Seq: j.nextSeq()}); err == nil {
+		t.Fatalf("append through a read-only handle should fail")
+	}
+	readOnly.Close()
+	if _, err := writable.WriteString(`{"seq":2,"op`); err != nil {
+		t.Fatalf("write torn record: %v", err)
+	}
+	j.file = writable
+
+	if err := j.append(journalRecord{Seq: j.nextSeq()}); err != nil {
+		t.Fatalf("append after failure: %v", err)
+	}
+	if err := j.close(); err != nil {
+		t.Fatalf("close: %v", err)
+	}
+
+	var seqs []uint64
+	replayed := newJournal(path, DefaultJournalConfig())
+	if err := replayed.replay(0, func(line []byte) error {
+		var record journalRecord
+		if err := json.Unmarshal(line, &record); err != nil {
+			return err
+		}
+		seqs = append(seqs, record.Seq)
+		return nil
+	}); err != nil {
+		t.Fatalf("replay: %v", err)
+	}
+	if !reflect.DeepEqual(seqs, []uint64{1, 2}) {
+		t.Fatalf("replayed sequences = %v, want [1 2]", seqs)
+	}
+}
+
+func TestJournalSyncsAfterAppendsStop(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "store.json")
+	j := newJournal(path, JournalConfig{Sync: JournalSyncInterval, SyncInterval: 20 * time.Millisecond})
+	defer j.close()
+	for i := 0; i < 2; i++ {
+		if err := j.append(journalRecord{Seq: j.nextSeq()}); err != nil {
+			t.Fatalf("append: %v", err)
+		}
+	}
+
+	deadline := time.Now().Add(2 * time.Second)
+	for {
+		j.mu.Lock()
+		dirty := j.dirty
+		j.mu.Unlock()
+		if !dirty {
+			return
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("the last append was never synced")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+}
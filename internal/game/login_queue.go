@@ -0,0 +1,214 @@
+package game
+
+import (
+	"errors"
+	"fmt"
+	"runtime"
+	"sync"
+	"time"
+
+	"golang.org/x/crypto/bcrypt"
+)
+
+// loginQueueNotice is the least time between queue position updates sent to
+// one waiting client.
+const loginQueueNotice = 2 * time.Second
+
+// errLoginAbandoned reports that a client gave up its place in the login
+// queue, usually by disconnecting.
+var errLoginAbandoned = errors.New("login abandoned while queued")
+
+// LoginConfig bounds the password hashing done for logins and registrations.
+type LoginConfig struct {
+	// Workers is how many passwords may be hashed at once. Logins beyond it
+	// wait in a first-come, first-served queue.
+	Workers int
+	// Cost is the bcrypt cost used for new password hashes. Existing hashes
+	// keep the cost they were created with.
+	Cost int
+}
+
+// DefaultLoginConfig returns the login limits used when none are supplied.
+// Half the CPUs hash passwords, leaving the rest for players already in the
+// game however many clients reconnect at once.
+func DefaultLoginConfig() LoginConfig {
+	return LoginConfig{
+		Workers: max(1, runtime.GOMAXPROCS(0)/2),
+		Cost:    bcrypt.DefaultCost,
+	}
+}
+
+// Validate reports whether the configured bcrypt cost is usable.
+func (c LoginConfig) Validate() error {
+	if c.Cost != 0 && (c.Cost < bcrypt.MinCost || c.Cost > bcrypt.MaxCost) {
+		return fmt.Errorf("bcrypt cost must be between %d and %d", bcrypt.MinCost, bcrypt.MaxCost)
+	}
+	return nil
+}
+
+func (c LoginConfig) normalized() LoginConfig {
+	defaults := DefaultLoginConfig()
+	if c.Workers <= 0 {
+		c.Workers = defaults.Workers
+	}
+	if c.Validate() != nil || c.Cost == 0 {
+		c.Cost = defaults.Cost
+	}
+	return c
+}
+
+// loginQueue hands out a fixed number of password hashing slots in the order
+// they were asked for.
+type loginQueue struct {
+	mu      sync.Mutex
+	cfg     LoginConfig
+	running int
+	waiting []*loginTicket
+}
+
+// loginTicket is one caller waiting for a slot.
+type loginTicket struct {
+	// ready is closed once the ticket holds a slot.
+	ready   chan struct{}
+	granted bool
+	// position carries the ticket's latest 1-based place in the queue.
+	position chan int
+}
+
+func newLoginQueue(cfg LoginConfig) *loginQueue {
+	return &loginQueue{cfg: cfg.normalized()}
+}
+
+func (q *loginQueue) configure(cfg LoginConfig) {
+	q.mu.Lock()
+	q.cfg = cfg.normalized()
+	q.grantLocked()
+	q.mu.Unlock()
+}
+
+func (q *loginQueue) cost() int {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	return q.cfg.Cost
+}
+
+// queued reports how many callers are waiting for a slot.
+func (q *loginQueue) queued() int {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	return len(q.waiting)
+}
+
+// acquire blocks until the caller holds a hashing slot. While it waits,
+// notify is told the caller's place in the queue when it first joins and
+// then at most every loginQueueNotice; returning false gives up the place
+// and makes acquire fail with errLoginAbandoned. A nil notify waits
+// silently.
+func (q *loginQueue) acquire(notify func(position int) bool) error {
+	q.mu.Lock()
+	if len(q.waiting) == 0 && q.running < q.cfg.Workers {
+		q.running++
+		q.mu.Unlock()
+		serverMetrics.loginQueueWait.observe(0)
+		return nil
+	}
+	start := time.Now()
+	t := &loginTicket{ready: make(chan struct{}), position: make(chan int, 1)}
+	q.waiting = append(q.waiting, t)
+	t.position <- len(q.waiting)
+	q.mu.Unlock()
+
+	var noticed time.Time
+	for {
+		select {
+		case <-t.ready:
+			serverMetrics.loginQueueWait.observe(time.Since(start))
+			return nil
+		case position := <-t.position:
+			if notify == nil || time.Since(noticed) < loginQueueNotice {
+				continue
+			}
+			noticed = time.Now()
+			if !notify(position) {
+				q.abandon(t)
+				return errLoginAbandoned
+			}
+		}
+	}
+}
+
+// release returns a slot taken by acquire.
+func (q *loginQueue) release() {
+	q.mu.Lock()
+	q.running--
+	q.grantLocked()
+	q.mu.Unlock()
+}
+
+func (q *loginQueue) abandon(t *loginTicket) {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	if t.granted {
+		// The slot arrived as the caller gave up; pass it on.
+		q.running--
+		q.grantLocked()
+		return
+	}
+	for i, waiting := range q.waiting {
+		if waiting == t {
+			q.waiting = append(q.waiting[:i], q.waiting[i+1:]...)
+			break
+		}
+	}
+	q.renumberLocked()
+}
+
+// grantLocked hands free slots to the longest waiting callers.
+func (q *loginQueue) grantLocked() {
+	granted := 0
+	for q.running < q.cfg.Workers && granted < len(q.waiting) {
+		t := q.waiting[granted]
+		t.granted = true
+		close(t.ready)
+		q.running++
+		granted++
+	}
+	if granted == 0 {
+		return
+	}
+	clear(q.waiting[:granted])
+	q.waiting = q.waiting[granted:]
+	if len(q.waiting) == 0 {
+		q.waiting = nil
+	}
+	q.renumberLocked()
+}
+
+func (q *loginQueue) renumberLocked() {
+	for i, t := range q.waiting {
+		select {
+		case <-t.position:
+		default:
+		}
+		t.position <- i + 1
+	}
+}
+
+// hashing runs fn while holding a hashing slot.
+func (q *loginQueue) hashing(notify func(position int) bool, fn func()) error {
+	if err := q.acquire(notify); err != nil {
+		return err
+	}
+	defer q.release()
+	fn()
+	return nil
+}
+
+// loginQueueNotifier tells a waiting client its place in the login queue.
+// It reports false once the client can no longer be reached.
+func loginQueueNotifier(session *TelnetSession) func(int) bool {
+	return func(position int) bool {
+		notice := fmt.Sprintf("\r\nThe server is busy. You are number %d in the login queue; please wait.", position)
+		return session.WriteString(Ansi(Style(notice, AnsiYellow))) == nil
+	}
+}
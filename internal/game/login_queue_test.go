@@ -0,0 +1,97 @@
+package game
+
+import (
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestLoginQueueServesInOrder(t *testing.T) {
+	q := newLoginQueue(LoginConfig{Workers: 1})
+	if err := q.acquire(nil); err != nil {
+		t.Fatalf("acquire: %v", err)
+	}
+
+	var mu sync.Mutex
+	var order []int
+	positions := make([]chan int, 3)
+	var done sync.WaitGroup
+	for i := range positions {
+		positions[i] = make(chan int, len(positions))
+		done.Add(1)
+		go func(i int) {
+			defer done.Done()
+			err := q.hashing(func(position int) bool {
+				positions[i] <- position
+				return true
+			}, func() {
+				mu.Lock()
+				order = append(order, i)
+				mu.Unlock()
+			})
+			if err != nil {
+				t.Errorf("hashing: %v", err)
+			}
+		}(i)
+		// Wait for each caller to join before the next so the order is known.
+		if got := <-positions[i]; got != i+1 {
+			t.Fatalf("caller %d queued at %d, want %d", i, got, i+1)
+		}
+	}
+	if q.queued() != 3 {
+		t.Fatalf("queued = %d, want 3", q.queued())
+	}
+	q.release()
+	done.Wait()
+
+	if len(order) != 3 || order[0] != 0 || order[1] != 1 || order[2] != 2 {
+		t.Fatalf("served in order %v, want [0 1 2]", order)
+	}
+	if q.running != 0 || q.queued() != 0 {
+		t.Fatalf("queue left %d running and %d waiting", q.running, q.queued())
+	}
+}
+
+func TestLoginQueueAbandonFreesPlace(t *testing.T) {
+	q := newLoginQueue(LoginConfig{Workers: 1})
+	if err := q.acquire(nil); err != nil {
+		t.Fatalf("acquire: %v", err)
+	}
+	if err := q.acquire(func(int) bool { return false }); err != errLoginAbandoned {
+		t.Fatalf("acquire = %v, want errLoginAbandoned", err)
+	}
+	if q.queued() != 0 {
+		t.Fatalf("an abandoned caller is still queued")
+	}
+
+	waited := make(chan error, 1)
+	go func() { waited <- q.acquire(nil) }()
+	deadline := time.Now().Add(5 * time.Second)
+	for q.queued() != 1 {
+		if time.Now().After(deadline) {
+			t.Fatalf("caller never queued")
+		}
+		time.Sleep(time.Millisecond)
+	}
+	q.release()
+	if err := <-waited; err != nil {
+		t.Fatalf("acquire: %v", err)
+	}
+	q.release()
+	if q.running != 0 {
+		t.Fatalf("running = %d after releasing every slot", q.running)
+	}
+}
+
+func TestLoginConfigValidatesCost(t *testing.T) {
+	if err := (LoginConfig{Cost: 3}).Validate(); err == nil {
+		t.Fatalf("expected a cost below bcrypt's minimum to be rejected")
+	}
+	if err := (LoginConfig{Cost: 12}).Validate(); err != nil {
+		t.Fatalf("Validate: %v", err)
+	}
+	cfg := LoginConfig{Workers: -1, Cost: 99}.normalized()
+	if cfg.Workers < 1 || cfg.Cost != DefaultLoginConfig().Cost {
+		t.Fatalf("normalized = %+v", cfg)
+	}
+}
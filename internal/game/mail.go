@@ -22,14 +22,33 @@ type MailMessage struct {
 	CreatedAt  time.Time `json:"created_at"`
 }
 
-// MailSystem manages persistent public board messages.
+// MailSystem manages persistent public board messages. New messages are
+// appended to a journal beside the JSON snapshot, which is rewritten only when
+// the journal is compacted.
 type MailSystem struct {
 	mu     sync.RWMutex
 	path   string
 	nextID int
 	boards map[string][]MailMessage
+
+	journal       *journal
+	snapshotSaved bool
+}
+
+type mailSnapshot struct {
+	NextID     int                      `json:"next_id"`
+	Boards     map[string][]MailMessage `json:"boards"`
+	JournalSeq uint64                   `json:"journal_seq,omitempty"`
 }
 
+type mailJournalEntry struct {
+	Seq     uint64       `json:"seq"`
+	Op      string       `json:"op"`
+	Message *MailMessage `json:"message,omitempty"`
+}
+
+const mailJournalPost = "post"
+
 // NewMailSystem constructs a mail system backed by the provided file path.
 // When path is empty the system operates purely in-memory without persistence.
 func NewMailSystem(path string) (*MailSystem, error) {
@@ -41,22 +60,17 @@ func NewMailSystem(path string) (*MailSystem, error) {
 	if strings.TrimSpace(path) == "" {
 		return ms, nil
 	}
+	ms.journal = newJournal(path, DefaultJournalConfig())
 	data, err := os.ReadFile(path)
-	if errors.Is(err, os.ErrNotExist) {
-		return ms, nil
-	}
-	if err != nil {
+	if err != nil && !errors.Is(err, os.ErrNotExist) {
 		return nil, fmt.Errorf("read mail file: %w", err)
 	}
-	if len(data) == 0 {
-		return ms, nil
-	}
-	var record struct {
-		NextID int                      `json:"next_id"`
-		Boards map[string][]MailMessage `json:"boards"`
-	}
-	if err := json.Unmarshal(data, &record); err != nil {
-		return nil, fmt.Errorf("decode mail file: %w", err)
+	var record mailSnapshot
+	if len(data) > 0 {
+		if err := json.Unmarshal(data, &record); err != nil {
+			return nil, fmt.Errorf("decode mail file: %w", err)
+		}
+		ms.snapshotSaved = true
 	}
 	if record.Boards != nil {
 		for name, messages := range record.Boards {
@@ -76,9 +90,52 @@ func NewMailSystem(path string) (*MailSystem, error) {
 	} else {
 		ms.nextID = ms.computeNextID()
 	}
+	if err := ms.journal.replay(record.JournalSeq, ms.applyJournalEntry); err != nil {
+		return nil, fmt.Errorf("replay mail journal: %w", err)
+	}
 	return ms, nil
 }
 
+func (m *MailSystem) applyJournalEntry(line []byte) error {
+	var entry mailJournalEntry
+	if err := json.Unmarshal(line, &entry); err != nil {
+		return err
+	}
+	if entry.Op != mailJournalPost || entry.Message == nil {
+		return fmt.Errorf("unknown mail journal op %q", entry.Op)
+	}
+	board := normalizeBoard(entry.Message.Board)
+	if board == "" {
+		return nil
+	}
+	msg := sanitizeLoadedMessage(board, *entry.Message)
+	m.boards[board] = append(m.boards[board], msg)
+	if msg.ID >= m.nextID {
+		m.nextID = msg.ID + 1
+	}
+	return nil
+}
+
+// SetJournalConfig changes the fsync policy and compaction threshold of the
+// mail journal.
+func (m *MailSystem) SetJournalConfig(cfg JournalConfig) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	if m.journal != nil {
+		m.journal.cfg = cfg.normalized()
+	}
+}
+
+// Close syncs and closes the mail journal.
+func (m *MailSystem) Close() error {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	if m.journal == nil {
+		return nil
+	}
+	return m.journal.close()
+}
+
 func sanitizeLoadedMessage(board string, msg MailMessage) MailMessage {
 	msg.Board = board
 	msg.Recipients = normalizeRecipients(msg.Recipients)
@@ -217,7 +274,7 @@ func (m *MailSystem) Write(board, author string, recipients []string, body strin
 	}
 	m.boards[key] = append(m.boards[key], msg)
 	m.nextID = msg.ID + 1
-	if err := m.saveLocked(); err != nil {
+	if err := m.persistLocked(msg); err != nil {
 		// Revert the append when persistence fails.
 		list := m.boards[key]
 		m.boards[key] = list[:len(list)-1]
@@ -227,6 +284,19 @@ func (m *MailSystem) Write(board, author string, recipients []string, body strin
 	return msg, nil
 }
 
+// persistLocked records a newly posted message. It is normally a single
+// journal append; the snapshot is rewritten when none exists yet or the
+// journal is due for compaction.
+func (m *MailSystem) persistLocked(msg MailMessage) error {
+	if strings.TrimSpace(m.path) == "" {
+		return nil
+	}
+	if m.journal == nil || !m.snapshotSaved || m.journal.needsCompaction() {
+		return m.saveLocked()
+	}
+	return m.journal.append(mailJournalEntry{Seq: m.journal.nextSeq(), Op: mailJournalPost, Message: &msg})
+}
+
 func (m *MailSystem) saveLocked() error {
 	if strings.TrimSpace(m.path) == "" {
 		return nil
@@ -239,13 +309,13 @@ func (m *MailSystem) saveLocked() error {
 	if err != nil {
 		return fmt.Errorf("create temp mail file: %w", err)
 	}
-	record := struct {
-		NextID int                      `json:"next_id"`
-		Boards map[string][]MailMessage `json:"boards"`
-	}{
+	record := mailSnapshot{
 		NextID: m.nextID,
 		Boards: m.boards,
 	}
+	if m.journal != nil {
+		record.JournalSeq = m.journal.seq
+	}
 	enc := json.NewEncoder(tmp)
 	enc.SetIndent("", "  ")
 	if err := enc.Encode(record); err != nil {
@@ -253,6 +323,13 @@ func (m *MailSystem) saveLocked() error {
 		os.Remove(tmp.Name())
 		return fmt.Errorf("write mail file: %w", err)
 	}
+	if m.journal != nil {
+		if err := syncFile(tmp); err != nil {
+			tmp.Close()
+			os.Remove(tmp.Name())
+			return err
+		}
+	}
 	if err := tmp.Close(); err != nil {
 		os.Remove(tmp.Name())
 		return fmt.Errorf("close temp mail file: %w", err)
@@ -261,6 +338,14 @@ func (m *MailSystem) saveLocked() error {
 		os.Remove(tmp.Name())
 		return fmt.Errorf("replace mail file: %w", err)
 	}
+	m.snapshotSaved = true
+	if m.journal != nil {
+		// Records left behind by a failed truncate are skipped on replay
+		// because the snapshot carries their sequence numbers.
+		if err := m.journal.truncate(); err != nil {
+			fmt.Printf("failed to truncate mail journal: %v\n", err)
+		}
+	}
 	return nil
 }
 
@@ -1,8 +1,10 @@
 package game
 
 import (
+	"fmt"
 	"os"
 	"path/filepath"
+	"strings"
 	"testing"
 )
 
@@ -70,3 +72,65 @@ func TestMailSystemMessagesForPlayerFilters(t *testing.T) {
 		t.Fatalf("sageMsgs len = %d, want 1", len(sageMsgs))
 	}
 }
+
+func TestMailSystemJournalsPostsAndCompacts(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "mail.json")
+	mail, err := NewMailSystem(path)
+	if err != nil {
+		t.Fatalf("NewMailSystem error: %v", err)
+	}
+	mail.SetJournalConfig(JournalConfig{Sync: JournalSyncNever, CompactAfter: 3})
+	for i := 0; i < 3; i++ {
+		if _, err := mail.Write("general", "Author", nil, fmt.Sprintf("Post %d", i)); err != nil {
+			t.Fatalf("Write %d: %v", i, err)
+		}
+	}
+	snapshot, err := os.ReadFile(path)
+	if err != nil {
+		t.Fatalf("read snapshot: %v", err)
+	}
+	if strings.Contains(string(snapshot), "Post 2") {
+		t.Fatalf("later posts should be journaled, not rewritten into the snapshot")
+	}
+	if _, err := os.Stat(path + ".journal"); err != nil {
+		t.Fatalf("expected journal file: %v", err)
+	}
+
+	// Simulate a crash that left half a record at the end of the journal.
+	journalFile, err := os.OpenFile(path+".journal", os.O_APPEND|os.O_WRONLY, 0o644)
+	if err != nil {
+		t.Fatalf("open journal: %v", err)
+	}
+	if _, err := journalFile.WriteString(`{"seq":99,"op":"po`); err != nil {
+		t.Fatalf("write torn record: %v", err)
+	}
+	journalFile.Close()
+
+	reloaded, err := NewMailSystem(path)
+	if err != nil {
+		t.Fatalf("reload NewMailSystem error: %v", err)
+	}
+	msgs := reloaded.Messages("general")
+	if len(msgs) != 3 || msgs[2].Body != "Post 2" || reloaded.nextID != 4 {
+		t.Fatalf("replayed messages = %#v (nextID %d)", msgs, reloaded.nextID)
+	}
+
+	reloaded.SetJournalConfig(JournalConfig{Sync: JournalSyncAlways, CompactAfter: 2})
+	if _, err := reloaded.Write("general", "Author", nil, "Post 3"); err != nil {
+		t.Fatalf("Write after replay: %v", err)
+	}
+	if _, err := os.Stat(path + ".journal"); !os.IsNotExist(err) {
+		t.Fatalf("journal should be removed after compaction, stat err = %v", err)
+	}
+	if err := reloaded.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	compacted, err := NewMailSystem(path)
+	if err != nil {
+		t.Fatalf("reload compacted: %v", err)
+	}
+	if msgs := compacted.Messages("general"); len(msgs) != 4 || msgs[3].ID != 4 {
+		t.Fatalf("compacted messages = %#v", msgs)
+	}
+}
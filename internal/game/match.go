@@ -1,6 +1,11 @@
 package game
 
-import "strings"
+import (
+	"sort"
+	"strings"
+	"unicode"
+	"unicode/utf8"
+)
 
 // uniqueMatch attempts to resolve the provided target string against a slice of
 // candidate names. It performs a case-insensitive comparison, supports prefix
@@ -8,30 +13,25 @@ import "strings"
 // the index of the uniquely matched candidate and true. If no match or an
 // ambiguous match is found, it returns -1 and false.
 func uniqueMatch(target string, names []string, matchWords bool) (int, bool) {
+	return uniqueMatchFunc(target, len(names), func(i int) string { return names[i] }, matchWords)
+}
+
+// uniqueMatchFunc is uniqueMatch over n candidates whose names are read
+// through name, so callers can match entities without first copying their
+// names into a slice. Candidates whose name is empty never match.
+func uniqueMatchFunc(target string, n int, name func(int) string, matchWords bool) (int, bool) {
 	trimmed := strings.TrimSpace(target)
 	if trimmed == "" {
 		return -1, false
 	}
-	normalized := strings.ToLower(trimmed)
 
 	partial := -1
 	ambiguous := false
-	for i, name := range names {
-		candidate := strings.ToLower(strings.TrimSpace(name))
-		if candidate == normalized {
+	for i := 0; i < n; i++ {
+		exact, match := matchName(name(i), trimmed, matchWords)
+		if exact {
 			return i, true
 		}
-
-		match := strings.HasPrefix(candidate, normalized)
-		if !match && matchWords {
-			for _, word := range strings.Fields(candidate) {
-				if strings.HasPrefix(word, normalized) {
-					match = true
-					break
-				}
-			}
-		}
-
 		if match {
 			if partial != -1 {
 				ambiguous = true
@@ -46,3 +46,136 @@ func uniqueMatch(target string, names []string, matchWords bool) (int, bool) {
 	}
 	return -1, false
 }
+
+// matchName reports whether target equals name, ignoring case and
+// surrounding space, or prefixes the name or, when words is set, one of its
+// words. Both sides are folded as they are compared, so a lookup neither
+// allocates nor touches shared state.
+func matchName(name, target string, words bool) (exact, partial bool) {
+	name = strings.TrimSpace(name)
+	if name == "" {
+		return false, false
+	}
+	if cmp, prefix := compareFold(name, target); prefix {
+		return cmp == 0, true
+	}
+	if !words {
+		return false, false
+	}
+	start := -1
+	for i, r := range name {
+		space := unicode.IsSpace(r)
+		if start < 0 && !space {
+			start = i
+		} else if start >= 0 && space {
+			if _, prefix := compareFold(name[start:i], target); prefix {
+				return false, true
+			}
+			start = -1
+		}
+	}
+	if start >= 0 {
+		if _, prefix := compareFold(name[start:], target); prefix {
+			return false, true
+		}
+	}
+	return false, false
+}
+
+// compareFold compares s and target, both lowered as they are read, like
+// strings.Compare, without allocating. prefix reports whether lowered target
+// is a prefix of lowered s.
+func compareFold(s, target string) (cmp int, prefix bool) {
+	i := 0
+	for _, tr := range target {
+		if i >= len(s) {
+			return -1, false
+		}
+		r, size := rune(s[i]), 1
+		if r >= utf8.RuneSelf {
+			r, size = utf8.DecodeRuneInString(s[i:])
+		}
+		r, tr = unicode.ToLower(r), unicode.ToLower(tr)
+		if r != tr {
+			if r < tr {
+				return -1, false
+			}
+			return 1, false
+		}
+		i += size
+	}
+	if i < len(s) {
+		return 1, true
+	}
+	return 0, true
+}
+
+// playerNameEntry is one online player in the world's sorted name index,
+// under its name folded once when the player joins or is renamed.
+type playerNameEntry struct {
+	folded string
+	player *Player
+}
+
+// indexPlayerNameLocked adds p to the sorted player name index, replacing any
+// player previously stored under the same name. Callers must hold w.mu for
+// writing.
+func (w *World) indexPlayerNameLocked(p *Player) {
+	folded := strings.ToLower(strings.TrimSpace(p.Name))
+	i := sort.Search(len(w.playerNames), func(i int) bool {
+		return w.playerNames[i].folded >= folded
+	})
+	for j := i; j < len(w.playerNames) && w.playerNames[j].folded == folded; j++ {
+		if existing := w.playerNames[j].player; existing == p || existing.Name == p.Name {
+			w.playerNames[j].player = p
+			return
+		}
+	}
+	w.playerNames = append(w.playerNames, playerNameEntry{})
+	copy(w.playerNames[i+1:], w.playerNames[i:])
+	w.playerNames[i] = playerNameEntry{folded: folded, player: p}
+}
+
+// unindexPlayerNameLocked removes p from the sorted player name index.
+func (w *World) unindexPlayerNameLocked(p *Player) {
+	for i, entry := range w.playerNames {
+		if entry.player == p {
+			w.playerNames = append(w.playerNames[:i], w.playerNames[i+1:]...)
+			return
+		}
+	}
+}
+
+// matchPlayerNameLocked resolves name against the online players through the
+// sorted index: only players whose folded name starts with name are visited.
+// It reports false when nothing or more than one player matches.
+func (w *World) matchPlayerNameLocked(name string) (*Player, bool) {
+	lo := sort.Search(len(w.playerNames), func(i int) bool {
+		cmp, _ := compareFold(w.playerNames[i].folded, name)
+		return cmp >= 0
+	})
+	var match *Player
+	ambiguous := false
+	for i := lo; i < len(w.playerNames); i++ {
+		entry := w.playerNames[i]
+		cmp, prefix := compareFold(entry.folded, name)
+		if !prefix {
+			break
+		}
+		if !entry.player.Alive {
+			continue
+		}
+		if cmp == 0 {
+			return entry.player, true
+		}
+		if match != nil {
+			ambiguous = true
+			continue
+		}
+		match = entry.player
+	}
+	if match == nil || ambiguous {
+		return nil, false
+	}
+	return match, true
+}
@@ -0,0 +1,87 @@
+package game
+
+import "testing"
+
+func TestUniqueMatchFoldsCaseAndWords(t *testing.T) {
+	names := []string{"Rusty Sword", "Red Ball", "  Lantern "}
+	cases := []struct {
+		target string
+		words  bool
+		want   int
+	}{
+		{"rusty sword", false, 0},
+		{"RUS", false, 0},
+		{"lantern", false, 2},
+		{"ball", true, 1},
+		{"ball", false, -1},
+		{"r", false, -1},
+		{"red ba", true, 1},
+		{"sword ", true, 0},
+		{"ed", true, -1},
+		{"", true, -1},
+	}
+	for _, tc := range cases {
+		got, ok := uniqueMatch(tc.target, names, tc.words)
+		if tc.want < 0 {
+			if ok {
+				t.Fatalf("uniqueMatch(%q, words=%t) = %d, want no match", tc.target, tc.words, got)
+			}
+			continue
+		}
+		if !ok || got != tc.want {
+			t.Fatalf("uniqueMatch(%q, words=%t) = %d, %t; want %d", tc.target, tc.words, got, ok, tc.want)
+		}
+	}
+}
+
+func TestPlayerNameIndexTracksPlayers(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	alice := &Player{Name: "Alice", Room: StartRoom, Alive: true}
+	alfred := &Player{Name: "Alfred", Room: StartRoom, Alive: true}
+	bob := &Player{Name: "Bob", Room: StartRoom, Alive: true}
+	for _, p := range []*Player{alice, alfred, bob} {
+		world.AddPlayerForTest(p)
+	}
+	if len(world.playerNames) != 3 {
+		t.Fatalf("expected 3 indexed players, got %d", len(world.playerNames))
+	}
+	if p, ok := world.FindPlayer("ALF"); !ok || p != alfred {
+		t.Fatalf("FindPlayer(ALF) = %v, %t", p, ok)
+	}
+	if _, ok := world.FindPlayer("al"); ok {
+		t.Fatalf("expected an ambiguous prefix to fail")
+	}
+
+	if err := world.RenamePlayer(alfred, "Zed"); err != nil {
+		t.Fatalf("RenamePlayer: %v", err)
+	}
+	if p, ok := world.FindPlayer("al"); !ok || p != alice {
+		t.Fatalf("FindPlayer(al) after rename = %v, %t", p, ok)
+	}
+	if p, ok := world.FindPlayer("z"); !ok || p != alfred {
+		t.Fatalf("FindPlayer(z) after rename = %v, %t", p, ok)
+	}
+
+	world.removePlayer("Bob")
+	if _, ok := world.FindPlayer("bo"); ok {
+		t.Fatalf("expected a removed player not to match")
+	}
+	if len(world.playerNames) != len(world.players) {
+		t.Fatalf("index has %d players, world has %d", len(world.playerNames), len(world.players))
+	}
+}
+
+func TestNameLookupsDoNotAllocate(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	for _, name := range []string{"Alice", "Alfred", "Bob"} {
+		world.AddPlayerForTest(&Player{Name: name, Room: StartRoom, Alive: true})
+	}
+	items := []Item{{Name: "Rusty Sword"}, {Name: "Red Ball"}, {Name: "Lantern"}}
+	allocs := testing.AllocsPerRun(100, func() {
+		world.FindPlayer("ALF")
+		findItemIndex(items, "Ball")
+	})
+	if allocs != 0 {
+		t.Fatalf("name lookups allocated %.0f times", allocs)
+	}
+}
@@ -0,0 +1,97 @@
+package game
+
+import (
+	"bytes"
+	"compress/zlib"
+	"sync"
+	"time"
+)
+
+// telnetOptCompress2 is the MCCP2 option: once the client agrees, everything
+// the server sends is a single zlib stream.
+const telnetOptCompress2 byte = 86
+
+// mccpLevel favours speed: output is flushed after every batch, so higher
+// levels cost noticeably more CPU and memory per session for little gain.
+const mccpLevel = zlib.BestSpeed
+
+// mccpWriters keeps compressors from finished streams for reuse.
+var mccpWriters sync.Pool
+
+// offerCompression advertises MCCP2. Compression starts when the client
+// answers with DO.
+func (s *TelnetSession) offerCompression() {
+	s.compressOffered = true
+	_ = s.writeCommand(telnetWILL, telnetOptCompress2)
+}
+
+// startCompression sends the MCCP2 start marker and compresses every write
+// after it.
+func (s *TelnetSession) startCompression() error {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if s.zw != nil {
+		return nil
+	}
+	if err := s.writeWire([]byte{telnetIAC, telnetSB, telnetOptCompress2, telnetIAC, telnetSE}); err != nil {
+		return err
+	}
+	if zw, ok := mccpWriters.Get().(*zlib.Writer); ok {
+		zw.Reset(&s.zbuf)
+		s.zw = zw
+	} else {
+		zw, err := zlib.NewWriterLevel(&s.zbuf, mccpLevel)
+		if err != nil {
+			return err
+		}
+		s.zw = zw
+	}
+	s.compressing.Store(true)
+	return nil
+}
+
+// stopCompression ends the zlib stream; later writes are sent uncompressed.
+func (s *TelnetSession) stopCompression() error {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if s.zw == nil {
+		return nil
+	}
+	s.zbuf.Reset()
+	_ = s.zw.Close()
+	mccpWriters.Put(s.zw)
+	s.zw = nil
+	s.compressing.Store(false)
+	err := s.writeWire(s.zbuf.Bytes())
+	s.zbuf.Reset()
+	return err
+}
+
+// sendLocked writes data to the client, through the compressor when MCCP2 is
+// active. Each call is flushed so the client can render it straight away.
+// Callers must hold s.mu.
+func (s *TelnetSession) sendLocked(data []byte) error {
+	if s.zw == nil {
+		return s.writeWire(data)
+	}
+	start := time.Now()
+	s.zbuf.Reset()
+	_, _ = s.zw.Write(data)
+	_ = s.zw.Flush()
+	s.compressTime.Add(int64(time.Since(start)))
+	s.compressIn.Add(uint64(len(data)))
+	s.compressOut.Add(uint64(s.zbuf.Len()))
+	err := s.writeWire(s.zbuf.Bytes())
+	if s.zbuf.Cap() > outputBufferRetain {
+		s.zbuf = bytes.Buffer{}
+	}
+	return err
+}
+
+// addCompressionStats fills in the session's MCCP2 counters.
+func (s *TelnetSession) addCompressionStats(stats *OutputStats) {
+	stats.Compressed = s.compressing.Load()
+	stats.RawBytes = s.compressIn.Load()
+	stats.WireBytes = s.compressOut.Load()
+	stats.CompressTime = time.Duration(s.compressTime.Load())
+}
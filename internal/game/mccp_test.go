@@ -0,0 +1,97 @@
+package game
+
+import (
+	"bytes"
+	"compress/zlib"
+	"io"
+	"strings"
+	"testing"
+)
+
+func (r *recordingConn) joined() []byte {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	return bytes.Join(r.writes, nil)
+}
+
+func TestCompressionNegotiatesAndCompressesOutput(t *testing.T) {
+	conn := &recordingConn{}
+	session := &TelnetSession{conn: conn, output: newOutputQueue(DefaultOutputConfig())}
+	session.offerCompression()
+	session.handleNegotiation(telnetDO, telnetOptCompress2)
+
+	text := strings.Repeat("A long room description full of ANSI styling.\n", 20)
+	if err := session.WriteBatch([]string{text, "> "}); err != nil {
+		t.Fatalf("WriteBatch: %v", err)
+	}
+	session.handleNegotiation(telnetDONT, telnetOptCompress2)
+	if err := session.WriteString("plain"); err != nil {
+		t.Fatalf("WriteString: %v", err)
+	}
+
+	stream := conn.joined()
+	offer := []byte{telnetIAC, telnetWILL, telnetOptCompress2}
+	start := []byte{telnetIAC, telnetSB, telnetOptCompress2, telnetIAC, telnetSE}
+	if !bytes.HasPrefix(stream, append(offer, start...)) {
+		t.Fatalf("expected WILL and the MCCP2 start marker, got % x", stream[:8])
+	}
+	if !bytes.HasSuffix(stream, []byte("plain")) {
+		t.Fatalf("expected output after DONT to be uncompressed")
+	}
+	compressed := stream[len(offer)+len(start) : len(stream)-len("plain")]
+	zr, err := zlib.NewReader(bytes.NewReader(compressed))
+	if err != nil {
+		t.Fatalf("zlib.NewReader: %v", err)
+	}
+	decoded, err := io.ReadAll(zr)
+	if err != nil {
+		t.Fatalf("decompress: %v", err)
+	}
+	want := string(translateForTelnet([]byte(text + "> ")))
+	if string(decoded) != want {
+		t.Fatalf("decompressed %d bytes, want %d", len(decoded), len(want))
+	}
+
+	stats := session.OutputStats()
+	if stats.Compressed {
+		t.Fatalf("expected compression to be off after DONT")
+	}
+	if stats.RawBytes != uint64(len(want)) || stats.WireBytes == 0 || stats.WireBytes >= stats.RawBytes/4 {
+		t.Fatalf("unexpected compression counters: raw %d, wire %d", stats.RawBytes, stats.WireBytes)
+	}
+}
+
+func TestCompressionRefusedWithoutOffer(t *testing.T) {
+	conn := &recordingConn{}
+	session := &TelnetSession{conn: conn, output: newOutputQueue(DefaultOutputConfig())}
+	session.handleNegotiation(telnetDO, telnetOptCompress2)
+	if err := session.WriteString("hi"); err != nil {
+		t.Fatalf("WriteString: %v", err)
+	}
+	want := append([]byte{telnetIAC, telnetWONT, telnetOptCompress2}, "hi"...)
+	if got := conn.joined(); !bytes.Equal(got, want) {
+		t.Fatalf("stream = % x, want % x", got, want)
+	}
+}
+
+func BenchmarkCompressedWriteBatch(b *testing.B) {
+	session := &TelnetSession{conn: &nopConn{}, output: newOutputQueue(DefaultOutputConfig())}
+	session.offerCompression()
+	if err := session.startCompression(); err != nil {
+		b.Fatal(err)
+	}
+	batch := []string{
+		Ansi(Style("\r\nAtrium of Echoes\r\n", AnsiCyan, AnsiBold)),
+		"Light pools like molten glass along the floor mosaics.\r\n",
+		Ansi(Style("Exits: north, south, up\r\n", AnsiGreen)),
+		"[L01 HP 50/50 MP 0/0] > ",
+	}
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		if err := session.WriteBatch(batch); err != nil {
+			b.Fatal(err)
+		}
+	}
+	stats := session.OutputStats()
+	b.ReportMetric(float64(stats.RawBytes)/float64(stats.WireBytes), "ratio")
+}
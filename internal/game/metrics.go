@@ -0,0 +1,323 @@
+package game
+
+import (
+	"fmt"
+	"io"
+	"math"
+	"runtime"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// latencyBuckets are the upper bounds shared by every latency histogram,
+// from lock waits measured in microseconds to multi-second flushes.
+var latencyBuckets = [...]time.Duration{
+	10 * time.Microsecond,
+	50 * time.Microsecond,
+	100 * time.Microsecond,
+	250 * time.Microsecond,
+	500 * time.Microsecond,
+	time.Millisecond,
+	2500 * time.Microsecond,
+	5 * time.Millisecond,
+	10 * time.Millisecond,
+	25 * time.Millisecond,
+	50 * time.Millisecond,
+	100 * time.Millisecond,
+	250 * time.Millisecond,
+	500 * time.Millisecond,
+	time.Second,
+	2500 * time.Millisecond,
+	5 * time.Second,
+	10 * time.Second,
+}
+
+// histogram counts durations into latencyBuckets. Its zero value is ready
+// to use and observing never locks or allocates.
+type histogram struct {
+	counts [len(latencyBuckets) + 1]atomic.Uint64
+	sum    atomic.Int64
+}
+
+func (h *histogram) observe(d time.Duration) {
+	i := 0
+	for i < len(latencyBuckets) && d > latencyBuckets[i] {
+		i++
+	}
+	h.counts[i].Add(1)
+	h.sum.Add(int64(d))
+}
+
+// histogramCounts is a copy of histogram bucket counts.
+type histogramCounts [len(latencyBuckets) + 1]uint64
+
+func (h *histogram) addCounts(into *histogramCounts) {
+	for i := range h.counts {
+		into[i] += h.counts[i].Load()
+	}
+}
+
+// since returns the observations made after prev was taken.
+func (c histogramCounts) since(prev histogramCounts) histogramCounts {
+	for i := range c {
+		c[i] -= prev[i]
+	}
+	return c
+}
+
+// quantile returns the upper bound of the bucket holding the q quantile, or
+// zero when c holds fewer than minCount observations.
+func (c histogramCounts) quantile(q float64, minCount uint64) time.Duration {
+	var total uint64
+	for _, n := range c {
+		total += n
+	}
+	if total == 0 || total < minCount {
+		return 0
+	}
+	rank := uint64(math.Ceil(q * float64(total)))
+	var seen uint64
+	for i, n := range c {
+		seen += n
+		if seen >= rank && i < len(latencyBuckets) {
+			return latencyBuckets[i]
+		}
+	}
+	return latencyBuckets[len(latencyBuckets)-1]
+}
+
+// histogramVec is a set of histograms split by the value of one label.
+type histogramVec struct {
+	mu         sync.RWMutex
+	histograms map[string]*histogram
+}
+
+func (v *histogramVec) with(value string) *histogram {
+	v.mu.RLock()
+	h, ok := v.histograms[value]
+	v.mu.RUnlock()
+	if ok {
+		return h
+	}
+	v.mu.Lock()
+	defer v.mu.Unlock()
+	if h, ok := v.histograms[value]; ok {
+		return h
+	}
+	if v.histograms == nil {
+		v.histograms = make(map[string]*histogram)
+	}
+	h = &histogram{}
+	v.histograms[value] = h
+	return h
+}
+
+// serverMetrics collects the timings exposed on the portal's /metrics page.
+// They are process-wide because a process runs a single world.
+var serverMetrics struct {
+	commands       histogramVec
+	scripts        histogramVec
+	flushes        histogramVec
+	worldLockRead  histogram
+	worldLockWrite histogram
+	worldLockHold  histogram
+	combatRoundLag histogram
+	loginQueueWait histogram
+}
+
+// ObserveCommand records how long the named command's handler took.
+func ObserveCommand(name string, d time.Duration) {
+	serverMetrics.commands.with(name).observe(d)
+}
+
+// observeFlush records how long one persistence flush of store took.
+func observeFlush(store string, start time.Time) {
+	serverMetrics.flushes.with(store).observe(time.Since(start))
+}
+
+// worldLockWaits returns the world lock wait counts for readers and
+// writers together.
+func worldLockWaits() histogramCounts {
+	var c histogramCounts
+	serverMetrics.worldLockRead.addCounts(&c)
+	serverMetrics.worldLockWrite.addCounts(&c)
+	return c
+}
+
+// worldMutex is the world's directory lock. It times how long callers wait
+// for it and how long writers hold it; read hold times are not tracked
+// because readers overlap. Uncontended acquisitions skip the clock and count
+// as waiting no time at all.
+type worldMutex struct {
+	sync.RWMutex
+	// lockedAt is when the current writer acquired the lock.
+	lockedAt time.Time
+}
+
+func (m *worldMutex) Lock() {
+	if m.RWMutex.TryLock() {
+		m.lockedAt = time.Now()
+		serverMetrics.worldLockWrite.observe(0)
+		return
+	}
+	start := time.Now()
+	m.RWMutex.Lock()
+	m.lockedAt = time.Now()
+	serverMetrics.worldLockWrite.observe(m.lockedAt.Sub(start))
+}
+
+func (m *worldMutex) Unlock() {
+	held := time.Since(m.lockedAt)
+	m.RWMutex.Unlock()
+	serverMetrics.worldLockHold.observe(held)
+}
+
+func (m *worldMutex) RLock() {
+	if m.RWMutex.TryRLock() {
+		serverMetrics.worldLockRead.observe(0)
+		return
+	}
+	start := time.Now()
+	m.RWMutex.RLock()
+	serverMetrics.worldLockRead.observe(time.Since(start))
+}
+
+// WriteMetrics writes the server's metrics to out in the Prometheus text
+// exposition format.
+func (w *World) WriteMetrics(out io.Writer) error {
+	m := &metricsWriter{out: out}
+
+	m.histogramVec("lumenclay_command_duration_seconds", "Time spent in command handlers.", "command", &serverMetrics.commands)
+	m.header("lumenclay_world_lock_wait_seconds", "Time spent waiting for the world lock.", "histogram")
+	m.series("lumenclay_world_lock_wait_seconds", "mode", "read", &serverMetrics.worldLockRead)
+	m.series("lumenclay_world_lock_wait_seconds", "mode", "write", &serverMetrics.worldLockWrite)
+	m.histogram("lumenclay_world_lock_hold_seconds", "Time the world lock was held for writing.", &serverMetrics.worldLockHold)
+	m.histogramVec("lumenclay_persistence_flush_seconds", "Time spent flushing persisted state.", "store", &serverMetrics.flushes)
+	m.histogramVec("lumenclay_script_hook_seconds", "Time spent running script hooks.", "hook", &serverMetrics.scripts)
+	m.histogram("lumenclay_combat_round_lag_seconds", "How late combat rounds started.", &serverMetrics.combatRoundLag)
+	m.histogram("lumenclay_login_queue_wait_seconds", "Time logins waited for a password hashing slot.", &serverMetrics.loginQueueWait)
+
+	var queued, deepest int
+	var dropped, coalesced uint64
+	snapshots := w.PlayerSnapshots()
+	for _, snap := range snapshots {
+		queued += snap.Output.Queued
+		deepest = max(deepest, snap.Output.Queued)
+		dropped += snap.Output.Dropped
+		coalesced += snap.Output.Coalesced
+	}
+	m.gauge("lumenclay_players_online", "Players currently connected.", float64(len(snapshots)))
+	m.gauge("lumenclay_output_queued_bytes", "Bytes waiting in all output queues.", float64(queued))
+	m.gauge("lumenclay_output_queue_max_bytes", "Bytes waiting in the deepest output queue.", float64(deepest))
+	m.gauge("lumenclay_output_dropped_messages", "Messages shed from connected sessions' output queues.", float64(dropped))
+	m.gauge("lumenclay_output_coalesced_messages", "Messages merged in connected sessions' output queues.", float64(coalesced))
+	m.header("lumenclay_connections_rejected_total", "Connections refused by admission control.", "counter")
+	for _, r := range rejections {
+		m.printf("lumenclay_connections_rejected_total{reason=%q} %d\n", r.reason, r.count.Load())
+	}
+	w.mu.RLock()
+	admission, accounts := w.admission, w.accounts
+	w.mu.RUnlock()
+	if admission != nil {
+		overloaded := 0.0
+		if admission.overloaded.Load() {
+			overloaded = 1
+		}
+		m.gauge("lumenclay_overloaded", "Whether new connections are refused to shed load.", overloaded)
+	}
+	abandoned, abandonedTotal := w.AbandonedScripts()
+	m.gauge("lumenclay_script_hooks_abandoned", "Script hooks still running after overrunning their budget.", float64(abandoned))
+	m.counter("lumenclay_script_hooks_abandoned_total", "Script hooks that overran their budget.", float64(abandonedTotal))
+	m.gauge("lumenclay_combats_active", "Combats currently running.", float64(w.CombatStats().Active))
+	if accounts != nil {
+		m.gauge("lumenclay_login_queue_waiting", "Logins waiting for a password hashing slot.", float64(accounts.LoginsQueued()))
+	}
+
+	var mem runtime.MemStats
+	runtime.ReadMemStats(&mem)
+	m.gauge("go_goroutines", "Number of goroutines that currently exist.", float64(runtime.NumGoroutine()))
+	m.gauge("go_memstats_heap_alloc_bytes", "Bytes of allocated heap objects.", float64(mem.HeapAlloc))
+	m.gauge("go_memstats_heap_inuse_bytes", "Bytes in in-use heap spans.", float64(mem.HeapInuse))
+	m.gauge("go_memstats_heap_objects", "Number of allocated heap objects.", float64(mem.HeapObjects))
+	m.gauge("go_memstats_sys_bytes", "Bytes of memory obtained from the OS.", float64(mem.Sys))
+	m.counter("go_gc_cycles_total", "Completed GC cycles.", float64(mem.NumGC))
+	m.counter("go_gc_pause_seconds_total", "Total time the world was stopped for GC.", time.Duration(mem.PauseTotalNs).Seconds())
+	return m.err
+}
+
+// metricsWriter renders metric families, remembering the first write error.
+type metricsWriter struct {
+	out io.Writer
+	err error
+}
+
+func (m *metricsWriter) printf(format string, args ...any) {
+	if m.err == nil {
+		_, m.err = fmt.Fprintf(m.out, format, args...)
+	}
+}
+
+func (m *metricsWriter) header(name, help, kind string) {
+	m.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, kind)
+}
+
+func (m *metricsWriter) gauge(name, help string, value float64) {
+	m.header(name, help, "gauge")
+	m.printf("%s %s\n", name, formatMetricValue(value))
+}
+
+func (m *metricsWriter) counter(name, help string, value float64) {
+	m.header(name, help, "counter")
+	m.printf("%s %s\n", name, formatMetricValue(value))
+}
+
+func (m *metricsWriter) histogramVec(name, help, label string, v *histogramVec) {
+	v.mu.RLock()
+	values := make([]string, 0, len(v.histograms))
+	for value := range v.histograms {
+		values = append(values, value)
+	}
+	v.mu.RUnlock()
+	sort.Strings(values)
+
+	m.header(name, help, "histogram")
+	for _, value := range values {
+		m.series(name, label, value, v.with(value))
+	}
+}
+
+func (m *metricsWriter) histogram(name, help string, h *histogram) {
+	m.header(name, help, "histogram")
+	m.series(name, "", "", h)
+}
+
+// series writes one histogram's cumulative buckets, sum and count.
+func (m *metricsWriter) series(name, label, value string, h *histogram) {
+	labels := ""
+	if label != "" {
+		labels = label + "=" + strconv.Quote(value) + ","
+	}
+	var total uint64
+	for i := range h.counts {
+		total += h.counts[i].Load()
+		bound := "+Inf"
+		if i < len(latencyBuckets) {
+			bound = formatMetricValue(latencyBuckets[i].Seconds())
+		}
+		m.printf("%s_bucket{%sle=%q} %d\n", name, labels, bound, total)
+	}
+	labels = strings.TrimSuffix(labels, ",")
+	if labels != "" {
+		labels = "{" + labels + "}"
+	}
+	m.printf("%s_sum%s %s\n", name, labels, formatMetricValue(time.Duration(h.sum.Load()).Seconds()))
+	m.printf("%s_count%s %d\n", name, labels, total)
+}
+
+func formatMetricValue(v float64) string {
+	return strconv.FormatFloat(v, 'g', -1, 64)
+}
@@ -0,0 +1,107 @@
+package game
+
+import (
+	"net/http"
+	"net/http/httptest"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestHistogramBuckets(t *testing.T) {
+	var h histogram
+	h.observe(5 * time.Microsecond)
+	h.observe(10 * time.Microsecond)
+	h.observe(time.Millisecond)
+	h.observe(time.Minute)
+	if got := h.counts[0].Load(); got != 2 {
+		t.Fatalf("first bucket = %d, want 2", got)
+	}
+	if got := h.counts[5].Load(); got != 1 {
+		t.Fatalf("1ms bucket = %d, want 1", got)
+	}
+	if got := h.counts[len(latencyBuckets)].Load(); got != 1 {
+		t.Fatalf("+Inf bucket = %d, want 1", got)
+	}
+	if got := time.Duration(h.sum.Load()); got != time.Minute+time.Millisecond+15*time.Microsecond {
+		t.Fatalf("sum = %s", got)
+	}
+}
+
+func TestWriteMetricsExposition(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	world.AddPlayerForTest(&Player{Name: "Alice", Room: StartRoom, Alive: true})
+	ObserveCommand("look", 2*time.Millisecond)
+	world.mu.Lock()
+	world.mu.Unlock()
+
+	var out strings.Builder
+	if err := world.WriteMetrics(&out); err != nil {
+		t.Fatalf("WriteMetrics: %v", err)
+	}
+	text := out.String()
+	for _, want := range []string{
+		"# TYPE lumenclay_command_duration_seconds histogram\n",
+		`lumenclay_command_duration_seconds_bucket{command="look",le="0.0025"} `,
+		`lumenclay_command_duration_seconds_bucket{command="look",le="+Inf"} `,
+		`lumenclay_command_duration_seconds_count{command="look"} `,
+		`lumenclay_world_lock_wait_seconds_count{mode="write"} `,
+		"lumenclay_world_lock_hold_seconds_count ",
+		"lumenclay_players_online 1\n",
+		"go_goroutines ",
+	} {
+		if !strings.Contains(text, want) {
+			t.Fatalf("metrics missing %q:\n%s", want, text)
+		}
+	}
+}
+
+func TestPortalMetricsRequireStaffOrToken(t *testing.T) {
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: {ID: StartRoom}})
+	portal := &PortalServer{
+		world:        world,
+		sessionTTL:   time.Minute,
+		metricsToken: "secret",
+		tokens:       make(map[string]portalToken),
+		sessions: map[string]portalSession{
+			"admin":   {Role: PortalRoleAdmin, Expires: time.Now().Add(time.Minute)},
+			"builder": {Role: PortalRoleBuilder, Expires: time.Now().Add(time.Minute)},
+			"player":  {Role: PortalRolePlayer, Expires: time.Now().Add(time.Minute)},
+		},
+	}
+	request := func(path, session, token string) int {
+		req := httptest.NewRequest(http.MethodGet, path, nil)
+		if session != "" {
+			req.AddCookie(&http.Cookie{Name: portalCookieName, Value: session})
+		}
+		if token != "" {
+			req.Header.Set("Authorization", "Bearer "+token)
+		}
+		rec := httptest.NewRecorder()
+		if strings.HasPrefix(path, "/debug/pprof/") {
+			portal.handlePprof(rec, req)
+		} else {
+			portal.handleMetrics(rec, req)
+		}
+		return rec.Code
+	}
+	cases := []struct {
+		path, session, token string
+		want                 int
+	}{
+		{"/metrics", "", "", http.StatusUnauthorized},
+		{"/metrics", "player", "", http.StatusForbidden},
+		{"/metrics", "builder", "", http.StatusOK},
+		{"/metrics", "", "wrong", http.StatusUnauthorized},
+		{"/metrics", "", "secret", http.StatusOK},
+		{"/debug/pprof/", "builder", "", http.StatusForbidden},
+		{"/debug/pprof/", "", "secret", http.StatusUnauthorized},
+		{"/debug/pprof/cmdline", "", "secret", http.StatusUnauthorized},
+		{"/debug/pprof/", "admin", "", http.StatusOK},
+	}
+	for _, tc := range cases {
+		if got := request(tc.path, tc.session, tc.token); got != tc.want {
+			t.Fatalf("%s session=%q token=%q: status %d, want %d", tc.path, tc.session, tc.token, got, tc.want)
+		}
+	}
+}
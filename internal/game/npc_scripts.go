@@ -1,9 +1,10 @@
 package game
 
 import (
-	"crypto/sha1"
-	"encoding/hex"
 	"fmt"
+	"path"
+	"reflect"
+	"runtime"
 	"strings"
 	"sync"
 
@@ -15,7 +16,22 @@ type NPCSpeaker struct {
 	Name string
 }
 
+// scriptCall is embedded in every script context. It carries what a queued
+// hook needs to run so contexts can be recycled instead of closing over them.
+type scriptCall struct {
+	scriptGuard
+	engine *scriptEngine
+	source string
+	hook   string
+	// legacy is set once a map payload has handed closures over the context
+	// to the script, after which the context is never reused.
+	legacy bool
+}
+
+// NPCScriptContext is passed to typed NPC hooks, which scripts declare as
+// func OnEnter(ctx *lumenclay.NPCContext).
 type NPCScriptContext struct {
+	scriptCall
 	world   *World
 	room    RoomID
 	npc     NPC
@@ -23,6 +39,8 @@ type NPCScriptContext struct {
 	Message string
 }
 
+var npcContextPool = sync.Pool{New: func() any { return new(NPCScriptContext) }}
+
 func (ctx *NPCScriptContext) NPCName() string {
 	return ctx.npc.Name
 }
@@ -31,8 +49,16 @@ func (ctx *NPCScriptContext) Room() RoomID {
 	return ctx.room
 }
 
+// SpeakerName returns the player who triggered the hook, or "".
+func (ctx *NPCScriptContext) SpeakerName() string {
+	if ctx.Speaker == nil {
+		return ""
+	}
+	return ctx.Speaker.Name
+}
+
 func (ctx *NPCScriptContext) Say(text string) {
-	if ctx == nil || ctx.world == nil {
+	if ctx == nil || ctx.world == nil || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
@@ -44,7 +70,7 @@ func (ctx *NPCScriptContext) Say(text string) {
 }
 
 func (ctx *NPCScriptContext) Emote(action string) {
-	if ctx == nil || ctx.world == nil {
+	if ctx == nil || ctx.world == nil || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(action)
@@ -56,7 +82,7 @@ func (ctx *NPCScriptContext) Emote(action string) {
 }
 
 func (ctx *NPCScriptContext) Tell(text string) {
-	if ctx == nil || ctx.world == nil || ctx.Speaker == nil || ctx.Speaker.Name == "" {
+	if ctx == nil || ctx.world == nil || !ctx.active() || ctx.Speaker == nil || ctx.Speaker.Name == "" {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
@@ -67,15 +93,96 @@ func (ctx *NPCScriptContext) Tell(text string) {
 	ctx.world.sendToPlayer(ctx.Speaker.Name, message)
 }
 
+func (ctx *NPCScriptContext) runHook() bool {
+	hook, ok := ctx.engine.loadHook(ctx.source, ctx.hook, "npc", ctx.npc.Name)
+	if !ok || !hook.accepts("npc") {
+		return ok
+	}
+	return ctx.engine.invoke("npc", ctx.npc.Name, ctx.hook, func() {
+		if hook.npc != nil {
+			hook.npc(ctx)
+			return
+		}
+		ctx.legacy = true
+		hook.legacy(ctx.engine.payloadForNPC(ctx, ctx.Message))
+	})
+}
+
+func (ctx *NPCScriptContext) release() {
+	if ctx.legacy {
+		return
+	}
+	*ctx = NPCScriptContext{}
+	npcContextPool.Put(ctx)
+}
+
+// scriptPlayer is the player who triggered a hook. Hooks run later on an
+// executor worker, so the name and window width are read when the hook is
+// queued rather than from the live player.
+type scriptPlayer struct {
+	player *Player
+	name   string
+	width  int
+}
+
+func newScriptPlayer(p *Player) scriptPlayer {
+	if p == nil {
+		return scriptPlayer{}
+	}
+	width, _ := p.WindowSize()
+	return scriptPlayer{player: p, name: p.Name, width: width}
+}
+
+// send delivers msg through the player's output queue without ever waiting
+// on the client, and drops it once the player has left the world.
+func (t *scriptPlayer) send(w *World, msg string) {
+	if t.player == nil {
+		return
+	}
+	if w == nil {
+		sendDirect(t.player, msg)
+		return
+	}
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	if current, ok := w.players[t.player.Name]; ok && current == t.player && t.player.Alive {
+		sendDirect(t.player, msg)
+	}
+}
+
+// RoomScriptContext is passed to typed room hooks, which scripts declare as
+// func OnLook(ctx *lumenclay.RoomContext).
 type RoomScriptContext struct {
+	scriptCall
 	world  *World
-	room   *Room
-	player *Player
+	room   RoomID
+	player scriptPlayer
 	via    string
 }
 
+var roomContextPool = sync.Pool{New: func() any { return new(RoomScriptContext) }}
+
+func (ctx *RoomScriptContext) Room() string {
+	return string(ctx.room)
+}
+
+// Player returns the player who triggered the hook, or "".
+func (ctx *RoomScriptContext) Player() string {
+	return ctx.player.name
+}
+
+// Via returns the exit the player arrived through, if any.
+func (ctx *RoomScriptContext) Via() string {
+	return ctx.via
+}
+
+// Hook returns the name of the hook being run.
+func (ctx *RoomScriptContext) Hook() string {
+	return ctx.hook
+}
+
 func (ctx *RoomScriptContext) Broadcast(text string) {
-	if ctx == nil || ctx.world == nil || ctx.room == nil {
+	if ctx == nil || ctx.world == nil || ctx.room == "" || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
@@ -83,46 +190,91 @@ func (ctx *RoomScriptContext) Broadcast(text string) {
 		return
 	}
 	message := Ansi(fmt.Sprintf("\r\nThe atmosphere whispers: %s", cleaned))
-	ctx.world.BroadcastToRoom(ctx.room.ID, message, nil)
+	ctx.world.BroadcastToRoom(ctx.room, message, nil)
 }
 
 func (ctx *RoomScriptContext) Narrate(text string) {
-	if ctx == nil || ctx.player == nil {
+	if ctx == nil || ctx.player.player == nil || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
 	if cleaned == "" {
 		return
 	}
-	width, _ := ctx.player.WindowSize()
-	wrapped := WrapText(cleaned, width)
-	ctx.player.Output <- Ansi(fmt.Sprintf("\r\n%s", Style(wrapped, AnsiItalic, AnsiDim)))
+	wrapped := WrapText(cleaned, ctx.player.width)
+	ctx.player.send(ctx.world, Ansi(fmt.Sprintf("\r\n%s", Style(wrapped, AnsiItalic, AnsiDim))))
+}
+
+func (ctx *RoomScriptContext) runHook() bool {
+	name := string(ctx.room)
+	hook, ok := ctx.engine.loadHook(ctx.source, ctx.hook, "room", name)
+	if !ok || !hook.accepts("room") {
+		return ok
+	}
+	return ctx.engine.invoke("room", name, ctx.hook, func() {
+		if hook.room != nil {
+			hook.room(ctx)
+			return
+		}
+		ctx.legacy = true
+		hook.legacy(ctx.engine.payloadForRoom(ctx, ctx.hook))
+	})
+}
+
+func (ctx *RoomScriptContext) release() {
+	if ctx.legacy {
+		return
+	}
+	*ctx = RoomScriptContext{}
+	roomContextPool.Put(ctx)
 }
 
+// AreaScriptContext is passed to typed area hooks, which scripts declare as
+// func OnEnter(ctx *lumenclay.AreaContext).
 type AreaScriptContext struct {
+	scriptCall
 	world  *World
 	area   areaMetadata
-	room   *Room
-	player *Player
+	room   RoomID
+	player scriptPlayer
 	via    string
 }
 
+var areaContextPool = sync.Pool{New: func() any { return new(AreaScriptContext) }}
+
+func (ctx *AreaScriptContext) Area() string {
+	return ctx.area.Name
+}
+
+func (ctx *AreaScriptContext) Room() string {
+	return string(ctx.room)
+}
+
+// Player returns the player who triggered the hook, or "".
+func (ctx *AreaScriptContext) Player() string {
+	return ctx.player.name
+}
+
+// Via returns the exit the player arrived through, if any.
+func (ctx *AreaScriptContext) Via() string {
+	return ctx.via
+}
+
 func (ctx *AreaScriptContext) Narrate(text string) {
-	if ctx == nil || ctx.player == nil {
+	if ctx == nil || ctx.player.player == nil || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
 	if cleaned == "" {
 		return
 	}
-	width, _ := ctx.player.WindowSize()
-	wrapped := WrapText(cleaned, width)
+	wrapped := WrapText(cleaned, ctx.player.width)
 	prefix := Style(fmt.Sprintf("[%s]", ctx.area.Name), AnsiBold, AnsiMagenta)
-	ctx.player.Output <- Ansi(fmt.Sprintf("\r\n%s %s", prefix, Style(wrapped, AnsiItalic)))
+	ctx.player.send(ctx.world, Ansi(fmt.Sprintf("\r\n%s %s", prefix, Style(wrapped, AnsiItalic))))
 }
 
 func (ctx *AreaScriptContext) Broadcast(text string) {
-	if ctx == nil || ctx.world == nil || ctx.room == nil {
+	if ctx == nil || ctx.world == nil || ctx.room == "" || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
@@ -131,174 +283,330 @@ func (ctx *AreaScriptContext) Broadcast(text string) {
 	}
 	prefix := Style(fmt.Sprintf("[%s]", ctx.area.Name), AnsiBold, AnsiMagenta)
 	message := Ansi(fmt.Sprintf("\r\n%s %s", prefix, cleaned))
-	ctx.world.BroadcastToRoom(ctx.room.ID, message, nil)
+	ctx.world.BroadcastToRoom(ctx.room, message, nil)
 }
 
+func (ctx *AreaScriptContext) runHook() bool {
+	hook, ok := ctx.engine.loadHook(ctx.source, ctx.hook, "area", ctx.area.Name)
+	if !ok || !hook.accepts("area") {
+		return ok
+	}
+	return ctx.engine.invoke("area", ctx.area.Name, ctx.hook, func() {
+		if hook.area != nil {
+			hook.area(ctx)
+			return
+		}
+		ctx.legacy = true
+		hook.legacy(ctx.engine.payloadForArea(ctx))
+	})
+}
+
+func (ctx *AreaScriptContext) release() {
+	if ctx.legacy {
+		return
+	}
+	*ctx = AreaScriptContext{}
+	areaContextPool.Put(ctx)
+}
+
+// ItemScriptContext is passed to typed item hooks, which scripts declare as
+// func OnInspect(ctx *lumenclay.ItemContext).
 type ItemScriptContext struct {
-	world    *World
-	room     RoomID
-	player   *Player
-	item     *Item
+	scriptCall
+	world  *World
+	room   RoomID
+	player scriptPlayer
+	// item is a copy taken when the hook was queued.
+	item     Item
 	location string
 }
 
+var itemContextPool = sync.Pool{New: func() any { return new(ItemScriptContext) }}
+
+func (ctx *ItemScriptContext) Item() string {
+	return ctx.item.Name
+}
+
+func (ctx *ItemScriptContext) Room() string {
+	return string(ctx.room)
+}
+
+// Player returns the player inspecting the item, or "".
+func (ctx *ItemScriptContext) Player() string {
+	return ctx.player.name
+}
+
+// Where reports whether the item was inspected in the room or an inventory.
+func (ctx *ItemScriptContext) Where() string {
+	return ctx.location
+}
+
 func (ctx *ItemScriptContext) Describe(text string) {
-	if ctx == nil || ctx.player == nil {
+	if ctx == nil || ctx.player.player == nil || !ctx.active() {
 		return
 	}
 	cleaned := strings.TrimSpace(text)
 	if cleaned == "" {
 		return
 	}
-	width, _ := ctx.player.WindowSize()
-	wrapped := WrapText(cleaned, width)
-	ctx.player.Output <- Ansi(fmt.Sprintf("\r\n%s", Style(wrapped, AnsiItalic)))
+	wrapped := WrapText(cleaned, ctx.player.width)
+	ctx.player.send(ctx.world, Ansi(fmt.Sprintf("\r\n%s", Style(wrapped, AnsiItalic))))
+}
+
+func (ctx *ItemScriptContext) runHook() bool {
+	hook, ok := ctx.engine.loadHook(ctx.source, ctx.hook, "item", ctx.item.Name)
+	if !ok || !hook.accepts("item") {
+		return ok
+	}
+	return ctx.engine.invoke("item", ctx.item.Name, ctx.hook, func() {
+		if hook.item != nil {
+			hook.item(ctx)
+			return
+		}
+		ctx.legacy = true
+		hook.legacy(ctx.engine.payloadForItem(ctx))
+	})
+}
+
+func (ctx *ItemScriptContext) release() {
+	if ctx.legacy {
+		return
+	}
+	*ctx = ItemScriptContext{}
+	itemContextPool.Put(ctx)
 }
 
 type scriptEntry struct {
 	script *compiledScript
 	err    error
+	// ready is closed once script and err are set.
+	ready chan struct{}
+}
+
+// scriptPackages is the standard library subset scripts may import. Loading
+// only these keeps each interpreter's symbol table small.
+var scriptPackages = []string{
+	"fmt",
+	"math",
+	"math/rand",
+	"sort",
+	"strconv",
+	"strings",
+	"time",
+	"unicode",
+	"unicode/utf8",
+}
+
+var (
+	scriptSymbolsOnce sync.Once
+	scriptSymbols     interp.Exports
+)
+
+// allowedScriptSymbols returns the exports for scriptPackages, built once and
+// shared by every interpreter.
+func allowedScriptSymbols() interp.Exports {
+	scriptSymbolsOnce.Do(func() {
+		scriptSymbols = make(interp.Exports, len(scriptPackages))
+		for _, pkg := range scriptPackages {
+			key := pkg + "/" + path.Base(pkg)
+			if symbols, ok := stdlib.Symbols[key]; ok {
+				scriptSymbols[key] = symbols
+			}
+		}
+	})
+	return scriptSymbols
+}
+
+// scriptHook holds one hook as the script declared it: either the legacy
+// map payload or a typed context for a particular kind of script.
+type scriptHook struct {
+	legacy func(map[string]any)
+	npc    func(*NPCScriptContext)
+	room   func(*RoomScriptContext)
+	area   func(*AreaScriptContext)
+	item   func(*ItemScriptContext)
+}
+
+// accepts reports whether the hook can run for the given kind of script.
+func (h scriptHook) accepts(kind string) bool {
+	if h.legacy != nil {
+		return true
+	}
+	switch kind {
+	case "npc":
+		return h.npc != nil
+	case "room":
+		return h.room != nil
+	case "area":
+		return h.area != nil
+	case "item":
+		return h.item != nil
+	}
+	return false
+}
+
+// hostScriptSymbols exposes the typed hook contexts to scripts as the
+// "lumenclay" package.
+var hostScriptSymbols = interp.Exports{
+	"lumenclay/lumenclay": {
+		"NPCContext":  reflect.ValueOf((*NPCScriptContext)(nil)),
+		"RoomContext": reflect.ValueOf((*RoomScriptContext)(nil)),
+		"AreaContext": reflect.ValueOf((*AreaScriptContext)(nil)),
+		"ItemContext": reflect.ValueOf((*ItemScriptContext)(nil)),
+	},
 }
 
 type compiledScript struct {
-	onEnter   func(map[string]any)
-	onHear    func(map[string]any)
-	onLook    func(map[string]any)
-	onInspect func(map[string]any)
+	onEnter   scriptHook
+	onHear    scriptHook
+	onLook    scriptHook
+	onInspect scriptHook
+}
+
+func (s *compiledScript) hook(name string) scriptHook {
+	switch name {
+	case "OnEnter":
+		return s.onEnter
+	case "OnHear":
+		return s.onHear
+	case "OnLook":
+		return s.onLook
+	case "OnInspect":
+		return s.onInspect
+	}
+	return scriptHook{}
 }
 
 type scriptEngine struct {
-	mu      sync.RWMutex
+	mu sync.RWMutex
+	// scripts is keyed by trimmed source so lookups on the hook path do not
+	// allocate.
 	scripts map[string]*scriptEntry
+	exec    *scriptExecutor
 }
 
 func newScriptEngine() *scriptEngine {
-	return &scriptEngine{scripts: make(map[string]*scriptEntry)}
+	return &scriptEngine{
+		scripts: make(map[string]*scriptEntry),
+		exec:    newScriptExecutor(DefaultScriptConfig()),
+	}
 }
 
 func (e *scriptEngine) callNPCOnEnter(world *World, room RoomID, npc NPC, speaker *NPCSpeaker) {
-	if e == nil {
+	if e == nil || !e.mayRun(npc.Script, "OnEnter", "npc") {
 		return
 	}
-	script, err := e.scriptFor(npc.Script)
-	if err != nil {
-		fmt.Printf("NPC script failed to load: %v\n", err)
-		return
-	}
-	if script == nil || script.onEnter == nil {
-		return
-	}
-	ctx := &NPCScriptContext{world: world, room: room, npc: npc, Speaker: speaker}
-	payload := e.payloadForNPC(ctx, "")
-	e.invoke(npc.Script, "OnEnter", func() {
-		script.onEnter(payload)
-	})
+	ctx := npcContextPool.Get().(*NPCScriptContext)
+	ctx.engine, ctx.source, ctx.hook = e, npc.Script, "OnEnter"
+	ctx.world, ctx.room, ctx.npc, ctx.Speaker = world, room, npc, speaker
+	e.dispatch(room, "npc", npc.Name, &ctx.scriptCall, ctx)
 }
 
 func (e *scriptEngine) callNPCOnHear(world *World, room RoomID, npc NPC, speaker *NPCSpeaker, message string) {
-	if e == nil {
+	if e == nil || !e.mayRun(npc.Script, "OnHear", "npc") {
 		return
 	}
-	script, err := e.scriptFor(npc.Script)
-	if err != nil {
-		fmt.Printf("NPC script failed to load: %v\n", err)
-		return
-	}
-	if script == nil || script.onHear == nil {
-		return
-	}
-	ctx := &NPCScriptContext{world: world, room: room, npc: npc, Speaker: speaker, Message: message}
-	payload := e.payloadForNPC(ctx, message)
-	e.invoke(npc.Script, "OnHear", func() {
-		script.onHear(payload)
-	})
+	ctx := npcContextPool.Get().(*NPCScriptContext)
+	ctx.engine, ctx.source, ctx.hook = e, npc.Script, "OnHear"
+	ctx.world, ctx.room, ctx.npc, ctx.Speaker, ctx.Message = world, room, npc, speaker, message
+	e.dispatch(room, "npc", npc.Name, &ctx.scriptCall, ctx)
 }
 
 func (e *scriptEngine) callRoomOnEnter(world *World, room *Room, player *Player, via string) {
-	if e == nil || room == nil || strings.TrimSpace(room.Script) == "" {
-		return
-	}
-	script, err := e.scriptFor(room.Script)
-	if err != nil {
-		fmt.Printf("Room %s script failed to load: %v\n", room.ID, err)
-		return
-	}
-	if script == nil || script.onEnter == nil {
-		return
-	}
-	ctx := &RoomScriptContext{world: world, room: room, player: player, via: via}
-	payload := e.payloadForRoom(ctx, "OnEnter")
-	e.invoke(fmt.Sprintf("room:%s", room.ID), "OnEnter", func() {
-		script.onEnter(payload)
-	})
+	e.callRoom(world, room, player, via, "OnEnter")
 }
 
 func (e *scriptEngine) callRoomOnLook(world *World, room *Room, player *Player) {
-	if e == nil || room == nil || strings.TrimSpace(room.Script) == "" {
-		return
-	}
-	script, err := e.scriptFor(room.Script)
-	if err != nil {
-		fmt.Printf("Room %s script failed to load: %v\n", room.ID, err)
-		return
-	}
-	if script == nil || script.onLook == nil {
+	e.callRoom(world, room, player, "", "OnLook")
+}
+
+func (e *scriptEngine) callRoom(world *World, room *Room, player *Player, via, hook string) {
+	if e == nil || room == nil || !e.mayRun(room.Script, hook, "room") {
 		return
 	}
-	ctx := &RoomScriptContext{world: world, room: room, player: player}
-	payload := e.payloadForRoom(ctx, "OnLook")
-	e.invoke(fmt.Sprintf("room:%s", room.ID), "OnLook", func() {
-		script.onLook(payload)
-	})
+	ctx := roomContextPool.Get().(*RoomScriptContext)
+	ctx.engine, ctx.source, ctx.hook = e, room.Script, hook
+	ctx.world, ctx.room, ctx.player, ctx.via = world, room.ID, newScriptPlayer(player), via
+	e.dispatch(room.ID, "room", string(room.ID), &ctx.scriptCall, ctx)
 }
 
 func (e *scriptEngine) callAreaOnEnter(world *World, area areaMetadata, room *Room, player *Player, via string) {
-	if e == nil || strings.TrimSpace(area.Script) == "" {
+	if e == nil || room == nil || !e.mayRun(area.Script, "OnEnter", "area") {
 		return
 	}
-	script, err := e.scriptFor(area.Script)
-	if err != nil {
-		fmt.Printf("Area %s script failed to load: %v\n", area.Name, err)
+	ctx := areaContextPool.Get().(*AreaScriptContext)
+	ctx.engine, ctx.source, ctx.hook = e, area.Script, "OnEnter"
+	ctx.world, ctx.area, ctx.room, ctx.player, ctx.via = world, area, room.ID, newScriptPlayer(player), via
+	e.dispatch(room.ID, "area", area.Name, &ctx.scriptCall, ctx)
+}
+
+func (e *scriptEngine) callItemOnInspect(world *World, room RoomID, item *Item, player *Player, location string) {
+	if e == nil || item == nil || !e.mayRun(item.Script, "OnInspect", "item") {
 		return
 	}
-	if script == nil || script.onEnter == nil {
-		return
+	ctx := itemContextPool.Get().(*ItemScriptContext)
+	ctx.engine, ctx.source, ctx.hook = e, item.Script, "OnInspect"
+	// The hook runs later, so it gets its own copy of the item.
+	ctx.world, ctx.room, ctx.player, ctx.item, ctx.location = world, room, newScriptPlayer(player), *item, location
+	e.dispatch(room, "item", item.Name, &ctx.scriptCall, ctx)
+}
+
+// mayRun reports whether a hook could be defined by source. Scripts are
+// compiled on the worker the first time they run; once one is cached,
+// scripts that do not define the hook are skipped without queueing anything.
+func (e *scriptEngine) mayRun(source, hook, kind string) bool {
+	if strings.TrimSpace(source) == "" {
+		return false
 	}
-	ctx := &AreaScriptContext{world: world, area: area, room: room, player: player, via: via}
-	payload := e.payloadForArea(ctx)
-	e.invoke(fmt.Sprintf("area:%s", area.Name), "OnEnter", func() {
-		script.onEnter(payload)
-	})
+	entry, ok := e.cachedScript(source)
+	if !ok {
+		return true
+	}
+	return entry.err == nil && entry.script != nil && entry.script.hook(hook).accepts(kind)
 }
 
-func (e *scriptEngine) callItemOnInspect(world *World, room RoomID, item *Item, player *Player, location string) {
-	if e == nil || item == nil || strings.TrimSpace(item.Script) == "" {
+// dispatch hands a prepared context to the executor, or runs it inline when
+// the engine has none. Contexts are recycled once their hook has finished.
+func (e *scriptEngine) dispatch(room RoomID, kind, name string, call *scriptCall, task scriptTask) {
+	if e.exec == nil {
+		task.runHook()
+		task.release()
 		return
 	}
-	script, err := e.scriptFor(item.Script)
+	if !e.exec.submit(scriptJob{room: room, kind: kind, name: name, hook: call.hook, guard: &call.scriptGuard, task: task}) {
+		task.release()
+	}
+}
+
+// loadHook returns the compiled hook for source, reporting false when the
+// script failed to load.
+func (e *scriptEngine) loadHook(source, hook, kind, name string) (scriptHook, bool) {
+	script, err := e.scriptFor(source)
 	if err != nil {
-		fmt.Printf("Item %s script failed to load: %v\n", item.Name, err)
-		return
+		fmt.Printf("Script %s:%s failed to load: %v\n", kind, name, err)
+		return scriptHook{}, false
 	}
-	if script == nil || script.onInspect == nil {
-		return
+	if script == nil {
+		return scriptHook{}, true
 	}
-	ctx := &ItemScriptContext{world: world, room: room, player: player, item: item, location: location}
-	payload := e.payloadForItem(ctx)
-	e.invoke(fmt.Sprintf("item:%s", item.Name), "OnInspect", func() {
-		script.onInspect(payload)
-	})
+	return script.hook(hook), true
 }
 
-func (e *scriptEngine) invoke(name, hook string, fn func()) {
+// invoke runs fn, reporting false if it panicked.
+func (e *scriptEngine) invoke(kind, name, hook string, fn func()) (ok bool) {
 	defer func() {
 		if r := recover(); r != nil {
-			fmt.Printf("script %s %s panic: %v\n", name, hook, r)
+			fmt.Printf("script %s:%s %s panic: %v\n", kind, name, hook, r)
+			ok = false
 		}
 	}()
 	fn()
+	return true
 }
 
+// The payloadFor functions build the map passed to scripts written against
+// the original func(map[string]any) hook signature.
+
 func (e *scriptEngine) payloadForNPC(ctx *NPCScriptContext, message string) map[string]any {
 	payload := map[string]any{
 		"say": func(text string) {
@@ -310,13 +618,9 @@ func (e *scriptEngine) payloadForNPC(ctx *NPCScriptContext, message string) map[
 		"tell": func(text string) {
 			ctx.Tell(text)
 		},
-		"npc":  ctx.NPCName(),
-		"room": string(ctx.Room()),
-	}
-	if ctx.Speaker != nil {
-		payload["speaker"] = ctx.Speaker.Name
-	} else {
-		payload["speaker"] = ""
+		"npc":     ctx.NPCName(),
+		"room":    string(ctx.Room()),
+		"speaker": ctx.SpeakerName(),
 	}
 	if strings.TrimSpace(message) != "" {
 		payload["message"] = message
@@ -332,11 +636,11 @@ func (e *scriptEngine) payloadForRoom(ctx *RoomScriptContext, hook string) map[s
 		"broadcast": func(text string) {
 			ctx.Broadcast(text)
 		},
-		"room": string(ctx.room.ID),
+		"room": string(ctx.room),
 		"hook": hook,
 	}
-	if ctx.player != nil {
-		payload["player"] = ctx.player.Name
+	if ctx.player.player != nil {
+		payload["player"] = ctx.player.name
 		payload["via"] = ctx.via
 	}
 	return payload
@@ -352,11 +656,11 @@ func (e *scriptEngine) payloadForArea(ctx *AreaScriptContext) map[string]any {
 		},
 		"area": ctx.area.Name,
 	}
-	if ctx.room != nil {
-		payload["room"] = string(ctx.room.ID)
+	if ctx.room != "" {
+		payload["room"] = string(ctx.room)
 	}
-	if ctx.player != nil {
-		payload["player"] = ctx.player.Name
+	if ctx.player.player != nil {
+		payload["player"] = ctx.player.name
 		payload["via"] = ctx.via
 	}
 	return payload
@@ -369,91 +673,165 @@ func (e *scriptEngine) payloadForItem(ctx *ItemScriptContext) map[string]any {
 		},
 		"room":  string(ctx.room),
 		"where": ctx.location,
+		"item":  ctx.item.Name,
 	}
-	if ctx.item != nil {
-		payload["item"] = ctx.item.Name
-	} else {
-		payload["item"] = ""
-	}
-	if ctx.player != nil {
-		payload["player"] = ctx.player.Name
+	if ctx.player.player != nil {
+		payload["player"] = ctx.player.name
 	}
 	return payload
 }
 
-func (e *scriptEngine) scriptFor(source string) (*compiledScript, error) {
+// cachedScript returns the cache entry for source if it has finished
+// compiling.
+func (e *scriptEngine) cachedScript(source string) (*scriptEntry, bool) {
 	trimmed := strings.TrimSpace(source)
 	if trimmed == "" {
-		return nil, nil
+		return &scriptEntry{}, true
 	}
-	key := hashScript(trimmed)
 	e.mu.RLock()
-	entry, ok := e.scripts[key]
+	entry, ok := e.scripts[trimmed]
 	e.mu.RUnlock()
-	if ok {
-		return entry.script, entry.err
+	if !ok {
+		return nil, false
 	}
-	e.mu.Lock()
-	defer e.mu.Unlock()
-	if entry, ok := e.scripts[key]; ok {
-		return entry.script, entry.err
+	select {
+	case <-entry.ready:
+		return entry, true
+	default:
+		return nil, false
 	}
-	script, err := e.compile(trimmed)
-	e.scripts[key] = &scriptEntry{script: script, err: err}
-	return script, err
 }
 
-func (e *scriptEngine) compile(source string) (*compiledScript, error) {
-	interpreter := interp.New(interp.Options{})
-	interpreter.Use(stdlib.Symbols)
-	if _, err := interpreter.Eval(source); err != nil {
-		return nil, fmt.Errorf("compile: %w", err)
+// scriptFor returns the compiled script for source, compiling it on first
+// use. Different sources compile concurrently; callers asking for a source
+// that is already compiling wait for that compile instead of repeating it.
+func (e *scriptEngine) scriptFor(source string) (*compiledScript, error) {
+	trimmed := strings.TrimSpace(source)
+	if trimmed == "" {
+		return nil, nil
 	}
-	compiled := &compiledScript{}
-	if value, err := interpreter.Eval("OnEnter"); err == nil {
-		fn, ok := value.Interface().(func(map[string]any))
+	e.mu.RLock()
+	entry, ok := e.scripts[trimmed]
+	e.mu.RUnlock()
+	if !ok {
+		e.mu.Lock()
+		entry, ok = e.scripts[trimmed]
 		if !ok {
-			return nil, fmt.Errorf("OnEnter has unexpected type %T", value.Interface())
+			entry = &scriptEntry{ready: make(chan struct{})}
+			e.scripts[trimmed] = entry
 		}
-		compiled.onEnter = fn
-	} else if !isUndefinedSymbol(err) {
-		return nil, fmt.Errorf("OnEnter: %w", err)
-	}
-	if value, err := interpreter.Eval("OnHear"); err == nil {
-		fn, ok := value.Interface().(func(map[string]any))
+		e.mu.Unlock()
 		if !ok {
-			return nil, fmt.Errorf("OnHear has unexpected type %T", value.Interface())
+			entry.script, entry.err = e.compile(trimmed)
+			close(entry.ready)
+			return entry.script, entry.err
 		}
-		compiled.onHear = fn
-	} else if !isUndefinedSymbol(err) {
-		return nil, fmt.Errorf("OnHear: %w", err)
 	}
-	if value, err := interpreter.Eval("OnLook"); err == nil {
-		fn, ok := value.Interface().(func(map[string]any))
-		if !ok {
-			return nil, fmt.Errorf("OnLook has unexpected type %T", value.Interface())
+	<-entry.ready
+	return entry.script, entry.err
+}
+
+// precompile compiles every distinct source in parallel, one worker per CPU,
+// and reports how many were compiled and how many failed.
+func (e *scriptEngine) precompile(sources []string) (compiled, failed int) {
+	if e == nil {
+		return 0, 0
+	}
+	seen := make(map[string]bool, len(sources))
+	pending := make([]string, 0, len(sources))
+	for _, source := range sources {
+		trimmed := strings.TrimSpace(source)
+		if trimmed == "" || seen[trimmed] {
+			continue
+		}
+		seen[trimmed] = true
+		if _, ok := e.cachedScript(trimmed); ok {
+			continue
 		}
-		compiled.onLook = fn
-	} else if !isUndefinedSymbol(err) {
-		return nil, fmt.Errorf("OnLook: %w", err)
+		pending = append(pending, trimmed)
+	}
+	if len(pending) == 0 {
+		return 0, 0
+	}
+	workers := runtime.GOMAXPROCS(0)
+	if workers > len(pending) {
+		workers = len(pending)
+	}
+	var (
+		mu   sync.Mutex
+		wg   sync.WaitGroup
+		next = make(chan string)
+	)
+	for i := 0; i < workers; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for source := range next {
+				_, err := e.scriptFor(source)
+				mu.Lock()
+				if err != nil {
+					failed++
+				} else {
+					compiled++
+				}
+				mu.Unlock()
+			}
+		}()
+	}
+	for _, source := range pending {
+		next <- source
+	}
+	close(next)
+	wg.Wait()
+	return compiled, failed
+}
+
+func (e *scriptEngine) compile(source string) (*compiledScript, error) {
+	interpreter := interp.New(interp.Options{})
+	if err := interpreter.Use(allowedScriptSymbols()); err != nil {
+		return nil, fmt.Errorf("load script symbols: %w", err)
 	}
-	if value, err := interpreter.Eval("OnInspect"); err == nil {
-		fn, ok := value.Interface().(func(map[string]any))
-		if !ok {
-			return nil, fmt.Errorf("OnInspect has unexpected type %T", value.Interface())
+	if err := interpreter.Use(hostScriptSymbols); err != nil {
+		return nil, fmt.Errorf("load script symbols: %w", err)
+	}
+	if _, err := interpreter.Eval(source); err != nil {
+		return nil, fmt.Errorf("compile: %w", err)
+	}
+	compiled := &compiledScript{}
+	for _, target := range []struct {
+		name string
+		hook *scriptHook
+	}{
+		{"OnEnter", &compiled.onEnter},
+		{"OnHear", &compiled.onHear},
+		{"OnLook", &compiled.onLook},
+		{"OnInspect", &compiled.onInspect},
+	} {
+		value, err := interpreter.Eval(target.name)
+		if err != nil {
+			if isUndefinedSymbol(err) {
+				continue
+			}
+			return nil, fmt.Errorf("%s: %w", target.name, err)
+		}
+		switch fn := value.Interface().(type) {
+		case func(map[string]any):
+			target.hook.legacy = fn
+		case func(*NPCScriptContext):
+			target.hook.npc = fn
+		case func(*RoomScriptContext):
+			target.hook.room = fn
+		case func(*AreaScriptContext):
+			target.hook.area = fn
+		case func(*ItemScriptContext):
+			target.hook.item = fn
+		default:
+			return nil, fmt.Errorf("%s has unexpected type %T", target.name, fn)
 		}
-		compiled.onInspect = fn
-	} else if !isUndefinedSymbol(err) {
-		return nil, fmt.Errorf("OnInspect: %w", err)
 	}
 	return compiled, nil
 }
 
-func hashScript(src string) string {
-	sum := sha1.Sum([]byte(src))
-	return hex.EncodeToString(sum[:])
-}
-
 func isUndefinedSymbol(err error) bool {
 	if err == nil {
 		return false
@@ -461,3 +839,44 @@ func isUndefinedSymbol(err error) bool {
 	msg := err.Error()
 	return strings.Contains(msg, "undefined") || strings.Contains(msg, "not declared")
 }
+
+// appendRoomScripts adds every script attached to room, its NPCs, their loot,
+// its items and its resets to sources.
+func appendRoomScripts(sources []string, room *Room) []string {
+	sources = append(sources, room.Script)
+	for i := range room.NPCs {
+		sources = append(sources, room.NPCs[i].Script)
+		for j := range room.NPCs[i].Loot {
+			sources = append(sources, room.NPCs[i].Loot[j].Script)
+		}
+	}
+	for i := range room.Items {
+		sources = append(sources, room.Items[i].Script)
+	}
+	for i := range room.Resets {
+		sources = append(sources, room.Resets[i].Script)
+	}
+	return sources
+}
+
+// PrecompileScripts compiles every script in the world ahead of its first
+// hook so players never wait on the interpreter. Scripts that fail to
+// compile are remembered and reported when their hooks fire.
+func (w *World) PrecompileScripts() (compiled, failed int) {
+	if w == nil || w.scripts == nil {
+		return 0, 0
+	}
+	w.mu.RLock()
+	sources := make([]string, 0, len(w.rooms)+len(w.areaMeta))
+	for _, meta := range w.areaMeta {
+		sources = append(sources, meta.Script)
+	}
+	for id, room := range w.rooms {
+		lock := w.roomLock(id)
+		lock.Lock()
+		sources = appendRoomScripts(sources, room)
+		lock.Unlock()
+	}
+	w.mu.RUnlock()
+	return w.scripts.precompile(sources)
+}
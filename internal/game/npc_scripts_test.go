@@ -1,23 +1,27 @@
 package game
 
 import (
+	"path"
 	"regexp"
 	"strings"
 	"testing"
+	"time"
 )
 
 var ansiPattern = regexp.MustCompile(`\x1b\[[0-9;]*[A-Za-z]`)
 
-func drainOutput(ch chan string) []string {
-	var out []string
-	for {
-		select {
-		case msg := <-ch:
-			out = append(out, msg)
-		default:
-			return out
-		}
+func drainOutput(p *Player) []string {
+	return p.TakeOutputForTest()
+}
+
+// nextOutput waits for the next message queued for p.
+func nextOutput(t *testing.T, p *Player) string {
+	t.Helper()
+	msg, ok := p.NextOutputForTest(5 * time.Second)
+	if !ok {
+		t.Fatalf("%s received no output", p.Name)
 	}
+	return msg
 }
 
 func stripAnsi(s string) string {
@@ -57,11 +61,12 @@ func OnHear(ctx map[string]any) {
 	}
 	world := NewWorldWithRooms(rooms)
 
-	player := &Player{Name: "Tester", Room: StartRoom, Output: make(chan string, 16), Alive: true}
+	player := &Player{Name: "Tester", Room: StartRoom, Alive: true}
 	world.AddPlayerForTest(player)
 
 	EnterRoom(world, player, "")
-	outputs := stripAnsi(strings.Join(drainOutput(player.Output), "\n"))
+	world.waitForScripts()
+	outputs := stripAnsi(strings.Join(drainOutput(player), "\n"))
 	if !strings.Contains(outputs, "Guide says, \"Welcome to the scripted hall.\"") {
 		t.Fatalf("expected enter script to speak, got %q", outputs)
 	}
@@ -70,7 +75,8 @@ func OnHear(ctx map[string]any) {
 	}
 
 	world.HandlePlayerSpeech(player, "Tell me the secret")
-	outputs = stripAnsi(strings.Join(drainOutput(player.Output), "\n"))
+	world.waitForScripts()
+	outputs = stripAnsi(strings.Join(drainOutput(player), "\n"))
 	if !strings.Contains(outputs, "Guide tells you, \"The secret door opens when you hum the kiln's rhythm.\"") {
 		t.Fatalf("expected hear script response, got %q", outputs)
 	}
@@ -108,11 +114,12 @@ func OnEnter(ctx map[string]any) {
 	world.roomSources[StartRoom] = "start.json"
 	world.areaMeta["start.json"] = areaMetadata{Name: "Lumen Clay Convergence", Script: areaScript}
 
-	player := &Player{Name: "Scholar", Room: StartRoom, Output: make(chan string, 16), Alive: true}
+	player := &Player{Name: "Scholar", Room: StartRoom, Alive: true}
 	world.AddPlayerForTest(player)
 
 	EnterRoom(world, player, "")
-	outputs := stripAnsi(strings.Join(drainOutput(player.Output), "\n"))
+	world.waitForScripts()
+	outputs := stripAnsi(strings.Join(drainOutput(player), "\n"))
 	if !strings.Contains(outputs, "A hush settles as the mosaics inhale your presence.") {
 		t.Fatalf("expected room enter narration, got %q", outputs)
 	}
@@ -121,7 +128,8 @@ func OnEnter(ctx map[string]any) {
 	}
 
 	world.TriggerRoomLook(player)
-	outputs = stripAnsi(strings.Join(drainOutput(player.Output), "\n"))
+	world.waitForScripts()
+	outputs = stripAnsi(strings.Join(drainOutput(player), "\n"))
 	if !strings.Contains(outputs, "vaulted ceiling sketches new constellations") {
 		t.Fatalf("expected room look flourish, got %q", outputs)
 	}
@@ -144,13 +152,152 @@ func OnInspect(ctx map[string]any) {
 		},
 	}
 	world := NewWorldWithRooms(rooms)
-	player := &Player{Name: "Artisan", Room: StartRoom, Output: make(chan string, 16), Alive: true}
+	player := &Player{Name: "Artisan", Room: StartRoom, Alive: true}
 	world.AddPlayerForTest(player)
 
 	item := &rooms[StartRoom].Items[0]
 	world.TriggerItemInspect(player, StartRoom, item, "room")
-	outputs := stripAnsi(strings.Join(drainOutput(player.Output), "\n"))
+	world.waitForScripts()
+	outputs := stripAnsi(strings.Join(drainOutput(player), "\n"))
 	if !strings.Contains(outputs, "Tiny glyphs crawl across the surface") {
 		t.Fatalf("expected item inspect flourish, got %q", outputs)
 	}
 }
+
+func TestPrecompileScriptsCachesEachSourceOnce(t *testing.T) {
+	greeter := "package main\n\nfunc OnEnter(ctx map[string]any) {}\n"
+	looker := "package main\n\nfunc OnLook(ctx map[string]any) {}\n"
+	world := NewWorldWithRooms(map[RoomID]*Room{
+		StartRoom: {
+			ID:     StartRoom,
+			Script: looker,
+			NPCs:   []NPC{{Name: "Guide", Script: greeter}, {Name: "Twin", Script: greeter}},
+			Items:  []Item{{Name: "Plaque", Script: "  " + looker}},
+		},
+	})
+	world.areaMeta["start.json"] = areaMetadata{Name: "Start", Script: greeter}
+
+	compiled, failed := world.PrecompileScripts()
+	if compiled+failed != 2 {
+		t.Fatalf("expected 2 distinct scripts compiled, got %d compiled and %d failed", compiled, failed)
+	}
+	for _, source := range []string{greeter, looker} {
+		if _, ok := world.scripts.cachedScript(source); !ok {
+			t.Fatalf("expected %q to be cached after precompiling", source)
+		}
+	}
+	if compiled, failed := world.PrecompileScripts(); compiled+failed != 0 {
+		t.Fatalf("expected cached scripts to be skipped, got %d compiled and %d failed", compiled, failed)
+	}
+}
+
+func TestScriptSymbolsOnlyExposeAllowedPackages(t *testing.T) {
+	allowed := make(map[string]bool, len(scriptPackages))
+	for _, pkg := range scriptPackages {
+		allowed[pkg+"/"+path.Base(pkg)] = true
+	}
+	for key := range allowedScriptSymbols() {
+		if !allowed[key] {
+			t.Fatalf("unexpected package %q in script symbols", key)
+		}
+	}
+}
+
+// engineWithHooks returns an engine that runs hooks inline with source
+// already compiled to script.
+func engineWithHooks(source string, script *compiledScript) *scriptEngine {
+	engine := &scriptEngine{scripts: make(map[string]*scriptEntry)}
+	entry := &scriptEntry{script: script, ready: make(chan struct{})}
+	close(entry.ready)
+	engine.scripts[strings.TrimSpace(source)] = entry
+	return engine
+}
+
+func TestTypedNPCHookUsesPooledContext(t *testing.T) {
+	const source = "package main\n\nfunc OnHear(ctx *lumenclay.NPCContext) {}\n"
+	var heard, speaker string
+	engine := engineWithHooks(source, &compiledScript{onHear: scriptHook{npc: func(ctx *NPCScriptContext) {
+		heard, speaker = ctx.Message, ctx.SpeakerName()
+	}}})
+	npc := NPC{Name: "Guide", Script: source}
+	listener := &NPCSpeaker{Name: "Tester"}
+
+	engine.callNPCOnHear(nil, StartRoom, npc, listener, "hello")
+	if heard != "hello" || speaker != "Tester" {
+		t.Fatalf("typed hook saw message %q from %q", heard, speaker)
+	}
+	engine.callNPCOnEnter(nil, StartRoom, npc, listener)
+	if heard != "hello" {
+		t.Fatalf("expected OnEnter to be skipped for a script without it")
+	}
+	allocs := testing.AllocsPerRun(100, func() {
+		engine.callNPCOnHear(nil, StartRoom, npc, listener, "hello")
+	})
+	if allocs != 0 {
+		t.Fatalf("typed hook allocated %.0f times per call", allocs)
+	}
+}
+
+func TestLegacyHookStillReceivesMapPayload(t *testing.T) {
+	const source = "package main\n\nfunc OnInspect(ctx map[string]any) {}\n"
+	var payload map[string]any
+	engine := engineWithHooks(source, &compiledScript{onInspect: scriptHook{legacy: func(ctx map[string]any) {
+		payload = ctx
+	}}})
+	player := &Player{Name: "Tester"}
+	engine.callItemOnInspect(nil, StartRoom, &Item{Name: "Lamp", Script: source}, player, "room")
+	if payload["item"] != "Lamp" || payload["player"] != "Tester" || payload["where"] != "room" {
+		t.Fatalf("unexpected payload: %v", payload)
+	}
+	if _, ok := payload["describe"].(func(string)); !ok {
+		t.Fatalf("expected a describe callback in the payload")
+	}
+}
+
+func TestRoomHookNarrationOnlyReachesPlayersInTheWorld(t *testing.T) {
+	const source = "package main\n\nfunc OnLook(ctx *lumenclay.RoomContext) {}\n"
+	var seen string
+	engine := engineWithHooks(source, &compiledScript{onLook: scriptHook{room: func(ctx *RoomScriptContext) {
+		seen = ctx.Room() + "/" + ctx.Player()
+		ctx.Narrate("The walls hum.")
+	}}})
+	room := &Room{ID: StartRoom, Script: source}
+	world := NewWorldWithRooms(map[RoomID]*Room{StartRoom: room})
+	player := &Player{Name: "Tester", Room: StartRoom, Alive: true}
+	world.AddPlayerForTest(player)
+
+	engine.callRoomOnLook(world, room, player)
+	if seen != string(StartRoom)+"/Tester" {
+		t.Fatalf("hook saw %q", seen)
+	}
+	if got := drainOutput(player); len(got) != 1 || !strings.Contains(got[0], "The walls hum.") {
+		t.Fatalf("expected the narration, got %q", got)
+	}
+
+	world.removePlayer(player.Name)
+	engine.callRoomOnLook(world, room, player)
+	if got := drainOutput(player); len(got) != 0 {
+		t.Fatalf("narration reached a player who had left: %q", got)
+	}
+}
+
+func BenchmarkNPCHearHook(b *testing.B) {
+	const source = "package main\n\nfunc OnHear(ctx any) {}\n"
+	npc := NPC{Name: "Guide", Script: source}
+	listener := &NPCSpeaker{Name: "Tester"}
+	for _, bench := range []struct {
+		name string
+		hook scriptHook
+	}{
+		{"typed", scriptHook{npc: func(ctx *NPCScriptContext) { _ = ctx.Message }}},
+		{"map", scriptHook{legacy: func(ctx map[string]any) { _ = ctx["message"] }}},
+	} {
+		engine := engineWithHooks(source, &compiledScript{onHear: bench.hook})
+		b.Run(bench.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				engine.callNPCOnHear(nil, StartRoom, npc, listener, "hello")
+			}
+		})
+	}
+}
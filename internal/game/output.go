@@ -0,0 +1,423 @@
+package game
+
+import (
+	"fmt"
+	"math"
+	"strings"
+	"sync"
+	"time"
+)
+
+// OutputPolicy selects how a session's output queue sheds load once a client
+// stops keeping up with the messages addressed to it.
+type OutputPolicy string
+
+const (
+	// OutputPolicyCoalesce collapses superseded prompts first and then drops
+	// the oldest room and channel chatter.
+	OutputPolicyCoalesce OutputPolicy = "coalesce"
+	// OutputPolicyDropOldest drops the oldest chatter and leaves prompts alone.
+	OutputPolicyDropOldest OutputPolicy = "drop-oldest"
+	// OutputPolicyDisconnect never drops output and instead closes sessions
+	// that fall too far behind.
+	OutputPolicyDisconnect OutputPolicy = "disconnect"
+)
+
+const (
+	defaultOutputQueueBytes   = 64 << 10
+	defaultOutputStallTimeout = 30 * time.Second
+	// outputHardLimitFactor sets the hard cap, in multiples of QueueBytes,
+	// on a backlog that shedding could not trim. Past it the session is
+	// disconnected whatever the policy.
+	outputHardLimitFactor = 4
+)
+
+// OutputConfig bounds the output queued for each telnet session.
+type OutputConfig struct {
+	// QueueBytes is the backlog size at which the policy starts shedding.
+	QueueBytes int
+	// Policy decides what happens once the backlog exceeds QueueBytes.
+	Policy OutputPolicy
+	// StallTimeout is how long a single write may block before the session
+	// is disconnected.
+	StallTimeout time.Duration
+	// Compression offers MCCP2 to new connections.
+	Compression bool
+}
+
+// DefaultOutputConfig returns the output limits used when none are supplied.
+func DefaultOutputConfig() OutputConfig {
+	return OutputConfig{
+		QueueBytes:   defaultOutputQueueBytes,
+		Policy:       OutputPolicyCoalesce,
+		StallTimeout: defaultOutputStallTimeout,
+		Compression:  true,
+	}
+}
+
+// ParseOutputPolicy validates a policy name supplied on the command line.
+func ParseOutputPolicy(value string) (OutputPolicy, error) {
+	switch OutputPolicy(strings.ToLower(strings.TrimSpace(value))) {
+	case "", OutputPolicyCoalesce:
+		return OutputPolicyCoalesce, nil
+	case OutputPolicyDropOldest:
+		return OutputPolicyDropOldest, nil
+	case OutputPolicyDisconnect:
+		return OutputPolicyDisconnect, nil
+	default:
+		return "", fmt.Errorf("unknown output policy %q (want coalesce, drop-oldest or disconnect)", value)
+	}
+}
+
+func (c OutputConfig) normalized() OutputConfig {
+	defaults := DefaultOutputConfig()
+	if c.QueueBytes <= 0 {
+		c.QueueBytes = defaults.QueueBytes
+	}
+	if c.Policy == "" {
+		c.Policy = defaults.Policy
+	}
+	if c.StallTimeout <= 0 {
+		c.StallTimeout = defaults.StallTimeout
+	}
+	return c
+}
+
+// OutputStats summarises a session's output queue for the staff portal.
+type OutputStats struct {
+	Queued    int
+	HighWater int
+	Dropped   uint64
+	Coalesced uint64
+	// Compressed reports whether MCCP2 is active. RawBytes and WireBytes
+	// count output before and after compression, and CompressTime the
+	// time spent compressing it.
+	Compressed   bool
+	RawBytes     uint64
+	WireBytes    uint64
+	CompressTime time.Duration
+}
+
+type outputClass uint8
+
+const (
+	// outputDirect is a reply to the player's own command, including combat
+	// results, and is never dropped.
+	outputDirect outputClass = iota
+	// outputPrompt only matters until the next prompt supersedes it.
+	outputPrompt
+	// outputChatter is room and channel traffic generated by other players.
+	outputChatter
+)
+
+type outputEntry struct {
+	msg   string
+	class outputClass
+}
+
+// outputQueue is the bounded backlog between the game and a session's socket.
+// Producers never block on it; the flusher drains it in batches. Whatever the
+// policy, a session whose write has stalled for StallTimeout, or whose
+// backlog stays above the hard limit after shedding, is disconnected.
+type outputQueue struct {
+	mu        sync.Mutex
+	cfg       OutputConfig
+	entries   []outputEntry
+	bytes     int
+	highWater int
+	dropped   uint64
+	coalesced uint64
+	closed    bool
+	// writingSince is set while the flusher is blocked in a write.
+	writingSince time.Time
+	notify       chan struct{}
+	// onStall is called once, outside the lock, when the queue gives up on
+	// the client.
+	onStall func()
+	// onPush, when set, is called outside the lock after output is queued
+	// or the queue is closed; poll mode uses it instead of a flush goroutine.
+	onPush  func()
+	stalled bool
+	now     func() time.Time
+}
+
+func newOutputQueue(cfg OutputConfig) *outputQueue {
+	return &outputQueue{
+		cfg:    cfg.normalized(),
+		notify: make(chan struct{}, 1),
+		now:    time.Now,
+	}
+}
+
+func (q *outputQueue) configure(cfg OutputConfig) {
+	q.mu.Lock()
+	q.cfg = cfg.normalized()
+	q.mu.Unlock()
+}
+
+// push queues msg and applies the shedding policy. It reports false when the
+// queue has been closed and the message was discarded.
+func (q *outputQueue) push(msg string, class outputClass) bool {
+	q.mu.Lock()
+	if q.closed {
+		q.mu.Unlock()
+		return false
+	}
+	q.entries = append(q.entries, outputEntry{msg: msg, class: class})
+	q.bytes += len(msg)
+	if q.bytes > q.highWater {
+		q.highWater = q.bytes
+	}
+	if q.bytes > q.cfg.QueueBytes {
+		switch q.cfg.Policy {
+		case OutputPolicyDisconnect:
+		case OutputPolicyDropOldest:
+			q.shedLocked(false)
+		default:
+			q.shedLocked(true)
+		}
+	}
+	var stall func()
+	writeStalled := !q.writingSince.IsZero() && q.now().Sub(q.writingSince) > q.cfg.StallTimeout
+	if writeStalled || q.bytes > outputHardLimitFactor*q.cfg.QueueBytes {
+		stall = q.giveUpLocked()
+	}
+	onPush := q.onPush
+	q.mu.Unlock()
+
+	select {
+	case q.notify <- struct{}{}:
+	default:
+	}
+	if onPush != nil {
+		onPush()
+	}
+	if stall != nil {
+		stall()
+	}
+	return true
+}
+
+// giveUpLocked closes the queue, discarding its backlog, and returns the
+// stall callback the first time it is called.
+func (q *outputQueue) giveUpLocked() func() {
+	q.closed = true
+	clear(q.entries)
+	q.entries = nil
+	q.bytes = 0
+	if q.stalled {
+		return nil
+	}
+	q.stalled = true
+	return q.onStall
+}
+
+// setOnPush installs the callback run after each push and on close.
+func (q *outputQueue) setOnPush(fn func()) {
+	q.mu.Lock()
+	q.onPush = fn
+	q.mu.Unlock()
+}
+
+// shedLocked trims the backlog back under the limit. Direct output is always
+// kept, and the newest prompt survives even when coalescing.
+func (q *outputQueue) shedLocked(coalescePrompts bool) {
+	lastPrompt := -1
+	if coalescePrompts {
+		for i := len(q.entries) - 1; i >= 0; i-- {
+			if q.entries[i].class == outputPrompt {
+				lastPrompt = i
+				break
+			}
+		}
+	}
+	kept := q.entries[:0]
+	for i, entry := range q.entries {
+		switch {
+		case coalescePrompts && entry.class == outputPrompt && i != lastPrompt:
+			q.bytes -= len(entry.msg)
+			q.coalesced++
+			continue
+		case entry.class == outputChatter && q.bytes > q.cfg.QueueBytes:
+			q.bytes -= len(entry.msg)
+			q.dropped++
+			continue
+		}
+		kept = append(kept, entry)
+	}
+	clear(q.entries[len(kept):])
+	q.entries = kept
+}
+
+// next blocks until output is queued and appends up to limit bytes of it to
+// dst. The second result is false once the queue is closed and empty.
+func (q *outputQueue) next(dst []string, limit int) ([]string, bool) {
+	for {
+		batch, open := q.take(dst, limit)
+		if len(batch) > len(dst) || !open {
+			return batch, open
+		}
+		<-q.notify
+	}
+}
+
+// take is next without waiting: it appends whatever is queued, possibly
+// nothing, and reports false once the queue is closed and empty.
+func (q *outputQueue) take(dst []string, limit int) ([]string, bool) {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	if len(q.entries) == 0 {
+		return dst, !q.closed
+	}
+	size, n := 0, 0
+	for n < len(q.entries) && (n == 0 || size+len(q.entries[n].msg) <= limit) {
+		size += len(q.entries[n].msg)
+		dst = append(dst, q.entries[n].msg)
+		n++
+	}
+	clear(q.entries[:n])
+	q.entries = q.entries[n:]
+	if len(q.entries) == 0 {
+		q.entries = q.entries[:0:0]
+	}
+	q.bytes -= size
+	q.writingSince = q.now()
+	return dst, true
+}
+
+// pending reports whether a flush has anything left to do: queued output,
+// or a closed queue whose connection still needs closing.
+func (q *outputQueue) pending() bool {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	return len(q.entries) > 0 || q.closed
+}
+
+// written records that the batch returned by next has left the process.
+func (q *outputQueue) written() {
+	q.mu.Lock()
+	q.writingSince = time.Time{}
+	q.mu.Unlock()
+}
+
+// close stops accepting output. Anything already queued is still flushed
+// unless discard is set.
+func (q *outputQueue) close(discard bool) {
+	q.mu.Lock()
+	q.closed = true
+	if discard {
+		clear(q.entries)
+		q.entries = nil
+		q.bytes = 0
+	}
+	onPush := q.onPush
+	q.mu.Unlock()
+	select {
+	case q.notify <- struct{}{}:
+	default:
+	}
+	if onPush != nil {
+		onPush()
+	}
+}
+
+func (q *outputQueue) stats() OutputStats {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	return OutputStats{
+		Queued:    q.bytes,
+		HighWater: q.highWater,
+		Dropped:   q.dropped,
+		Coalesced: q.coalesced,
+	}
+}
+
+func classifyOutput(msg string) outputClass {
+	if isPrompt(msg) {
+		return outputPrompt
+	}
+	return outputDirect
+}
+
+// Send delivers msg to p in order with everything else sent to p. Prompts
+// are recognised so they can be coalesced; everything else is direct output
+// and is never shed.
+func (p *Player) Send(msg string) {
+	p.deliver(msg, classifyOutput(msg))
+}
+
+// sendDirect delivers output that must not be shed, such as a private
+// message, even though someone other than p produced it.
+func sendDirect(p *Player, msg string) {
+	if p == nil {
+		return
+	}
+	p.deliver(msg, outputDirect)
+}
+
+// sendChatter delivers room or channel traffic produced by someone other than
+// p. It may be shed when p's client falls behind.
+func sendChatter(p *Player, msg string) {
+	if p == nil {
+		return
+	}
+	p.deliver(msg, outputChatter)
+}
+
+// Connected reports whether p has an output queue, which every player with a
+// session has.
+func (p *Player) Connected() bool {
+	return p != nil && p.queue.Load() != nil
+}
+
+// deliver queues msg on p's output queue, which never blocks. Players without
+// one have nothing to show it on and miss it.
+func (p *Player) deliver(msg string, class outputClass) {
+	if q := p.queue.Load(); q != nil {
+		q.push(msg, class)
+	}
+}
+
+// AttachOutputForTest gives p an output queue with no session behind it, so a
+// test can read what the game sends p with TakeOutputForTest.
+func (p *Player) AttachOutputForTest() {
+	if p.queue.Load() == nil {
+		p.queue.Store(newOutputQueue(DefaultOutputConfig()))
+	}
+}
+
+// TakeOutputForTest returns and clears everything queued for p.
+func (p *Player) TakeOutputForTest() []string {
+	q := p.queue.Load()
+	if q == nil {
+		return nil
+	}
+	msgs, _ := q.take(nil, math.MaxInt)
+	q.written()
+	return msgs
+}
+
+// NextOutputForTest waits up to timeout for the next message queued for p.
+func (p *Player) NextOutputForTest(timeout time.Duration) (string, bool) {
+	q := p.queue.Load()
+	if q == nil {
+		return "", false
+	}
+	deadline := time.NewTimer(timeout)
+	defer deadline.Stop()
+	for {
+		msgs, open := q.take(nil, 1)
+		q.written()
+		if len(msgs) > 0 {
+			return msgs[0], true
+		}
+		if !open {
+			return "", false
+		}
+		select {
+		case <-q.notify:
+		case <-deadline.C:
+			return "", false
+		}
+	}
+}
@@ -0,0 +1,139 @@
+package game
+
+import (
+	"testing"
+	"time"
+)
+
+func queuedMessages(q *outputQueue) []string {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	msgs := make([]string, len(q.entries))
+	for i, entry := range q.entries {
+		msgs[i] = entry.msg
+	}
+	return msgs
+}
+
+func TestOutputQueueDropOldestKeepsDirectAndPrompts(t *testing.T) {
+	q := newOutputQueue(OutputConfig{QueueBytes: 12, Policy: OutputPolicyDropOldest})
+	q.push("hit!", outputDirect)
+	q.push("chat1", outputChatter)
+	q.push("> ", outputPrompt)
+	q.push("chat2", outputChatter)
+	q.push("chat3", outputChatter)
+
+	got := queuedMessages(q)
+	want := []string{"hit!", "> ", "chat3"}
+	if len(got) != len(want) {
+		t.Fatalf("queued = %q, want %q", got, want)
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("queued = %q, want %q", got, want)
+		}
+	}
+	stats := q.stats()
+	if stats.Dropped != 2 || stats.Coalesced != 0 {
+		t.Fatalf("unexpected counters: %+v", stats)
+	}
+	if stats.Queued != 11 || stats.HighWater != 16 {
+		t.Fatalf("unexpected sizes: %+v", stats)
+	}
+}
+
+func TestOutputQueueCoalesceKeepsNewestPrompt(t *testing.T) {
+	q := newOutputQueue(OutputConfig{QueueBytes: 8, Policy: OutputPolicyCoalesce})
+	q.push("> 1", outputPrompt)
+	q.push("ok", outputDirect)
+	q.push("> 2", outputPrompt)
+	q.push("> 3", outputPrompt)
+
+	got := queuedMessages(q)
+	if len(got) != 2 || got[0] != "ok" || got[1] != "> 3" {
+		t.Fatalf("queued = %q, want [ok > 3]", got)
+	}
+	if stats := q.stats(); stats.Coalesced != 2 || stats.Dropped != 0 {
+		t.Fatalf("unexpected counters: %+v", stats)
+	}
+}
+
+func TestOutputQueueDisconnectsStalledWriter(t *testing.T) {
+	now := time.Unix(1000, 0)
+	q := newOutputQueue(OutputConfig{QueueBytes: 4, Policy: OutputPolicyDisconnect, StallTimeout: time.Second})
+	q.now = func() time.Time { return now }
+	stalled := 0
+	q.onStall = func() { stalled++ }
+
+	q.push("first", outputChatter)
+	if _, open := q.next(nil, outputBatchLimit); !open {
+		t.Fatalf("expected queue to stay open")
+	}
+	q.push("second", outputChatter)
+	if stalled != 0 {
+		t.Fatalf("disconnected before the stall timeout elapsed")
+	}
+
+	now = now.Add(2 * time.Second)
+	q.push("third", outputChatter)
+	if stalled != 1 {
+		t.Fatalf("expected stall callback once, got %d", stalled)
+	}
+	if q.push("late", outputChatter) {
+		t.Fatalf("expected pushes to be rejected after disconnect")
+	}
+	if stats := q.stats(); stats.Dropped != 0 {
+		t.Fatalf("disconnect policy should not drop output: %+v", stats)
+	}
+}
+
+func TestOutputQueueDisconnectsPastHardLimit(t *testing.T) {
+	q := newOutputQueue(OutputConfig{QueueBytes: 4, Policy: OutputPolicyCoalesce})
+	stalled := 0
+	q.onStall = func() { stalled++ }
+
+	for i := 0; i < outputHardLimitFactor; i++ {
+		q.push("hit!", outputDirect)
+	}
+	if stalled != 0 {
+		t.Fatalf("disconnected at the hard limit rather than past it")
+	}
+	q.push("hit!", outputDirect)
+	if stalled != 1 {
+		t.Fatalf("expected direct output past the hard limit to disconnect, got %d stalls", stalled)
+	}
+	if stats := q.stats(); stats.Queued != 0 {
+		t.Fatalf("expected the backlog to be discarded: %+v", stats)
+	}
+	if q.push("late", outputDirect) {
+		t.Fatalf("expected pushes to be rejected after disconnect")
+	}
+}
+
+func TestOutputQueueStallTimeoutAppliesToEveryPolicy(t *testing.T) {
+	for _, policy := range []OutputPolicy{OutputPolicyCoalesce, OutputPolicyDropOldest} {
+		now := time.Unix(1000, 0)
+		q := newOutputQueue(OutputConfig{Policy: policy, StallTimeout: time.Second})
+		q.now = func() time.Time { return now }
+		stalled := 0
+		q.onStall = func() { stalled++ }
+
+		q.push("first", outputDirect)
+		q.take(nil, outputBatchLimit)
+		now = now.Add(2 * time.Second)
+		q.push("second", outputChatter)
+		if stalled != 1 {
+			t.Fatalf("%s: expected a stalled write to disconnect, got %d stalls", policy, stalled)
+		}
+	}
+}
+
+func TestIsPromptRecognisesRenderedPrompts(t *testing.T) {
+	p := &Player{Name: "Tester"}
+	if !isPrompt(Prompt(p)) || !isPrompt(Prompt(nil)) {
+		t.Fatalf("expected rendered prompts to be recognised")
+	}
+	if isPrompt(Ansi(Style("\r\nYou strike the wolf. >", AnsiYellow))) {
+		t.Fatalf("unexpected prompt match for ordinary output")
+	}
+}
@@ -2,37 +2,48 @@ package game
 
 import (
 	"strings"
-	"sync"
+	"sync/atomic"
 	"time"
 )
 
 // Player represents a connected adventurer in the world.
 type Player struct {
-	Name             string
-	Account          string
-	Session          *TelnetSession
-	Room             RoomID
-	Home             RoomID
-	Output           chan string
-	Alive            bool
-	IsAdmin          bool
-	IsModerator      bool
-	IsBuilder        bool
-	Channels         map[Channel]bool
-	ChannelAliases   map[Channel]string
-	Inventory        []Item
-	JoinedAt         time.Time
-	Level            int
-	Experience       int
-	Health           int
-	MaxHealth        int
-	Mana             int
-	MaxMana          int
-	history          []time.Time
-	channelHistory   map[Channel][]ChannelLogEntry
-	channelHistoryMu sync.Mutex
-	MutedChannels    map[Channel]bool
-	QuestLog         map[string]*QuestProgress
+	Name           string
+	Account        string
+	Session        *TelnetSession
+	Room           RoomID
+	Home           RoomID
+	Alive          bool
+	IsAdmin        bool
+	IsModerator    bool
+	IsBuilder      bool
+	Channels       map[Channel]bool
+	ChannelAliases map[Channel]string
+	Inventory      []Item
+	JoinedAt       time.Time
+	Level          int
+	Experience     int
+	Health         int
+	MaxHealth      int
+	Mana           int
+	MaxMana        int
+	// queue is the session output queue Send delivers to, set while the
+	// player is logged in over telnet.
+	queue atomic.Pointer[outputQueue]
+	// defeated is set when the player falls in combat and cleared once they
+	// have been moved home, so nothing can hit or be hit by them in between.
+	// It is written under the room's shard lock or the world lock.
+	defeated bool
+	// commands limits how quickly the player may send commands.
+	commands tokenBucket
+	// channelHistoryFrom is the channel log sequence at which the player
+	// joined; broadcasts before it are not part of their history.
+	channelHistoryFrom uint64
+	MutedChannels      map[Channel]bool
+	QuestLog           map[string]*QuestProgress
+	indexedRoom        RoomID
+	indexed            bool
+	loginSeq           uint64
 }
 
 // PlayerProfile captures persistent player state and preferences.
@@ -51,23 +62,42 @@ const (
 const (
 	// ChannelHistoryDefault is the default number of entries displayed by the history command.
 	ChannelHistoryDefault = 10
-	// ChannelHistoryLimit caps the number of retained messages per channel.
+	// ChannelHistoryLimit caps the number of messages a player's history shows per channel.
 	ChannelHistoryLimit = 50
 )
 
 func (p *Player) allowCommand(now time.Time) bool {
-	cutoff := now.Add(-commandWindow)
-	filtered := p.history[:0]
-	for _, t := range p.history {
-		if t.After(cutoff) {
-			filtered = append(filtered, t)
-		}
+	return p.commands.take(now)
+}
+
+// tokenBucket allows bursts of up to burst events, refilled at rate per
+// second. Zero rate and burst use commandLimit per commandWindow.
+type tokenBucket struct {
+	rate   float64
+	burst  float64
+	tokens float64
+	last   time.Time
+}
+
+func (b *tokenBucket) take(now time.Time) bool {
+	rate, burst := b.rate, b.burst
+	if rate <= 0 {
+		rate = float64(commandLimit) / commandWindow.Seconds()
 	}
-	p.history = filtered
-	if len(p.history) >= commandLimit {
+	if burst < 1 {
+		burst = commandLimit
+	}
+	if b.last.IsZero() {
+		b.tokens = burst
+		b.last = now
+	} else if elapsed := now.Sub(b.last); elapsed > 0 {
+		b.tokens = min(burst, b.tokens+elapsed.Seconds()*rate)
+		b.last = now
+	}
+	if b.tokens < 1 {
 		return false
 	}
-	p.history = append(p.history, now)
+	b.tokens--
 	return true
 }
 
@@ -167,40 +197,6 @@ func (p *Player) setChannelAlias(channel Channel, alias string) {
 	p.ChannelAliases[channel] = trimmed
 }
 
-func (p *Player) rememberChannelMessage(channel Channel, message string, when time.Time) {
-	if when.IsZero() {
-		when = time.Now()
-	}
-	p.channelHistoryMu.Lock()
-	if p.channelHistory == nil {
-		p.channelHistory = make(map[Channel][]ChannelLogEntry)
-	}
-	entries := append(p.channelHistory[channel], ChannelLogEntry{Timestamp: when, Message: message, Channel: channel})
-	if excess := len(entries) - ChannelHistoryLimit; excess > 0 {
-		entries = append([]ChannelLogEntry(nil), entries[excess:]...)
-	}
-	p.channelHistory[channel] = entries
-	p.channelHistoryMu.Unlock()
-}
-
-func (p *Player) snapshotChannelHistory(channel Channel, limit int) []ChannelLogEntry {
-	if limit <= 0 || limit > ChannelHistoryLimit {
-		limit = ChannelHistoryLimit
-	}
-	p.channelHistoryMu.Lock()
-	defer p.channelHistoryMu.Unlock()
-	entries := p.channelHistory[channel]
-	if len(entries) == 0 {
-		return nil
-	}
-	if len(entries) > limit {
-		entries = entries[len(entries)-limit:]
-	}
-	out := make([]ChannelLogEntry, len(entries))
-	copy(out, entries)
-	return out
-}
-
 func (p *Player) muted(channel Channel) bool {
 	if p.MutedChannels == nil {
 		return false
@@ -56,6 +56,9 @@ type PortalConfig struct {
 	KeyFile    string
 	TokenTTL   time.Duration
 	SessionTTL time.Duration
+	// MetricsToken lets scrapers read /metrics and /debug/pprof/ with an
+	// "Authorization: Bearer" header instead of a portal session.
+	MetricsToken string
 }
 
 var portalFactory = newPortalServer
@@ -111,6 +114,8 @@ type PortalServer struct {
 	baseURL    string
 	tokenTTL   time.Duration
 	sessionTTL time.Duration
+	// metricsToken, when set, authorises scrapers of the diagnostics pages.
+	metricsToken string
 
 	mu        sync.Mutex
 	tokens    map[string]portalToken
@@ -121,6 +126,12 @@ type PortalServer struct {
 	server   *http.Server
 	listener net.Listener
 	ready    chan struct{}
+
+	// feed shares snapshots between requests and drives /api/stream; done
+	// is closed by Close to end open streams.
+	feed      *portalFeed
+	done      chan struct{}
+	closeOnce sync.Once
 }
 
 func newPortalServer(world *World, cfg PortalConfig) (PortalProvider, error) {
@@ -170,17 +181,20 @@ func newPortalServer(world *World, cfg PortalConfig) (PortalProvider, error) {
 
 	server := &http.Server{}
 	portal := &PortalServer{
-		world:      world,
-		baseURL:    baseURL,
-		tokenTTL:   tokenTTL,
-		sessionTTL: sessionTTL,
-		tokens:     make(map[string]portalToken),
-		sessions:   make(map[string]portalSession),
-		documents:  make(map[string]portalDocument),
-		server:     server,
-		listener:   listener,
-		ready:      make(chan struct{}),
-	}
+		world:        world,
+		baseURL:      baseURL,
+		tokenTTL:     tokenTTL,
+		sessionTTL:   sessionTTL,
+		metricsToken: strings.TrimSpace(cfg.MetricsToken),
+		tokens:       make(map[string]portalToken),
+		sessions:     make(map[string]portalSession),
+		documents:    make(map[string]portalDocument),
+		server:       server,
+		listener:     listener,
+		ready:        make(chan struct{}),
+		done:         make(chan struct{}),
+	}
+	portal.feed = &portalFeed{collect: portal.collectPortalData}
 
 	mux := http.NewServeMux()
 	mux.HandleFunc("/", portal.handleRoot)
@@ -188,7 +202,10 @@ func newPortalServer(world *World, cfg PortalConfig) (PortalProvider, error) {
 	mux.HandleFunc("/interface", portal.handleInterface)
 	mux.HandleFunc("/api/players", portal.handlePlayersAPI)
 	mux.HandleFunc("/api/overview", portal.handleOverviewAPI)
+	mux.HandleFunc("/api/stream", portal.handleStreamAPI)
 	mux.HandleFunc("/api/documents", portal.handleDocumentsAPI)
+	mux.HandleFunc("/metrics", portal.handleMetrics)
+	mux.HandleFunc("/debug/pprof/", portal.handlePprof)
 	server.Handler = portal.addSecurityHeaders(mux)
 
 	go func() {
@@ -244,6 +261,7 @@ func (p *PortalServer) Close() error {
 	if p == nil {
 		return nil
 	}
+	p.closeOnce.Do(func() { close(p.done) })
 	ctx, cancel := context.WithTimeout(context.Background(), 2*time.Second)
 	defer cancel()
 	return p.server.Shutdown(ctx)
@@ -338,7 +356,8 @@ func (p *PortalServer) handleInterface(w http.ResponseWriter, r *http.Request) {
 		overview portalOverview
 	)
 	if isStaffPortalRole(session.Role) {
-		views, overview = p.collectPortalData(now)
+		snapshot := p.feed.current(now)
+		views, overview = snapshot.views, snapshot.overview
 	} else {
 		views = []portalPlayerView{}
 	}
@@ -385,11 +404,10 @@ func (p *PortalServer) handlePlayersAPI(w http.ResponseWriter, r *http.Request)
 		return
 	}
 	p.setSessionCookie(w, id, session.Expires)
-	views, _ := p.collectPortalData(time.Now())
-	data, _ := json.Marshal(views)
+	snapshot := p.feed.current(time.Now())
 	w.Header().Set("Content-Type", "application/json")
 	w.Header().Set("Cache-Control", "no-store")
-	_, _ = w.Write(data)
+	_, _ = w.Write(snapshot.players)
 }
 
 func (p *PortalServer) collectPortalData(now time.Time) ([]portalPlayerView, portalOverview) {
@@ -400,15 +418,22 @@ func (p *PortalServer) collectPortalData(now time.Time) ([]portalPlayerView, por
 	var sessionsCount int64
 	for _, snap := range snapshots {
 		view := portalPlayerView{
-			Name:      snap.Name,
-			Location:  snap.RoomTitle,
-			RoomID:    string(snap.Room),
-			Roles:     playerRolesForSnapshot(snap),
-			Level:     snap.Level,
-			Health:    snap.Health,
-			MaxHealth: snap.MaxHealth,
-			Mana:      snap.Mana,
-			MaxMana:   snap.MaxMana,
+			Name:          snap.Name,
+			Location:      snap.RoomTitle,
+			RoomID:        string(snap.Room),
+			Roles:         playerRolesForSnapshot(snap),
+			Level:         snap.Level,
+			Health:        snap.Health,
+			MaxHealth:     snap.MaxHealth,
+			Mana:          snap.Mana,
+			MaxMana:       snap.MaxMana,
+			OutputQueued:  snap.Output.Queued,
+			OutputPeak:    snap.Output.HighWater,
+			OutputDropped: snap.Output.Dropped,
+			OutputMerged:  snap.Output.Coalesced,
+			OutputRaw:     snap.Output.RawBytes,
+			OutputWire:    snap.Output.WireBytes,
+			CompressMicro: snap.Output.CompressTime.Microseconds(),
 		}
 		if strings.TrimSpace(view.Location) == "" {
 			view.Location = view.RoomID
@@ -448,6 +473,17 @@ func (p *PortalServer) collectPortalData(now time.Time) ([]portalPlayerView, por
 		overview.AverageSessionSeconds = sessionTotal / sessionsCount
 	}
 	overview.AverageSessionDisplay = formatCompactDuration(time.Duration(overview.AverageSessionSeconds) * time.Second)
+	combat := p.world.CombatStats()
+	overview.ActiveCombats = combat.Active
+	overview.CombatJitterMillis = float64(combat.MeanJitter) / float64(time.Millisecond)
+	overview.CombatJitterMaxMillis = float64(combat.MaxJitter) / float64(time.Millisecond)
+	for _, script := range p.world.ScriptStats() {
+		overview.ScriptCalls += script.Calls
+		overview.ScriptTimeouts += script.Timeouts
+		if script.Disabled {
+			overview.ScriptsDisabled++
+		}
+	}
 	return views, overview
 }
 
@@ -462,11 +498,10 @@ func (p *PortalServer) handleOverviewAPI(w http.ResponseWriter, r *http.Request)
 		return
 	}
 	p.setSessionCookie(w, id, session.Expires)
-	_, overview := p.collectPortalData(time.Now())
-	data, _ := json.Marshal(overview)
+	snapshot := p.feed.current(time.Now())
 	w.Header().Set("Content-Type", "application/json")
 	w.Header().Set("Cache-Control", "no-store")
-	_, _ = w.Write(data)
+	_, _ = w.Write(snapshot.summary)
 }
 
 func (p *PortalServer) handleDocumentsAPI(w http.ResponseWriter, r *http.Request) {
@@ -859,6 +894,13 @@ type portalPlayerView struct {
 	MaxMana        int      `json:"max_mana"`
 	JoinedAt       string   `json:"joined_at,omitempty"`
 	SessionSeconds int64    `json:"session_seconds,omitempty"`
+	OutputQueued   int      `json:"output_queued"`
+	OutputPeak     int      `json:"output_high_water"`
+	OutputDropped  uint64   `json:"output_dropped"`
+	OutputMerged   uint64   `json:"output_coalesced"`
+	OutputRaw      uint64   `json:"output_raw_bytes,omitempty"`
+	OutputWire     uint64   `json:"output_wire_bytes,omitempty"`
+	CompressMicro  int64    `json:"output_compress_us,omitempty"`
 }
 
 type portalDocument struct {
@@ -900,13 +942,19 @@ type portalPageData struct {
 }
 
 type portalOverview struct {
-	TotalPlayers          int    `json:"total_players"`
-	StaffOnline           int    `json:"staff_online"`
-	Builders              int    `json:"builders"`
-	Moderators            int    `json:"moderators"`
-	Admins                int    `json:"admins"`
-	AverageSessionSeconds int64  `json:"average_session_seconds"`
-	AverageSessionDisplay string `json:"average_session_display"`
+	TotalPlayers          int     `json:"total_players"`
+	StaffOnline           int     `json:"staff_online"`
+	Builders              int     `json:"builders"`
+	Moderators            int     `json:"moderators"`
+	Admins                int     `json:"admins"`
+	AverageSessionSeconds int64   `json:"average_session_seconds"`
+	AverageSessionDisplay string  `json:"average_session_display"`
+	ActiveCombats         int     `json:"active_combats"`
+	CombatJitterMillis    float64 `json:"combat_jitter_ms"`
+	CombatJitterMaxMillis float64 `json:"combat_jitter_max_ms"`
+	ScriptCalls           uint64  `json:"script_calls"`
+	ScriptTimeouts        uint64  `json:"script_timeouts"`
+	ScriptsDisabled       int     `json:"scripts_disabled"`
 }
 
 func formatCompactDuration(d time.Duration) string {
@@ -1192,6 +1240,26 @@ const formatSession = (seconds) => {
   }
   return parts.join(' ');
 };
+const formatBytes = (value) => {
+  const total = safeNumber(value, 0);
+  if (total < 1024) {
+    return total + ' B';
+  }
+  return (total / 1024).toFixed(total < 10240 ? 1 : 0) + ' KB';
+};
+const formatOutput = (entry) => {
+  const dropped = safeNumber(entry.output_dropped, 0);
+  const merged = safeNumber(entry.output_coalesced, 0);
+  let label = 'peak ' + formatBytes(entry.output_high_water);
+  if (dropped) label += ', ' + dropped + ' dropped';
+  if (merged) label += ', ' + merged + ' merged';
+  const raw = safeNumber(entry.output_raw_bytes, 0);
+  const wire = safeNumber(entry.output_wire_bytes, 0);
+  if (raw && wire) {
+    label += ', mccp ' + (raw / wire).toFixed(1) + 'x in ' + (safeNumber(entry.output_compress_us, 0) / 1000).toFixed(1) + ' ms';
+  }
+  return label;
+};
 const formatTimestamp = (value) => {
   if (!value) {
     return '';
@@ -1357,7 +1425,7 @@ const renderPlayers = (entries) => {
     playersMount.innerHTML = '<p class="empty-state">No adventurers are currently connected.</p>';
     return;
   }
-  let html = '<table><thead><tr><th>Name</th><th>Location</th><th>Level</th><th>Vitality</th><th>Energy</th><th>Session</th><th>Roles</th></tr></thead><tbody>';
+  let html = '<table><thead><tr><th>Name</th><th>Location</th><th>Level</th><th>Vitality</th><th>Energy</th><th>Session</th><th>Output</th><th>Roles</th></tr></thead><tbody>';
   for (let i = 0; i < entries.length; i++) {
     const entry = entries[i];
     const roles = (entry.roles || []).map((role) => '<span class="role-chip">' + escapeHTML(role) + '</span>').join('');
@@ -1372,6 +1440,7 @@ const renderPlayers = (entries) => {
       '<td data-label="Vitality" class="vital-metric">' + formatVital(entry.health, entry.max_health) + '</td>' +
       '<td data-label="Energy" class="vital-metric">' + formatVital(entry.mana, entry.max_mana) + '</td>' +
       '<td data-label="Session"><span class="session-pill"' + sessionTitle + '>' + escapeHTML(sessionLabel) + '</span></td>' +
+      '<td data-label="Output" class="vital-metric" title="Queued now: ' + escapeHTML(formatBytes(entry.output_queued)) + '">' + escapeHTML(formatOutput(entry)) + '</td>' +
       '<td data-label="Roles">' + roles + '</td>' +
       '</tr>';
   }
@@ -1627,7 +1696,82 @@ const refresh = async () => {
     console.warn('Portal refresh failed', err);
   }
 };
-setInterval(refresh, 10000);
+let livePlayers = Array.isArray(initialPlayers) ? initialPlayers.slice() : [];
+let renderQueued = false;
+const renderLive = () => {
+  renderQueued = false;
+  const now = Date.now();
+  for (let i = 0; i < livePlayers.length; i++) {
+    const entry = livePlayers[i];
+    const joined = entry.joined_at ? Date.parse(entry.joined_at) : NaN;
+    if (Number.isFinite(joined)) {
+      entry.session_seconds = Math.max(0, Math.floor((now - joined) / 1000));
+    }
+  }
+  renderPlayers(livePlayers);
+};
+const queueRender = () => {
+  if (!renderQueued) {
+    renderQueued = true;
+    setTimeout(renderLive, 0);
+  }
+};
+const upsertPlayer = (entry) => {
+  const index = livePlayers.findIndex((player) => player.name === entry.name);
+  if (index >= 0) {
+    livePlayers[index] = entry;
+  } else {
+    livePlayers.push(entry);
+  }
+  queueRender();
+};
+const parseStreamEvent = (event) => {
+  try {
+    return JSON.parse(event.data);
+  } catch (err) {
+    console.warn('Portal stream event was malformed', err);
+    return null;
+  }
+};
+if (typeof EventSource !== 'undefined' && playersMount) {
+  const stream = new EventSource('/api/stream');
+  stream.addEventListener('snapshot', (event) => {
+    const data = parseStreamEvent(event);
+    if (!data) return;
+    livePlayers = Array.isArray(data.players) ? data.players : [];
+    queueRender();
+    renderOverview(data.overview);
+  });
+  stream.addEventListener('join', (event) => {
+    const data = parseStreamEvent(event);
+    if (data) upsertPlayer(data);
+  });
+  stream.addEventListener('vitals', (event) => {
+    const data = parseStreamEvent(event);
+    if (data) upsertPlayer(data);
+  });
+  stream.addEventListener('move', (event) => {
+    const data = parseStreamEvent(event);
+    const entry = data && livePlayers.find((player) => player.name === data.name);
+    if (!entry) return;
+    entry.room_id = data.room_id;
+    entry.location = data.location;
+    queueRender();
+  });
+  stream.addEventListener('leave', (event) => {
+    const data = parseStreamEvent(event);
+    if (!data) return;
+    livePlayers = livePlayers.filter((player) => player.name !== data.name);
+    queueRender();
+  });
+  stream.addEventListener('overview', (event) => {
+    const data = parseStreamEvent(event);
+    if (data) renderOverview(data);
+  });
+  setInterval(queueRender, 10000);
+} else {
+  setInterval(refresh, 10000);
+}
 </script>
 </body>
 </html>`))
@@ -0,0 +1,80 @@
+package game
+
+import (
+	"bytes"
+	"crypto/subtle"
+	"net/http"
+	"net/http/pprof"
+	"strings"
+)
+
+// handleMetrics serves the server metrics in the Prometheus text format to
+// staff sessions and to scrapers presenting the configured metrics token.
+func (p *PortalServer) handleMetrics(w http.ResponseWriter, r *http.Request) {
+	if r.Method != http.MethodGet {
+		http.Error(w, "method not allowed", http.StatusMethodNotAllowed)
+		return
+	}
+	if !p.authorizeDiagnostics(w, r, isStaffPortalRole) {
+		return
+	}
+	var buf bytes.Buffer
+	if err := p.world.WriteMetrics(&buf); err != nil {
+		http.Error(w, "metrics error", http.StatusInternalServerError)
+		return
+	}
+	w.Header().Set("Content-Type", "text/plain; version=0.0.4; charset=utf-8")
+	w.Header().Set("Cache-Control", "no-store")
+	_, _ = w.Write(buf.Bytes())
+}
+
+// handlePprof exposes the runtime profiles under /debug/pprof/ to admin
+// sessions only. The metrics token is not enough: cmdline would show it, and
+// the bus secret, to whoever holds it.
+func (p *PortalServer) handlePprof(w http.ResponseWriter, r *http.Request) {
+	if !p.authorizeSession(w, r, func(role PortalRole) bool { return role == PortalRoleAdmin }) {
+		return
+	}
+	switch strings.TrimPrefix(r.URL.Path, "/debug/pprof/") {
+	case "cmdline":
+		pprof.Cmdline(w, r)
+	case "profile":
+		pprof.Profile(w, r)
+	case "symbol":
+		pprof.Symbol(w, r)
+	case "trace":
+		pprof.Trace(w, r)
+	default:
+		pprof.Index(w, r)
+	}
+}
+
+// authorizeDiagnostics accepts a bearer metrics token, when one is
+// configured, or a portal session whose role passes allowed. It writes the
+// error response itself when the request is refused.
+func (p *PortalServer) authorizeDiagnostics(w http.ResponseWriter, r *http.Request, allowed func(PortalRole) bool) bool {
+	if token, ok := strings.CutPrefix(r.Header.Get("Authorization"), "Bearer "); ok && p.metricsToken != "" {
+		if subtle.ConstantTimeCompare([]byte(strings.TrimSpace(token)), []byte(p.metricsToken)) == 1 {
+			return true
+		}
+		http.Error(w, "unauthorized", http.StatusUnauthorized)
+		return false
+	}
+	return p.authorizeSession(w, r, allowed)
+}
+
+// authorizeSession accepts a portal session whose role passes allowed,
+// writing the error response itself when the request is refused.
+func (p *PortalServer) authorizeSession(w http.ResponseWriter, r *http.Request, allowed func(PortalRole) bool) bool {
+	session, id, ok := p.sessionForRequest(r)
+	if !ok {
+		http.Error(w, "unauthorized", http.StatusUnauthorized)
+		return false
+	}
+	if !allowed(session.Role) {
+		http.Error(w, "forbidden", http.StatusForbidden)
+		return false
+	}
+	p.setSessionCookie(w, id, session.Expires)
+	return true
+}
@@ -0,0 +1,269 @@
+package game
+
+import (
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"net/http"
+	"slices"
+	"sync"
+	"time"
+)
+
+const (
+	// portalSnapshotTTL is how long one world snapshot serves every portal
+	// request, so concurrent dashboards share a single PlayerSnapshots call.
+	portalSnapshotTTL = time.Second
+	// portalStreamInterval is how often open streams receive changes.
+	portalStreamInterval = 2 * time.Second
+	// portalStreamBuffer is how many updates a stream may fall behind before
+	// it is dropped; the browser reconnects and starts from a new snapshot.
+	portalStreamBuffer = 16
+)
+
+var portalKeepalive = []byte(": keepalive\n\n")
+
+// portalSnapshot is the dashboard data collected at one instant, with its
+// JSON encodings for the REST endpoints.
+type portalSnapshot struct {
+	at       time.Time
+	views    []portalPlayerView
+	overview portalOverview
+	players  []byte
+	summary  []byte
+}
+
+// portalFeed caches the latest snapshot for REST polls and turns successive
+// snapshots into join, leave, move and vitals events for /api/stream. A
+// single aggregator goroutine runs while at least one stream is open.
+type portalFeed struct {
+	collect func(time.Time) ([]portalPlayerView, portalOverview)
+
+	mu       sync.Mutex
+	snapshot *portalSnapshot
+
+	// streamMu guards the subscribers and last, the snapshot they have all
+	// been brought up to date with.
+	streamMu sync.Mutex
+	subs     map[chan []byte]struct{}
+	last     *portalSnapshot
+	stop     chan struct{}
+}
+
+// current returns a snapshot no older than portalSnapshotTTL, collecting a
+// new one when needed.
+func (f *portalFeed) current(now time.Time) *portalSnapshot {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	if s := f.snapshot; s != nil && !now.Before(s.at) && now.Sub(s.at) < portalSnapshotTTL {
+		return s
+	}
+	views, overview := f.collect(now)
+	players, _ := json.Marshal(views)
+	summary, _ := json.Marshal(overview)
+	f.snapshot = &portalSnapshot{at: now, views: views, overview: overview, players: players, summary: summary}
+	return f.snapshot
+}
+
+// subscribe registers a stream and returns its update channel together with
+// the snapshot event the stream must start from.
+func (f *portalFeed) subscribe() (chan []byte, []byte) {
+	f.streamMu.Lock()
+	defer f.streamMu.Unlock()
+	if f.last == nil {
+		f.last = f.current(time.Now())
+	}
+	if f.subs == nil {
+		f.subs = make(map[chan []byte]struct{})
+	}
+	ch := make(chan []byte, portalStreamBuffer)
+	f.subs[ch] = struct{}{}
+	if f.stop == nil {
+		f.stop = make(chan struct{})
+		go f.run(f.stop)
+	}
+	return ch, portalSnapshotEvent(f.last)
+}
+
+func (f *portalFeed) unsubscribe(ch chan []byte) {
+	f.streamMu.Lock()
+	delete(f.subs, ch)
+	f.stopIfIdleLocked()
+	f.streamMu.Unlock()
+}
+
+func (f *portalFeed) stopIfIdleLocked() {
+	if len(f.subs) == 0 && f.stop != nil {
+		close(f.stop)
+		f.stop = nil
+		f.last = nil
+	}
+}
+
+func (f *portalFeed) run(stop chan struct{}) {
+	ticker := time.NewTicker(portalStreamInterval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-stop:
+			return
+		case now := <-ticker.C:
+			f.publish(now)
+		}
+	}
+}
+
+// publish sends every stream the changes since the last snapshot. Streams
+// whose buffer is full are closed rather than waited for.
+func (f *portalFeed) publish(now time.Time) {
+	f.streamMu.Lock()
+	defer f.streamMu.Unlock()
+	if f.last == nil {
+		return
+	}
+	next := f.current(now)
+	frames := portalDeltaEvents(f.last, next)
+	f.last = next
+	if len(frames) == 0 {
+		frames = portalKeepalive
+	}
+	for ch := range f.subs {
+		select {
+		case ch <- frames:
+		default:
+			delete(f.subs, ch)
+			close(ch)
+		}
+	}
+	f.stopIfIdleLocked()
+}
+
+type portalMoveEvent struct {
+	Name     string `json:"name"`
+	RoomID   string `json:"room_id"`
+	Location string `json:"location"`
+}
+
+type portalLeaveEvent struct {
+	Name string `json:"name"`
+}
+
+func portalSnapshotEvent(s *portalSnapshot) []byte {
+	var buf bytes.Buffer
+	buf.WriteString("event: snapshot\ndata: {\"players\":")
+	buf.Write(s.players)
+	buf.WriteString(",\"overview\":")
+	buf.Write(s.summary)
+	buf.WriteString("}\n\n")
+	return buf.Bytes()
+}
+
+// portalDeltaEvents encodes the differences between two snapshots as
+// server-sent events.
+func portalDeltaEvents(prev, next *portalSnapshot) []byte {
+	var buf bytes.Buffer
+	before := make(map[string]*portalPlayerView, len(prev.views))
+	for i := range prev.views {
+		before[prev.views[i].Name] = &prev.views[i]
+	}
+	for i := range next.views {
+		view := &next.views[i]
+		old, ok := before[view.Name]
+		if !ok {
+			writePortalEvent(&buf, "join", view)
+			continue
+		}
+		delete(before, view.Name)
+		if old.RoomID != view.RoomID || old.Location != view.Location {
+			writePortalEvent(&buf, "move", portalMoveEvent{Name: view.Name, RoomID: view.RoomID, Location: view.Location})
+		}
+		if !samePortalVitals(old, view) {
+			writePortalEvent(&buf, "vitals", view)
+		}
+	}
+	for i := range prev.views {
+		if _, left := before[prev.views[i].Name]; left {
+			writePortalEvent(&buf, "leave", portalLeaveEvent{Name: prev.views[i].Name})
+		}
+	}
+	if !bytes.Equal(prev.summary, next.summary) {
+		fmt.Fprintf(&buf, "event: overview\ndata: %s\n\n", next.summary)
+	}
+	return buf.Bytes()
+}
+
+func writePortalEvent(buf *bytes.Buffer, event string, payload any) {
+	data, err := json.Marshal(payload)
+	if err != nil {
+		return
+	}
+	fmt.Fprintf(buf, "event: %s\ndata: %s\n\n", event, data)
+}
+
+// samePortalVitals reports whether a player's row changed other than by
+// moving or by the session timer, which the browser advances itself.
+func samePortalVitals(a, b *portalPlayerView) bool {
+	return a.Level == b.Level &&
+		a.Health == b.Health && a.MaxHealth == b.MaxHealth &&
+		a.Mana == b.Mana && a.MaxMana == b.MaxMana &&
+		a.JoinedAt == b.JoinedAt &&
+		a.OutputQueued == b.OutputQueued && a.OutputPeak == b.OutputPeak &&
+		a.OutputDropped == b.OutputDropped && a.OutputMerged == b.OutputMerged &&
+		a.OutputRaw == b.OutputRaw && a.OutputWire == b.OutputWire &&
+		slices.Equal(a.Roles, b.Roles)
+}
+
+// handleStreamAPI streams dashboard changes to staff as server-sent events.
+// The stream ends when the portal session would expire; the browser then
+// reconnects, renewing the session if it is still valid.
+func (p *PortalServer) handleStreamAPI(w http.ResponseWriter, r *http.Request) {
+	if r.Method != http.MethodGet {
+		http.Error(w, "method not allowed", http.StatusMethodNotAllowed)
+		return
+	}
+	session, id, ok := p.sessionForRequest(r)
+	if !ok {
+		http.Error(w, "unauthorized", http.StatusUnauthorized)
+		return
+	}
+	if !isStaffPortalRole(session.Role) {
+		http.Error(w, "forbidden", http.StatusForbidden)
+		return
+	}
+	flusher, ok := w.(http.Flusher)
+	if !ok {
+		http.Error(w, "streaming unsupported", http.StatusInternalServerError)
+		return
+	}
+	p.setSessionCookie(w, id, session.Expires)
+	w.Header().Set("Content-Type", "text/event-stream")
+	w.Header().Set("Cache-Control", "no-store")
+
+	updates, initial := p.feed.subscribe()
+	defer p.feed.unsubscribe(updates)
+	if _, err := w.Write(initial); err != nil {
+		return
+	}
+	flusher.Flush()
+
+	expired := time.NewTimer(time.Until(session.Expires))
+	defer expired.Stop()
+	for {
+		select {
+		case frames, ok := <-updates:
+			if !ok {
+				return
+			}
+			if _, err := w.Write(frames); err != nil {
+				return
+			}
+			flusher.Flush()
+		case <-r.Context().Done():
+			return
+		case <-p.done:
+			return
+		case <-expired.C:
+			return
+		}
+	}
+}
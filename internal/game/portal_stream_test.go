@@ -0,0 +1,187 @@
+package game
+
+import (
+	"bufio"
+	"context"
+	"crypto/tls"
+	"net/http"
+	"net/url"
+	"path/filepath"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+)
+
+// fakePortalData serves a mutable player list to a portalFeed.
+type fakePortalData struct {
+	mu    sync.Mutex
+	views []portalPlayerView
+	calls int
+}
+
+func (d *fakePortalData) collect(time.Time) ([]portalPlayerView, portalOverview) {
+	d.mu.Lock()
+	defer d.mu.Unlock()
+	d.calls++
+	views := append([]portalPlayerView(nil), d.views...)
+	return views, portalOverview{TotalPlayers: len(views)}
+}
+
+func (d *fakePortalData) set(views ...portalPlayerView) {
+	d.mu.Lock()
+	d.views = views
+	d.mu.Unlock()
+}
+
+func TestPortalFeedSharesSnapshotWithinTick(t *testing.T) {
+	data := &fakePortalData{}
+	feed := &portalFeed{collect: data.collect}
+	now := time.Now()
+	first := feed.current(now)
+	if again := feed.current(now.Add(portalSnapshotTTL / 2)); again != first {
+		t.Fatalf("expected the snapshot to be reused within the tick")
+	}
+	if later := feed.current(now.Add(portalSnapshotTTL)); later == first {
+		t.Fatalf("expected a new snapshot after the tick")
+	}
+	if data.calls != 2 {
+		t.Fatalf("collected %d times, want 2", data.calls)
+	}
+}
+
+func TestPortalDeltaEvents(t *testing.T) {
+	prev := &portalSnapshot{
+		views: []portalPlayerView{
+			{Name: "Alice", RoomID: "start", Health: 10, SessionSeconds: 5, Roles: []string{"builder"}},
+			{Name: "Bob", RoomID: "start"},
+			{Name: "Cara", RoomID: "hall"},
+		},
+		summary: []byte(`{"total_players":3}`),
+	}
+	next := &portalSnapshot{
+		views: []portalPlayerView{
+			{Name: "Alice", RoomID: "start", Health: 10, SessionSeconds: 7, Roles: []string{"builder"}},
+			{Name: "Bob", RoomID: "hall", Location: "Hall", Health: 4},
+			{Name: "Dan", RoomID: "start"},
+		},
+		summary: []byte(`{"total_players":3}`),
+	}
+	got := string(portalDeltaEvents(prev, next))
+	for _, want := range []string{
+		"event: move\ndata: {\"name\":\"Bob\",\"room_id\":\"hall\",\"location\":\"Hall\"}\n\n",
+		"event: vitals\ndata: {\"name\":\"Bob\"",
+		"event: join\ndata: {\"name\":\"Dan\"",
+		"event: leave\ndata: {\"name\":\"Cara\"}\n\n",
+	} {
+		if !strings.Contains(got, want) {
+			t.Fatalf("events missing %q:\n%s", want, got)
+		}
+	}
+	if strings.Contains(got, "Alice") || strings.Contains(got, "overview") {
+		t.Fatalf("expected no events for unchanged data:\n%s", got)
+	}
+}
+
+func TestPortalFeedStreamsChanges(t *testing.T) {
+	data := &fakePortalData{}
+	data.set(portalPlayerView{Name: "Alice", RoomID: "start"})
+	feed := &portalFeed{collect: data.collect}
+
+	updates, initial := feed.subscribe()
+	if !strings.HasPrefix(string(initial), "event: snapshot\ndata: {\"players\":[{\"name\":\"Alice\"") {
+		t.Fatalf("unexpected snapshot event %q", initial)
+	}
+	data.set(portalPlayerView{Name: "Alice", RoomID: "start"}, portalPlayerView{Name: "Bob", RoomID: "hall"})
+	feed.publish(time.Now().Add(portalSnapshotTTL))
+	select {
+	case frames := <-updates:
+		if !strings.Contains(string(frames), "event: join\ndata: {\"name\":\"Bob\"") {
+			t.Fatalf("expected a join for Bob, got %q", frames)
+		}
+	default:
+		t.Fatalf("expected an update after publish")
+	}
+
+	for i := 0; i <= portalStreamBuffer; i++ {
+		feed.publish(time.Now().Add(time.Duration(i+2) * portalSnapshotTTL))
+	}
+	for range updates {
+	}
+	feed.unsubscribe(updates)
+	feed.streamMu.Lock()
+	defer feed.streamMu.Unlock()
+	if len(feed.subs) != 0 || feed.stop != nil {
+		t.Fatalf("expected the slow stream to be dropped and the aggregator stopped")
+	}
+}
+
+func TestPortalStreamEndpoint(t *testing.T) {
+	dir := t.TempDir()
+	world := NewWorldWithRooms(map[RoomID]*Room{
+		"start": {ID: "start", Title: "Atrium", Exits: map[string]RoomID{}},
+	})
+	builder := &Player{Name: "Builder", Room: "start", Alive: true, IsBuilder: true}
+	world.AddPlayerForTest(builder)
+
+	cfg := PortalConfig{
+		Addr:     "127.0.0.1:0",
+		CertFile: filepath.Join(dir, "portal-cert.pem"),
+		KeyFile:  filepath.Join(dir, "portal-key.pem"),
+	}
+	provider, err := newPortalServer(world, cfg)
+	if err != nil {
+		t.Fatalf("newPortalServer error: %v", err)
+	}
+	portal := provider.(*PortalServer)
+	t.Cleanup(func() {
+		_ = portal.Close()
+	})
+	ctx, cancel := context.WithTimeout(context.Background(), 2*time.Second)
+	defer cancel()
+	if err := portal.WaitReady(ctx); err != nil {
+		t.Fatalf("portal did not start: %v", err)
+	}
+
+	client := &http.Client{
+		Transport: &http.Transport{TLSClientConfig: &tls.Config{InsecureSkipVerify: true}},
+		CheckRedirect: func(req *http.Request, via []*http.Request) error {
+			return http.ErrUseLastResponse
+		},
+	}
+	link, err := provider.GenerateLink(PortalRoleBuilder, "Builder")
+	if err != nil {
+		t.Fatalf("GenerateLink error: %v", err)
+	}
+	resp, err := client.Get(link.URL)
+	if err != nil {
+		t.Fatalf("GET portal token failed: %v", err)
+	}
+	resp.Body.Close()
+	cookie := findPortalCookie(resp.Cookies())
+	if cookie == nil {
+		t.Fatalf("portal cookie not set")
+	}
+
+	streamURL, _ := url.Parse(portal.BaseURL())
+	streamURL.Path = "/api/stream"
+	req, _ := http.NewRequestWithContext(ctx, http.MethodGet, streamURL.String(), nil)
+	req.AddCookie(cookie)
+	stream, err := client.Do(req)
+	if err != nil {
+		t.Fatalf("GET stream failed: %v", err)
+	}
+	defer stream.Body.Close()
+	if ct := stream.Header.Get("Content-Type"); ct != "text/event-stream" {
+		t.Fatalf("stream content type = %q", ct)
+	}
+	reader := bufio.NewReader(stream.Body)
+	line, err := reader.ReadString('\n')
+	if err != nil || line != "event: snapshot\n" {
+		t.Fatalf("first stream line = %q, %v", line, err)
+	}
+	data, err := reader.ReadString('\n')
+	if err != nil || !strings.Contains(data, `"name":"Builder"`) {
+		t.Fatalf("snapshot data = %q, %v", data, err)
+	}
+}
@@ -22,7 +22,7 @@ func TestPortalLinkSingleUse(t *testing.T) {
 	world := NewWorldWithRooms(map[RoomID]*Room{
 		"start": {ID: "start", Title: "Atrium", Description: "", Exits: map[string]RoomID{}},
 	})
-	player := &Player{Name: "Builder", Room: "start", Alive: true, Output: make(chan string, 1)}
+	player := &Player{Name: "Builder", Room: "start", Alive: true}
 	player.IsBuilder = true
 	world.AddPlayerForTest(player)
 
@@ -114,7 +114,7 @@ func TestPortalDocumentsAPI(t *testing.T) {
 	world := NewWorldWithRooms(map[RoomID]*Room{
 		"start": {ID: "start", Title: "Atrium", Description: "", Exits: map[string]RoomID{}},
 	})
-	player := &Player{Name: "Builder", Room: "start", Alive: true, Output: make(chan string, 1)}
+	player := &Player{Name: "Builder", Room: "start", Alive: true}
 	player.IsBuilder = true
 	world.AddPlayerForTest(player)
 
@@ -252,7 +252,7 @@ func TestPortalScriptFormatting(t *testing.T) {
 	world := NewWorldWithRooms(map[RoomID]*Room{
 		"start": {ID: "start", Title: "Atrium", Description: "", Exits: map[string]RoomID{}},
 	})
-	builder := &Player{Name: "Builder", Room: "start", Alive: true, Output: make(chan string, 1)}
+	builder := &Player{Name: "Builder", Room: "start", Alive: true}
 	builder.IsBuilder = true
 	world.AddPlayerForTest(builder)
 
@@ -379,10 +379,10 @@ func TestPortalPlayerAccessNotesOnly(t *testing.T) {
 	world := NewWorldWithRooms(map[RoomID]*Room{
 		"start": {ID: "start", Title: "Atrium", Description: "", Exits: map[string]RoomID{}},
 	})
-	builder := &Player{Name: "Builder", Room: "start", Alive: true, Output: make(chan string, 1)}
+	builder := &Player{Name: "Builder", Room: "start", Alive: true}
 	builder.IsBuilder = true
 	world.AddPlayerForTest(builder)
-	player := &Player{Name: "Seeker", Room: "start", Alive: true, Output: make(chan string, 1)}
+	player := &Player{Name: "Seeker", Room: "start", Alive: true}
 	world.AddPlayerForTest(player)
 
 	cfg := PortalConfig{Addr: "127.0.0.1:0", CertFile: cert, KeyFile: key}
@@ -552,7 +552,7 @@ func TestPortalDocumentLimit(t *testing.T) {
 	world := NewWorldWithRooms(map[RoomID]*Room{
 		"start": {ID: "start", Title: "Atrium", Description: "", Exits: map[string]RoomID{}},
 	})
-	builder := &Player{Name: "Builder", Room: "start", Alive: true, Output: make(chan string, 1)}
+	builder := &Player{Name: "Builder", Room: "start", Alive: true}
 	builder.IsBuilder = true
 	world.AddPlayerForTest(builder)
 
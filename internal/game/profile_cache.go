@@ -0,0 +1,69 @@
+package game
+
+import (
+	"container/list"
+	"maps"
+)
+
+// profileCacheSize is the number of player profiles kept decoded in memory.
+const profileCacheSize = 1024
+
+// profileCache holds the most recently used player profiles as they are on
+// disk, so reconnecting players are not read back and decoded each time.
+// Players with no profile file are cached too.
+type profileCache struct {
+	limit   int
+	entries map[string]*list.Element
+	// order has the most recently used profile at the front.
+	order list.List
+}
+
+type profileCacheEntry struct {
+	name    string
+	profile PlayerProfile
+	found   bool
+}
+
+func newProfileCache(limit int) *profileCache {
+	return &profileCache{limit: limit, entries: make(map[string]*list.Element)}
+}
+
+// get returns the cached profile for name and whether name has a profile
+// file. ok is false when name is not cached.
+func (c *profileCache) get(name string) (profile PlayerProfile, found, ok bool) {
+	elem, ok := c.entries[name]
+	if !ok {
+		return PlayerProfile{}, false, false
+	}
+	c.order.MoveToFront(elem)
+	entry := elem.Value.(*profileCacheEntry)
+	return entry.profile, entry.found, true
+}
+
+// put records what is on disk for name, replacing any cached copy.
+func (c *profileCache) put(name string, profile PlayerProfile, found bool) {
+	if elem, ok := c.entries[name]; ok {
+		elem.Value = &profileCacheEntry{name: name, profile: profile, found: found}
+		c.order.MoveToFront(elem)
+		return
+	}
+	c.entries[name] = c.order.PushFront(&profileCacheEntry{name: name, profile: profile, found: found})
+	for c.order.Len() > c.limit {
+		oldest := c.order.Back()
+		c.order.Remove(oldest)
+		delete(c.entries, oldest.Value.(*profileCacheEntry).name)
+	}
+}
+
+// add caches a profile read from disk unless a newer copy was cached while
+// it was being read.
+func (c *profileCache) add(name string, profile PlayerProfile, found bool) {
+	if _, ok := c.entries[name]; !ok {
+		c.put(name, profile, found)
+	}
+}
+
+func profilesEqual(a, b PlayerProfile) bool {
+	return a.Room == b.Room && a.Home == b.Home &&
+		maps.Equal(a.Channels, b.Channels) && maps.Equal(a.Aliases, b.Aliases)
+}
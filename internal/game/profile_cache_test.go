@@ -0,0 +1,113 @@
+package game
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+func TestProfileCacheEvictsLeastRecentlyUsed(t *testing.T) {
+	c := newProfileCache(2)
+	c.put("alice", PlayerProfile{Room: "a"}, true)
+	c.put("bob", PlayerProfile{Room: "b"}, true)
+	if _, _, ok := c.get("alice"); !ok {
+		t.Fatalf("expected alice to be cached")
+	}
+	c.put("carol", PlayerProfile{}, false)
+	if _, _, ok := c.get("bob"); ok {
+		t.Fatalf("expected bob, the least recently used, to be evicted")
+	}
+	if profile, found, ok := c.get("alice"); !ok || !found || profile.Room != "a" {
+		t.Fatalf("alice = %+v, %t, %t", profile, found, ok)
+	}
+	if _, found, ok := c.get("carol"); !ok || found {
+		t.Fatalf("expected carol to be cached as having no profile")
+	}
+
+	c.add("alice", PlayerProfile{Room: "stale"}, true)
+	if profile, _, _ := c.get("alice"); profile.Room != "a" {
+		t.Fatalf("add replaced a cached profile with %q", profile.Room)
+	}
+}
+
+func TestAccountProfilesAreServedFromMemory(t *testing.T) {
+	manager, err := NewAccountManager(filepath.Join(t.TempDir(), "accounts.json"))
+	if err != nil {
+		t.Fatalf("NewAccountManager: %v", err)
+	}
+	defer manager.Close()
+	if err := manager.Register("scout", "password123"); err != nil {
+		t.Fatalf("Register: %v", err)
+	}
+	profile := PlayerProfile{Room: "hall", Home: StartRoom, Channels: defaultChannelSettings()}
+	if err := manager.SaveProfile("scout", profile); err != nil {
+		t.Fatalf("SaveProfile: %v", err)
+	}
+	if err := manager.Flush(); err != nil {
+		t.Fatalf("Flush: %v", err)
+	}
+
+	path := manager.playerFilePath("scout")
+	if err := os.Remove(path); err != nil {
+		t.Fatalf("remove profile file: %v", err)
+	}
+	if got := manager.Profile("scout").Room; got != "hall" {
+		t.Fatalf("Profile room = %q, want the cached hall", got)
+	}
+
+	// Saving the state already on disk queues nothing to write.
+	if err := manager.SaveProfile("scout", profile); err != nil {
+		t.Fatalf("SaveProfile: %v", err)
+	}
+	if err := manager.Flush(); err != nil {
+		t.Fatalf("Flush: %v", err)
+	}
+	if _, err := os.Stat(path); !os.IsNotExist(err) {
+		t.Fatalf("an unchanged profile was written again")
+	}
+
+	profile.Room = "tower"
+	if err := manager.SaveProfile("scout", profile); err != nil {
+		t.Fatalf("SaveProfile: %v", err)
+	}
+	if err := manager.Flush(); err != nil {
+		t.Fatalf("Flush: %v", err)
+	}
+	if _, err := os.Stat(path); err != nil {
+		t.Fatalf("a changed profile was not written: %v", err)
+	}
+}
+
+func TestRegisterKeepsAnAccountWrittenDespiteAFailedProfile(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "accounts.json")
+	manager, err := NewAccountManager(path)
+	if err != nil {
+		t.Fatalf("NewAccountManager: %v", err)
+	}
+	defer manager.Close()
+	if err := manager.Register("scout", "password123"); err != nil {
+		t.Fatalf("Register: %v", err)
+	}
+	if err := manager.SaveProfile("scout", PlayerProfile{Room: "hall", Home: StartRoom}); err != nil {
+		t.Fatalf("SaveProfile: %v", err)
+	}
+	// A plain file where the players directory belongs fails every profile write.
+	if err := os.WriteFile(manager.playersPath, nil, 0o644); err != nil {
+		t.Fatalf("block players directory: %v", err)
+	}
+
+	if err := manager.Register("ranger", "password123"); err != nil {
+		t.Fatalf("Register failed over an unrelated profile write: %v", err)
+	}
+	if !manager.Exists("ranger") {
+		t.Fatalf("registered account missing from memory")
+	}
+	reloaded, err := NewAccountManager(path)
+	if err != nil {
+		t.Fatalf("reload accounts: %v", err)
+	}
+	defer reloaded.Close()
+	if !reloaded.Exists("ranger") {
+		t.Fatalf("registered account missing from accounts.json")
+	}
+}
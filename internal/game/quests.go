@@ -274,6 +274,9 @@ func (w *World) AvailableQuests(p *Player) []*Quest {
 	if !ok || stored != p || !p.Alive {
 		return nil
 	}
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	room, ok := w.rooms[p.Room]
 	if !ok {
 		return nil
@@ -316,12 +319,15 @@ func (w *World) AcceptQuest(p *Player, questID string) (*Quest, error) {
 	if trimmed == "" {
 		return nil, fmt.Errorf("quest id must not be empty")
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || !p.Alive {
 		return nil, fmt.Errorf("%s is not online", p.Name)
 	}
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	quest, ok := w.quests[trimmed]
 	if !ok {
 		return nil, fmt.Errorf("no such quest")
@@ -362,6 +368,9 @@ func (w *World) AcceptQuest(p *Player, questID string) (*Quest, error) {
 func (w *World) SnapshotQuestLog(p *Player) []QuestProgressSnapshot {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || len(p.QuestLog) == 0 {
 		return nil
@@ -406,8 +415,17 @@ func (w *World) SnapshotQuestLog(p *Player) []QuestProgressSnapshot {
 
 // RecordNPCKill updates quest progress after an NPC is defeated.
 func (w *World) RecordNPCKill(p *Player, npc NPC) []QuestProgressUpdate {
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
+	return w.recordNPCKillLocked(p, npc)
+}
+
+// recordNPCKillLocked advances kill objectives. Callers must hold w.mu for
+// reading and the shard lock of the player's room.
+func (w *World) recordNPCKillLocked(p *Player, npc NPC) []QuestProgressUpdate {
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || len(p.QuestLog) == 0 {
 		return nil
@@ -482,12 +500,15 @@ func (w *World) CompleteQuest(p *Player, questID string) (*QuestCompletionResult
 	if trimmed == "" {
 		return nil, fmt.Errorf("quest id must not be empty")
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || !p.Alive {
 		return nil, fmt.Errorf("%s is not online", p.Name)
 	}
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	quest, ok := w.quests[trimmed]
 	if !ok {
 		return nil, fmt.Errorf("no such quest")
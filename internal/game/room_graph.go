@@ -0,0 +1,269 @@
+package game
+
+import (
+	"sort"
+	"sync"
+)
+
+// roomGraph is a read-only snapshot of how rooms connect. Room IDs are
+// interned to dense indexes and every room's exits and distinct neighbors
+// are laid out in flat arrays, so movement and multi-hop queries need no
+// map lookups or allocations beyond their results. Exit targets that name
+// no room are interned too; they simply have no exits of their own.
+type roomGraph struct {
+	ids   []RoomID
+	index map[RoomID]int32
+
+	// exitStart[i]:exitStart[i+1] spans room i's exits, sorted by
+	// direction, in exitNames and exitTo.
+	exitStart []int32
+	exitNames []string
+	exitTo    []int32
+
+	// neighborStart[i]:neighborStart[i+1] spans room i's distinct
+	// neighbors, in exit order, in neighbors and neighborIDs.
+	neighborStart []int32
+	neighbors     []int32
+	neighborIDs   []RoomID
+
+	searches sync.Pool
+}
+
+// graphSearch is the scratch space for one breadth-first search. seen[i]
+// equals mark when room i has been reached by the current search.
+type graphSearch struct {
+	mark   uint32
+	seen   []uint32
+	parent []int32
+	via    []int32
+	queue  []int32
+}
+
+func buildRoomGraph(rooms map[RoomID]*Room) *roomGraph {
+	g := &roomGraph{
+		ids:   make([]RoomID, 0, len(rooms)),
+		index: make(map[RoomID]int32, len(rooms)),
+	}
+	for id := range rooms {
+		g.ids = append(g.ids, id)
+	}
+	sort.Slice(g.ids, func(i, j int) bool { return g.ids[i] < g.ids[j] })
+	for i, id := range g.ids {
+		g.index[id] = int32(i)
+	}
+	exits := 0
+	for _, room := range rooms {
+		if room != nil {
+			exits += len(room.Exits)
+		}
+	}
+	roomCount := len(g.ids)
+	g.exitStart = make([]int32, 1, roomCount+1)
+	g.exitNames = make([]string, 0, exits)
+	g.exitTo = make([]int32, 0, exits)
+	g.neighborStart = make([]int32, 1, roomCount+1)
+	g.neighbors = make([]int32, 0, exits)
+	for i := 0; i < roomCount; i++ {
+		start := len(g.exitNames)
+		if room := rooms[g.ids[i]]; room != nil {
+			for dir := range room.Exits {
+				g.exitNames = append(g.exitNames, dir)
+			}
+			names := g.exitNames[start:]
+			sort.Strings(names)
+			for _, dir := range names {
+				g.exitTo = append(g.exitTo, g.intern(room.Exits[dir]))
+			}
+		}
+		g.exitStart = append(g.exitStart, int32(len(g.exitNames)))
+		first := len(g.neighbors)
+		for _, to := range g.exitTo[start:] {
+			seen := false
+			for _, n := range g.neighbors[first:] {
+				if n == to {
+					seen = true
+					break
+				}
+			}
+			if !seen {
+				g.neighbors = append(g.neighbors, to)
+			}
+		}
+		g.neighborStart = append(g.neighborStart, int32(len(g.neighbors)))
+	}
+	// Interned exit targets that are not rooms have no exits.
+	for len(g.exitStart) <= len(g.ids) {
+		g.exitStart = append(g.exitStart, int32(len(g.exitNames)))
+		g.neighborStart = append(g.neighborStart, int32(len(g.neighbors)))
+	}
+	g.neighborIDs = make([]RoomID, len(g.neighbors))
+	for i, n := range g.neighbors {
+		g.neighborIDs[i] = g.ids[n]
+	}
+	return g
+}
+
+func (g *roomGraph) intern(id RoomID) int32 {
+	if i, ok := g.index[id]; ok {
+		return i
+	}
+	i := int32(len(g.ids))
+	g.ids = append(g.ids, id)
+	g.index[id] = i
+	return i
+}
+
+func (g *roomGraph) exits(i int32) (names []string, to []int32) {
+	start, end := g.exitStart[i], g.exitStart[i+1]
+	return g.exitNames[start:end], g.exitTo[start:end]
+}
+
+func (g *roomGraph) neighborsOf(i int32) []int32 {
+	return g.neighbors[g.neighborStart[i]:g.neighborStart[i+1]]
+}
+
+func (g *roomGraph) search() *graphSearch {
+	s, _ := g.searches.Get().(*graphSearch)
+	if s == nil {
+		s = &graphSearch{
+			seen:   make([]uint32, len(g.ids)),
+			parent: make([]int32, len(g.ids)),
+			via:    make([]int32, len(g.ids)),
+		}
+	}
+	if s.mark++; s.mark == 0 {
+		clear(s.seen)
+		s.mark = 1
+	}
+	s.queue = s.queue[:0]
+	return s
+}
+
+// within returns the rooms reachable from start in one to radius moves,
+// nearest first.
+func (g *roomGraph) within(start int32, radius int) []RoomID {
+	s := g.search()
+	defer g.searches.Put(s)
+	s.seen[start] = s.mark
+	s.queue = append(s.queue, start)
+	var found []RoomID
+	for depth, head := 0, 0; depth < radius && head < len(s.queue); depth++ {
+		end := len(s.queue)
+		for ; head < end; head++ {
+			for _, n := range g.neighborsOf(s.queue[head]) {
+				if s.seen[n] == s.mark {
+					continue
+				}
+				s.seen[n] = s.mark
+				s.queue = append(s.queue, n)
+				found = append(found, g.ids[n])
+			}
+		}
+	}
+	return found
+}
+
+// path returns the directions of a shortest route from start to goal.
+func (g *roomGraph) path(start, goal int32) ([]string, bool) {
+	if start == goal {
+		return []string{}, true
+	}
+	s := g.search()
+	defer g.searches.Put(s)
+	s.seen[start] = s.mark
+	s.queue = append(s.queue, start)
+	for head := 0; head < len(s.queue); head++ {
+		from := s.queue[head]
+		offset := g.exitStart[from]
+		_, to := g.exits(from)
+		for k, n := range to {
+			if s.seen[n] == s.mark {
+				continue
+			}
+			s.seen[n] = s.mark
+			s.parent[n] = from
+			s.via[n] = offset + int32(k)
+			if n != goal {
+				s.queue = append(s.queue, n)
+				continue
+			}
+			steps := 0
+			for at := goal; at != start; at = s.parent[at] {
+				steps++
+			}
+			route := make([]string, steps)
+			for at := goal; at != start; at = s.parent[at] {
+				steps--
+				route[steps] = g.exitNames[s.via[at]]
+			}
+			return route, true
+		}
+	}
+	return nil, false
+}
+
+// roomGraphLocked returns the current room graph, building it if builders
+// or an area reload changed the rooms since it was last used. Callers must
+// hold w.mu; readers may race to build it, and any of their copies will do.
+func (w *World) roomGraphLocked() *roomGraph {
+	if g := w.graph.Load(); g != nil {
+		return g
+	}
+	g := buildRoomGraph(w.rooms)
+	w.graph.CompareAndSwap(nil, g)
+	return g
+}
+
+// invalidateRoomGraphLocked drops the room graph after rooms or exits
+// change. Callers must hold w.mu for writing.
+func (w *World) invalidateRoomGraphLocked() {
+	w.graph.Store(nil)
+}
+
+// AdjacentRooms returns the distinct rooms the exits of room lead to. The
+// slice is shared and must not be modified.
+func (w *World) AdjacentRooms(room RoomID) []RoomID {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	if _, ok := w.rooms[room]; !ok {
+		return nil
+	}
+	g := w.roomGraphLocked()
+	i := g.index[room]
+	ids := g.neighborIDs[g.neighborStart[i]:g.neighborStart[i+1]]
+	if len(ids) == 0 {
+		return nil
+	}
+	return ids[:len(ids):len(ids)]
+}
+
+// RoomsWithin returns the rooms reachable from room in one to radius moves,
+// nearest first. room itself is not included.
+func (w *World) RoomsWithin(room RoomID, radius int) []RoomID {
+	if radius <= 0 {
+		return nil
+	}
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	if _, ok := w.rooms[room]; !ok {
+		return nil
+	}
+	g := w.roomGraphLocked()
+	return g.within(g.index[room], radius)
+}
+
+// RoomPath returns the directions of a shortest walk from one room to
+// another, or false if there is none. The path from a room to itself is
+// empty.
+func (w *World) RoomPath(from, to RoomID) ([]string, bool) {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	if _, ok := w.rooms[from]; !ok {
+		return nil, false
+	}
+	if _, ok := w.rooms[to]; !ok {
+		return nil, false
+	}
+	g := w.roomGraphLocked()
+	return g.path(g.index[from], g.index[to])
+}
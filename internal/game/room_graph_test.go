@@ -0,0 +1,101 @@
+package game
+
+import (
+	"reflect"
+	"testing"
+)
+
+// graphTestWorld is a line of rooms a-b-c-d with a loop from a back to
+// itself and an exit from d to a room that does not exist.
+func graphTestWorld() *World {
+	return NewWorldWithRooms(map[RoomID]*Room{
+		"a": {ID: "a", Exits: map[string]RoomID{"east": "b", "e": "b", "loop": "a"}},
+		"b": {ID: "b", Exits: map[string]RoomID{"west": "a", "east": "c"}},
+		"c": {ID: "c", Exits: map[string]RoomID{"west": "b", "east": "d"}},
+		"d": {ID: "d", Exits: map[string]RoomID{"west": "c", "void": "nowhere"}},
+	})
+}
+
+func TestAdjacentRoomsDedupesExits(t *testing.T) {
+	world := graphTestWorld()
+	if got, want := world.AdjacentRooms("a"), []RoomID{"b", "a"}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("AdjacentRooms(a) = %v, want %v", got, want)
+	}
+	if got, want := world.AdjacentRooms("d"), []RoomID{"nowhere", "c"}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("AdjacentRooms(d) = %v, want %v", got, want)
+	}
+	if got := world.AdjacentRooms("nowhere"); got != nil {
+		t.Fatalf("AdjacentRooms(nowhere) = %v, want nil", got)
+	}
+}
+
+func TestRoomsWithinRadius(t *testing.T) {
+	world := graphTestWorld()
+	if got, want := world.RoomsWithin("a", 2), []RoomID{"b", "c"}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("RoomsWithin(a, 2) = %v, want %v", got, want)
+	}
+	if got, want := world.RoomsWithin("b", 1), []RoomID{"c", "a"}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("RoomsWithin(b, 1) = %v, want %v", got, want)
+	}
+	if got := world.RoomsWithin("a", 0); got != nil {
+		t.Fatalf("RoomsWithin(a, 0) = %v, want nil", got)
+	}
+}
+
+func TestRoomPathFindsShortestRoute(t *testing.T) {
+	world := graphTestWorld()
+	path, ok := world.RoomPath("a", "d")
+	if !ok || !reflect.DeepEqual(path, []string{"e", "east", "east"}) {
+		t.Fatalf("RoomPath(a, d) = %v, %v", path, ok)
+	}
+	if path, ok := world.RoomPath("c", "c"); !ok || len(path) != 0 {
+		t.Fatalf("RoomPath(c, c) = %v, %v; want an empty path", path, ok)
+	}
+	if _, ok := world.RoomPath("a", "nowhere"); ok {
+		t.Fatalf("RoomPath to a missing room succeeded")
+	}
+}
+
+func TestRoomGraphFollowsExitEdits(t *testing.T) {
+	world := graphTestWorld()
+	if _, ok := world.RoomPath("d", "a"); !ok {
+		t.Fatalf("RoomPath(d, a) failed before the edit")
+	}
+	if err := world.SetExit("d", "up", "a"); err != nil {
+		t.Fatalf("SetExit: %v", err)
+	}
+	if path, ok := world.RoomPath("d", "a"); !ok || !reflect.DeepEqual(path, []string{"up"}) {
+		t.Fatalf("RoomPath(d, a) after the edit = %v, %v", path, ok)
+	}
+	if dir, dest, ok := world.ResolveExit("d", "u"); !ok || dir != "up" || dest != "a" {
+		t.Fatalf("ResolveExit(d, u) = %q, %q, %v", dir, dest, ok)
+	}
+	if err := world.ClearExit("a", "loop"); err != nil {
+		t.Fatalf("ClearExit: %v", err)
+	}
+	if got, want := world.AdjacentRooms("a"), []RoomID{"b"}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("AdjacentRooms(a) after ClearExit = %v, want %v", got, want)
+	}
+}
+
+func BenchmarkRoomsWithin(b *testing.B) {
+	rooms := make(map[RoomID]*Room, 1024)
+	for i := 0; i < 1024; i++ {
+		id := RoomID(string(rune('a'+i%26)) + string(rune('a'+i/26%26)) + string(rune('a'+i/676)))
+		rooms[id] = &Room{ID: id, Exits: map[string]RoomID{}}
+	}
+	ids := make([]RoomID, 0, len(rooms))
+	for id := range rooms {
+		ids = append(ids, id)
+	}
+	for i, id := range ids {
+		rooms[id].Exits["next"] = ids[(i+1)%len(ids)]
+		rooms[id].Exits["skip"] = ids[(i+7)%len(ids)]
+	}
+	world := NewWorldWithRooms(rooms)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		world.RoomsWithin(ids[i%len(ids)], 3)
+	}
+}
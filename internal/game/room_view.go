@@ -0,0 +1,79 @@
+package game
+
+// roomViewWidths is how many terminal widths each room keeps a rendered view
+// for; most players share one of a few common widths.
+const roomViewWidths = 4
+
+// RoomView is the part of a room's description that only changes when a
+// builder edits the room: its title, wrapped description and exits. Players,
+// NPCs and items are filled in by the caller on every request.
+type RoomView struct {
+	// Look is the view as sent by look. Enter is the same view with the
+	// extra blank line used on arrival.
+	Look  string
+	Enter string
+}
+
+type roomViewEntry struct {
+	room  *Room
+	width int
+	view  RoomView
+}
+
+// RoomView returns the rendered view of room id wrapped to width, building
+// it on first use. Views hold plain UTF-8; the session applies the client's
+// charset when it writes them, so one view serves every charset.
+func (w *World) RoomView(id RoomID, width int) (RoomView, bool) {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	room, ok := w.rooms[id]
+	if !ok || room == nil {
+		return RoomView{}, false
+	}
+
+	w.roomViewMu.Lock()
+	for _, entry := range w.roomViews[id] {
+		if entry.room == room && entry.width == width {
+			w.roomViewMu.Unlock()
+			return entry.view, true
+		}
+	}
+	w.roomViewMu.Unlock()
+
+	// Builder edits take w.mu for writing, so the room cannot change while
+	// the view is rendered and stored.
+	view := renderRoomView(room, width)
+	w.roomViewMu.Lock()
+	if w.roomViews == nil {
+		w.roomViews = make(map[RoomID][]roomViewEntry)
+	}
+	entries := w.roomViews[id]
+	if len(entries) > 0 && entries[0].room != room {
+		// The room was replaced by an area reload.
+		entries = entries[:0]
+	}
+	if len(entries) >= roomViewWidths {
+		entries = append(entries[:0], entries[1:]...)
+	}
+	w.roomViews[id] = append(entries, roomViewEntry{room: room, width: width, view: view})
+	w.roomViewMu.Unlock()
+	return view, true
+}
+
+func renderRoomView(r *Room, width int) RoomView {
+	header := Style(r.Title, AnsiBold, AnsiCyan) + "\r\n" +
+		Style(WrapText(r.Description, width), AnsiItalic, AnsiDim) + "\r\n" +
+		"Exits: " + Style(ExitList(r), AnsiGreen)
+	return RoomView{
+		Look:  Ansi("\r\n" + header),
+		Enter: Ansi("\r\n\r\n" + header),
+	}
+}
+
+// invalidateRoomViewLocked drops the rendered views of room id. Callers must
+// hold w.mu for writing.
+func (w *World) invalidateRoomViewLocked(id RoomID) {
+	w.roomViewMu.Lock()
+	delete(w.roomViews, id)
+	w.roomViewMu.Unlock()
+}
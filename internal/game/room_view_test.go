@@ -0,0 +1,111 @@
+package game
+
+import (
+	"strings"
+	"testing"
+	"unsafe"
+)
+
+func newRoomViewWorld() *World {
+	return NewWorldWithRooms(map[RoomID]*Room{
+		StartRoom: {ID: StartRoom, Title: "Atrium", Description: "Light pools like molten glass along the floor mosaics.", Exits: map[string]RoomID{"north": "hall"}},
+		"hall":    {ID: "hall", Title: "Hall", Description: "A long hall.", Exits: map[string]RoomID{"south": StartRoom}},
+	})
+}
+
+func sameString(a, b string) bool {
+	return len(a) == len(b) && unsafe.StringData(a) == unsafe.StringData(b)
+}
+
+func TestRoomViewIsCachedPerWidth(t *testing.T) {
+	world := newRoomViewWorld()
+	first, ok := world.RoomView(StartRoom, 80)
+	if !ok {
+		t.Fatalf("expected a view for the start room")
+	}
+	room, _ := world.GetRoom(StartRoom)
+	if want := renderRoomView(room, 80); first != want {
+		t.Fatalf("view = %q, want %q", first.Look, want.Look)
+	}
+	if !strings.HasPrefix(first.Enter, "\r\n\r\n") || !strings.HasSuffix(first.Enter, first.Look) {
+		t.Fatalf("enter view %q does not extend look view", first.Enter)
+	}
+	again, _ := world.RoomView(StartRoom, 80)
+	if !sameString(again.Look, first.Look) {
+		t.Fatalf("expected the cached view to be reused")
+	}
+	narrow, _ := world.RoomView(StartRoom, 20)
+	if narrow.Look == first.Look {
+		t.Fatalf("expected a different view at a narrower width")
+	}
+	for width := 30; width < 30+2*roomViewWidths; width++ {
+		world.RoomView(StartRoom, width)
+	}
+	if n := len(world.roomViews[StartRoom]); n > roomViewWidths {
+		t.Fatalf("room keeps %d views, want at most %d", n, roomViewWidths)
+	}
+	if _, ok := world.RoomView("missing", 80); ok {
+		t.Fatalf("expected no view for an unknown room")
+	}
+}
+
+func TestRoomViewInvalidatedByBuilderEdits(t *testing.T) {
+	world := newRoomViewWorld()
+	world.RoomView(StartRoom, 80)
+
+	if _, err := world.UpdateRoomDescription(StartRoom, "Freshly swept.", "Builder"); err != nil {
+		t.Fatalf("UpdateRoomDescription: %v", err)
+	}
+	view, _ := world.RoomView(StartRoom, 80)
+	if !strings.Contains(view.Look, "Freshly swept.") {
+		t.Fatalf("view not refreshed after a description edit: %q", view.Look)
+	}
+
+	if err := world.SetExit(StartRoom, "east", "hall"); err != nil {
+		t.Fatalf("SetExit: %v", err)
+	}
+	view, _ = world.RoomView(StartRoom, 80)
+	if !strings.Contains(view.Look, "east north") {
+		t.Fatalf("view not refreshed after an exit edit: %q", view.Look)
+	}
+
+	if _, err := world.UpdateRoomTitle(StartRoom, "Swept Atrium", "Builder"); err != nil {
+		t.Fatalf("UpdateRoomTitle: %v", err)
+	}
+	view, _ = world.RoomView(StartRoom, 80)
+	if !strings.Contains(view.Look, "Swept Atrium") {
+		t.Fatalf("view not refreshed after a title edit: %q", view.Look)
+	}
+}
+
+func TestRoomViewDropsReplacedRooms(t *testing.T) {
+	world := newRoomViewWorld()
+	world.RoomView("hall", 80)
+	world.mu.Lock()
+	world.rooms["hall"] = &Room{ID: "hall", Title: "Rebuilt Hall", Exits: map[string]RoomID{}}
+	world.mu.Unlock()
+	view, _ := world.RoomView("hall", 80)
+	if !strings.Contains(view.Look, "Rebuilt Hall") {
+		t.Fatalf("expected a view of the replacement room, got %q", view.Look)
+	}
+	if n := len(world.roomViews["hall"]); n != 1 {
+		t.Fatalf("expected the stale view to be dropped, have %d", n)
+	}
+}
+
+func BenchmarkRoomView(b *testing.B) {
+	world := newRoomViewWorld()
+	room, _ := world.GetRoom(StartRoom)
+	b.Run("cached", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			world.RoomView(StartRoom, 80)
+		}
+	})
+	b.Run("render", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			renderRoomView(room, 80)
+		}
+	})
+}
@@ -11,43 +11,40 @@ import (
 func EnterRoom(world *World, p *Player, via string) {
 	r, ok := world.GetRoom(p.Room)
 	if !ok {
-		p.Output <- Ansi(Style("\r\nYou seem to be nowhere.", AnsiYellow))
+		p.Send(Ansi(Style("\r\nYou seem to be nowhere.", AnsiYellow)))
 		return
 	}
 	width, _ := p.WindowSize()
 	if via != "" {
 		world.BroadcastToRoom(p.Room, Ansi(fmt.Sprintf("\r\n%s arrives from %s.", HighlightName(p.Name), via)), p)
 	}
-	title := Style(r.Title, AnsiBold, AnsiCyan)
-	desc := Style(WrapText(r.Description, width), AnsiItalic, AnsiDim)
-	exits := Style(ExitList(r), AnsiGreen)
-	p.Output <- Ansi(fmt.Sprintf("\r\n\r\n%s\r\n%s\r\nExits: %s", title, desc, exits))
+	if view, ok := world.RoomView(p.Room, width); ok {
+		p.Send(view.Enter)
+	}
 	others := world.ListPlayers(true, p.Room)
 	if len(others) > 1 {
 		seen := FilterOut(others, p.Name)
 		colored := HighlightNames(seen)
-		p.Output <- Ansi(fmt.Sprintf("\r\nYou see: %s", strings.Join(colored, ", ")))
+		p.Send(Ansi(fmt.Sprintf("\r\nYou see: %s", strings.Join(colored, ", "))))
 	}
 	if items := world.RoomItems(p.Room); len(items) > 0 {
 		names := make([]string, len(items))
 		for i, item := range items {
 			names[i] = HighlightItemName(item.Name)
 		}
-		p.Output <- Ansi(fmt.Sprintf("\r\nOn the ground: %s", strings.Join(names, ", ")))
+		p.Send(Ansi(fmt.Sprintf("\r\nOn the ground: %s", strings.Join(names, ", "))))
 	}
-	if len(r.NPCs) > 0 {
-		for _, npc := range r.NPCs {
-			if strings.TrimSpace(npc.AutoGreet) == "" {
-				continue
-			}
-			msg := fmt.Sprintf("\r\n%s says, \"%s\"", HighlightNPCName(npc.Name), npc.AutoGreet)
-			p.Output <- Ansi(msg)
+	for _, npc := range world.RoomNPCs(p.Room) {
+		if strings.TrimSpace(npc.AutoGreet) == "" {
+			continue
 		}
+		msg := fmt.Sprintf("\r\n%s says, \"%s\"", HighlightNPCName(npc.Name), npc.AutoGreet)
+		p.Send(Ansi(msg))
 	}
 	world.triggerAreaEnter(r, p, via)
 	world.triggerRoomEnter(r, p, via)
 	world.triggerNPCEnter(p.Room, p.Name)
-	p.Output <- Prompt(p)
+	p.Send(Prompt(p))
 }
 
 // ExitList renders the exits for a room in a deterministic order.
@@ -65,19 +65,20 @@ func TestEnterRoomTriggersNPCGreeting(t *testing.T) {
 		players: make(map[string]*Player),
 	}
 	player := &Player{
-		Name:   "Hero",
-		Room:   "start",
-		Output: make(chan string, 4),
-		Alive:  true,
+		Name:  "Hero",
+		Room:  "start",
+		Alive: true,
 	}
 	world.players[player.Name] = player
+	world.indexPlayerNameLocked(player)
+	player.AttachOutputForTest()
 
 	EnterRoom(world, player, "")
 
 	// First output is the room description.
-	<-player.Output
+	nextOutput(t, player)
 	// Second output should contain the NPC greeting.
-	greet := <-player.Output
+	greet := nextOutput(t, player)
 	if !strings.Contains(greet, "Guide") {
 		t.Fatalf("NPC greeting missing name: %q", greet)
 	}
@@ -103,17 +104,18 @@ func TestEnterRoomListsItems(t *testing.T) {
 		players: make(map[string]*Player),
 	}
 	player := &Player{
-		Name:   "Hero",
-		Room:   "start",
-		Output: make(chan string, 4),
-		Alive:  true,
+		Name:  "Hero",
+		Room:  "start",
+		Alive: true,
 	}
 	world.players[player.Name] = player
+	world.indexPlayerNameLocked(player)
+	player.AttachOutputForTest()
 
 	EnterRoom(world, player, "")
 
-	<-player.Output // room description
-	items := <-player.Output
+	nextOutput(t, player) // room description
+	items := nextOutput(t, player)
 	if !strings.Contains(items, "Lantern") || !strings.Contains(items, "Rope") {
 		t.Fatalf("expected item list to mention Lantern and Rope, got %q", items)
 	}
@@ -3,6 +3,7 @@ package game
 import (
 	"strings"
 	"unicode"
+	"unicode/utf8"
 )
 
 func sanitizeInput(s string) string {
@@ -33,6 +34,26 @@ func sanitizeInput(s string) string {
 	return builder.String()
 }
 
+// trimPlainInput handles the common case of a line made only of printable
+// ASCII with single spaces between words, which Trim would return with just
+// its outer spaces removed. It reports false for anything else.
+func trimPlainInput(s string) (string, bool) {
+	start, end := 0, len(s)
+	for start < end && s[start] == ' ' {
+		start++
+	}
+	for end > start && s[end-1] == ' ' {
+		end--
+	}
+	for i := start; i < end; i++ {
+		b := s[i]
+		if b < 0x20 || b > 0x7e || (b == ' ' && s[i+1] == ' ') {
+			return "", false
+		}
+	}
+	return s[start:end], true
+}
+
 func sanitizeRune(r rune) (rune, bool) {
 	switch {
 	case r == '\r':
@@ -56,3 +77,53 @@ func sanitizeRune(r rune) (rune, bool) {
 		return r, true
 	}
 }
+
+// stripTerminalControls removes escape sequences and control characters
+// from text that did not come from this server, keeping only line breaks.
+func stripTerminalControls(s string) string {
+	var builder strings.Builder
+	builder.Grow(len(s))
+	for i := 0; i < len(s); {
+		r, size := utf8.DecodeRuneInString(s[i:])
+		if r != 0x1b {
+			if r == '\r' || r == '\n' || (r >= 0x20 && r != 0x7f && !unicode.IsControl(r) && !unicode.Is(unicode.Cf, r)) {
+				builder.WriteRune(r)
+			}
+			i += size
+			continue
+		}
+		i = skipEscapeSequence(s, i+1)
+	}
+	return builder.String()
+}
+
+// skipEscapeSequence returns the index just past the escape sequence whose
+// introducer follows the ESC at s[i-1].
+func skipEscapeSequence(s string, i int) int {
+	if i >= len(s) {
+		return i
+	}
+	switch s[i] {
+	case '[':
+		// CSI: parameters and intermediates, then one final byte.
+		for i++; i < len(s); i++ {
+			if s[i] >= 0x40 && s[i] <= 0x7e {
+				return i + 1
+			}
+		}
+		return i
+	case ']', 'P', '_', '^', 'X':
+		// OSC and other strings run to BEL or ESC \.
+		for i++; i < len(s); i++ {
+			if s[i] == 0x07 {
+				return i + 1
+			}
+			if s[i] == 0x1b && i+1 < len(s) && s[i+1] == '\\' {
+				return i + 2
+			}
+		}
+		return i
+	default:
+		return i + 1
+	}
+}
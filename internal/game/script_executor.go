@@ -0,0 +1,490 @@
+package game
+
+import (
+	"fmt"
+	"runtime"
+	"sort"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+const (
+	defaultScriptBudget       = 250 * time.Millisecond
+	defaultScriptQueueDepth   = 64
+	defaultScriptDisableAfter = 3
+	// scriptTimeoutLogInterval limits how often hook timeouts are logged;
+	// the ones in between are counted in the next message.
+	scriptTimeoutLogInterval = time.Minute
+)
+
+// ScriptConfig bounds how world scripts are executed.
+type ScriptConfig struct {
+	// Workers is the number of goroutines running script hooks.
+	Workers int
+	// Budget is the wall-clock time a single hook may run before it is
+	// abandoned and its worker replaced. Go code cannot be stopped from the
+	// outside, so the hook keeps running; its room stays blocked until it
+	// returns or an admin releases the room.
+	Budget time.Duration
+	// QueueDepth caps the hooks waiting per room; further events are dropped.
+	QueueDepth int
+	// DisableAfter turns a script off once it has timed out this many times.
+	DisableAfter int
+}
+
+// DefaultScriptConfig returns the script limits used when none are supplied.
+func DefaultScriptConfig() ScriptConfig {
+	return ScriptConfig{
+		Workers:      runtime.GOMAXPROCS(0),
+		Budget:       defaultScriptBudget,
+		QueueDepth:   defaultScriptQueueDepth,
+		DisableAfter: defaultScriptDisableAfter,
+	}
+}
+
+func (c ScriptConfig) normalized() ScriptConfig {
+	defaults := DefaultScriptConfig()
+	if c.Workers <= 0 {
+		c.Workers = defaults.Workers
+	}
+	if c.Budget <= 0 {
+		c.Budget = defaults.Budget
+	}
+	if c.QueueDepth <= 0 {
+		c.QueueDepth = defaults.QueueDepth
+	}
+	if c.DisableAfter < 0 {
+		c.DisableAfter = 0
+	}
+	return c
+}
+
+// ScriptStats summarises one script's hook executions.
+type ScriptStats struct {
+	Name        string
+	Calls       uint64
+	Timeouts    uint64
+	Failures    uint64
+	Dropped     uint64
+	MeanLatency time.Duration
+	MaxLatency  time.Duration
+	Disabled    bool
+}
+
+type scriptCounters struct {
+	calls        uint64
+	timeouts     uint64
+	failures     uint64
+	dropped      uint64
+	totalLatency time.Duration
+	maxLatency   time.Duration
+	disabled     bool
+}
+
+// scriptGuard is embedded in every script context. Once a hook overruns its
+// budget the guard is stopped, and the context drops anything the abandoned
+// script still tries to say.
+type scriptGuard struct {
+	stopped atomic.Bool
+}
+
+func (g *scriptGuard) active() bool {
+	return g == nil || !g.stopped.Load()
+}
+
+// scriptTask is a queued hook. Script contexts implement it directly so
+// queueing a hook does not allocate a closure.
+type scriptTask interface {
+	// runHook returns false when the script panicked or failed to load.
+	runHook() bool
+	// release recycles the task once its hook has finished. It is not called
+	// for hooks that overran their budget.
+	release()
+}
+
+// scriptFunc adapts a plain function to scriptTask.
+type scriptFunc func() bool
+
+func (f scriptFunc) runHook() bool { return f() }
+func (f scriptFunc) release()      {}
+
+// scriptKey identifies a script in the executor's counters, such as the NPC
+// kind and its name.
+type scriptKey struct {
+	kind string
+	name string
+}
+
+func (k scriptKey) String() string {
+	return k.kind + ":" + k.name
+}
+
+type scriptJob struct {
+	room  RoomID
+	kind  string
+	name  string
+	hook  string
+	guard *scriptGuard
+	task  scriptTask
+}
+
+func (j scriptJob) key() scriptKey {
+	return scriptKey{kind: j.kind, name: j.name}
+}
+
+type scriptRoomQueue struct {
+	room RoomID
+	jobs []scriptJob
+	// stuck is the run state of an abandoned head job, or nil.
+	stuck *atomic.Int32
+}
+
+// scriptExecutor runs script hooks on a bounded worker pool. Hooks are queued
+// per room and a room has at most one hook running at a time, so events in a
+// room are handled in order while callers never wait for them.
+//
+// A hook that overruns its budget is abandoned: its worker leaves the pool
+// and is replaced, but only while fewer than Workers hooks are abandoned, so
+// runaway scripts can at most double the executor's goroutines. Once the
+// abandoned hook returns its goroutine rejoins the pool if there is room. A
+// room stuck behind a hook that never returns can be released by hand.
+type scriptExecutor struct {
+	mu      sync.Mutex
+	cfg     ScriptConfig
+	work    *sync.Cond
+	idle    *sync.Cond
+	ready   []*scriptRoomQueue
+	rooms   map[RoomID]*scriptRoomQueue
+	pending int
+	started bool
+	stats   map[scriptKey]*scriptCounters
+	// workers counts the goroutines serving the queue; abandoned counts
+	// hooks still running past their budget.
+	workers        int
+	abandoned      int
+	abandonedTotal uint64
+	// lastTimeoutLog and quietTimeouts rate-limit timeout messages.
+	lastTimeoutLog time.Time
+	quietTimeouts  int
+}
+
+func newScriptExecutor(cfg ScriptConfig) *scriptExecutor {
+	e := &scriptExecutor{
+		cfg:   cfg.normalized(),
+		rooms: make(map[RoomID]*scriptRoomQueue),
+		stats: make(map[scriptKey]*scriptCounters),
+	}
+	e.work = sync.NewCond(&e.mu)
+	e.idle = sync.NewCond(&e.mu)
+	return e
+}
+
+// configure applies cfg. Extra workers are started at once; when the pool
+// shrinks, idle workers exit and busy ones exit after their current hook.
+func (e *scriptExecutor) configure(cfg ScriptConfig) {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	e.cfg = cfg.normalized()
+	if e.started {
+		e.spawnLocked()
+		e.work.Broadcast()
+	}
+}
+
+// spawnLocked starts workers until the pool is at its configured size.
+func (e *scriptExecutor) spawnLocked() {
+	for e.workers < e.cfg.Workers {
+		e.workers++
+		go e.worker()
+	}
+}
+
+// submit queues a hook behind any others for the same room. It reports false
+// when the script is disabled or the room's queue is full.
+func (e *scriptExecutor) submit(job scriptJob) bool {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	counters := e.countersLocked(job.key())
+	if counters.disabled {
+		return false
+	}
+	q, ok := e.rooms[job.room]
+	if ok && len(q.jobs) >= e.cfg.QueueDepth {
+		counters.dropped++
+		return false
+	}
+	if !e.started {
+		e.started = true
+		e.spawnLocked()
+	}
+	e.pending++
+	if !ok {
+		q = &scriptRoomQueue{room: job.room}
+		e.rooms[job.room] = q
+		e.ready = append(e.ready, q)
+		e.work.Signal()
+	}
+	q.jobs = append(q.jobs, job)
+	return true
+}
+
+func (e *scriptExecutor) countersLocked(key scriptKey) *scriptCounters {
+	counters, ok := e.stats[key]
+	if !ok {
+		counters = &scriptCounters{}
+		e.stats[key] = counters
+	}
+	return counters
+}
+
+func (e *scriptExecutor) worker() {
+	for {
+		e.mu.Lock()
+		for len(e.ready) == 0 && e.workers <= e.cfg.Workers {
+			e.work.Wait()
+		}
+		if e.workers > e.cfg.Workers {
+			e.workers--
+			e.mu.Unlock()
+			return
+		}
+		q := e.ready[0]
+		e.ready[0] = nil
+		e.ready = e.ready[1:]
+		job := q.jobs[0]
+		budget := e.cfg.Budget
+		e.mu.Unlock()
+
+		if !e.runJob(q, job, budget) {
+			// The hook overran its budget and the pool was full again by
+			// the time it returned.
+			return
+		}
+	}
+}
+
+const (
+	scriptJobRunning int32 = iota
+	scriptJobFinished
+	scriptJobTimedOut
+)
+
+// runJob runs the room's head hook. It reports whether the calling
+// goroutine should keep serving the queue.
+func (e *scriptExecutor) runJob(q *scriptRoomQueue, job scriptJob, budget time.Duration) bool {
+	var state atomic.Int32
+	start := time.Now()
+	timer := time.AfterFunc(budget, func() {
+		if !state.CompareAndSwap(scriptJobRunning, scriptJobTimedOut) {
+			return
+		}
+		if job.guard != nil {
+			job.guard.stopped.Store(true)
+		}
+		e.timedOut(q, &state, job, budget)
+	})
+	ok := job.task.runHook()
+	timer.Stop()
+	if !state.CompareAndSwap(scriptJobRunning, scriptJobFinished) {
+		return e.abandonedReturned(q, &state)
+	}
+	elapsed := time.Since(start)
+	serverMetrics.scripts.with(job.kind + "." + job.hook).observe(elapsed)
+
+	e.mu.Lock()
+	counters := e.countersLocked(job.key())
+	counters.calls++
+	counters.totalLatency += elapsed
+	if elapsed > counters.maxLatency {
+		counters.maxLatency = elapsed
+	}
+	if !ok {
+		counters.failures++
+	}
+	e.finishLocked(q)
+	e.mu.Unlock()
+	job.task.release()
+	return true
+}
+
+// timedOut abandons a hook that overran its budget. Its worker leaves the
+// pool and is replaced while the number of abandoned hooks is within the
+// cap; the room stays blocked until the hook returns or is released.
+func (e *scriptExecutor) timedOut(q *scriptRoomQueue, state *atomic.Int32, job scriptJob, budget time.Duration) {
+	serverMetrics.scripts.with(job.kind + "." + job.hook).observe(budget)
+	e.mu.Lock()
+	counters := e.countersLocked(job.key())
+	counters.calls++
+	counters.timeouts++
+	counters.totalLatency += budget
+	if budget > counters.maxLatency {
+		counters.maxLatency = budget
+	}
+	timeouts := counters.timeouts
+	disable := e.cfg.DisableAfter > 0 && timeouts >= uint64(e.cfg.DisableAfter) && !counters.disabled
+	if disable {
+		counters.disabled = true
+	}
+	q.stuck = state
+	e.workers--
+	e.abandoned++
+	e.abandonedTotal++
+	if e.abandoned <= e.cfg.Workers {
+		e.spawnLocked()
+	}
+	now := time.Now()
+	logTimeout := now.Sub(e.lastTimeoutLog) >= scriptTimeoutLogInterval
+	quiet := e.quietTimeouts
+	if logTimeout {
+		e.lastTimeoutLog = now
+		e.quietTimeouts = 0
+	} else {
+		e.quietTimeouts++
+	}
+	e.mu.Unlock()
+	if logTimeout {
+		if quiet > 0 {
+			fmt.Printf("script %s %s exceeded its %s budget and was abandoned (%d more timeouts since the last report)\n", job.key(), job.hook, budget, quiet)
+		} else {
+			fmt.Printf("script %s %s exceeded its %s budget and was abandoned\n", job.key(), job.hook, budget)
+		}
+	}
+	if disable {
+		fmt.Printf("script %s disabled after %d timeouts\n", job.key(), timeouts)
+	}
+}
+
+// abandonedReturned unblocks the room of an abandoned hook that has finally
+// returned, unless it was already released, and reports whether its
+// goroutine may rejoin the pool.
+func (e *scriptExecutor) abandonedReturned(q *scriptRoomQueue, state *atomic.Int32) bool {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	e.abandoned--
+	if q.stuck == state {
+		q.stuck = nil
+		e.finishLocked(q)
+	}
+	if e.workers < e.cfg.Workers {
+		e.workers++
+		return true
+	}
+	return false
+}
+
+// finishLocked releases the room's head job and requeues the room behind the
+// others when it still has work, so one busy room cannot starve the rest.
+func (e *scriptExecutor) finishLocked(q *scriptRoomQueue) {
+	q.jobs[0] = scriptJob{}
+	q.jobs = q.jobs[1:]
+	e.pending--
+	if len(q.jobs) > 0 {
+		e.ready = append(e.ready, q)
+		e.work.Signal()
+	} else {
+		delete(e.rooms, q.room)
+	}
+	if e.pending == 0 {
+		e.idle.Broadcast()
+	}
+}
+
+// release unblocks a room whose head hook was abandoned, so the hooks queued
+// behind it run. The abandoned hook keeps running, and anything it still says
+// is discarded. It reports false when the room is not stuck.
+func (e *scriptExecutor) release(room RoomID) bool {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	q, ok := e.rooms[room]
+	if !ok || q.stuck == nil {
+		return false
+	}
+	q.stuck = nil
+	e.finishLocked(q)
+	return true
+}
+
+// wait blocks until every queued hook has returned, including abandoned
+// ones that were not released.
+func (e *scriptExecutor) wait() {
+	e.mu.Lock()
+	for e.pending > 0 {
+		e.idle.Wait()
+	}
+	e.mu.Unlock()
+}
+
+func (e *scriptExecutor) snapshot() []ScriptStats {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	stats := make([]ScriptStats, 0, len(e.stats))
+	for key, c := range e.stats {
+		s := ScriptStats{
+			Name:       key.String(),
+			Calls:      c.calls,
+			Timeouts:   c.timeouts,
+			Failures:   c.failures,
+			Dropped:    c.dropped,
+			MaxLatency: c.maxLatency,
+			Disabled:   c.disabled,
+		}
+		if c.calls > 0 {
+			s.MeanLatency = c.totalLatency / time.Duration(c.calls)
+		}
+		stats = append(stats, s)
+	}
+	sort.Slice(stats, func(i, j int) bool { return stats[i].Name < stats[j].Name })
+	return stats
+}
+
+// abandonedHooks reports how many hooks are still running past their budget
+// and how many have been abandoned since the executor started.
+func (e *scriptExecutor) abandonedHooks() (int, uint64) {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	return e.abandoned, e.abandonedTotal
+}
+
+// ConfigureScripts applies worker, budget and queue limits to world scripts.
+func (w *World) ConfigureScripts(cfg ScriptConfig) {
+	if w == nil || w.scripts == nil || w.scripts.exec == nil {
+		return
+	}
+	w.scripts.exec.configure(cfg)
+}
+
+// ScriptStats reports per-script hook counters sorted by script name.
+func (w *World) ScriptStats() []ScriptStats {
+	if w == nil || w.scripts == nil || w.scripts.exec == nil {
+		return nil
+	}
+	return w.scripts.exec.snapshot()
+}
+
+// AbandonedScripts reports how many script hooks are still running after
+// overrunning their budget, and how many have overrun it in total.
+func (w *World) AbandonedScripts() (running int, total uint64) {
+	if w == nil || w.scripts == nil || w.scripts.exec == nil {
+		return 0, 0
+	}
+	return w.scripts.exec.abandonedHooks()
+}
+
+// ReleaseScriptRoom unblocks the hooks queued in room behind a hook that
+// overran its budget and has not returned. It reports false when no hook
+// holds the room.
+func (w *World) ReleaseScriptRoom(room RoomID) bool {
+	if w == nil || w.scripts == nil || w.scripts.exec == nil {
+		return false
+	}
+	return w.scripts.exec.release(room)
+}
+
+// waitForScripts blocks until every queued script hook has run.
+func (w *World) waitForScripts() {
+	if w == nil || w.scripts == nil || w.scripts.exec == nil {
+		return
+	}
+	w.scripts.exec.wait()
+}
@@ -0,0 +1,235 @@
+package game
+
+import (
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestScriptExecutorKeepsPerRoomOrder(t *testing.T) {
+	exec := newScriptExecutor(ScriptConfig{Workers: 4, Budget: time.Second})
+	var mu sync.Mutex
+	seen := make(map[RoomID][]int)
+	for i := 0; i < 50; i++ {
+		for _, room := range []RoomID{"north", "south"} {
+			i, room := i, room
+			exec.submit(scriptJob{room: room, kind: "npc", name: string(room), hook: "OnHear", task: scriptFunc(func() bool {
+				mu.Lock()
+				seen[room] = append(seen[room], i)
+				mu.Unlock()
+				return true
+			})})
+		}
+	}
+	exec.wait()
+	for room, order := range seen {
+		if len(order) != 50 {
+			t.Fatalf("%s ran %d hooks, want 50", room, len(order))
+		}
+		for i, got := range order {
+			if got != i {
+				t.Fatalf("%s ran hook %d at position %d", room, got, i)
+			}
+		}
+	}
+	for _, stats := range exec.snapshot() {
+		if stats.Calls != 50 || stats.Timeouts != 0 {
+			t.Fatalf("unexpected stats: %+v", stats)
+		}
+	}
+}
+
+func TestScriptExecutorAbandonsRunawayHook(t *testing.T) {
+	exec := newScriptExecutor(ScriptConfig{Workers: 1, Budget: 20 * time.Millisecond, DisableAfter: 1})
+	release := make(chan struct{})
+	guard := &scriptGuard{}
+	exec.submit(scriptJob{room: "hall", kind: "npc", name: "Looper", hook: "OnEnter", guard: guard, task: scriptFunc(func() bool {
+		<-release
+		return true
+	})})
+	ran := make(chan struct{})
+	exec.submit(scriptJob{room: "hall", kind: "npc", name: "Greeter", hook: "OnEnter", task: scriptFunc(func() bool {
+		close(ran)
+		return true
+	})})
+	elsewhere := make(chan struct{})
+	exec.submit(scriptJob{room: "yard", kind: "npc", name: "Gardener", hook: "OnEnter", task: scriptFunc(func() bool {
+		close(elsewhere)
+		return true
+	})})
+
+	select {
+	case <-elsewhere:
+	case <-time.After(2 * time.Second):
+		t.Fatalf("a runaway hook held up another room")
+	}
+	if guard.active() {
+		t.Fatalf("expected the runaway hook's context to be stopped")
+	}
+	if running, total := exec.abandonedHooks(); running != 1 || total != 1 {
+		t.Fatalf("abandoned hooks = %d running, %d total; want 1, 1", running, total)
+	}
+	select {
+	case <-ran:
+		t.Fatalf("a hook ran in a room whose abandoned hook was still running")
+	case <-time.After(50 * time.Millisecond):
+	}
+
+	close(release)
+	select {
+	case <-ran:
+	case <-time.After(2 * time.Second):
+		t.Fatalf("hook queued behind a runaway script never ran")
+	}
+	exec.wait()
+	if running, _ := exec.abandonedHooks(); running != 0 {
+		t.Fatalf("%d hooks still counted as abandoned after returning", running)
+	}
+	if exec.submit(scriptJob{room: "hall", kind: "npc", name: "Looper", hook: "OnEnter", task: scriptFunc(func() bool { return true })}) {
+		t.Fatalf("expected the script to be disabled after timing out")
+	}
+	for _, stats := range exec.snapshot() {
+		if stats.Name == "npc:Looper" && (stats.Timeouts != 1 || !stats.Disabled) {
+			t.Fatalf("unexpected runaway stats: %+v", stats)
+		}
+	}
+}
+
+func TestScriptExecutorReleasesStuckRoom(t *testing.T) {
+	exec := newScriptExecutor(ScriptConfig{Workers: 1, Budget: 10 * time.Millisecond})
+	release := make(chan struct{})
+	exec.submit(scriptJob{room: "hall", kind: "room", name: "hall", hook: "OnLook", task: scriptFunc(func() bool {
+		<-release
+		return true
+	})})
+	ran := make(chan struct{})
+	exec.submit(scriptJob{room: "hall", kind: "npc", name: "Greeter", hook: "OnEnter", task: scriptFunc(func() bool {
+		close(ran)
+		return true
+	})})
+	if exec.release("yard") {
+		t.Fatalf("released a room with no hooks")
+	}
+	deadline := time.Now().Add(2 * time.Second)
+	for !exec.release("hall") {
+		if time.Now().After(deadline) {
+			t.Fatalf("the runaway hook never left its room stuck")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	select {
+	case <-ran:
+	case <-time.After(2 * time.Second):
+		t.Fatalf("hook queued behind a released room never ran")
+	}
+	exec.wait()
+
+	close(release)
+	deadline = time.Now().Add(2 * time.Second)
+	for {
+		if running, _ := exec.abandonedHooks(); running == 0 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("released hook still counted as abandoned after returning")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	exec.mu.Lock()
+	pending := exec.pending
+	exec.mu.Unlock()
+	if pending != 0 {
+		t.Fatalf("pending = %d after the released hook returned, want 0", pending)
+	}
+}
+
+func TestScriptExecutorCapsAbandonedHooks(t *testing.T) {
+	exec := newScriptExecutor(ScriptConfig{Workers: 1, Budget: 10 * time.Millisecond})
+	release := make(chan struct{})
+	for _, room := range []RoomID{"a", "b", "c"} {
+		exec.submit(scriptJob{room: room, kind: "room", name: string(room), hook: "OnLook", task: scriptFunc(func() bool {
+			<-release
+			return true
+		})})
+	}
+	deadline := time.Now().Add(2 * time.Second)
+	for {
+		if running, _ := exec.abandonedHooks(); running == 2 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("expected two hooks to be abandoned")
+		}
+		time.Sleep(time.Millisecond)
+	}
+	// The second abandoned hook is past the cap, so nothing replaced it
+	// and the third room waits for a worker.
+	time.Sleep(50 * time.Millisecond)
+	exec.mu.Lock()
+	workers, abandoned := exec.workers, exec.abandoned
+	exec.mu.Unlock()
+	if workers != 0 || abandoned != 2 {
+		t.Fatalf("workers = %d, abandoned = %d; want 0, 2", workers, abandoned)
+	}
+	close(release)
+	exec.wait()
+	exec.mu.Lock()
+	workers = exec.workers
+	exec.mu.Unlock()
+	if workers != 1 {
+		t.Fatalf("pool has %d workers after the hooks returned, want 1", workers)
+	}
+}
+
+func TestScriptExecutorShrinksPool(t *testing.T) {
+	exec := newScriptExecutor(ScriptConfig{Workers: 4, Budget: time.Second})
+	exec.submit(scriptJob{room: "hall", kind: "room", name: "hall", hook: "OnLook", task: scriptFunc(func() bool { return true })})
+	exec.wait()
+	exec.configure(ScriptConfig{Workers: 1, Budget: time.Second})
+	deadline := time.Now().Add(2 * time.Second)
+	for {
+		exec.mu.Lock()
+		workers := exec.workers
+		exec.mu.Unlock()
+		if workers == 1 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("pool still has %d workers after shrinking to 1", workers)
+		}
+		time.Sleep(time.Millisecond)
+	}
+	ran := make(chan struct{})
+	exec.submit(scriptJob{room: "hall", kind: "room", name: "hall", hook: "OnLook", task: scriptFunc(func() bool {
+		close(ran)
+		return true
+	})})
+	select {
+	case <-ran:
+	case <-time.After(2 * time.Second):
+		t.Fatalf("the shrunken pool stopped running hooks")
+	}
+}
+
+func TestScriptExecutorDropsEventsPastQueueDepth(t *testing.T) {
+	exec := newScriptExecutor(ScriptConfig{Workers: 1, Budget: time.Second, QueueDepth: 2})
+	release := make(chan struct{})
+	block := func() bool {
+		<-release
+		return true
+	}
+	accepted := 0
+	for i := 0; i < 5; i++ {
+		if exec.submit(scriptJob{room: "plaza", kind: "room", name: "plaza", hook: "OnLook", task: scriptFunc(block)}) {
+			accepted++
+		}
+	}
+	close(release)
+	exec.wait()
+	if accepted != 2 {
+		t.Fatalf("accepted %d hooks, want 2", accepted)
+	}
+	if stats := exec.snapshot(); len(stats) != 1 || stats[0].Dropped != 3 {
+		t.Fatalf("unexpected stats: %+v", stats)
+	}
+}
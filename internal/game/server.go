@@ -12,8 +12,10 @@ import (
 	"math/big"
 	"net"
 	"os"
+	"os/signal"
 	"path/filepath"
 	"strings"
+	"syscall"
 	"time"
 )
 
@@ -30,9 +32,19 @@ type serverConfig struct {
 }
 
 type serverOptions struct {
-	mailPath  string
-	tellsPath string
-	portalCfg *PortalConfig
+	mailPath   string
+	tellsPath  string
+	portalCfg  *PortalConfig
+	outputCfg  OutputConfig
+	journalCfg JournalConfig
+	areaWatch  time.Duration
+	areaReset  time.Duration
+	scriptCfg  ScriptConfig
+	loginCfg   LoginConfig
+	admission  *AdmissionConfig
+	cluster    *ClusterConfig
+	onListen   func(net.Addr, *World)
+	connMode   ConnMode
 }
 
 // ServerOption customises the behaviour of ListenAndServe and ListenAndServeTLS.
@@ -68,6 +80,88 @@ func WithPortalConfig(cfg PortalConfig) ServerOption {
 	}
 }
 
+// WithOutputConfig overrides the per-session output queue limits and policy.
+func WithOutputConfig(cfg OutputConfig) ServerOption {
+	return func(opts *serverOptions) {
+		opts.outputCfg = cfg
+	}
+}
+
+// WithJournalConfig sets the fsync policy and compaction threshold used by the
+// mail, offline tell and builder area journals.
+func WithJournalConfig(cfg JournalConfig) ServerOption {
+	return func(opts *serverOptions) {
+		opts.journalCfg = cfg
+	}
+}
+
+// WithScriptConfig sets the script worker pool size and per-hook budget.
+func WithScriptConfig(cfg ScriptConfig) ServerOption {
+	return func(opts *serverOptions) {
+		opts.scriptCfg = cfg
+	}
+}
+
+// WithLoginConfig sets how many passwords may be hashed at once and the
+// bcrypt cost of new hashes.
+func WithLoginConfig(cfg LoginConfig) ServerOption {
+	return func(opts *serverOptions) {
+		opts.loginCfg = cfg
+	}
+}
+
+// WithAdmissionConfig overrides the default connection limits, login
+// timeout, command rate and load shedding thresholds.
+func WithAdmissionConfig(cfg AdmissionConfig) ServerOption {
+	return func(opts *serverOptions) {
+		copy := cfg
+		opts.admission = &copy
+	}
+}
+
+// WithCluster joins the server to other nodes, sharing global channels,
+// tells, who lists and mail with them.
+func WithCluster(cfg ClusterConfig) ServerOption {
+	return func(opts *serverOptions) {
+		copy := cfg
+		opts.cluster = &copy
+	}
+}
+
+// WithListenHook calls fn with the listener's address and the loaded world
+// once the server is accepting connections. Load tests use it to find a
+// server started on port 0 and to read its session statistics.
+func WithListenHook(fn func(addr net.Addr, world *World)) ServerOption {
+	return func(opts *serverOptions) {
+		opts.onListen = fn
+	}
+}
+
+// WithConnMode chooses how logged-in sessions are served. ConnModePoll falls
+// back to goroutines where epoll is unavailable, and TLS sessions always use
+// goroutines.
+func WithConnMode(mode ConnMode) ServerOption {
+	return func(opts *serverOptions) {
+		opts.connMode = mode
+	}
+}
+
+// WithAreaWatch polls the areas directory at the given interval and reloads
+// area files that change. Zero disables watching.
+func WithAreaWatch(interval time.Duration) ServerOption {
+	return func(opts *serverOptions) {
+		opts.areaWatch = interval
+	}
+}
+
+// WithAreaResets repopulates areas whose files do not set reset_interval
+// every interval. Areas that set their own interval reset regardless.
+func WithAreaResets(interval time.Duration) ServerOption {
+	return func(opts *serverOptions) {
+		opts.areaReset = interval
+	}
+}
+
 var (
 	accountManagerFactory = NewAccountManager
 	worldFactory          = NewWorld
@@ -174,7 +268,22 @@ func generateSelfSignedCert(certFile, keyFile, addr string) error {
 
 func handleConn(conn net.Conn, world *World, accounts *AccountManager, dispatcher Dispatcher) {
 	session := NewTelnetSession(conn)
-	defer session.Close()
+	var polled *pollSession
+	var flushing bool
+	defer func() {
+		if polled == nil {
+			if flushing {
+				session.finishOutput()
+			}
+			_ = session.Close()
+		}
+	}()
+	if world.outputConfig().Compression {
+		session.offerCompression()
+	}
+	if timeout := world.loginTimeout(); timeout > 0 {
+		_ = conn.SetReadDeadline(time.Now().Add(timeout))
+	}
 	username, isAdmin, err := login(session, accounts)
 	if err != nil {
 		return
@@ -195,19 +304,14 @@ func handleConn(conn net.Conn, world *World, accounts *AccountManager, dispatche
 		answer := strings.ToLower(Trim(response))
 		switch answer {
 		case "y", "yes":
-			oldSession, oldOutput, ok := world.PrepareTakeover(username)
+			oldSession, ok := world.PrepareTakeover(username)
 			if !ok {
 				continue
 			}
 			takeover := Ansi("\r\n" + Style("Your connection has been claimed from another location.", AnsiYellow) + "\r\n")
-			if oldOutput != nil {
-				select {
-				case oldOutput <- takeover:
-				default:
-				}
-				close(oldOutput)
-			}
 			if oldSession != nil {
+				oldSession.output.push(takeover, outputDirect)
+				oldSession.finishOutput()
 				_ = oldSession.Close()
 			}
 			_ = session.WriteString(Ansi("\r\n" + Style("Previous connection released.\r\n", AnsiGreen)))
@@ -231,53 +335,71 @@ func handleConn(conn net.Conn, world *World, accounts *AccountManager, dispatche
 		fmt.Printf("failed to record login for %s: %v\n", username, err)
 	}
 
-	go func() {
-		for out := range p.Output {
-			_ = session.WriteString(out)
-		}
-	}()
+	session.ConfigureOutput(world.outputConfig())
+	if poller := world.connPoller(); poller != nil {
+		polled = poller.attach(world, p, session, dispatcher)
+	}
+	if polled == nil {
+		session.startOutput()
+		flushing = true
+	}
 
-	p.Output <- Ansi("\r\n" + Style(postLoginAtmosphere, AnsiMagenta, AnsiBold) + "\r\n")
-	p.Output <- Ansi("Welcome, " + HighlightName(p.Name) + Style("!\r\n", AnsiMagenta))
-	p.Output <- Ansi(Style(postLoginPrompt+"\r\n", AnsiGreen))
+	p.Send(Ansi("\r\n" + Style(postLoginAtmosphere, AnsiMagenta, AnsiBold) + "\r\n"))
+	p.Send(Ansi("Welcome, " + HighlightName(p.Name) + Style("!\r\n", AnsiMagenta)))
+	p.Send(Ansi(Style(postLoginPrompt+"\r\n", AnsiGreen)))
 	EnterRoom(world, p, "")
 	world.DeliverOfflineTells(p)
 
 	_ = conn.SetReadDeadline(time.Time{})
 
+	if polled != nil {
+		// The poller reads and dispatches from here on, so this goroutine
+		// and its stack go away while the player is idle.
+		polled.start()
+		return
+	}
 	for {
 		line, err := session.ReadLine()
-		if err != nil {
-			break
-		}
-		line = Trim(line)
-		if line == "" {
-			p.Output <- Prompt(p)
-			continue
-		}
-		if !p.allowCommand(time.Now()) {
-			p.Output <- Ansi(Style("\r\nYou are sending commands too quickly. Please wait.", AnsiYellow))
-			p.Output <- Prompt(p)
-			continue
-		}
-		if !p.Alive {
+		if err != nil || !serveLine(world, p, dispatcher, line) {
 			break
 		}
-		if quit := dispatcher(world, p, line); quit {
-			break
-		}
-		p.Output <- Prompt(p)
 	}
+	if p.Session == session {
+		logout(world, p)
+	}
+}
 
-	if p.Session != session {
-		return
+// serveLine runs one line of input for p and reports whether the session
+// should keep reading.
+func serveLine(world *World, p *Player, dispatcher Dispatcher, line string) bool {
+	line = Trim(line)
+	if line == "" {
+		p.Send(Prompt(p))
+		return true
+	}
+	if !p.allowCommand(time.Now()) {
+		p.Send(Ansi(Style("\r\nYou are sending commands too quickly. Please wait.", AnsiYellow)))
+		p.Send(Prompt(p))
+		return true
 	}
+	if !p.Alive {
+		return false
+	}
+	if quit := dispatcher(world, p, line); quit {
+		return false
+	}
+	p.Send(Prompt(p))
+	return true
+}
 
+// logout says goodbye to p, tells the room and removes p from the world,
+// which closes p's output queue once the farewell is queued.
+func logout(world *World, p *Player) {
 	farewell := "\r\n" + Style(logoffAtmosphere, AnsiMagenta, AnsiBold) + "\r\n"
-	p.Output <- Ansi(farewell)
-	p.Output <- Ansi("Until next time, " + HighlightName(p.Name) + Style(".\r\n", AnsiMagenta))
-	p.Output <- Ansi(Style("\r\n"+copyrightNotice+"\r\n", AnsiBlue, AnsiDim))
-	p.Alive = false
+	p.Send(Ansi(farewell))
+	p.Send(Ansi("Until next time, " + HighlightName(p.Name) + Style(".\r\n", AnsiMagenta)))
+	p.Send(Ansi(Style("\r\n"+copyrightNotice+"\r\n", AnsiBlue, AnsiDim)))
+	world.markPlayerOffline(p)
 	world.BroadcastToRoom(p.Room, Ansi(fmt.Sprintf("\r\n%s leaves.", HighlightName(p.Name))), p)
 	world.PersistPlayer(p)
 	world.removePlayer(p.Name)
@@ -328,40 +450,91 @@ func listenAndServe(addr, accountsPath, areasPath, adminAccount string, dispatch
 		}
 	}
 
-	accounts, err := accountManagerFactory(accountsPath)
-	if err != nil {
-		return err
-	}
-	accounts.SetAdminAccount(adminAccount)
-	world, err := worldFactory(areasPath)
-	if err != nil {
-		return err
-	}
-	world.ConfigurePrivileges(cfg.forceAllAdmin, cfg.lockCriticalOps)
-	world.AttachAccountManager(accounts)
-
 	accountsDir := filepath.Dir(accountsPath)
-
 	mailPath := options.mailPath
 	if mailPath == "" {
 		mailPath = filepath.Join(accountsDir, "mail.json")
 	}
-	mail, err := mailSystemFactory(mailPath)
-	if err != nil {
-		return err
-	}
-	world.AttachMailSystem(mail)
-
 	tellsPath := options.tellsPath
 	if tellsPath == "" {
 		tellsPath = filepath.Join(accountsDir, "tells.json")
 	}
-	tells, err := tellSystemFactory(tellsPath)
+
+	stores, err := loadServerStores(accountsPath, areasPath, mailPath, tellsPath)
+	accounts, world, mail, tells := stores.accounts, stores.world, stores.mail, stores.tells
+	if accounts != nil {
+		defer func() {
+			if err := accounts.Close(); err != nil {
+				fmt.Printf("failed to flush account data: %v\n", err)
+			}
+		}()
+	}
+	if world != nil {
+		defer func() {
+			if err := world.Close(); err != nil {
+				fmt.Printf("failed to flush builder rooms: %v\n", err)
+			}
+		}()
+	}
+	if mail != nil {
+		defer func() {
+			if err := mail.Close(); err != nil {
+				fmt.Printf("failed to sync mail journal: %v\n", err)
+			}
+		}()
+	}
+	if tells != nil {
+		defer func() {
+			if err := tells.Close(); err != nil {
+				fmt.Printf("failed to sync tell journal: %v\n", err)
+			}
+		}()
+	}
 	if err != nil {
 		return err
 	}
+	fmt.Printf("Loaded %s\n", stores)
+
+	accounts.SetAdminAccount(adminAccount)
+	accounts.ConfigureLogins(options.loginCfg)
+	world.SetJournalConfig(options.journalCfg)
+	world.ConfigurePrivileges(cfg.forceAllAdmin, cfg.lockCriticalOps)
+	world.ConfigureOutput(options.outputCfg)
+	world.ConfigureScripts(options.scriptCfg)
+	world.AttachAccountManager(accounts)
+	mail.SetJournalConfig(options.journalCfg)
+	world.AttachMailSystem(mail)
+	tells.SetJournalConfig(options.journalCfg)
 	world.AttachTellSystem(tells)
 
+	if options.cluster != nil && options.cluster.Enabled() {
+		cluster := options.cluster.normalized()
+		bus, err := ListenPeerBus(cluster)
+		if err != nil {
+			return err
+		}
+		defer bus.Close()
+		world.AttachBus(cluster.Node, bus)
+		fmt.Printf("Joined cluster as %s with %d peers\n", cluster.Node, len(cluster.Peers))
+	}
+
+	admissionCfg := DefaultAdmissionConfig()
+	if options.admission != nil {
+		admissionCfg = *options.admission
+	}
+	admission := newAdmission(admissionCfg)
+	world.useAdmission(admission)
+
+	if options.connMode == ConnModePoll {
+		poller, err := newConnPoller(0)
+		if err != nil {
+			fmt.Printf("failed to start poll connection mode: %v; using a goroutine per session\n", err)
+		} else {
+			world.useConnPoller(poller)
+			defer poller.close()
+		}
+	}
+
 	var portal PortalProvider
 	if options.portalCfg != nil {
 		portal, err = portalFactory(world, *options.portalCfg)
@@ -402,9 +575,45 @@ func listenAndServe(addr, accountsPath, areasPath, adminAccount string, dispatch
 	}
 	defer ln.Close()
 
-	return acceptConnections(ln, func(conn net.Conn) {
-		go handleConn(conn, world, accounts, dispatcher)
+	// Closing the listener on SIGINT/SIGTERM lets the deferred flushes run
+	// before the process exits.
+	signals := make(chan os.Signal, 1)
+	signal.Notify(signals, os.Interrupt, syscall.SIGTERM)
+	defer signal.Stop(signals)
+	stopping := make(chan struct{})
+	done := make(chan struct{})
+	defer close(done)
+	if options.areaWatch > 0 {
+		go world.WatchAreas(options.areaWatch, done)
+	}
+	world.ConfigureAreaResets(options.areaReset)
+	go world.RunAreaResets(done)
+	go world.RunBus(done)
+	go admission.watch(world, done)
+	go func() {
+		select {
+		case <-signals:
+			close(stopping)
+			_ = ln.Close()
+		case <-done:
+		}
+	}()
+
+	if options.onListen != nil {
+		options.onListen(ln.Addr(), world)
+	}
+	err = acceptConnections(ln, func(conn net.Conn) {
+		if conn, ok := admission.admit(conn); ok {
+			go handleConn(conn, world, accounts, dispatcher)
+		}
 	})
+	select {
+	case <-stopping:
+		fmt.Println("Shutting down; saving account, mail, tell and builder data")
+		return nil
+	default:
+		return err
+	}
 }
 
 const (
@@ -0,0 +1,110 @@
+package game
+
+import (
+	"fmt"
+	"strings"
+	"sync"
+	"time"
+)
+
+// LoadTiming records how long one startup stage took.
+type LoadTiming struct {
+	Stage   string
+	Elapsed time.Duration
+	// Stages breaks the stage down further, for example the world into its
+	// areas and quests.
+	Stages []LoadTiming
+}
+
+func (t LoadTiming) String() string {
+	out := fmt.Sprintf("%s %s", t.Stage, t.Elapsed.Round(time.Microsecond))
+	if len(t.Stages) > 0 {
+		out += " (" + formatLoadTimings(t.Stages) + ")"
+	}
+	return out
+}
+
+func formatLoadTimings(timings []LoadTiming) string {
+	parts := make([]string, 0, len(timings))
+	for _, timing := range timings {
+		if timing.Stage == "" {
+			continue
+		}
+		parts = append(parts, timing.String())
+	}
+	return strings.Join(parts, ", ")
+}
+
+// timeLoadStage runs fn and records its duration in timing.
+func timeLoadStage(timing *LoadTiming, stage string, fn func()) {
+	start := time.Now()
+	fn()
+	*timing = LoadTiming{Stage: stage, Elapsed: time.Since(start)}
+}
+
+// runLoadStage runs fn on its own goroutine as part of wg, recording its
+// duration in timing. Stages started together must not share state.
+func runLoadStage(wg *sync.WaitGroup, timing *LoadTiming, stage string, fn func()) {
+	wg.Add(1)
+	go func() {
+		defer wg.Done()
+		timeLoadStage(timing, stage, fn)
+	}()
+}
+
+// LoadTimings reports how long NewWorld spent on each of its loading stages.
+func (w *World) LoadTimings() []LoadTiming {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	return append([]LoadTiming(nil), w.loadTimings...)
+}
+
+// serverStores holds the independent stores listenAndServe loads at startup.
+type serverStores struct {
+	accounts *AccountManager
+	world    *World
+	mail     *MailSystem
+	tells    *TellSystem
+	timings  []LoadTiming
+	elapsed  time.Duration
+}
+
+// loadServerStores loads the accounts, world, mail and offline tells
+// concurrently. Stores that loaded are returned alongside the first error so
+// the caller can close them.
+func loadServerStores(accountsPath, areasPath, mailPath, tellsPath string) (serverStores, error) {
+	var (
+		stores                                   serverStores
+		accountsErr, worldErr, mailErr, tellsErr error
+		wg                                       sync.WaitGroup
+	)
+	start := time.Now()
+	stores.timings = make([]LoadTiming, 4)
+	runLoadStage(&wg, &stores.timings[0], "accounts", func() {
+		stores.accounts, accountsErr = accountManagerFactory(accountsPath)
+	})
+	runLoadStage(&wg, &stores.timings[1], "world", func() {
+		stores.world, worldErr = worldFactory(areasPath)
+	})
+	runLoadStage(&wg, &stores.timings[2], "mail", func() {
+		stores.mail, mailErr = mailSystemFactory(mailPath)
+	})
+	runLoadStage(&wg, &stores.timings[3], "tells", func() {
+		stores.tells, tellsErr = tellSystemFactory(tellsPath)
+	})
+	wg.Wait()
+	stores.elapsed = time.Since(start)
+	if stores.world != nil {
+		stores.timings[1].Stages = stores.world.LoadTimings()
+	}
+	for _, err := range []error{accountsErr, worldErr, mailErr, tellsErr} {
+		if err != nil {
+			return stores, err
+		}
+	}
+	return stores, nil
+}
+
+func (s serverStores) String() string {
+	return fmt.Sprintf("%s; ready in %s", formatLoadTimings(s.timings), s.elapsed.Round(time.Microsecond))
+}
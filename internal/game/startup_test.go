@@ -0,0 +1,57 @@
+package game
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+func TestLoadRoomsDecodesAreasInParallel(t *testing.T) {
+	dir := t.TempDir()
+	for i := 0; i < 12; i++ {
+		writeAreaForTest(t, dir, fmt.Sprintf("area%02d.json", i), areaFile{
+			Name:  fmt.Sprintf("Area %d", i),
+			Rooms: []Room{{ID: RoomID(fmt.Sprintf("room%02d", i)), Title: "Room"}},
+		})
+	}
+	rooms, sources, areas, err := loadRooms(dir)
+	if err != nil {
+		t.Fatalf("loadRooms: %v", err)
+	}
+	if len(rooms) != 12 || len(areas) != 12 {
+		t.Fatalf("expected 12 rooms in 12 areas, got %d rooms and %d areas", len(rooms), len(areas))
+	}
+	if got := sources["room07"]; got != "area07.json" {
+		t.Fatalf("room07 source = %q", got)
+	}
+	data, err := os.ReadFile(filepath.Join(dir, "area07.json"))
+	if err != nil {
+		t.Fatalf("ReadFile: %v", err)
+	}
+	if areas["area07.json"].Digest != digestBytes(data) {
+		t.Fatalf("streamed digest does not match the file contents")
+	}
+
+	writeAreaForTest(t, dir, "area99.json", areaFile{Name: "Dup", Rooms: []Room{{ID: "room03"}}})
+	if _, _, _, err := loadRooms(dir); err == nil || !strings.Contains(err.Error(), "duplicate room id room03") {
+		t.Fatalf("expected duplicate room error, got %v", err)
+	}
+}
+
+func TestNewWorldRecordsLoadTimings(t *testing.T) {
+	dir := t.TempDir()
+	writeAreaForTest(t, dir, "start.json", areaFile{Name: "Start", Rooms: []Room{{ID: StartRoom}}})
+	world, err := NewWorld(dir)
+	if err != nil {
+		t.Fatalf("NewWorld: %v", err)
+	}
+	defer world.Close()
+	summary := formatLoadTimings(world.LoadTimings())
+	for _, stage := range []string{"areas", "quests", "builder journal", "scripts"} {
+		if !strings.Contains(summary, stage) {
+			t.Fatalf("expected %q in load timings %q", stage, summary)
+		}
+	}
+}
@@ -52,14 +52,36 @@ func (p TellRetentionPolicy) normalized() TellRetentionPolicy {
 	return p
 }
 
-// TellSystem persists offline tells for delivery when players return.
+// TellSystem persists offline tells for delivery when players return. Queued
+// and consumed tells are appended to a journal beside the JSON snapshot, which
+// is rewritten only when the journal is compacted.
 type TellSystem struct {
 	mu     sync.RWMutex
 	path   string
 	queue  map[string][]OfflineTell
 	policy TellRetentionPolicy
+
+	journal       *journal
+	snapshotSaved bool
+}
+
+type tellSnapshot struct {
+	Queue      map[string][]OfflineTell `json:"queue"`
+	JournalSeq uint64                   `json:"journal_seq,omitempty"`
 }
 
+type tellJournalEntry struct {
+	Seq  uint64       `json:"seq"`
+	Op   string       `json:"op"`
+	Key  string       `json:"key"`
+	Tell *OfflineTell `json:"tell,omitempty"`
+}
+
+const (
+	tellJournalQueue   = "queue"
+	tellJournalConsume = "consume"
+)
+
 // NewTellSystem constructs an offline tell manager backed by the provided file path
 // using the default retention policy. When path is empty the system operates purely
 // in-memory without persistence.
@@ -84,21 +106,17 @@ func NewTellSystemWithRetention(path string, policy TellRetentionPolicy) (*TellS
 	if trimmed == "" {
 		return system, nil
 	}
+	system.journal = newJournal(path, DefaultJournalConfig())
 	data, err := os.ReadFile(path)
-	if errors.Is(err, os.ErrNotExist) {
-		return system, nil
-	}
-	if err != nil {
+	if err != nil && !errors.Is(err, os.ErrNotExist) {
 		return nil, fmt.Errorf("read offline tells: %w", err)
 	}
-	if len(data) == 0 {
-		return system, nil
-	}
-	var file struct {
-		Queue map[string][]OfflineTell `json:"queue"`
-	}
-	if err := json.Unmarshal(data, &file); err != nil {
-		return nil, fmt.Errorf("decode offline tells: %w", err)
+	var file tellSnapshot
+	if len(data) > 0 {
+		if err := json.Unmarshal(data, &file); err != nil {
+			return nil, fmt.Errorf("decode offline tells: %w", err)
+		}
+		system.snapshotSaved = true
 	}
 	now := time.Now().UTC()
 	for key, list := range file.Queue {
@@ -106,40 +124,95 @@ func NewTellSystemWithRetention(path string, policy TellRetentionPolicy) (*TellS
 		if normalized == "" {
 			continue
 		}
-		sanitized := make([]OfflineTell, 0, len(list))
 		for _, entry := range list {
-			body := strings.TrimSpace(entry.Body)
-			if body == "" {
-				continue
-			}
-			sender := strings.TrimSpace(entry.Sender)
-			recipient := strings.TrimSpace(entry.Recipient)
-			if recipient == "" {
-				recipient = key
+			if tell, ok := sanitizeLoadedTell(entry, key, now); ok {
+				system.queue[normalized] = append(system.queue[normalized], tell)
 			}
-			created := entry.CreatedAt
-			if created.IsZero() {
-				created = now
-			}
-			sanitized = append(sanitized, OfflineTell{
-				Sender:    sender,
-				Recipient: recipient,
-				Body:      body,
-				CreatedAt: created.UTC(),
-			})
 		}
-		if len(sanitized) == 0 {
-			continue
-		}
-		pruned := system.applyRetention(sanitized, now)
+	}
+	if err := system.journal.replay(file.JournalSeq, func(line []byte) error {
+		return system.applyJournalEntry(line, now)
+	}); err != nil {
+		return nil, fmt.Errorf("replay offline tells journal: %w", err)
+	}
+	for key, list := range system.queue {
+		pruned := system.applyRetention(list, now)
 		if len(pruned) == 0 {
+			delete(system.queue, key)
 			continue
 		}
-		system.queue[normalized] = pruned
+		system.queue[key] = pruned
 	}
 	return system, nil
 }
 
+func sanitizeLoadedTell(entry OfflineTell, key string, now time.Time) (OfflineTell, bool) {
+	body := strings.TrimSpace(entry.Body)
+	if body == "" {
+		return OfflineTell{}, false
+	}
+	sender := strings.TrimSpace(entry.Sender)
+	recipient := strings.TrimSpace(entry.Recipient)
+	if recipient == "" {
+		recipient = key
+	}
+	created := entry.CreatedAt
+	if created.IsZero() {
+		created = now
+	}
+	return OfflineTell{
+		Sender:    sender,
+		Recipient: recipient,
+		Body:      body,
+		CreatedAt: created.UTC(),
+	}, true
+}
+
+func (t *TellSystem) applyJournalEntry(line []byte, now time.Time) error {
+	var entry tellJournalEntry
+	if err := json.Unmarshal(line, &entry); err != nil {
+		return err
+	}
+	key := normalizeTellKey(entry.Key)
+	if key == "" {
+		return nil
+	}
+	switch entry.Op {
+	case tellJournalQueue:
+		if entry.Tell == nil {
+			return nil
+		}
+		if tell, ok := sanitizeLoadedTell(*entry.Tell, entry.Key, now); ok {
+			t.queue[key] = append(t.queue[key], tell)
+		}
+	case tellJournalConsume:
+		delete(t.queue, key)
+	default:
+		return fmt.Errorf("unknown offline tell journal op %q", entry.Op)
+	}
+	return nil
+}
+
+// SetJournalConfig changes the fsync policy and compaction threshold of the
+// offline tell journal.
+func (t *TellSystem) SetJournalConfig(cfg JournalConfig) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if t.journal != nil {
+		t.journal.cfg = cfg.normalized()
+	}
+}
+
+// Close syncs and closes the offline tell journal.
+func (t *TellSystem) Close() error {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if t.journal == nil {
+		return nil
+	}
+	return t.journal.close()
+}
+
 // PendingFor returns a snapshot of queued tells for the specified recipient without removing them.
 func (t *TellSystem) PendingFor(recipient string) []OfflineTell {
 	key := normalizeTellKey(recipient)
@@ -172,7 +245,7 @@ func (t *TellSystem) ConsumeFor(recipient string) []OfflineTell {
 	snapshot := make([]OfflineTell, len(list))
 	copy(snapshot, list)
 	delete(t.queue, key)
-	if err := t.persistLocked(); err != nil {
+	if err := t.persistLocked(tellJournalEntry{Op: tellJournalConsume, Key: key}); err != nil {
 		t.queue[key] = list
 		return nil
 	}
@@ -231,7 +304,7 @@ func (t *TellSystem) Queue(sender, recipient, body string, when time.Time) (Offl
 	} else {
 		t.queue[key] = retained
 	}
-	if err := t.persistLocked(); err != nil {
+	if err := t.persistLocked(tellJournalEntry{Op: tellJournalQueue, Key: key, Tell: &tell}); err != nil {
 		if len(existing) == 0 {
 			delete(t.queue, key)
 		} else {
@@ -242,13 +315,24 @@ func (t *TellSystem) Queue(sender, recipient, body string, when time.Time) (Offl
 	return tell, nil
 }
 
-func (t *TellSystem) persistLocked() error {
+// persistLocked records a change to the queue. It is normally a single
+// journal append; the snapshot is rewritten when none exists yet or the
+// journal is due for compaction.
+func (t *TellSystem) persistLocked(entry tellJournalEntry) error {
 	if t.queue == nil {
 		t.queue = make(map[string][]OfflineTell)
 	}
 	if strings.TrimSpace(t.path) == "" {
 		return nil
 	}
+	if t.journal == nil || !t.snapshotSaved || t.journal.needsCompaction() {
+		return t.saveLocked()
+	}
+	entry.Seq = t.journal.nextSeq()
+	return t.journal.append(entry)
+}
+
+func (t *TellSystem) saveLocked() error {
 	active := make(map[string][]OfflineTell, len(t.queue))
 	now := time.Now().UTC()
 	for key, list := range t.queue {
@@ -264,9 +348,13 @@ func (t *TellSystem) persistLocked() error {
 		active[key] = copied
 	}
 	if len(active) == 0 {
+		// The snapshot goes first: replaying the journal onto an empty queue
+		// still ends empty, while a stale snapshot would resurrect tells.
 		if err := os.Remove(t.path); err != nil && !errors.Is(err, os.ErrNotExist) {
 			return fmt.Errorf("remove offline tells: %w", err)
 		}
+		t.snapshotSaved = false
+		t.truncateJournalLocked()
 		return nil
 	}
 	dir := filepath.Dir(t.path)
@@ -277,15 +365,24 @@ func (t *TellSystem) persistLocked() error {
 	if err != nil {
 		return fmt.Errorf("create temp offline tells file: %w", err)
 	}
+	record := tellSnapshot{Queue: active}
+	if t.journal != nil {
+		record.JournalSeq = t.journal.seq
+	}
 	enc := json.NewEncoder(tmp)
 	enc.SetIndent("", "  ")
-	if err := enc.Encode(struct {
-		Queue map[string][]OfflineTell `json:"queue"`
-	}{Queue: active}); err != nil {
+	if err := enc.Encode(record); err != nil {
 		tmp.Close()
 		os.Remove(tmp.Name())
 		return fmt.Errorf("write offline tells: %w", err)
 	}
+	if t.journal != nil {
+		if err := syncFile(tmp); err != nil {
+			tmp.Close()
+			os.Remove(tmp.Name())
+			return err
+		}
+	}
 	if err := tmp.Close(); err != nil {
 		os.Remove(tmp.Name())
 		return fmt.Errorf("close offline tells file: %w", err)
@@ -294,9 +391,22 @@ func (t *TellSystem) persistLocked() error {
 		os.Remove(tmp.Name())
 		return fmt.Errorf("replace offline tells file: %w", err)
 	}
+	t.snapshotSaved = true
+	t.truncateJournalLocked()
 	return nil
 }
 
+func (t *TellSystem) truncateJournalLocked() {
+	if t.journal == nil {
+		return
+	}
+	// Records left behind by a failed truncate are skipped on replay because
+	// the snapshot carries their sequence numbers.
+	if err := t.journal.truncate(); err != nil {
+		fmt.Printf("failed to truncate offline tells journal: %v\n", err)
+	}
+}
+
 func normalizeTellKey(name string) string {
 	return strings.ToLower(strings.TrimSpace(name))
 }
@@ -173,3 +173,43 @@ func TestTellSystemRetentionPersistsPrunedEntries(t *testing.T) {
 		t.Fatalf("Reloaded pending unexpected: %#v", pending)
 	}
 }
+
+func TestTellSystemReplaysJournalOverSnapshot(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "tells.json")
+	system, err := NewTellSystem(path)
+	if err != nil {
+		t.Fatalf("NewTellSystem: %v", err)
+	}
+	base := time.Date(2025, time.February, 1, 9, 0, 0, 0, time.UTC)
+	if _, err := system.Queue("Alice", "Bob", "Snapshot", base); err != nil {
+		t.Fatalf("Queue snapshot: %v", err)
+	}
+	if _, err := system.Queue("Alice", "Cara", "Journal 1", base.Add(time.Minute)); err != nil {
+		t.Fatalf("Queue journal: %v", err)
+	}
+	if _, err := system.Queue("Dana", "Cara", "Journal 2", base.Add(2*time.Minute)); err != nil {
+		t.Fatalf("Queue journal: %v", err)
+	}
+	if consumed := system.ConsumeFor("Bob"); len(consumed) != 1 {
+		t.Fatalf("ConsumeFor returned %d entries, want 1", len(consumed))
+	}
+	if _, err := os.Stat(path + ".journal"); err != nil {
+		t.Fatalf("expected journal file: %v", err)
+	}
+	if err := system.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	reloaded, err := NewTellSystem(path)
+	if err != nil {
+		t.Fatalf("reload TellSystem: %v", err)
+	}
+	if pending := reloaded.PendingFor("Bob"); pending != nil {
+		t.Fatalf("consumed tells should stay consumed after replay: %#v", pending)
+	}
+	pending := reloaded.PendingFor("Cara")
+	if len(pending) != 2 || pending[0].Body != "Journal 1" || pending[1].Body != "Journal 2" {
+		t.Fatalf("replayed tells incorrect: %#v", pending)
+	}
+}
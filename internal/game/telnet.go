@@ -3,10 +3,15 @@ package game
 import (
 	"bufio"
 	"bytes"
+	"compress/zlib"
+	"errors"
 	"net"
 	"strconv"
 	"strings"
 	"sync"
+	"sync/atomic"
+	"time"
+	"unicode/utf8"
 
 	"golang.org/x/text/encoding/charmap"
 )
@@ -198,8 +203,50 @@ type TelnetSession struct {
 	hasMTTS          bool
 	suppressGoAhead  bool
 	requestedCharset bool
+
+	// line and subneg are reused by ReadLine, which only the connection's
+	// reading goroutine calls. afterCR is set when the last line ended in CR.
+	line    []byte
+	subneg  []byte
+	afterCR bool
+
+	// outBuf is reused for every encoded write and is guarded by mu.
+	outBuf []byte
+	// zw compresses output into zbuf while MCCP2 is active; both are
+	// guarded by mu. The counters are read without it for OutputStats.
+	compressOffered bool
+	zw              *zlib.Writer
+	zbuf            bytes.Buffer
+	compressing     atomic.Bool
+	compressIn      atomic.Uint64
+	compressOut     atomic.Uint64
+	compressTime    atomic.Int64
+	// output holds messages waiting for the socket; see startOutput.
+	output *outputQueue
+	// flushed is closed once the output queue has been closed and written
+	// out, by whichever of startOutput or a connPoller serves the session.
+	flushed     chan struct{}
+	flushedOnce sync.Once
+	// poll is set while a connPoller serves the session.
+	poll atomic.Pointer[pollSession]
 }
 
+const (
+	// outputBatchLimit caps how many encoded bytes are coalesced into a single
+	// write when draining queued player output.
+	outputBatchLimit = 64 << 10
+	// outputBufferRetain is the largest output buffer kept between writes.
+	outputBufferRetain = 256 << 10
+	// outputDrainTimeout bounds how long a closing session waits for its
+	// farewell to be written.
+	outputDrainTimeout = 5 * time.Second
+	// maxInputLine caps the bytes kept for one line of input; the rest of an
+	// overlong line is dropped.
+	maxInputLine = 4096
+	// maxSubnegotiation caps the payload kept for one telnet subnegotiation.
+	maxSubnegotiation = 1024
+)
+
 func NewTelnetSession(conn net.Conn) *TelnetSession {
 	s := &TelnetSession{
 		conn:      conn,
@@ -208,6 +255,12 @@ func NewTelnetSession(conn net.Conn) *TelnetSession {
 		height:    24,
 		termTypes: make(map[string]struct{}),
 		charset:   "UTF-8",
+		output:    newOutputQueue(DefaultOutputConfig()),
+		flushed:   make(chan struct{}),
+	}
+	s.output.onStall = func() {
+		_ = s.Close()
+		s.markFlushed()
 	}
 	s.features.add(mttsANSI)
 	s.performHandshake()
@@ -231,23 +284,126 @@ func (s *TelnetSession) writeCommand(cmd, opt byte) error {
 func (s *TelnetSession) writeRaw(payload []byte) error {
 	s.mu.Lock()
 	defer s.mu.Unlock()
-	_, err := s.conn.Write(payload)
-	return err
+	return s.sendLocked(payload)
 }
 
 func (s *TelnetSession) WriteString(msg string) error {
 	s.mu.Lock()
 	defer s.mu.Unlock()
 
-	data := []byte(msg)
-	if s.charMap != nil {
-		data = encodeWithCharmap(s.charMap, data)
+	s.outBuf = appendTelnetString(s.outBuf[:0], s.charMap, msg)
+	return s.flushLocked()
+}
+
+// WriteBatch encodes every message into the session's output buffer and sends
+// them to the client with a single write.
+func (s *TelnetSession) WriteBatch(msgs []string) error {
+	if len(msgs) == 0 {
+		return nil
+	}
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	buf := s.outBuf[:0]
+	for _, msg := range msgs {
+		buf = appendTelnetString(buf, s.charMap, msg)
+	}
+	s.outBuf = buf
+	return s.flushLocked()
+}
+
+func (s *TelnetSession) flushLocked() error {
+	err := s.sendLocked(s.outBuf)
+	if cap(s.outBuf) > outputBufferRetain {
+		s.outBuf = nil
+	}
+	return err
+}
+
+// writeWire sends encoded bytes to the client. While a connPoller serves the
+// session they are handed to its flush task instead, so the caller never
+// waits for a slow client.
+func (s *TelnetSession) writeWire(data []byte) error {
+	if ps := s.poll.Load(); ps != nil {
+		ps.queueWire(data)
+		return nil
 	}
-	data = translateForTelnet(data)
 	_, err := s.conn.Write(data)
 	return err
 }
 
+// ConfigureOutput applies the server's output queue limits to the session.
+func (s *TelnetSession) ConfigureOutput(cfg OutputConfig) {
+	s.output.configure(cfg)
+}
+
+// OutputStats reports the session's output backlog, shedding and
+// compression counters.
+func (s *TelnetSession) OutputStats() OutputStats {
+	stats := s.output.stats()
+	s.addCompressionStats(&stats)
+	return stats
+}
+
+// queue returns the output queue players send to, or nil without a session.
+func (s *TelnetSession) queue() *outputQueue {
+	if s == nil {
+		return nil
+	}
+	return s.output
+}
+
+// startOutput starts the goroutine that writes the session's output queue.
+// Whatever has queued up while the previous write was in flight is coalesced
+// into one write, so a command's output and its prompt usually leave in a
+// single segment.
+func (s *TelnetSession) startOutput() {
+	go func() {
+		s.flushOutput()
+		s.markFlushed()
+	}()
+}
+
+func (s *TelnetSession) markFlushed() {
+	if s.flushed != nil {
+		s.flushedOnce.Do(func() { close(s.flushed) })
+	}
+}
+
+// finishOutput closes the output queue and waits, for a bounded time, for
+// what is already queued to be written.
+func (s *TelnetSession) finishOutput() {
+	s.output.close(false)
+	if s.flushed == nil {
+		return
+	}
+	select {
+	case <-s.flushed:
+	case <-time.After(outputDrainTimeout):
+	}
+}
+
+// flushOutput writes batches from the output queue until it is closed. After
+// a failed write the rest of the backlog is discarded.
+func (s *TelnetSession) flushOutput() {
+	batch := make([]string, 0, 16)
+	for {
+		var open bool
+		batch, open = s.output.next(batch[:0], outputBatchLimit)
+		if len(batch) > 0 {
+			err := s.WriteBatch(batch)
+			s.output.written()
+			clear(batch)
+			if err != nil {
+				s.output.close(true)
+			}
+		}
+		if !open {
+			return
+		}
+	}
+}
+
 func (s *TelnetSession) decodeInput(data []byte) string {
 	if len(data) == 0 {
 		return ""
@@ -259,66 +415,204 @@ func (s *TelnetSession) decodeInput(data []byte) string {
 }
 
 func translateForTelnet(data []byte) []byte {
-	var buf bytes.Buffer
+	if len(data) == 0 {
+		return nil
+	}
+	return appendTelnetString(make([]byte, 0, len(data)+8), nil, string(data))
+}
+
+// appendTelnetString encodes msg with the optional charmap, expands bare line
+// feeds to CRLF and escapes IAC bytes, appending the result to dst.
+func appendTelnetString(dst []byte, cm *charmap.Charmap, msg string) []byte {
 	var prev byte
-	for _, b := range data {
-		switch b {
-		case '\n':
-			if prev != '\r' {
-				buf.WriteByte('\r')
-			}
-			buf.WriteByte('\n')
-		case telnetIAC:
-			buf.WriteByte(telnetIAC)
-			buf.WriteByte(telnetIAC)
-		default:
-			buf.WriteByte(b)
+	if cm == nil {
+		for i := 0; i < len(msg); i++ {
+			b := msg[i]
+			dst = appendTelnetByte(dst, prev, b)
+			prev = b
+		}
+		return dst
+	}
+	for _, r := range msg {
+		b, ok := cm.EncodeRune(r)
+		if !ok {
+			b = '?'
 		}
+		dst = appendTelnetByte(dst, prev, b)
 		prev = b
 	}
-	return buf.Bytes()
+	return dst
+}
+
+func appendTelnetByte(dst []byte, prev, b byte) []byte {
+	switch b {
+	case '\n':
+		if prev != '\r' {
+			dst = append(dst, '\r')
+		}
+		return append(dst, '\n')
+	case telnetIAC:
+		return append(dst, telnetIAC, telnetIAC)
+	default:
+		return append(dst, b)
+	}
 }
 
+// inputSpecial marks the bytes ReadLine has to act on. Runs of any other
+// bytes are copied into the line in one step.
+var inputSpecial = func() (set [256]bool) {
+	for _, b := range []byte{'\r', '\n', 0x00, 0x08, 0x7f, telnetIAC} {
+		set[b] = true
+	}
+	return set
+}()
+
+// ReadLine returns the next line of input with telnet commands removed. It
+// scans whatever the reader has buffered, so a pasted burst is handled a
+// chunk at a time, and collects the line in a buffer reused across calls.
+// Bytes past maxInputLine are dropped until the line ends.
+//
+// Telnet commands are only handled once they are fully buffered, so a
+// reader that reports errWouldBlock leaves the session ready to resume the
+// same line on the next call.
 func (s *TelnetSession) ReadLine() (string, error) {
-	var buf bytes.Buffer
+	if s.reader == nil {
+		s.reader = bufio.NewReader(s.conn)
+	}
+	want := 1
 	for {
-		b, err := s.reader.ReadByte()
-		if err != nil {
-			return "", err
+		if s.reader.Buffered() < want {
+			if _, err := s.reader.Peek(want); err != nil {
+				if errors.Is(err, bufio.ErrBufferFull) {
+					// Only a misbehaving client sends a subnegotiation
+					// longer than the whole buffer; drop it.
+					_, _ = s.reader.Discard(s.reader.Buffered())
+					want = 1
+					continue
+				}
+				return "", err
+			}
 		}
+		want = 1
+		chunk, _ := s.reader.Peek(s.reader.Buffered())
+		if s.afterCR {
+			// A CR ends the line at once; swallow the LF of a CRLF that
+			// arrives separately instead of waiting for it.
+			s.afterCR = false
+			if chunk[0] == '\n' {
+				_, _ = s.reader.Discard(1)
+				continue
+			}
+		}
+		n := 0
+		for n < len(chunk) && !inputSpecial[chunk[n]] {
+			n++
+		}
+		s.appendInput(chunk[:n])
+		_, _ = s.reader.Discard(n)
+		if n == len(chunk) {
+			continue
+		}
+		if rest := chunk[n:]; rest[0] == telnetIAC && telnetCommandLength(rest) < 0 {
+			want = len(rest) + 1
+			continue
+		}
+
+		b, _ := s.reader.ReadByte()
 		switch b {
 		case '\r':
-			if next, err := s.reader.Peek(1); err == nil && next[0] == '\n' {
-				_, _ = s.reader.ReadByte()
-			}
-			return s.decodeInput(buf.Bytes()), nil
+			s.afterCR = true
+			return s.finishLine(), nil
 		case '\n':
-			return s.decodeInput(buf.Bytes()), nil
+			return s.finishLine(), nil
 		case 0x08, 0x7f:
-			bs := buf.Bytes()
-			if len(bs) > 0 {
-				buf.Truncate(len(bs) - 1)
-			}
+			s.eraseInput()
 		case 0x00:
 			// ignore NULs
 		case telnetIAC:
-			if err := s.handleIAC(&buf); err != nil {
+			if err := s.handleIAC(); err != nil {
 				return "", err
 			}
-		default:
-			buf.WriteByte(b)
 		}
 	}
 }
 
-func (s *TelnetSession) handleIAC(buf *bytes.Buffer) error {
+// appendInput adds data to the current line, dropping whatever does not fit
+// within maxInputLine.
+func (s *TelnetSession) appendInput(data []byte) {
+	if room := maxInputLine - len(s.line); len(data) > room {
+		data = data[:room]
+	}
+	s.line = append(s.line, data...)
+}
+
+// eraseInput removes the last character from the current line.
+func (s *TelnetSession) eraseInput() {
+	if len(s.line) == 0 {
+		return
+	}
+	size := 1
+	if s.charMap == nil {
+		_, size = utf8.DecodeLastRune(s.line)
+	}
+	s.line = s.line[:len(s.line)-size]
+}
+
+func (s *TelnetSession) finishLine() string {
+	line := s.line
+	if len(line) == maxInputLine && s.charMap == nil {
+		// Don't leave half a character behind where the line was cut.
+		for i := len(line) - 1; i >= 0 && i >= len(line)-utf8.UTFMax; i-- {
+			if utf8.RuneStart(line[i]) {
+				if !utf8.FullRune(line[i:]) {
+					line = line[:i]
+				}
+				break
+			}
+		}
+	}
+	text := s.decodeInput(line)
+	s.line = s.line[:0]
+	return text
+}
+
+// telnetCommandLength returns the length of the telnet command at the start
+// of data, which begins with IAC, or -1 if it is not complete yet.
+func telnetCommandLength(data []byte) int {
+	if len(data) < 2 {
+		return -1
+	}
+	switch data[1] {
+	case telnetDO, telnetDONT, telnetWILL, telnetWONT:
+		if len(data) < 3 {
+			return -1
+		}
+		return 3
+	case telnetSB:
+		for i := 2; i+1 < len(data); i++ {
+			if data[i] != telnetIAC {
+				continue
+			}
+			if data[i+1] == telnetSE {
+				return i + 2
+			}
+			i++
+		}
+		return -1
+	}
+	return 2
+}
+
+func (s *TelnetSession) handleIAC() error {
 	cmd, err := s.reader.ReadByte()
 	if err != nil {
 		return err
 	}
 	switch cmd {
 	case telnetIAC:
-		buf.WriteByte(telnetIAC)
+		if len(s.line) < maxInputLine {
+			s.line = append(s.line, telnetIAC)
+		}
 	case telnetDO, telnetDONT, telnetWILL, telnetWONT:
 		opt, err := s.reader.ReadByte()
 		if err != nil {
@@ -338,6 +632,14 @@ func (s *TelnetSession) handleIAC(buf *bytes.Buffer) error {
 func (s *TelnetSession) handleNegotiation(cmd, opt byte) {
 	switch cmd {
 	case telnetDO:
+		if opt == telnetOptCompress2 {
+			if s.compressOffered {
+				_ = s.startCompression()
+			} else {
+				_ = s.writeCommand(telnetWONT, opt)
+			}
+			return
+		}
 		if opt == telnetOptSuppressGA {
 			s.suppressGoAhead = true
 		}
@@ -352,6 +654,12 @@ func (s *TelnetSession) handleNegotiation(cmd, opt byte) {
 			_ = s.writeCommand(telnetWONT, opt)
 		}
 	case telnetDONT:
+		if opt == telnetOptCompress2 {
+			// DONT answers our WILL, so it needs no reply.
+			s.compressOffered = false
+			_ = s.stopCompression()
+			return
+		}
 		if opt == telnetOptSuppressGA {
 			s.suppressGoAhead = false
 		}
@@ -391,7 +699,7 @@ func (s *TelnetSession) handleSubnegotiation() error {
 	if err != nil {
 		return err
 	}
-	payload := make([]byte, 0, 16)
+	payload := s.subneg[:0]
 	for {
 		b, err := s.reader.ReadByte()
 		if err != nil {
@@ -402,7 +710,7 @@ func (s *TelnetSession) handleSubnegotiation() error {
 			if err != nil {
 				return err
 			}
-			if esc == telnetIAC {
+			if esc == telnetIAC && len(payload) < maxSubnegotiation {
 				payload = append(payload, telnetIAC)
 				continue
 			}
@@ -412,8 +720,11 @@ func (s *TelnetSession) handleSubnegotiation() error {
 			// unexpected command inside subnegotiation, ignore and continue
 			continue
 		}
-		payload = append(payload, b)
+		if len(payload) < maxSubnegotiation {
+			payload = append(payload, b)
+		}
 	}
+	s.subneg = payload
 
 	switch opt {
 	case telnetOptTerminalType:
@@ -652,19 +963,23 @@ func decodeWithCharmap(cm *charmap.Charmap, input []byte) string {
 	if cm == nil || len(input) == 0 {
 		return string(input)
 	}
-	runes := make([]rune, len(input))
-	for i, b := range input {
-		runes[i] = cm.DecodeByte(b)
+	var builder strings.Builder
+	builder.Grow(len(input))
+	for _, b := range input {
+		builder.WriteRune(cm.DecodeByte(b))
 	}
-	return string(runes)
+	return builder.String()
 }
 
+// Close shuts the connection without waiting for mu, so it also unblocks a
+// write that is stuck on a stalled client.
 func (s *TelnetSession) Close() error {
-	s.mu.Lock()
-	defer s.mu.Unlock()
 	if s.conn == nil {
 		return nil
 	}
+	if ps := s.poll.Load(); ps != nil {
+		ps.detach()
+	}
 	return s.conn.Close()
 }
 
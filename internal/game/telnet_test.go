@@ -1,6 +1,9 @@
 package game
 
 import (
+	"io"
+	"strings"
+	"sync"
 	"testing"
 
 	"golang.org/x/text/encoding/charmap"
@@ -56,3 +59,166 @@ func TestSanitizeTelnetString(t *testing.T) {
 		t.Fatalf("unexpected sanitized string: %q", got)
 	}
 }
+
+type recordingConn struct {
+	nopConn
+	mu     sync.Mutex
+	writes [][]byte
+}
+
+func (r *recordingConn) Write(b []byte) (int, error) {
+	r.mu.Lock()
+	r.writes = append(r.writes, append([]byte(nil), b...))
+	r.mu.Unlock()
+	return len(b), nil
+}
+
+func TestFlushOutputCoalescesQueuedMessages(t *testing.T) {
+	conn := &recordingConn{}
+	session := &TelnetSession{conn: conn, output: newOutputQueue(DefaultOutputConfig())}
+	session.output.push("You see a lantern.\n", outputDirect)
+	session.output.push("Exits: north\n", outputDirect)
+	session.output.push("> ", outputPrompt)
+	session.output.close(false)
+
+	session.flushOutput()
+
+	if len(conn.writes) != 1 {
+		t.Fatalf("expected a single coalesced write, got %d", len(conn.writes))
+	}
+	want := "You see a lantern.\r\nExits: north\r\n> "
+	if got := string(conn.writes[0]); got != want {
+		t.Fatalf("coalesced write = %q, want %q", got, want)
+	}
+}
+
+func TestSendKeepsChatterInOrderWithDirectOutput(t *testing.T) {
+	conn := &recordingConn{}
+	session := &TelnetSession{conn: conn, output: newOutputQueue(DefaultOutputConfig())}
+	p := &Player{Name: "Alice"}
+	p.queue.Store(session.queue())
+	p.Send("You see a lantern.\n")
+	sendChatter(p, "Bob waves.\n")
+	sendDirect(p, "Bob tells you: hi\n")
+	p.Send("> ")
+	session.output.close(false)
+
+	session.flushOutput()
+
+	var got strings.Builder
+	for _, write := range conn.writes {
+		got.Write(write)
+	}
+	want := "You see a lantern.\r\nBob waves.\r\nBob tells you: hi\r\n> "
+	if got.String() != want {
+		t.Fatalf("sent output = %q, want %q", got.String(), want)
+	}
+}
+
+// chunkedConn serves its chunks to successive reads, then io.EOF.
+type chunkedConn struct {
+	nopConn
+	chunks []string
+}
+
+func (c *chunkedConn) Read(b []byte) (int, error) {
+	if len(c.chunks) == 0 {
+		return 0, io.EOF
+	}
+	n := copy(b, c.chunks[0])
+	if n == len(c.chunks[0]) {
+		c.chunks = c.chunks[1:]
+	} else {
+		c.chunks[0] = c.chunks[0][n:]
+	}
+	return n, nil
+}
+
+func readAllLines(t *testing.T, session *TelnetSession) []string {
+	t.Helper()
+	var lines []string
+	for {
+		line, err := session.ReadLine()
+		if err == io.EOF {
+			return lines
+		}
+		if err != nil {
+			t.Fatalf("ReadLine: %v", err)
+		}
+		lines = append(lines, line)
+	}
+}
+
+func TestReadLineParsesTelnetStream(t *testing.T) {
+	naws := string([]byte{telnetIAC, telnetSB, telnetOptWindowSize, 0, 120, 0, 40, telnetIAC, telnetSE})
+	will := string([]byte{telnetIAC, telnetWILL, telnetOptTerminalType})
+	conn := &chunkedConn{chunks: []string{
+		"look\r",
+		"\nsay hi" + will + " there\r\n",
+		"bare\ncr nul\r\x00",
+		"ab\x08c\x7fd\n",
+		"caf\u00e9\x7f\n",
+		"x" + string([]byte{telnetIAC, telnetIAC}) + "y" + naws[:4],
+		naws[4:] + "z\r\n",
+	}}
+	session := &TelnetSession{conn: conn, charset: "UTF-8"}
+
+	got := readAllLines(t, session)
+	want := []string{"look", "say hi there", "bare", "cr nul", "ad", "caf", "x\xffyz"}
+	if strings.Join(got, "|") != strings.Join(want, "|") {
+		t.Fatalf("lines = %q, want %q", got, want)
+	}
+	if session.width != 120 || session.height != 40 {
+		t.Fatalf("window size = %dx%d, want 120x40", session.width, session.height)
+	}
+}
+
+func TestReadLineCapsLineLength(t *testing.T) {
+	long := strings.Repeat("a", maxInputLine-1) + "\u00e9" + strings.Repeat("b", 3*maxInputLine)
+	conn := &chunkedConn{chunks: []string{long + "\r\nnext\r\n"}}
+	session := &TelnetSession{conn: conn}
+
+	got := readAllLines(t, session)
+	if len(got) != 2 || got[1] != "next" {
+		t.Fatalf("expected the overlong line and \"next\", got %d lines", len(got))
+	}
+	if got[0] != strings.Repeat("a", maxInputLine-1) {
+		t.Fatalf("overlong line kept %d bytes, want %d", len(got[0]), maxInputLine-1)
+	}
+	if cap(session.line) > 2*maxInputLine {
+		t.Fatalf("line buffer grew to %d bytes", cap(session.line))
+	}
+}
+
+// repeatConn serves the same input forever.
+type repeatConn struct {
+	nopConn
+	data string
+}
+
+func (c *repeatConn) Read(b []byte) (int, error) {
+	return copy(b, c.data), nil
+}
+
+func TestReadLineAllocatesOnlyTheLine(t *testing.T) {
+	session := &TelnetSession{conn: &repeatConn{data: "get lantern\r\n"}}
+	if _, err := session.ReadLine(); err != nil {
+		t.Fatalf("ReadLine: %v", err)
+	}
+	allocs := testing.AllocsPerRun(100, func() {
+		_, _ = session.ReadLine()
+	})
+	if allocs > 1 {
+		t.Fatalf("ReadLine allocated %.0f times per line", allocs)
+	}
+}
+
+func BenchmarkReadLine(b *testing.B) {
+	session := &TelnetSession{conn: &repeatConn{data: "say the quick brown fox jumps over the lazy dog\r\n"}}
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		if _, err := session.ReadLine(); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
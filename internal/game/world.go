@@ -1,14 +1,19 @@
 package game
 
 import (
+	"bufio"
 	"encoding/json"
 	"errors"
 	"fmt"
+	"hash/fnv"
+	"io"
 	"os"
 	"path/filepath"
+	"runtime"
 	"sort"
 	"strings"
 	"sync"
+	"sync/atomic"
 	"time"
 )
 
@@ -29,6 +34,9 @@ type Room struct {
 	Items       []Item            `json:"items"`
 	Resets      []RoomReset       `json:"resets,omitempty"`
 	Script      string            `json:"script,omitempty"`
+	// itemIndex counts Items by name for resets. Like Items it belongs to
+	// the room's shard.
+	itemIndex roomItemIndex
 }
 
 // RoomRevision captures a snapshot of a room's editable fields.
@@ -185,19 +193,49 @@ var (
 	ErrItemNotCarried = errors.New("item not carried")
 )
 
+// roomShardCount is the number of lock stripes protecting room contents.
+const roomShardCount = 64
+
+type roomShard struct {
+	mu sync.Mutex
+}
+
+// World holds the shared game state.
+//
+// Locking is two-level. w.mu guards the world's directory: the room and player
+// maps, the occupancy index, room definitions (titles, descriptions, exits,
+// resets) and which room each player is in. Room contents that change during
+// play (a room's Items and NPCs) together with the carried state of the
+// players standing in it (Inventory, vitals, experience and QuestLog) belong
+// to that room's shard in roomShards.
+//
+// Shard-owned state may be touched either with w.mu held exclusively, or with
+// w.mu read-locked and the room's shard lock held. Because a player only
+// changes rooms under the exclusive lock, holding w.mu.RLock pins every
+// player's room and therefore its shard. Lock order is always w.mu first,
+// then at most one shard; operations spanning rooms (Move, MoveToRoom,
+// LinkRooms, defeat respawns, builder edits) take w.mu exclusively instead of
+// stacking shard locks. No lock may be held while calling into the account,
+// mail or tell stores.
 type World struct {
-	mu                sync.RWMutex
+	mu                worldMutex
+	roomShards        [roomShardCount]roomShard
 	rooms             map[RoomID]*Room
 	players           map[string]*Player
 	playerOrder       []string
+	occupants         map[RoomID]map[*Player]struct{}
+	loginSeq          uint64
 	combats           map[RoomID]*combatInstance
+	combatScheduler   *combatScheduler
 	areasPath         string
 	accounts          *AccountManager
 	mail              *MailSystem
 	tells             *TellSystem
 	roomSources       map[RoomID]string
 	roomHistories     map[RoomID]*roomHistory
+	roomDigests       map[RoomID]uint64
 	builderPath       string
+	builder           *builderStore
 	forceAllAdmin     bool
 	criticalOpsLocked bool
 	disabledCommands  map[string]bool
@@ -206,6 +244,39 @@ type World struct {
 	portal            PortalProvider
 	scripts           *scriptEngine
 	areaMeta          map[string]areaMetadata
+	outputCfg         OutputConfig
+	loadTimings       []LoadTiming
+	// playerNames indexes players by folded name for partial lookups.
+	playerNames []playerNameEntry
+	// channelLogs holds each channel's shared message history.
+	channelLogs  map[Channel]*channelLog
+	channelLogMu sync.Mutex
+	channelSeq   atomic.Uint64
+	// roomViews caches each room's rendered view per terminal width.
+	roomViews  map[RoomID][]roomViewEntry
+	roomViewMu sync.Mutex
+	// poller serves logged-in sessions in poll connection mode.
+	poller *connPoller
+	// admission limits connections and command rates when serving.
+	admission *admission
+	// resets schedules timed area resets.
+	resets  *areaResetScheduler
+	resetMu sync.Mutex
+	// graph is the interned room graph, or nil until it is next needed.
+	graph atomic.Pointer[roomGraph]
+	// bus relays channels, tells, who lists and mail to other nodes.
+	bus *busRelay
+}
+
+// roomLock returns the shard lock guarding the contents of the room. Callers
+// must hold w.mu for reading.
+func (w *World) roomLock(id RoomID) *sync.Mutex {
+	hash := uint32(2166136261)
+	for i := 0; i < len(id); i++ {
+		hash ^= uint32(id[i])
+		hash *= 16777619
+	}
+	return &w.roomShards[hash%roomShardCount].mu
 }
 
 // ActivePlayer returns the currently connected player with the provided name.
@@ -224,27 +295,27 @@ func (w *World) ActivePlayer(name string) (*Player, bool) {
 }
 
 // PrepareTakeover detaches the active session for the provided player so that
-// another connection can assume control. It returns the previous session and
-// output channel so the caller can notify and close them.
-func (w *World) PrepareTakeover(name string) (*TelnetSession, chan string, bool) {
+// another connection can assume control. It returns the previous session so
+// the caller can notify and close it; output sent to the player from here on
+// is dropped until the new session is attached.
+func (w *World) PrepareTakeover(name string) (*TelnetSession, bool) {
 	w.mu.Lock()
 	defer w.mu.Unlock()
 	if w.players == nil {
-		return nil, nil, false
+		return nil, false
 	}
 	existing, ok := w.players[name]
 	if !ok || !existing.Alive {
-		return nil, nil, false
+		return nil, false
 	}
 
 	oldSession := existing.Session
-	oldOutput := existing.Output
 	existing.Session = nil
-	existing.Output = nil
+	existing.queue.Store(nil)
 	existing.Alive = false
 	w.removePlayerOrderLocked(name)
 
-	return oldSession, oldOutput, true
+	return oldSession, true
 }
 
 // PlayerLocation describes the room occupied by a connected player.
@@ -267,6 +338,7 @@ type PlayerSnapshot struct {
 	Mana        int
 	MaxMana     int
 	JoinedAt    time.Time
+	Output      OutputStats
 }
 
 func snapshotVitals(p *Player) (level, health, maxHealth, mana, maxMana int) {
@@ -297,28 +369,61 @@ func snapshotVitals(p *Player) (level, health, maxHealth, mana, maxMana int) {
 }
 
 func NewWorld(areasPath string) (*World, error) {
-	rooms, sources, areas, err := loadRooms(areasPath)
-	if err != nil {
-		return nil, err
-	}
-	quests, err := loadQuestData(areasPath)
+	var (
+		rooms              map[RoomID]*Room
+		sources            map[RoomID]string
+		areas              map[string]areaMetadata
+		quests             map[string]*Quest
+		roomsErr, questErr error
+		timings            = make([]LoadTiming, 4)
+		wg                 sync.WaitGroup
+	)
+	runLoadStage(&wg, &timings[0], "areas", func() {
+		rooms, sources, areas, roomsErr = loadRooms(areasPath)
+	})
+	runLoadStage(&wg, &timings[1], "quests", func() {
+		quests, questErr = loadQuestData(areasPath)
+	})
+	wg.Wait()
+	if roomsErr != nil {
+		return nil, roomsErr
+	}
+	if questErr != nil {
+		return nil, questErr
+	}
+	builderPath := filepath.Join(areasPath, builderAreaFile)
+	var builder *builderStore
+	var err error
+	timeLoadStage(&timings[2], "builder journal", func() {
+		builder, err = openBuilderStore(builderPath, areas[builderAreaFile], rooms, sources)
+	})
 	if err != nil {
 		return nil, err
 	}
-	return &World{
+	world := &World{
+		loadTimings:   timings,
 		rooms:         rooms,
 		players:       make(map[string]*Player),
 		playerOrder:   make([]string, 0),
+		occupants:     make(map[RoomID]map[*Player]struct{}),
 		combats:       make(map[RoomID]*combatInstance),
 		areasPath:     areasPath,
 		roomSources:   sources,
 		areaMeta:      areas,
 		roomHistories: newRoomHistories(rooms),
-		builderPath:   filepath.Join(areasPath, builderAreaFile),
+		roomDigests:   digestRooms(rooms, sources),
+		builderPath:   builderPath,
+		builder:       builder,
 		quests:        quests,
 		questsByNPC:   indexQuestsByNPC(quests),
 		scripts:       newScriptEngine(),
-	}, nil
+	}
+	timeLoadStage(&world.loadTimings[3], "scripts", func() {
+		if _, failed := world.PrecompileScripts(); failed > 0 {
+			fmt.Printf("failed to compile %d world scripts\n", failed)
+		}
+	})
+	return world, nil
 }
 
 // NewWorldWithRooms constructs a world populated with the provided rooms.
@@ -327,6 +432,7 @@ func NewWorldWithRooms(rooms map[RoomID]*Room) *World {
 		rooms:         rooms,
 		players:       make(map[string]*Player),
 		playerOrder:   make([]string, 0),
+		occupants:     make(map[RoomID]map[*Player]struct{}),
 		combats:       make(map[RoomID]*combatInstance),
 		roomSources:   make(map[RoomID]string, len(rooms)),
 		roomHistories: newRoomHistories(rooms),
@@ -344,6 +450,19 @@ func (w *World) ConfigurePrivileges(forceAllAdmin, lockCriticalOps bool) {
 	w.mu.Unlock()
 }
 
+// ConfigureOutput sets the output queue limits applied to new sessions.
+func (w *World) ConfigureOutput(cfg OutputConfig) {
+	w.mu.Lock()
+	w.outputCfg = cfg.normalized()
+	w.mu.Unlock()
+}
+
+func (w *World) outputConfig() OutputConfig {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	return w.outputCfg.normalized()
+}
+
 // SetCommandDisabled toggles whether a command is available to players.
 func (w *World) SetCommandDisabled(name string, disabled bool) {
 	normalized := strings.ToLower(strings.TrimSpace(name))
@@ -438,7 +557,8 @@ func (w *World) AccountStats(name string) (AccountStats, bool) {
 	return accounts.Stats(name)
 }
 
-// AddPlayerForTest inserts a player into the world's tracking structures.
+// AddPlayerForTest inserts a player into the world's tracking structures and
+// gives it an output queue: its session's, or a standalone one tests can read.
 func (w *World) AddPlayerForTest(p *Player) {
 	w.mu.Lock()
 	defer w.mu.Unlock()
@@ -466,20 +586,45 @@ func (w *World) AddPlayerForTest(p *Player) {
 	if w.forceAllAdmin {
 		p.IsAdmin = true
 	}
+	if q := p.Session.queue(); q != nil {
+		p.queue.Store(q)
+	} else {
+		p.AttachOutputForTest()
+	}
 	w.players[p.Name] = p
+	w.indexPlayerNameLocked(p)
+	w.startChannelHistoryLocked(p)
 	w.removePlayerOrderLocked(p.Name)
-	w.playerOrder = append(w.playerOrder, p.Name)
+	w.appendPlayerOrderLocked(p)
+	w.placePlayerLocked(p, p.Room)
 }
 
 type areaFile struct {
 	Name   string `json:"name"`
 	Script string `json:"script,omitempty"`
-	Rooms  []Room `json:"rooms"`
+	// ResetInterval is how often the area's rooms repopulate, as a Go
+	// duration such as "15m". Empty uses the server's default.
+	ResetInterval string `json:"reset_interval,omitempty"`
+	Rooms         []Room `json:"rooms"`
+	// JournalSeq is the last builder journal record folded into the file.
+	JournalSeq uint64 `json:"journal_seq,omitempty"`
 }
 
 type areaMetadata struct {
-	Name   string
-	Script string
+	Name          string
+	Script        string
+	ResetInterval time.Duration
+	JournalSeq    uint64
+	// Digest hashes the file contents so reloads can skip unchanged files.
+	Digest uint64
+}
+
+// loadedArea is one decoded area file waiting to be merged into the world.
+type loadedArea struct {
+	name   string
+	file   areaFile
+	digest uint64
+	err    error
 }
 
 func loadRooms(areasPath string) (map[RoomID]*Room, map[RoomID]string, map[string]areaMetadata, error) {
@@ -498,22 +643,23 @@ func loadRooms(areasPath string) (map[RoomID]*Room, map[RoomID]string, map[strin
 		names = append(names, entry.Name())
 	}
 	sort.Strings(names)
+	loaded := decodeAreaFiles(areasPath, names)
 
 	rooms := make(map[RoomID]*Room)
 	sources := make(map[RoomID]string)
 	areas := make(map[string]areaMetadata)
-	var builderFileName string
-	for _, name := range names {
-		if name == builderAreaFile {
-			builderFileName = name
+	builderIdx := -1
+	for i := range loaded {
+		if loaded[i].name == builderAreaFile {
+			builderIdx = i
 			continue
 		}
-		if err := loadAreaFile(areasPath, name, rooms, sources, areas, false); err != nil {
+		if err := mergeAreaFile(loaded[i], rooms, sources, areas, false); err != nil {
 			return nil, nil, nil, err
 		}
 	}
-	if builderFileName != "" {
-		if err := loadAreaFile(areasPath, builderFileName, rooms, sources, areas, true); err != nil {
+	if builderIdx >= 0 {
+		if err := mergeAreaFile(loaded[builderIdx], rooms, sources, areas, true); err != nil {
 			return nil, nil, nil, err
 		}
 	}
@@ -523,40 +669,101 @@ func loadRooms(areasPath string) (map[RoomID]*Room, map[RoomID]string, map[strin
 	return rooms, sources, areas, nil
 }
 
-func loadAreaFile(areasPath, name string, rooms map[RoomID]*Room, sources map[RoomID]string, areas map[string]areaMetadata, allowOverride bool) error {
-	data, err := os.ReadFile(filepath.Join(areasPath, name))
+// decodeAreaFiles reads and decodes the named area files in parallel, one
+// worker per CPU, returning them in the order given.
+func decodeAreaFiles(areasPath string, names []string) []loadedArea {
+	loaded := make([]loadedArea, len(names))
+	workers := runtime.GOMAXPROCS(0)
+	if workers > len(names) {
+		workers = len(names)
+	}
+	next := make(chan int)
+	var wg sync.WaitGroup
+	for i := 0; i < workers; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for idx := range next {
+				loaded[idx] = readAreaFile(areasPath, names[idx])
+			}
+		}()
+	}
+	for idx := range names {
+		next <- idx
+	}
+	close(next)
+	wg.Wait()
+	return loaded
+}
+
+func readAreaFile(areasPath, name string) loadedArea {
+	f, err := os.Open(filepath.Join(areasPath, name))
 	if err != nil {
-		return fmt.Errorf("read area %s: %w", name, err)
+		return loadedArea{name: name, err: fmt.Errorf("read area %s: %w", name, err)}
+	}
+	defer f.Close()
+	file, digest, err := decodeAreaFile(name, bufio.NewReader(f))
+	return loadedArea{name: name, file: file, digest: digest, err: err}
+}
+
+func mergeAreaFile(area loadedArea, rooms map[RoomID]*Room, sources map[RoomID]string, areas map[string]areaMetadata, allowOverride bool) error {
+	if area.err != nil {
+		return area.err
 	}
+	file := area.file
+	areas[area.name] = areaMetadata{Name: file.Name, Script: strings.TrimSpace(file.Script), ResetInterval: file.resetInterval(), JournalSeq: file.JournalSeq, Digest: area.digest}
+	for i := range file.Rooms {
+		room := &file.Rooms[i]
+		if _, exists := rooms[room.ID]; exists && !allowOverride {
+			return fmt.Errorf("duplicate room id %s", room.ID)
+		}
+		rooms[room.ID] = room
+		sources[room.ID] = area.name
+	}
+	return nil
+}
+
+// decodeAreaFile streams one area file through the JSON decoder, normalising
+// its rooms and hashing the raw contents so reloads can skip unchanged files.
+func decodeAreaFile(name string, r io.Reader) (areaFile, uint64, error) {
+	hash := fnv.New64a()
+	tee := io.TeeReader(r, hash)
 	var file areaFile
-	if err := json.Unmarshal(data, &file); err != nil {
-		return fmt.Errorf("decode area %s: %w", name, err)
+	if err := json.NewDecoder(tee).Decode(&file); err != nil {
+		return areaFile{}, 0, fmt.Errorf("decode area %s: %w", name, err)
+	}
+	if _, err := io.Copy(io.Discard, tee); err != nil {
+		return areaFile{}, 0, fmt.Errorf("read area %s: %w", name, err)
+	}
+	if interval := strings.TrimSpace(file.ResetInterval); interval != "" {
+		if d, err := time.ParseDuration(interval); err != nil || d < 0 {
+			return areaFile{}, 0, fmt.Errorf("area %s has an invalid reset_interval %q", name, file.ResetInterval)
+		}
 	}
-	areas[name] = areaMetadata{Name: file.Name, Script: strings.TrimSpace(file.Script)}
 	for i := range file.Rooms {
-		room := file.Rooms[i]
+		room := &file.Rooms[i]
 		if room.ID == "" {
-			return fmt.Errorf("area %s contains a room without an id", name)
+			return areaFile{}, 0, fmt.Errorf("area %s contains a room without an id", name)
 		}
 		if room.Exits == nil {
 			room.Exits = make(map[string]RoomID)
 		}
-		if len(room.NPCs) > 0 {
-			for i := range room.NPCs {
-				normalizeNPC(&room.NPCs[i])
-			}
-		}
-		if _, exists := rooms[room.ID]; exists && !allowOverride {
-			return fmt.Errorf("duplicate room id %s", room.ID)
+		for j := range room.NPCs {
+			normalizeNPC(&room.NPCs[j])
 		}
-		r := room
-		rooms[room.ID] = &r
-		sources[room.ID] = name
 	}
-	return nil
+	return file, hash.Sum64(), nil
 }
 
+// markRoomAsBuilderLocked records that builders now own room id. Every
+// builder edit calls it, so it also drops the room's cached views, item
+// counts and the room graph.
 func (w *World) markRoomAsBuilderLocked(id RoomID) (string, bool) {
+	w.invalidateRoomViewLocked(id)
+	w.invalidateRoomGraphLocked()
+	if room := w.rooms[id]; room != nil {
+		room.itemIndex = roomItemIndex{}
+	}
 	if w.roomSources == nil {
 		w.roomSources = make(map[RoomID]string)
 	}
@@ -612,6 +819,7 @@ func (w *World) setExitLocked(roomID RoomID, direction string, target *RoomID) (
 		} else if room.Exits != nil {
 			delete(room.Exits, direction)
 		}
+		w.invalidateRoomGraphLocked()
 		if hadSource {
 			w.roomSources[roomID] = prevSource
 		} else {
@@ -621,87 +829,6 @@ func (w *World) setExitLocked(roomID RoomID, direction string, target *RoomID) (
 	return undo, nil
 }
 
-func (w *World) persistBuilderRoomsLocked() error {
-	if w.builderPath == "" {
-		return nil
-	}
-	rooms := make([]Room, 0, len(w.roomSources))
-	for id, source := range w.roomSources {
-		if source != builderAreaFile {
-			continue
-		}
-		room, ok := w.rooms[id]
-		if !ok {
-			continue
-		}
-		copyRoom := *room
-		copyRoom.ID = id
-		if room.Exits == nil {
-			copyRoom.Exits = make(map[string]RoomID)
-		} else {
-			copyRoom.Exits = cloneExits(room.Exits)
-		}
-		if room.NPCs != nil {
-			npcs := make([]NPC, len(room.NPCs))
-			copy(npcs, room.NPCs)
-			copyRoom.NPCs = npcs
-		}
-		if room.Items != nil {
-			items := make([]Item, len(room.Items))
-			copy(items, room.Items)
-			copyRoom.Items = items
-		}
-		if room.Resets != nil {
-			resets := make([]RoomReset, len(room.Resets))
-			copy(resets, room.Resets)
-			copyRoom.Resets = resets
-		}
-		rooms = append(rooms, copyRoom)
-	}
-	sort.Slice(rooms, func(i, j int) bool {
-		return rooms[i].ID < rooms[j].ID
-	})
-	name := "Builder Rooms"
-	script := ""
-	if w.areaMeta != nil {
-		if meta, ok := w.areaMeta[builderAreaFile]; ok {
-			if strings.TrimSpace(meta.Name) != "" {
-				name = meta.Name
-			}
-			script = meta.Script
-		}
-	}
-	file := areaFile{Name: name, Script: script, Rooms: rooms}
-	if w.areaMeta == nil {
-		w.areaMeta = make(map[string]areaMetadata)
-	}
-	w.areaMeta[builderAreaFile] = areaMetadata{Name: name, Script: script}
-	dir := filepath.Dir(w.builderPath)
-	if err := os.MkdirAll(dir, 0o755); err != nil {
-		return fmt.Errorf("create builder area directory: %w", err)
-	}
-	tmp, err := os.CreateTemp(dir, "builder-*.tmp")
-	if err != nil {
-		return fmt.Errorf("create temp builder area file: %w", err)
-	}
-	enc := json.NewEncoder(tmp)
-	enc.SetIndent("", "  ")
-	if err := enc.Encode(file); err != nil {
-		tmp.Close()
-		os.Remove(tmp.Name())
-		return fmt.Errorf("write builder area: %w", err)
-	}
-	if err := tmp.Close(); err != nil {
-		os.Remove(tmp.Name())
-		return fmt.Errorf("close builder area: %w", err)
-	}
-	if err := os.Rename(tmp.Name(), w.builderPath); err != nil {
-		os.Remove(tmp.Name())
-		return fmt.Errorf("replace builder area: %w", err)
-	}
-	return nil
-}
-
 func cloneExits(exits map[string]RoomID) map[string]RoomID {
 	if exits == nil {
 		return nil
@@ -739,8 +866,9 @@ func (w *World) addPlayer(name string, session *TelnetSession, isAdmin bool, pro
 			return nil, fmt.Errorf("%s is already connected", name)
 		}
 		existing.Session = session
-		existing.Output = make(chan string, 32)
-		existing.Room = room
+		existing.defeated = false
+		existing.queue.Store(session.queue())
+		w.placePlayerLocked(existing, room)
 		existing.Home = home
 		existing.Alive = true
 		existing.IsAdmin = isAdmin
@@ -748,11 +876,12 @@ func (w *World) addPlayer(name string, session *TelnetSession, isAdmin bool, pro
 		existing.Channels = cloneChannelSettings(channels)
 		existing.ChannelAliases = cloneChannelAliases(aliases)
 		existing.JoinedAt = now
+		w.limitCommandsLocked(existing)
 		existing.EnsureStats()
 		existing.Health = existing.MaxHealth
 		existing.Mana = existing.MaxMana
 		w.removePlayerOrderLocked(name)
-		w.playerOrder = append(w.playerOrder, name)
+		w.appendPlayerOrderLocked(existing)
 		persistChannels := cloneChannelSettings(existing.Channels)
 		persistAliases := cloneChannelAliases(existing.ChannelAliases)
 		account := existing.Account
@@ -771,7 +900,6 @@ func (w *World) addPlayer(name string, session *TelnetSession, isAdmin bool, pro
 		Session:        session,
 		Room:           room,
 		Home:           home,
-		Output:         make(chan string, 32),
 		Alive:          true,
 		IsAdmin:        isAdmin,
 		IsModerator:    false,
@@ -780,12 +908,17 @@ func (w *World) addPlayer(name string, session *TelnetSession, isAdmin bool, pro
 		ChannelAliases: cloneChannelAliases(playerAliases),
 		JoinedAt:       now,
 	}
+	p.queue.Store(session.queue())
+	w.limitCommandsLocked(p)
 	p.EnsureStats()
 	p.Health = p.MaxHealth
 	p.Mana = p.MaxMana
 	w.players[name] = p
+	w.indexPlayerNameLocked(p)
+	w.startChannelHistoryLocked(p)
 	w.removePlayerOrderLocked(name)
-	w.playerOrder = append(w.playerOrder, name)
+	w.appendPlayerOrderLocked(p)
+	w.placePlayerLocked(p, room)
 	persistChannels := cloneChannelSettings(playerChannels)
 	persistAliases := cloneChannelAliases(playerAliases)
 	account := p.Account
@@ -796,43 +929,30 @@ func (w *World) addPlayer(name string, session *TelnetSession, isAdmin bool, pro
 	return p, nil
 }
 
+// markPlayerOffline flags p as leaving so snapshots and lookups skip it
+// while its farewell is sent.
+func (w *World) markPlayerOffline(p *Player) {
+	w.mu.Lock()
+	p.Alive = false
+	w.mu.Unlock()
+}
+
 func (w *World) removePlayer(name string) {
 	w.mu.Lock()
 	defer w.mu.Unlock()
 	if p, ok := w.players[name]; ok {
 		delete(w.players, name)
+		w.unindexPlayerNameLocked(p)
 		w.removePlayerOrderLocked(name)
-		if p.Output != nil {
-			close(p.Output)
+		w.unplacePlayerLocked(p)
+		// The session's queue stays attached, closed, so output sent to
+		// the departing player is dropped while its backlog is flushed.
+		if q := p.queue.Load(); q != nil {
+			q.close(false)
 		}
 	}
 }
 
-func (w *World) Reboot() ([]*Player, error) {
-	w.mu.Lock()
-	defer w.mu.Unlock()
-	if w.areasPath == "" {
-		return nil, fmt.Errorf("world does not have an areas path configured")
-	}
-	rooms, sources, areas, err := loadRooms(w.areasPath)
-	if err != nil {
-		return nil, err
-	}
-	w.rooms = rooms
-	w.roomSources = sources
-	w.roomHistories = newRoomHistories(rooms)
-	w.areaMeta = areas
-	if w.areasPath != "" {
-		w.builderPath = filepath.Join(w.areasPath, builderAreaFile)
-	}
-	revived := make([]*Player, 0, len(w.players))
-	for _, p := range w.players {
-		p.Room = StartRoom
-		revived = append(revived, p)
-	}
-	return revived, nil
-}
-
 func (w *World) GetRoom(id RoomID) (*Room, bool) {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
@@ -860,12 +980,9 @@ func (w *World) areaMetadataForRoom(id RoomID) (areaMetadata, bool) {
 func (w *World) BroadcastToRoom(room RoomID, msg string, except *Player) {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
-	for _, p := range w.players {
-		if p.Room == room && p != except && p.Alive {
-			select {
-			case p.Output <- msg:
-			default:
-			}
+	for p := range w.occupants[room] {
+		if p != except && p.Alive {
+			sendChatter(p, msg)
 		}
 	}
 }
@@ -877,32 +994,30 @@ func (w *World) sendToPlayer(name string, msg string) {
 	}
 	w.mu.RLock()
 	target, ok := w.players[trimmed]
-	if !ok || target == nil || !target.Alive {
-		w.mu.RUnlock()
-		return
-	}
-	output := target.Output
+	ok = ok && target != nil && target.Alive
 	w.mu.RUnlock()
-	if output == nil {
+	if !ok {
 		return
 	}
-	select {
-	case output <- msg:
-	default:
-	}
+	sendDirect(target, msg)
 }
 
 func (w *World) BroadcastToRoomChannel(room RoomID, msg string, except *Player, channel Channel) {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
-	for _, target := range w.players {
-		if target.Room != room || target == except || !target.Alive {
+	var to []string
+	for target := range w.occupants[room] {
+		if target == except || !target.Alive {
 			continue
 		}
 		if !target.channelEnabled(channel) {
 			continue
 		}
-		w.deliverChannelMessage(target, msg, channel)
+		to = append(to, target.Name)
+		sendChatter(target, msg)
+	}
+	if len(to) > 0 {
+		w.recordChannelMessage(channel, msg, to, "", nil)
 	}
 }
 
@@ -910,49 +1025,74 @@ func (w *World) BroadcastToRoomsChannel(rooms []RoomID, msg string, except *Play
 	if len(rooms) == 0 {
 		return
 	}
-	roomSet := make(map[RoomID]struct{}, len(rooms))
-	for _, room := range rooms {
-		roomSet[room] = struct{}{}
-	}
 	w.mu.RLock()
 	defer w.mu.RUnlock()
-	for _, target := range w.players {
-		if target == except || !target.Alive {
+	var to []string
+	for i, room := range rooms {
+		if containsRoomID(rooms[:i], room) {
 			continue
 		}
-		if _, ok := roomSet[target.Room]; !ok {
-			continue
+		for target := range w.occupants[room] {
+			if target == except || !target.Alive {
+				continue
+			}
+			if !target.channelEnabled(channel) {
+				continue
+			}
+			to = append(to, target.Name)
+			sendChatter(target, msg)
 		}
-		if !target.channelEnabled(channel) {
-			continue
+	}
+	if len(to) > 0 {
+		w.recordChannelMessage(channel, msg, to, "", nil)
+	}
+}
+
+func containsPlayer(players []*Player, p *Player) bool {
+	for _, candidate := range players {
+		if candidate == p {
+			return true
+		}
+	}
+	return false
+}
+
+func containsRoomID(rooms []RoomID, id RoomID) bool {
+	for _, room := range rooms {
+		if room == id {
+			return true
 		}
-		w.deliverChannelMessage(target, msg, channel)
 	}
+	return false
 }
 
+// BroadcastToAllChannel sends msg to every player listening on channel. The
+// message is logged once for all of them; only the players it skipped are
+// recorded with it.
 func (w *World) BroadcastToAllChannel(msg string, except *Player, channel Channel) {
+	w.broadcastToAllChannel(msg, except, channel)
+	w.publishBus(BusMessage{Kind: BusChannel, Channel: channel, Text: msg})
+}
+
+func (w *World) broadcastToAllChannel(msg string, except *Player, channel Channel) {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	var skipped []string
 	for _, target := range w.players {
-		if target == except || !target.Alive {
+		if target == except {
 			continue
 		}
-		if !target.channelEnabled(channel) {
+		if !target.Alive || !target.channelEnabled(channel) {
+			skipped = append(skipped, target.Name)
 			continue
 		}
-		w.deliverChannelMessage(target, msg, channel)
+		sendChatter(target, msg)
 	}
-}
-
-func (w *World) deliverChannelMessage(target *Player, msg string, channel Channel) {
-	if target == nil {
-		return
-	}
-	target.rememberChannelMessage(channel, msg, time.Now())
-	select {
-	case target.Output <- msg:
-	default:
+	skip := ""
+	if except != nil {
+		skip = except.Name
 	}
+	w.recordChannelMessage(channel, msg, nil, skip, skipped)
 }
 
 // QueueOfflineTell stores a private message for delivery when the recipient returns.
@@ -1018,27 +1158,8 @@ func (w *World) DeliverOfflineTells(p *Player) {
 		stamp := tell.CreatedAt.Local().Format("2006-01-02 15:04")
 		builder.WriteString(fmt.Sprintf("  [%s] %s tells you: %s\r\n", stamp, HighlightName(tell.Sender), tell.Body))
 	}
-	p.Output <- Ansi(builder.String())
-	p.Output <- Prompt(p)
-}
-
-func (w *World) AdjacentRooms(room RoomID) []RoomID {
-	w.mu.RLock()
-	defer w.mu.RUnlock()
-	current, ok := w.rooms[room]
-	if !ok {
-		return nil
-	}
-	seen := make(map[RoomID]struct{}, len(current.Exits))
-	neighbors := make([]RoomID, 0, len(current.Exits))
-	for _, next := range current.Exits {
-		if _, ok := seen[next]; ok {
-			continue
-		}
-		seen[next] = struct{}{}
-		neighbors = append(neighbors, next)
-	}
-	return neighbors
+	p.Send(Ansi(builder.String()))
+	p.Send(Prompt(p))
 }
 
 func (w *World) SetChannel(p *Player, channel Channel, enabled bool) {
@@ -1126,7 +1247,10 @@ func (w *World) ChannelHistory(p *Player, channel Channel, limit int) []ChannelL
 	if !ok || stored != p {
 		return nil
 	}
-	return p.snapshotChannelHistory(channel, limit)
+	if limit <= 0 || limit > ChannelHistoryLimit {
+		limit = ChannelHistoryLimit
+	}
+	return w.channelLog(channel).history(p, limit)
 }
 
 // RecordPlayerChannelMessage adds a message to the player's personal channel history.
@@ -1140,7 +1264,7 @@ func (w *World) RecordPlayerChannelMessage(p *Player, channel Channel, msg strin
 	if !ok || stored != p {
 		return
 	}
-	p.rememberChannelMessage(channel, msg, time.Now())
+	w.recordChannelMessage(channel, msg, []string{p.Name}, "", nil)
 }
 
 // ChannelMuted reports whether the player is currently muted on the specified channel.
@@ -1217,8 +1341,10 @@ func (w *World) RenamePlayer(p *Player, newName string) error {
 	}
 	oldName := p.Name
 	delete(w.players, p.Name)
+	w.unindexPlayerNameLocked(p)
 	p.Name = newName
 	w.players[newName] = p
+	w.indexPlayerNameLocked(p)
 	w.replacePlayerOrderLocked(oldName, newName)
 	return nil
 }
@@ -1226,6 +1352,14 @@ func (w *World) RenamePlayer(p *Player, newName string) error {
 func (w *World) ListPlayers(roomOnly bool, room RoomID) []string {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	if roomOnly {
+		occupants := w.roomOccupantsLocked(room, nil)
+		names := make([]string, len(occupants))
+		for i, p := range occupants {
+			names[i] = p.Name
+		}
+		return names
+	}
 	names := make([]string, 0, len(w.playerOrder))
 	seen := make(map[string]struct{}, len(w.playerOrder))
 	for _, name := range w.playerOrder {
@@ -1236,9 +1370,6 @@ func (w *World) ListPlayers(roomOnly bool, room RoomID) []string {
 		if !p.Alive {
 			continue
 		}
-		if roomOnly && p.Room != room {
-			continue
-		}
 		names = append(names, p.Name)
 		seen[p.Name] = struct{}{}
 	}
@@ -1247,9 +1378,6 @@ func (w *World) ListPlayers(roomOnly bool, room RoomID) []string {
 			if !p.Alive {
 				continue
 			}
-			if roomOnly && p.Room != room {
-				continue
-			}
 			if _, ok := seen[p.Name]; ok {
 				continue
 			}
@@ -1263,11 +1391,7 @@ func findItemIndex(items []Item, target string) int {
 	if target == "" {
 		return -1
 	}
-	names := make([]string, len(items))
-	for i, item := range items {
-		names[i] = item.Name
-	}
-	idx, ok := uniqueMatch(target, names, true)
+	idx, ok := uniqueMatchFunc(target, len(items), func(i int) string { return items[i].Name }, true)
 	if !ok {
 		return -1
 	}
@@ -1278,11 +1402,7 @@ func findNPCIndex(npcs []NPC, target string) int {
 	if target == "" {
 		return -1
 	}
-	names := make([]string, len(npcs))
-	for i, npc := range npcs {
-		names[i] = npc.Name
-	}
-	idx, ok := uniqueMatch(target, names, true)
+	idx, ok := uniqueMatchFunc(target, len(npcs), func(i int) string { return npcs[i].Name }, true)
 	if !ok {
 		return -1
 	}
@@ -1293,26 +1413,25 @@ func findResetIndex(resets []RoomReset, kind ResetKind, target string) int {
 	if target == "" {
 		return -1
 	}
-	candidates := make([]string, 0, len(resets))
-	indexes := make([]int, 0, len(resets))
-	for i, reset := range resets {
-		if reset.Kind != kind {
-			continue
+	idx, ok := uniqueMatchFunc(target, len(resets), func(i int) string {
+		if resets[i].Kind != kind {
+			return ""
 		}
-		candidates = append(candidates, reset.Name)
-		indexes = append(indexes, i)
-	}
-	idx, ok := uniqueMatch(target, candidates, true)
+		return resets[i].Name
+	}, true)
 	if !ok {
 		return -1
 	}
-	return indexes[idx]
+	return idx
 }
 
 // RoomItems returns a copy of the items present in the specified room.
 func (w *World) RoomItems(room RoomID) []Item {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(room)
+	lock.Lock()
+	defer lock.Unlock()
 	r, ok := w.rooms[room]
 	if !ok || len(r.Items) == 0 {
 		return nil
@@ -1326,6 +1445,9 @@ func (w *World) RoomItems(room RoomID) []Item {
 func (w *World) RoomNPCs(room RoomID) []NPC {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(room)
+	lock.Lock()
+	defer lock.Unlock()
 	r, ok := w.rooms[room]
 	if !ok || len(r.NPCs) == 0 {
 		return nil
@@ -1429,16 +1551,15 @@ func (w *World) FindRoomNPC(room RoomID, name string) (*NPC, bool) {
 	}
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(room)
+	lock.Lock()
+	defer lock.Unlock()
 	r, ok := w.rooms[room]
 	if !ok || len(r.NPCs) == 0 {
 		return nil, false
 	}
-	candidates := make([]string, len(r.NPCs))
-	for i, npc := range r.NPCs {
-		candidates[i] = npc.Name
-	}
-	idx, ok := uniqueMatch(target, candidates, true)
-	if !ok {
+	idx := findNPCIndex(r.NPCs, target)
+	if idx < 0 {
 		return nil, false
 	}
 	npc := r.NPCs[idx]
@@ -1472,8 +1593,17 @@ func (w *World) ApplyDamageToNPC(room RoomID, name string, damage int) (*NPCDama
 	if trimmed == "" {
 		return nil, fmt.Errorf("target must not be empty")
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	lock := w.roomLock(room)
+	lock.Lock()
+	defer lock.Unlock()
+	return w.damageNPCLocked(room, trimmed, damage)
+}
+
+// damageNPCLocked applies damage to an NPC. Callers must hold w.mu for
+// reading and the room's shard lock.
+func (w *World) damageNPCLocked(room RoomID, trimmed string, damage int) (*NPCDamageResult, error) {
 	r, ok := w.rooms[room]
 	if !ok {
 		return nil, fmt.Errorf("unknown room: %s", room)
@@ -1497,7 +1627,7 @@ func (w *World) ApplyDamageToNPC(room RoomID, name string, damage int) (*NPCDama
 	if defeated {
 		npc.Health = 0
 		if len(loot) > 0 {
-			r.Items = append(r.Items, loot...)
+			r.addItems(loot...)
 		}
 		r.NPCs = append(r.NPCs[:idx], r.NPCs[idx+1:]...)
 	} else {
@@ -1518,27 +1648,45 @@ func (w *World) ApplyDamageToPlayer(attacker *Player, targetName string, damage
 	if trimmed == "" {
 		return nil, fmt.Errorf("target must not be empty")
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
-	if !attacker.Alive {
+	result, err := w.damageRoomPlayer(attacker, trimmed, damage)
+	if err != nil {
+		return nil, err
+	}
+	if result.Defeated {
+		w.respawnPlayer(result.Target, result.PreviousRoom)
+	}
+	return result, nil
+}
+
+func (w *World) damageRoomPlayer(attacker *Player, trimmed string, damage int) (*PlayerDamageResult, error) {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	lock := w.roomLock(attacker.Room)
+	lock.Lock()
+	defer lock.Unlock()
+	if !attacker.Alive || attacker.defeated {
 		return nil, fmt.Errorf("you are in no condition to fight")
 	}
+	return w.damageRoomPlayerLocked(attacker, trimmed, damage, nil)
+}
+
+// damageRoomPlayerLocked damages the occupant of the attacker's room matching
+// trimmed, ignoring anyone listed in exclude or awaiting respawn. Callers must
+// hold w.mu for reading and the room's shard lock.
+func (w *World) damageRoomPlayerLocked(attacker *Player, trimmed string, damage int, exclude []*Player) (*PlayerDamageResult, error) {
 	attacker.EnsureStats()
-	var (
-		candidates []string
-		indexes    []*Player
-	)
-	for _, p := range w.players {
-		if p == attacker || !p.Alive || p.Room != attacker.Room {
-			continue
+	indexes := w.roomOccupantsLocked(attacker.Room, attacker)
+	kept := indexes[:0]
+	for _, p := range indexes {
+		if !p.defeated && !containsPlayer(exclude, p) {
+			kept = append(kept, p)
 		}
-		candidates = append(candidates, p.Name)
-		indexes = append(indexes, p)
 	}
-	if len(candidates) == 0 {
+	indexes = kept
+	if len(indexes) == 0 {
 		return nil, fmt.Errorf("no such opponent here")
 	}
-	idx, ok := uniqueMatch(trimmed, candidates, true)
+	idx, ok := uniqueMatchFunc(trimmed, len(indexes), func(i int) string { return indexes[i].Name }, true)
 	if !ok {
 		return nil, fmt.Errorf("no such opponent here")
 	}
@@ -1555,10 +1703,7 @@ func (w *World) ApplyDamageToPlayer(attacker *Player, targetName string, damage
 	}
 	result := &PlayerDamageResult{Target: target, Damage: damage, Defeated: defeated, PreviousRoom: target.Room, Remaining: remaining}
 	if defeated {
-		if target.Home == "" {
-			target.Home = StartRoom
-		}
-		target.Room = target.Home
+		target.defeated = true
 		target.EnsureStats()
 		target.Health = target.MaxHealth
 		target.Mana = target.MaxMana
@@ -1582,11 +1727,30 @@ func (w *World) ApplyDamageFromNPC(room RoomID, npcName string, target *Player,
 		return nil, fmt.Errorf("damage must be positive")
 	}
 
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	result, err := w.damagePlayerFromNPC(room, target, damage)
+	if err != nil {
+		return nil, err
+	}
+	if result.Defeated {
+		w.respawnPlayer(target, room)
+	}
+	return result, nil
+}
 
+func (w *World) damagePlayerFromNPC(room RoomID, target *Player, damage int) (*PlayerDamageResult, error) {
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	lock := w.roomLock(room)
+	lock.Lock()
+	defer lock.Unlock()
+	return w.damagePlayerFromNPCLocked(room, target, damage)
+}
+
+// damagePlayerFromNPCLocked applies NPC damage to a player standing in room.
+// Callers must hold w.mu for reading and the room's shard lock.
+func (w *World) damagePlayerFromNPCLocked(room RoomID, target *Player, damage int) (*PlayerDamageResult, error) {
 	stored, ok := w.players[target.Name]
-	if !ok || stored != target || !target.Alive {
+	if !ok || stored != target || !target.Alive || target.defeated {
 		return nil, fmt.Errorf("no such opponent here")
 	}
 	if target.Room != room {
@@ -1615,10 +1779,7 @@ func (w *World) ApplyDamageFromNPC(room RoomID, npcName string, target *Player,
 	}
 
 	if defeated {
-		if target.Home == "" {
-			target.Home = StartRoom
-		}
-		target.Room = target.Home
+		target.defeated = true
 		target.EnsureStats()
 		target.Health = target.MaxHealth
 		target.Mana = target.MaxMana
@@ -1630,6 +1791,27 @@ func (w *World) ApplyDamageFromNPC(room RoomID, npcName string, target *Player,
 	return result, nil
 }
 
+// respawnPlayer returns a defeated player to their home room, unless they have
+// already left the room they fell in. Until it runs the player stays marked
+// defeated, so no one can hit them, or be hit by them, between the killing
+// blow and the move.
+func (w *World) respawnPlayer(target *Player, fallen RoomID) {
+	w.mu.Lock()
+	defer w.mu.Unlock()
+	w.respawnPlayerLocked(target, fallen)
+}
+
+func (w *World) respawnPlayerLocked(target *Player, fallen RoomID) {
+	target.defeated = false
+	if stored, ok := w.players[target.Name]; !ok || stored != target || target.Room != fallen {
+		return
+	}
+	if target.Home == "" {
+		target.Home = StartRoom
+	}
+	w.placePlayerLocked(target, target.Home)
+}
+
 func (w *World) ensureCombat(room RoomID) *combatInstance {
 	w.mu.Lock()
 	defer w.mu.Unlock()
@@ -1637,14 +1819,32 @@ func (w *World) ensureCombat(room RoomID) *combatInstance {
 	if w.combats == nil {
 		w.combats = make(map[RoomID]*combatInstance)
 	}
+	if w.combatScheduler == nil {
+		w.combatScheduler = newCombatScheduler()
+	}
 	combat, ok := w.combats[room]
 	if !ok {
-		combat = newCombatInstance(w, room)
+		combat = newCombatInstance(w, room, w.combatScheduler)
 		w.combats[room] = combat
 	}
 	return combat
 }
 
+// CombatStats reports how many rooms are fighting and how closely combat
+// rounds have kept to their schedule.
+func (w *World) CombatStats() CombatStats {
+	w.mu.RLock()
+	active := len(w.combats)
+	scheduler := w.combatScheduler
+	w.mu.RUnlock()
+	var stats CombatStats
+	if scheduler != nil {
+		stats = scheduler.stats()
+	}
+	stats.Active = active
+	return stats
+}
+
 func (w *World) finishCombat(room RoomID, combat *combatInstance) {
 	w.mu.Lock()
 	if w.combats != nil {
@@ -1683,9 +1883,7 @@ func (w *World) StartCombat(attacker *Player, targetName string) error {
 		combat.addPlayer(attacker.Name, combatTarget{kind: combatTargetNPC, name: npc.Name})
 		combat.addNPC(npc.Name, combatTarget{kind: combatTargetPlayer, name: attacker.Name})
 
-		if attacker.Output != nil {
-			attacker.Output <- Ansi(fmt.Sprintf("\r\nYou engage %s in combat!", HighlightNPCName(npc.Name)))
-		}
+		attacker.Send(Ansi(fmt.Sprintf("\r\nYou engage %s in combat!", HighlightNPCName(npc.Name))))
 		w.BroadcastToRoom(attacker.Room, Ansi(fmt.Sprintf("\r\n%s engages %s in combat!", HighlightName(attacker.Name), HighlightNPCName(npc.Name))), attacker)
 
 		if !combat.executeRound() {
@@ -1697,20 +1895,12 @@ func (w *World) StartCombat(attacker *Player, targetName string) error {
 	}
 
 	w.mu.RLock()
-	candidates := make([]string, 0, len(w.players))
-	matches := make([]*Player, 0, len(w.players))
-	for _, p := range w.players {
-		if p == attacker || !p.Alive || p.Room != attacker.Room {
-			continue
-		}
-		candidates = append(candidates, p.Name)
-		matches = append(matches, p)
-	}
+	matches := w.roomOccupantsLocked(attacker.Room, attacker)
 	w.mu.RUnlock()
-	if len(candidates) == 0 {
+	if len(matches) == 0 {
 		return fmt.Errorf("no such opponent here")
 	}
-	idx, ok := uniqueMatch(trimmed, candidates, true)
+	idx, ok := uniqueMatchFunc(trimmed, len(matches), func(i int) string { return matches[i].Name }, true)
 	if !ok || idx < 0 || idx >= len(matches) {
 		return fmt.Errorf("no such opponent here")
 	}
@@ -1720,12 +1910,8 @@ func (w *World) StartCombat(attacker *Player, targetName string) error {
 	combat.addPlayer(attacker.Name, combatTarget{kind: combatTargetPlayer, name: target.Name})
 	combat.addPlayer(target.Name, combatTarget{kind: combatTargetPlayer, name: attacker.Name})
 
-	if attacker.Output != nil {
-		attacker.Output <- Ansi(fmt.Sprintf("\r\nYou engage %s in combat!", HighlightName(target.Name)))
-	}
-	if target.Output != nil {
-		target.Output <- Ansi(fmt.Sprintf("\r\n%s engages you in combat!", HighlightName(attacker.Name)))
-	}
+	attacker.Send(Ansi(fmt.Sprintf("\r\nYou engage %s in combat!", HighlightName(target.Name))))
+	target.Send(Ansi(fmt.Sprintf("\r\n%s engages you in combat!", HighlightName(attacker.Name))))
 	w.BroadcastToRoom(attacker.Room, Ansi(fmt.Sprintf("\r\n%s engages %s in combat!", HighlightName(attacker.Name), HighlightName(target.Name))), attacker)
 
 	if !combat.executeRound() {
@@ -1741,8 +1927,11 @@ func (w *World) AwardExperience(p *Player, amount int) int {
 	if p == nil || amount <= 0 {
 		return 0
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	return p.GainExperience(amount)
 }
 
@@ -1755,16 +1944,15 @@ func (w *World) FindRoomItem(room RoomID, name string) (*Item, bool) {
 	}
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(room)
+	lock.Lock()
+	defer lock.Unlock()
 	r, ok := w.rooms[room]
 	if !ok || len(r.Items) == 0 {
 		return nil, false
 	}
-	candidates := make([]string, len(r.Items))
-	for i, item := range r.Items {
-		candidates[i] = item.Name
-	}
-	idx, ok := uniqueMatch(target, candidates, true)
-	if !ok {
+	idx := findItemIndex(r.Items, target)
+	if idx < 0 {
 		return nil, false
 	}
 	item := r.Items[idx]
@@ -1788,6 +1976,9 @@ func (w *World) RoomResets(room RoomID) []RoomReset {
 func (w *World) PlayerInventory(p *Player) []Item {
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || len(stored.Inventory) == 0 {
 		return nil
@@ -1806,16 +1997,15 @@ func (w *World) FindInventoryItem(p *Player, name string) (*Item, bool) {
 	}
 	w.mu.RLock()
 	defer w.mu.RUnlock()
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || len(stored.Inventory) == 0 {
 		return nil, false
 	}
-	candidates := make([]string, len(stored.Inventory))
-	for i, item := range stored.Inventory {
-		candidates[i] = item.Name
-	}
-	idx, ok := uniqueMatch(target, candidates, true)
-	if !ok {
+	idx := findItemIndex(stored.Inventory, target)
+	if idx < 0 {
 		return nil, false
 	}
 	item := stored.Inventory[idx]
@@ -1828,12 +2018,15 @@ func (w *World) TakeItem(p *Player, name string) (*Item, error) {
 	if target == "" {
 		return nil, fmt.Errorf("item name must not be empty")
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || !p.Alive {
 		return nil, fmt.Errorf("%s is not online", p.Name)
 	}
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	room, ok := w.rooms[p.Room]
 	if !ok {
 		return nil, fmt.Errorf("unknown room: %s", p.Room)
@@ -1842,8 +2035,7 @@ func (w *World) TakeItem(p *Player, name string) (*Item, error) {
 	if idx == -1 {
 		return nil, ErrItemNotFound
 	}
-	item := room.Items[idx]
-	room.Items = append(room.Items[:idx], room.Items[idx+1:]...)
+	item := room.removeItemAt(idx)
 	p.Inventory = append(p.Inventory, item)
 	return &item, nil
 }
@@ -1854,12 +2046,15 @@ func (w *World) DropItem(p *Player, name string) (*Item, error) {
 	if target == "" {
 		return nil, fmt.Errorf("item name must not be empty")
 	}
-	w.mu.Lock()
-	defer w.mu.Unlock()
+	w.mu.RLock()
+	defer w.mu.RUnlock()
 	stored, ok := w.players[p.Name]
 	if !ok || stored != p || !p.Alive {
 		return nil, fmt.Errorf("%s is not online", p.Name)
 	}
+	lock := w.roomLock(p.Room)
+	lock.Lock()
+	defer lock.Unlock()
 	room, ok := w.rooms[p.Room]
 	if !ok {
 		return nil, fmt.Errorf("unknown room: %s", p.Room)
@@ -1870,7 +2065,7 @@ func (w *World) DropItem(p *Player, name string) (*Item, error) {
 	}
 	item := p.Inventory[idx]
 	p.Inventory = append(p.Inventory[:idx], p.Inventory[idx+1:]...)
-	room.Items = append(room.Items, item)
+	room.addItems(item)
 	return &item, nil
 }
 
@@ -1886,7 +2081,7 @@ func (w *World) Move(p *Player, dir string) (string, error) {
 		w.mu.Unlock()
 		return "", fmt.Errorf("you can't go that way")
 	}
-	p.Room = next
+	w.placePlayerLocked(p, next)
 	channels := cloneChannelSettings(p.Channels)
 	aliases := cloneChannelAliases(p.ChannelAliases)
 	account := p.Account
@@ -1905,21 +2100,16 @@ func (w *World) ResolveExit(room RoomID, direction string) (string, RoomID, bool
 	}
 	w.mu.RLock()
 	defer w.mu.RUnlock()
-	r, ok := w.rooms[room]
-	if !ok || len(r.Exits) == 0 {
+	if r, ok := w.rooms[room]; !ok || len(r.Exits) == 0 {
 		return "", "", false
 	}
-	names := make([]string, 0, len(r.Exits))
-	destinations := make([]RoomID, 0, len(r.Exits))
-	for dir, dest := range r.Exits {
-		names = append(names, dir)
-		destinations = append(destinations, dest)
-	}
+	g := w.roomGraphLocked()
+	names, to := g.exits(g.index[room])
 	idx, ok := uniqueMatch(target, names, true)
 	if !ok {
 		return "", "", false
 	}
-	return names[idx], destinations[idx], true
+	return names[idx], g.ids[to[idx]], true
 }
 
 func (w *World) findPlayerLocked(name string) (*Player, bool) {
@@ -1930,20 +2120,7 @@ func (w *World) findPlayerLocked(name string) (*Player, bool) {
 	if p, ok := w.players[trimmed]; ok && p.Alive {
 		return p, true
 	}
-	candidates := make([]*Player, 0, len(w.players))
-	names := make([]string, 0, len(w.players))
-	for _, p := range w.players {
-		if !p.Alive {
-			continue
-		}
-		candidates = append(candidates, p)
-		names = append(names, p.Name)
-	}
-	idx, ok := uniqueMatch(trimmed, names, false)
-	if !ok {
-		return nil, false
-	}
-	return candidates[idx], true
+	return w.matchPlayerNameLocked(trimmed)
 }
 
 // FindPlayer locates an online player by name, performing a case-insensitive match.
@@ -1993,7 +2170,7 @@ func (w *World) MoveToRoom(p *Player, room RoomID) error {
 		w.mu.Unlock()
 		return fmt.Errorf("%s is not online", p.Name)
 	}
-	p.Room = room
+	w.placePlayerLocked(p, room)
 	account := p.Account
 	home := p.Home
 	channels := cloneChannelSettings(p.Channels)
@@ -2051,7 +2228,7 @@ func (w *World) CreateRoom(id RoomID, title, editor string) (*Room, error) {
 	}
 	w.rooms[normalizedID] = room
 	prevSource, hadSource := w.markRoomAsBuilderLocked(normalizedID)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(normalizedID); err != nil {
 		if hadSource {
 			w.roomSources[normalizedID] = prevSource
 		} else {
@@ -2077,7 +2254,7 @@ func (w *World) UpdateRoomDescription(id RoomID, description, editor string) (*R
 	prevDesc := room.Description
 	prevSource, hadSource := w.markRoomAsBuilderLocked(id)
 	room.Description = description
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(id); err != nil {
 		room.Description = prevDesc
 		if hadSource {
 			w.roomSources[id] = prevSource
@@ -2111,7 +2288,7 @@ func (w *World) UpdateRoomTitle(id RoomID, title, editor string) (*Room, error)
 	prevTitle := room.Title
 	prevSource, hadSource := w.markRoomAsBuilderLocked(id)
 	room.Title = trimmed
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(id); err != nil {
 		room.Title = prevTitle
 		if hadSource {
 			w.roomSources[id] = prevSource
@@ -2176,7 +2353,7 @@ func (w *World) RevertRoomToRevision(id RoomID, number int, editor string) (*Roo
 	prevSource, hadSource := w.markRoomAsBuilderLocked(id)
 	room.Title = target.Title
 	room.Description = target.Description
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(id); err != nil {
 		room.Title = prevTitle
 		room.Description = prevDesc
 		if hadSource {
@@ -2205,7 +2382,7 @@ func (w *World) SetExit(from RoomID, direction string, to RoomID) error {
 		w.mu.Unlock()
 		return err
 	}
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(from); err != nil {
 		undo()
 		w.mu.Unlock()
 		return err
@@ -2226,7 +2403,7 @@ func (w *World) ClearExit(from RoomID, direction string) error {
 		w.mu.Unlock()
 		return err
 	}
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderEditsLocked([]builderEdit{w.unlinkEditLocked(from, dir)}); err != nil {
 		undo()
 		w.mu.Unlock()
 		return err
@@ -2249,6 +2426,7 @@ func (w *World) LinkRooms(from RoomID, direction string, to RoomID, back string)
 		return err
 	}
 	undos := []func(){undoForward}
+	linked := []RoomID{from}
 	if reverse != "" {
 		undoBack, err := w.setExitLocked(to, reverse, &from)
 		if err != nil {
@@ -2259,8 +2437,9 @@ func (w *World) LinkRooms(from RoomID, direction string, to RoomID, back string)
 			return err
 		}
 		undos = append(undos, undoBack)
+		linked = append(linked, to)
 	}
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(linked...); err != nil {
 		for _, undo := range undos {
 			undo()
 		}
@@ -2309,7 +2488,7 @@ func (w *World) UpsertRoomNPC(roomID RoomID, name, autoGreet string) (*NPC, erro
 		room.Resets = append(room.Resets, RoomReset{Kind: ResetKindNPC, Name: trimmed, AutoGreet: greet, Count: 1, Script: npc.Script})
 	}
 	prevSource, hadSource := w.markRoomAsBuilderLocked(roomID)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(roomID); err != nil {
 		room.NPCs = prevNPCs
 		room.Resets = prevResets
 		if hadSource {
@@ -2349,7 +2528,7 @@ func (w *World) RemoveRoomNPC(roomID RoomID, name string) error {
 		room.Resets = append(room.Resets[:resetIdx], room.Resets[resetIdx+1:]...)
 	}
 	prevSource, hadSource := w.markRoomAsBuilderLocked(roomID)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(roomID); err != nil {
 		room.NPCs = prevNPCs
 		room.Resets = prevResets
 		if hadSource {
@@ -2393,7 +2572,7 @@ func (w *World) UpsertRoomItemReset(roomID RoomID, name, description string) (*R
 	w.applyRoomResetsLocked(room)
 	result := room.Resets[idx]
 	prevSource, hadSource := w.markRoomAsBuilderLocked(roomID)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(roomID); err != nil {
 		room.Items = prevItems
 		room.Resets = prevResets
 		if hadSource {
@@ -2437,7 +2616,7 @@ func (w *World) RemoveRoomItemReset(roomID RoomID, name string) error {
 	}
 	room.Items = filtered
 	prevSource, hadSource := w.markRoomAsBuilderLocked(roomID)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(roomID); err != nil {
 		room.Items = prevItems
 		room.Resets = prevResets
 		if hadSource {
@@ -2465,7 +2644,7 @@ func (w *World) ApplyRoomResets(roomID RoomID) error {
 	prevResets := append([]RoomReset(nil), room.Resets...)
 	w.applyRoomResetsLocked(room)
 	prevSource, hadSource := w.markRoomAsBuilderLocked(roomID)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(roomID); err != nil {
 		room.Items = prevItems
 		room.NPCs = prevNPCs
 		room.Resets = prevResets
@@ -2527,7 +2706,7 @@ func (w *World) CloneRoomPopulation(source, target RoomID) error {
 	}
 	w.applyRoomResetsLocked(to)
 	prevSource, hadSource := w.markRoomAsBuilderLocked(target)
-	if err := w.persistBuilderRoomsLocked(); err != nil {
+	if err := w.persistBuilderRoomsLocked(target); err != nil {
 		to.Items = prevItems
 		to.NPCs = prevNPCs
 		to.Resets = prevResets
@@ -2629,13 +2808,19 @@ func (w *World) PlayerSnapshots() []PlayerSnapshot {
 		if room, ok := w.rooms[p.Room]; ok && room != nil {
 			snapshot.RoomTitle = room.Title
 		}
+		lock := w.roomLock(p.Room)
+		lock.Lock()
 		level, health, maxHealth, mana, maxMana := snapshotVitals(p)
+		lock.Unlock()
 		snapshot.Level = level
 		snapshot.Health = health
 		snapshot.MaxHealth = maxHealth
 		snapshot.Mana = mana
 		snapshot.MaxMana = maxMana
 		snapshot.JoinedAt = p.JoinedAt
+		if p.Session != nil && p.Session.output != nil {
+			snapshot.Output = p.Session.OutputStats()
+		}
 		snapshots = append(snapshots, snapshot)
 		seen[p.Name] = struct{}{}
 	}
@@ -2671,3 +2856,66 @@ func (w *World) replacePlayerOrderLocked(oldName, newName string) {
 	}
 	w.playerOrder = append(w.playerOrder, newName)
 }
+
+func (w *World) appendPlayerOrderLocked(p *Player) {
+	w.loginSeq++
+	p.loginSeq = w.loginSeq
+	w.playerOrder = append(w.playerOrder, p.Name)
+}
+
+// placePlayerLocked sets the player's room and keeps the occupancy index in
+// step with it. Every write to Player.Room made while the player is tracked by
+// the world must go through here.
+func (w *World) placePlayerLocked(p *Player, room RoomID) {
+	if p.indexed && p.indexedRoom == room {
+		p.Room = room
+		return
+	}
+	w.unplacePlayerLocked(p)
+	p.Room = room
+	if w.occupants == nil {
+		w.occupants = make(map[RoomID]map[*Player]struct{})
+	}
+	set, ok := w.occupants[room]
+	if !ok {
+		set = make(map[*Player]struct{})
+		w.occupants[room] = set
+	}
+	set[p] = struct{}{}
+	p.indexedRoom = room
+	p.indexed = true
+}
+
+func (w *World) unplacePlayerLocked(p *Player) {
+	if !p.indexed {
+		return
+	}
+	if set, ok := w.occupants[p.indexedRoom]; ok {
+		delete(set, p)
+		if len(set) == 0 {
+			delete(w.occupants, p.indexedRoom)
+		}
+	}
+	p.indexedRoom = ""
+	p.indexed = false
+}
+
+// roomOccupantsLocked returns the living players in a room, excluding the
+// provided player, ordered by login.
+func (w *World) roomOccupantsLocked(room RoomID, except *Player) []*Player {
+	set := w.occupants[room]
+	if len(set) == 0 {
+		return nil
+	}
+	occupants := make([]*Player, 0, len(set))
+	for p := range set {
+		if p == except || !p.Alive {
+			continue
+		}
+		occupants = append(occupants, p)
+	}
+	sort.Slice(occupants, func(i, j int) bool {
+		return occupants[i].loginSeq < occupants[j].loginSeq
+	})
+	return occupants
+}
@@ -9,6 +9,7 @@ import (
 	"path/filepath"
 	"reflect"
 	"strings"
+	"sync"
 	"testing"
 	"time"
 )
@@ -45,6 +46,7 @@ func TestWorldTakeDropItem(t *testing.T) {
 	}
 	player := &Player{Name: "Collector", Room: roomID, Alive: true}
 	world.players[player.Name] = player
+	world.indexPlayerNameLocked(player)
 
 	taken, err := world.TakeItem(player, "crystal key")
 	if err != nil {
@@ -97,6 +99,7 @@ func TestWorldTakeItemMatchesPartialWord(t *testing.T) {
 	}
 	player := &Player{Name: "Collector", Room: roomID, Alive: true}
 	world.players[player.Name] = player
+	world.indexPlayerNameLocked(player)
 
 	taken, err := world.TakeItem(player, "key")
 	if err != nil {
@@ -121,6 +124,7 @@ func TestWorldTakeItemPartialAmbiguous(t *testing.T) {
 	}
 	player := &Player{Name: "Collector", Room: roomID, Alive: true}
 	world.players[player.Name] = player
+	world.indexPlayerNameLocked(player)
 
 	if _, err := world.TakeItem(player, "key"); !errors.Is(err, ErrItemNotFound) {
 		t.Fatalf("expected ErrItemNotFound for ambiguous match, got %v", err)
@@ -257,8 +261,11 @@ func TestWorldFindPlayerPartialMatch(t *testing.T) {
 	alfred := &Player{Name: "Alfred", Alive: true}
 	bob := &Player{Name: "Bob", Alive: true}
 	world.players[alice.Name] = alice
+	world.indexPlayerNameLocked(alice)
 	world.players[alfred.Name] = alfred
+	world.indexPlayerNameLocked(alfred)
 	world.players[bob.Name] = bob
+	world.indexPlayerNameLocked(bob)
 
 	if p, ok := world.FindPlayer("ali"); !ok || p != alice {
 		t.Fatalf("FindPlayer partial prefix = (%v, %t), want Alice, true", p, ok)
@@ -283,15 +290,30 @@ func TestPlayerAllowCommandThrottles(t *testing.T) {
 	p := &Player{}
 	base := time.Now()
 	for i := 0; i < commandLimit; i++ {
-		if !p.allowCommand(base.Add(time.Duration(i) * (commandWindow / commandLimit))) {
-			t.Fatalf("command %d should be allowed", i)
+		if !p.allowCommand(base) {
+			t.Fatalf("command %d of the burst should be allowed", i)
 		}
 	}
-	if p.allowCommand(base.Add(commandWindow / 2)) {
+	if p.allowCommand(base.Add(commandWindow / (2 * commandLimit))) {
 		t.Fatalf("command should have been throttled")
 	}
-	if !p.allowCommand(base.Add(commandWindow + time.Millisecond)) {
-		t.Fatalf("command should be allowed after window")
+	refill := commandWindow / commandLimit
+	if !p.allowCommand(base.Add(refill)) {
+		t.Fatalf("command should be allowed once a token refills")
+	}
+	if p.allowCommand(base.Add(refill)) {
+		t.Fatalf("only one token should have refilled")
+	}
+	if !p.allowCommand(base.Add(time.Hour)) {
+		t.Fatalf("command should be allowed after a long pause")
+	}
+	for i := 1; i < commandLimit; i++ {
+		if !p.allowCommand(base.Add(time.Hour)) {
+			t.Fatalf("a long pause should refill only the burst, command %d denied", i)
+		}
+	}
+	if p.allowCommand(base.Add(time.Hour)) {
+		t.Fatalf("a long pause should not refill beyond the burst")
 	}
 }
 
@@ -300,7 +322,6 @@ func TestWorldChannelHistoryAndAliasResolution(t *testing.T) {
 	player := &Player{
 		Name:     "Alice",
 		Room:     StartRoom,
-		Output:   make(chan string, 8),
 		Alive:    true,
 		Channels: DefaultChannelSettings(),
 	}
@@ -346,7 +367,6 @@ func TestWorldChannelMute(t *testing.T) {
 	player := &Player{
 		Name:     "Alice",
 		Room:     StartRoom,
-		Output:   make(chan string, 8),
 		Alive:    true,
 		Channels: DefaultChannelSettings(),
 	}
@@ -373,6 +393,7 @@ func TestAccountManagerProfilePersistence(t *testing.T) {
 	if err != nil {
 		t.Fatalf("NewAccountManager: %v", err)
 	}
+	defer manager.Close()
 	if err := manager.Register("alice", "password123"); err != nil {
 		t.Fatalf("Register: %v", err)
 	}
@@ -406,6 +427,9 @@ func TestAccountManagerProfilePersistence(t *testing.T) {
 	if err := manager.SaveProfile("alice", updated); err != nil {
 		t.Fatalf("SaveProfile: %v", err)
 	}
+	if err := manager.Flush(); err != nil {
+		t.Fatalf("Flush: %v", err)
+	}
 
 	playerPath := manager.playerFilePath("alice")
 	if _, err := os.Stat(playerPath); err != nil {
@@ -478,6 +502,7 @@ func TestAccountManagerProfilePersistence(t *testing.T) {
 	if err != nil {
 		t.Fatalf("reload manager: %v", err)
 	}
+	defer reloaded.Close()
 	profile = reloaded.Profile("alice")
 	if profile.Room != updated.Room {
 		t.Fatalf("expected persisted room %q, got %q", updated.Room, profile.Room)
@@ -505,6 +530,7 @@ func TestAccountManagerRecordLoginAndStats(t *testing.T) {
 	if err != nil {
 		t.Fatalf("NewAccountManager: %v", err)
 	}
+	defer manager.Close()
 	if err := manager.Register("explorer", "secretpw"); err != nil {
 		t.Fatalf("Register: %v", err)
 	}
@@ -555,10 +581,14 @@ func TestAccountManagerRecordLoginAndStats(t *testing.T) {
 		t.Fatalf("LastLogin = %v, want %v", stats.LastLogin, secondLogin)
 	}
 
+	if err := manager.Flush(); err != nil {
+		t.Fatalf("Flush: %v", err)
+	}
 	reloaded, err := NewAccountManager(path)
 	if err != nil {
 		t.Fatalf("NewAccountManager reload: %v", err)
 	}
+	defer reloaded.Close()
 	persisted, ok := reloaded.Stats("explorer")
 	if !ok {
 		t.Fatalf("Stats should return data after reload")
@@ -574,6 +604,58 @@ func TestAccountManagerRecordLoginAndStats(t *testing.T) {
 	}
 }
 
+func TestAccountManagerWritesBehind(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "accounts.json")
+
+	manager, err := NewAccountManager(path)
+	if err != nil {
+		t.Fatalf("NewAccountManager: %v", err)
+	}
+	defer manager.Close()
+	if err := manager.Register("scout", "password123"); err != nil {
+		t.Fatalf("Register: %v", err)
+	}
+	if reloaded, err := NewAccountManager(path); err != nil {
+		t.Fatalf("reload after register: %v", err)
+	} else {
+		if !reloaded.Exists("scout") {
+			t.Fatalf("registration should be written through")
+		}
+		reloaded.Close()
+	}
+
+	login := time.Date(2025, time.March, 4, 5, 6, 7, 0, time.UTC)
+	if err := manager.RecordLogin("scout", login); err != nil {
+		t.Fatalf("RecordLogin: %v", err)
+	}
+	if err := manager.SaveProfile("scout", PlayerProfile{Room: "hall", Home: StartRoom}); err != nil {
+		t.Fatalf("SaveProfile: %v", err)
+	}
+	if _, err := os.Stat(manager.playerFilePath("scout")); !os.IsNotExist(err) {
+		t.Fatalf("profile should not be written before a flush, stat err = %v", err)
+	}
+	if got := manager.Profile("scout").Room; got != "hall" {
+		t.Fatalf("pending profile room = %q, want hall", got)
+	}
+
+	if err := manager.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	reloaded, err := NewAccountManager(path)
+	if err != nil {
+		t.Fatalf("reload after close: %v", err)
+	}
+	defer reloaded.Close()
+	stats, ok := reloaded.Stats("scout")
+	if !ok || stats.TotalLogins != 1 || !stats.LastLogin.Equal(login) {
+		t.Fatalf("login bookkeeping not flushed on close: %+v", stats)
+	}
+	if got := reloaded.Profile("scout").Room; got != "hall" {
+		t.Fatalf("flushed profile room = %q, want hall", got)
+	}
+}
+
 func TestWorldPersistsState(t *testing.T) {
 	dir := t.TempDir()
 	path := filepath.Join(dir, "accounts.json")
@@ -582,6 +664,7 @@ func TestWorldPersistsState(t *testing.T) {
 	if err != nil {
 		t.Fatalf("NewAccountManager: %v", err)
 	}
+	defer manager.Close()
 	if err := manager.Register("traveler", "password123"); err != nil {
 		t.Fatalf("Register: %v", err)
 	}
@@ -634,31 +717,26 @@ func TestWorldPrepareTakeover(t *testing.T) {
 		t.Fatalf("ActivePlayer should report the connected player")
 	}
 
-	oldSession, oldOutput, ok := world.PrepareTakeover("traveler")
+	oldSession, ok := world.PrepareTakeover("traveler")
 	if !ok {
 		t.Fatalf("PrepareTakeover should succeed when the player is connected")
 	}
 	if oldSession != nil {
 		t.Fatalf("PrepareTakeover should return nil session when none was set")
 	}
-	if oldOutput == nil {
-		t.Fatalf("PrepareTakeover should return the prior output channel")
-	}
 	if player.Alive {
 		t.Fatalf("player should be marked inactive after takeover preparation")
 	}
 	if player.Session != nil {
 		t.Fatalf("player session should be cleared during takeover preparation")
 	}
-	if player.Output != nil {
-		t.Fatalf("player output channel should be cleared during takeover preparation")
+	if player.Connected() {
+		t.Fatalf("player output queue should be cleared during takeover preparation")
 	}
 	if _, ok := world.ActivePlayer("traveler"); ok {
 		t.Fatalf("ActivePlayer should not report a player pending takeover")
 	}
 
-	close(oldOutput)
-
 	rejoined, err := world.addPlayer("traveler", nil, false, profile)
 	if err != nil {
 		t.Fatalf("addPlayer after takeover: %v", err)
@@ -666,8 +744,8 @@ func TestWorldPrepareTakeover(t *testing.T) {
 	if !rejoined.Alive {
 		t.Fatalf("player should be marked alive after rejoining")
 	}
-	if rejoined.Output == nil {
-		t.Fatalf("rejoined player should have a fresh output channel")
+	if rejoined.Session != nil {
+		t.Fatalf("rejoined player should have the new, empty session")
 	}
 
 	names := world.ListPlayers(false, "")
@@ -684,6 +762,7 @@ func TestWorldSetHomePersists(t *testing.T) {
 	if err != nil {
 		t.Fatalf("NewAccountManager: %v", err)
 	}
+	defer manager.Close()
 	if err := manager.Register("traveler", "password123"); err != nil {
 		t.Fatalf("Register: %v", err)
 	}
@@ -721,9 +800,9 @@ func TestListPlayersUsesLoginOrder(t *testing.T) {
 	}
 	world := NewWorldWithRooms(rooms)
 
-	alpha := &Player{Name: "Alpha", Room: StartRoom, Output: make(chan string, 1), Alive: true}
-	bravo := &Player{Name: "Bravo", Room: "hall", Output: make(chan string, 1), Alive: true}
-	charlie := &Player{Name: "Charlie", Room: StartRoom, Output: make(chan string, 1), Alive: true}
+	alpha := &Player{Name: "Alpha", Room: StartRoom, Alive: true}
+	bravo := &Player{Name: "Bravo", Room: "hall", Alive: true}
+	charlie := &Player{Name: "Charlie", Room: StartRoom, Alive: true}
 
 	world.AddPlayerForTest(alpha)
 	world.AddPlayerForTest(bravo)
@@ -747,7 +826,7 @@ func TestListPlayersUsesLoginOrder(t *testing.T) {
 
 	world.removePlayer("Alpha")
 
-	returning := &Player{Name: "Alpha", Room: "hall", Output: make(chan string, 1), Alive: true}
+	returning := &Player{Name: "Alpha", Room: "hall", Alive: true}
 	world.AddPlayerForTest(returning)
 
 	names = world.ListPlayers(false, "")
@@ -785,7 +864,7 @@ func TestStartCombatPlayerVsNPC(t *testing.T) {
 		},
 	}
 	world := NewWorldWithRooms(rooms)
-	player := &Player{Name: "Hero", Room: StartRoom, Output: make(chan string, 10), Alive: true, Level: 1}
+	player := &Player{Name: "Hero", Room: StartRoom, Alive: true, Level: 1}
 	world.AddPlayerForTest(player)
 
 	npc := rooms[StartRoom].NPCs[0]
@@ -828,7 +907,7 @@ func TestStartCombatNPCKillEndsCombat(t *testing.T) {
 		},
 	}
 	world := NewWorldWithRooms(rooms)
-	player := &Player{Name: "Hero", Room: StartRoom, Output: make(chan string, 10), Alive: true, Level: 5}
+	player := &Player{Name: "Hero", Room: StartRoom, Alive: true, Level: 5}
 	world.AddPlayerForTest(player)
 
 	if err := world.StartCombat(player, "chief"); err != nil {
@@ -854,8 +933,8 @@ func TestStartCombatPlayerVsPlayer(t *testing.T) {
 	rooms := map[RoomID]*Room{StartRoom: {ID: StartRoom}}
 	world := NewWorldWithRooms(rooms)
 
-	alpha := &Player{Name: "Alpha", Room: StartRoom, Output: make(chan string, 10), Alive: true, Level: 2}
-	bravo := &Player{Name: "Bravo", Room: StartRoom, Output: make(chan string, 10), Alive: true, Level: 2}
+	alpha := &Player{Name: "Alpha", Room: StartRoom, Alive: true, Level: 2}
+	bravo := &Player{Name: "Bravo", Room: StartRoom, Alive: true, Level: 2}
 
 	world.AddPlayerForTest(alpha)
 	world.AddPlayerForTest(bravo)
@@ -887,7 +966,7 @@ func TestStartCombatPlayerVsPlayer(t *testing.T) {
 func TestStartCombatUnknownTarget(t *testing.T) {
 	rooms := map[RoomID]*Room{StartRoom: {ID: StartRoom}}
 	world := NewWorldWithRooms(rooms)
-	player := &Player{Name: "Hero", Room: StartRoom, Output: make(chan string, 10), Alive: true, Level: 1}
+	player := &Player{Name: "Hero", Room: StartRoom, Alive: true, Level: 1}
 	world.AddPlayerForTest(player)
 
 	if err := world.StartCombat(player, "phantom"); err == nil {
@@ -933,6 +1012,7 @@ func TestWorldDeliverOfflineTells(t *testing.T) {
 	if err != nil {
 		t.Fatalf("NewAccountManager: %v", err)
 	}
+	defer accounts.Close()
 	if err := accounts.Register("Friend", "password"); err != nil {
 		t.Fatalf("register Friend: %v", err)
 	}
@@ -945,7 +1025,6 @@ func TestWorldDeliverOfflineTells(t *testing.T) {
 		Name:     "Sender",
 		Room:     "hall",
 		Home:     "hall",
-		Output:   make(chan string, 8),
 		Alive:    true,
 		Channels: DefaultChannelSettings(),
 	}
@@ -959,7 +1038,6 @@ func TestWorldDeliverOfflineTells(t *testing.T) {
 		Name:     "Friend",
 		Room:     "hall",
 		Home:     "hall",
-		Output:   make(chan string, 8),
 		Alive:    true,
 		Channels: DefaultChannelSettings(),
 	}
@@ -967,28 +1045,109 @@ func TestWorldDeliverOfflineTells(t *testing.T) {
 
 	world.DeliverOfflineTells(friend)
 
-	var first string
-	select {
-	case first = <-friend.Output:
-	default:
-		t.Fatalf("friend did not receive offline tell output")
+	output := drainOutput(friend)
+	if len(output) != 2 {
+		t.Fatalf("friend got %q, want the offline tells and a prompt", output)
 	}
+	first := output[0]
 	if !strings.Contains(first, "You have 1 offline tell") {
 		t.Fatalf("header missing: %q", first)
 	}
 	if !strings.Contains(first, "Sender") || !strings.Contains(first, "Meet me under the lantern") {
 		t.Fatalf("message missing: %q", first)
 	}
-	var prompt string
-	select {
-	case prompt = <-friend.Output:
-	default:
-		t.Fatalf("friend did not receive prompt after offline tells")
-	}
-	if !strings.Contains(prompt, ">") {
+	if prompt := output[1]; !strings.Contains(prompt, ">") {
 		t.Fatalf("prompt not received: %q", prompt)
 	}
 	if pending := tells.PendingFor("Friend"); len(pending) != 0 {
 		t.Fatalf("offline tells should be cleared, got %#v", pending)
 	}
 }
+
+func TestRoomOccupancyTracksMovement(t *testing.T) {
+	rooms := map[RoomID]*Room{
+		StartRoom: {ID: StartRoom, Exits: map[string]RoomID{"east": "hall"}},
+		"hall":    {ID: "hall", Exits: map[string]RoomID{"west": StartRoom}},
+	}
+	world := NewWorldWithRooms(rooms)
+
+	walker := &Player{Name: "Walker", Room: StartRoom, Alive: true}
+	watcher := &Player{Name: "Watcher", Room: "hall", Alive: true}
+	world.AddPlayerForTest(walker)
+	world.AddPlayerForTest(watcher)
+
+	world.BroadcastToRoom("hall", "ping", nil)
+	if got := drainOutput(walker); len(got) != 0 {
+		t.Fatalf("walker should not hear hall broadcast before moving, got %v", got)
+	}
+	if got := drainOutput(watcher); len(got) != 1 {
+		t.Fatalf("watcher messages = %v, want one", got)
+	}
+
+	if _, err := world.Move(walker, "east"); err != nil {
+		t.Fatalf("Move: %v", err)
+	}
+	if names := world.ListPlayers(true, "hall"); !reflect.DeepEqual(names, []string{"Walker", "Watcher"}) {
+		t.Fatalf("hall occupants = %v, want [Walker Watcher]", names)
+	}
+	if names := world.ListPlayers(true, StartRoom); len(names) != 0 {
+		t.Fatalf("start occupants = %v, want none", names)
+	}
+
+	world.BroadcastToRoom("hall", "pong", watcher)
+	if got := drainOutput(walker); len(got) != 1 || got[0] != "pong" {
+		t.Fatalf("walker messages = %v, want [pong]", got)
+	}
+
+	world.removePlayer("Walker")
+	if names := world.ListPlayers(true, "hall"); !reflect.DeepEqual(names, []string{"Watcher"}) {
+		t.Fatalf("hall occupants after logout = %v, want [Watcher]", names)
+	}
+	world.mu.RLock()
+	_, stale := world.occupants[StartRoom]
+	world.mu.RUnlock()
+	if stale {
+		t.Fatalf("empty rooms should be dropped from the occupancy index")
+	}
+}
+
+func TestRoomShardsConcurrentItemTransfers(t *testing.T) {
+	rooms := map[RoomID]*Room{
+		"market":  {ID: "market", Exits: map[string]RoomID{}, Items: []Item{{Name: "Apple"}}},
+		"library": {ID: "library", Exits: map[string]RoomID{}, Items: []Item{{Name: "Tome"}}},
+	}
+	world := NewWorldWithRooms(rooms)
+	shopper := &Player{Name: "Shopper", Room: "market", Alive: true}
+	reader := &Player{Name: "Reader", Room: "library", Alive: true}
+	world.AddPlayerForTest(shopper)
+	world.AddPlayerForTest(reader)
+
+	var wg sync.WaitGroup
+	cycle := func(p *Player, item string) {
+		defer wg.Done()
+		for i := 0; i < 200; i++ {
+			if _, err := world.TakeItem(p, item); err != nil {
+				t.Errorf("%s TakeItem: %v", p.Name, err)
+				return
+			}
+			if _, err := world.DropItem(p, item); err != nil {
+				t.Errorf("%s DropItem: %v", p.Name, err)
+				return
+			}
+		}
+	}
+	wg.Add(2)
+	go cycle(shopper, "apple")
+	go cycle(reader, "tome")
+	wg.Wait()
+
+	if items := world.RoomItems("market"); len(items) != 1 || items[0].Name != "Apple" {
+		t.Fatalf("market items = %#v, want Apple", items)
+	}
+	if items := world.RoomItems("library"); len(items) != 1 || items[0].Name != "Tome" {
+		t.Fatalf("library items = %#v, want Tome", items)
+	}
+	if inv := world.PlayerInventory(shopper); len(inv) != 0 {
+		t.Fatalf("shopper inventory = %#v, want empty", inv)
+	}
+}
@@ -6,6 +6,7 @@ import (
 	"net"
 	"path/filepath"
 	"strings"
+	"time"
 
 	"LumenClay/commands"
 	"LumenClay/internal/game"
@@ -24,13 +25,93 @@ func main() {
 	webAddr := flag.String("web-addr", "auto", "HTTPS port for the staff web portal (auto uses 443 on the same host as --addr; empty disables)")
 	webCert := flag.String("web-cert", "auto", "Path to the web portal TLS certificate directory or bundle (auto uses --cert)")
 	webBase := flag.String("web-base-url", "", "Optional external base URL for portal links")
+	metricsToken := flag.String("web-metrics-token", "", "Optional bearer token that lets scrapers read the portal's /metrics page")
+	outputQueue := flag.Int("output-queue", 64, "Per-session output backlog in KiB before the output policy sheds load")
+	outputPolicy := flag.String("output-policy", "coalesce", "How slow clients shed output: coalesce, drop-oldest, or disconnect")
+	outputStall := flag.Duration("output-stall", 30*time.Second, "How long a stalled write may block before the session is closed")
+	connMode := flag.String("conn-mode", "goroutine", "How logged-in sessions are served: goroutine (one per session) or poll (epoll and a shared loop pool; Linux, plain telnet only)")
+	mccp := flag.Bool("mccp", true, "Offer MCCP2 (zlib) compression to telnet clients that support it")
+	journalSync := flag.String("journal-sync", "interval", "When mail, tell and builder journal appends are fsynced: always, interval (at most once per second), or never")
+	areaWatch := flag.Duration("area-watch", 0, "Poll the areas directory at this interval and reload changed area files (0 disables)")
+	areaReset := flag.Duration("area-reset", 15*time.Minute, "How often areas without their own reset_interval repopulate their rooms' resets (0 disables)")
+	scriptWorkers := flag.Int("script-workers", 0, "Goroutines running world script hooks (0 uses one per CPU)")
+	scriptBudget := flag.Duration("script-budget", 250*time.Millisecond, "How long a single script hook may run before it is abandoned and its room's later hooks wait")
+	loginWorkers := flag.Int("login-workers", 0, "Logins that may hash passwords at once; the rest wait in a queue (0 uses half the CPUs)")
+	bcryptCost := flag.Int("bcrypt-cost", 10, "bcrypt cost for newly hashed passwords")
+	admissionDefaults := game.DefaultAdmissionConfig()
+	maxConns := flag.Int("max-connections", admissionDefaults.MaxConnections, "Open connections allowed at once, logged in or not (0 disables)")
+	maxConnsPerIP := flag.Int("max-connections-per-ip", admissionDefaults.MaxPerIP, "Open connections allowed from one remote address (0 disables)")
+	loginTimeout := flag.Duration("login-timeout", admissionDefaults.LoginTimeout, "How long a connection may take to log in before it is closed (0 disables)")
+	commandRate := flag.Float64("command-rate", admissionDefaults.CommandRate, "Commands per second a player may send once their burst is spent")
+	commandBurst := flag.Int("command-burst", admissionDefaults.CommandBurst, "Commands a player may send back to back")
+	shedLockWait := flag.Duration("shed-lock-wait", admissionDefaults.ShedLockWait, "Refuse new connections while the 99th percentile world lock wait exceeds this (0 disables)")
+	shedOutput := flag.Int("shed-output-backlog", admissionDefaults.ShedOutputBytes>>10, "Refuse new connections while more than this many KiB of output are queued across all sessions (0 disables)")
+	node := flag.String("node", "", "Name of this server in a cluster (defaults to the host name)")
+	busListen := flag.String("bus-listen", "", "Address other cluster nodes connect to for shared channels, tells, who and mail (empty runs standalone)")
+	busPeers := flag.String("bus-peers", "", "Comma-separated bus addresses of the other cluster nodes")
+	busSecret := flag.String("bus-secret", "", "Shared secret every cluster node must present (required with --bus-listen)")
 	flag.Parse()
 
+	policy, err := game.ParseOutputPolicy(*outputPolicy)
+	if err != nil {
+		log.Fatal(err)
+	}
+	syncPolicy, err := game.ParseJournalSync(*journalSync)
+	if err != nil {
+		log.Fatal(err)
+	}
+	mode, err := game.ParseConnMode(*connMode)
+	if err != nil {
+		log.Fatal(err)
+	}
+	loginCfg := game.LoginConfig{Workers: *loginWorkers, Cost: *bcryptCost}
+	if err := loginCfg.Validate(); err != nil {
+		log.Fatal(err)
+	}
+
 	mudCertFile, mudKeyFile := expandCertPaths(*certPath)
 	portalCertBase := resolveCertBase(*webCert, *certPath)
 	portalCertFile, portalKeyFile := expandCertPaths(portalCertBase)
 
-	var options []game.ServerOption
+	options := []game.ServerOption{game.WithOutputConfig(game.OutputConfig{
+		QueueBytes:   *outputQueue << 10,
+		Policy:       policy,
+		StallTimeout: *outputStall,
+		Compression:  *mccp,
+	})}
+	journalCfg := game.DefaultJournalConfig()
+	journalCfg.Sync = syncPolicy
+	options = append(options, game.WithJournalConfig(journalCfg))
+	scriptCfg := game.DefaultScriptConfig()
+	if *scriptWorkers > 0 {
+		scriptCfg.Workers = *scriptWorkers
+	}
+	scriptCfg.Budget = *scriptBudget
+	options = append(options, game.WithScriptConfig(scriptCfg))
+	options = append(options, game.WithConnMode(mode))
+	options = append(options, game.WithLoginConfig(loginCfg))
+	options = append(options, game.WithAdmissionConfig(game.AdmissionConfig{
+		MaxConnections:  *maxConns,
+		MaxPerIP:        *maxConnsPerIP,
+		LoginTimeout:    *loginTimeout,
+		CommandRate:     *commandRate,
+		CommandBurst:    *commandBurst,
+		ShedLockWait:    *shedLockWait,
+		ShedOutputBytes: *shedOutput << 10,
+	}))
+	if *areaWatch > 0 {
+		options = append(options, game.WithAreaWatch(*areaWatch))
+	}
+	options = append(options, game.WithAreaResets(*areaReset))
+	cluster := game.ClusterConfig{Node: *node, Listen: strings.TrimSpace(*busListen), Secret: *busSecret}
+	for _, peer := range strings.Split(*busPeers, ",") {
+		if peer = strings.TrimSpace(peer); peer != "" {
+			cluster.Peers = append(cluster.Peers, peer)
+		}
+	}
+	if cluster.Enabled() {
+		options = append(options, game.WithCluster(cluster))
+	}
 	if trimmed := strings.TrimSpace(*mailPath); trimmed != "" {
 		options = append(options, game.WithMailPath(trimmed))
 	}
@@ -39,15 +120,15 @@ func main() {
 	}
 	if resolved := resolveWebAddr(*webAddr, *addr); resolved != "" {
 		portalCfg := game.PortalConfig{
-			Addr:     resolved,
-			BaseURL:  strings.TrimSpace(*webBase),
-			CertFile: portalCertFile,
-			KeyFile:  portalKeyFile,
+			Addr:         resolved,
+			BaseURL:      strings.TrimSpace(*webBase),
+			CertFile:     portalCertFile,
+			KeyFile:      portalKeyFile,
+			MetricsToken: *metricsToken,
 		}
 		options = append(options, game.WithPortalConfig(portalCfg))
 	}
 
-	var err error
 	if *useTLS {
 		err = game.ListenAndServeTLS(*addr, *accountsPath, *areasPath, mudCertFile, mudKeyFile, *adminAccount, commands.Dispatch, *everyoneAdmin, options...)
 	} else {
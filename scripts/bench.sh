@@ -0,0 +1,19 @@
+#!/bin/sh
+# Runs the benchmark suite and stores the results under bench/ named after
+# the current commit, in the text format benchstat reads:
+#
+#   scripts/bench.sh                 # writes bench/<commit>.txt
+#   benchstat bench/<old>.txt bench/<new>.txt
+#
+# BENCH, COUNT and BENCHTIME narrow or lengthen the run.
+set -eu
+
+cd "$(dirname "$0")/.."
+rev=$(git rev-parse --short HEAD)
+if [ -n "$(git status --porcelain --untracked-files=no)" ]; then
+	rev="$rev-dirty"
+fi
+mkdir -p bench
+out="bench/$rev.txt"
+go test -run '^$' -bench "${BENCH:-.}" -benchmem -count "${COUNT:-6}" -benchtime "${BENCHTIME:-1s}" ./... | tee "$out"
+echo "wrote $out"